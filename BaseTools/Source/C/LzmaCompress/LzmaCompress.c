@@ -19,6 +19,7 @@
 #include "Sdk/C/Alloc.h"
 #include "Sdk/C/7zFile.h"
 #include "Sdk/C/7zVersion.h"
+#include "Sdk/C/CpuArch.h"
 #include "Sdk/C/LzmaDec.h"
 #include "Sdk/C/LzmaEnc.h"
 #include "Sdk/C/Bra.h"
@@ -27,6 +28,17 @@
 
 #define LZMA_HEADER_SIZE (LZMA_PROPS_SIZE + 8)
 
+//
+// The multi-block format of the LZMA parallel GUIDed section. The header is
+// followed by the encoded size of each block, as UINT32, and then by the
+// blocks. Each block is a complete LZMA stream with its own LZMA_HEADER_SIZE
+// header, which decodes to BlockSize bytes, except the last one which decodes
+// to the rest of the data. All the fields are little endian.
+//
+#define LZMA_PARALLEL_SIGNATURE           0x504D5A4C  // "LZMP"
+#define LZMA_PARALLEL_HEADER_SIZE         16
+#define LZMA_PARALLEL_DEFAULT_BLOCK_SIZE  (1 << 20)
+
 typedef enum {
   NoConverter,
   X86Converter,
@@ -41,6 +53,8 @@ const char *kInvalidParamValMessage = "Invalid parameter value";
 
 static BoolInt mQuietMode = False;
 static CONVERTER_TYPE mConType = NoConverter;
+static BoolInt mParallel = False;
+static UINT64 mBlockSize = LZMA_PARALLEL_DEFAULT_BLOCK_SIZE;
 
 UINT64 mDictionarySize = 28;
 UINT64 mCompressionMode = 2;
@@ -60,6 +74,8 @@ void PrintHelp(char *buffer)
              "  -d: decode file\n"
              "  -o FileName, --output FileName: specify the output filename\n"
              "  --f86: enable converter for x86 code\n"
+             "  --parallel: use the multi-block format, whose blocks can be decoded in parallel\n"
+             "  --block-size Size: set the block size in KB for --parallel, default: 1024 (1MB)\n"
              "  -v, --verbose: increase output messages\n"
              "  -q, --quiet: reduce output messages\n"
              "  --debug [0-9]: set debug level\n"
@@ -238,6 +254,167 @@ Done:
   return res;
 }
 
+static SRes EncodeParallel(ISeqOutStream *outStream, ISeqInStream *inStream, UInt64 fileSize, CLzmaEncProps *props)
+{
+  SRes res;
+  size_t inSize = (size_t)fileSize;
+  size_t blockSize = (size_t)mBlockSize;
+  size_t blockCount;
+  size_t tableSize;
+  size_t block;
+  Byte *inBuffer = 0;
+  Byte *outBuffer = 0;
+  size_t outSize;
+  size_t outPos;
+
+  if (inSize == 0)
+    return SZ_ERROR_INPUT_EOF;
+  if (fileSize > 0xFFFFFFFF)
+    return SZ_ERROR_UNSUPPORTED;
+
+  inBuffer = (Byte *)MyAlloc(inSize);
+  if (inBuffer == 0)
+    return SZ_ERROR_MEM;
+
+  if (SeqInStream_Read(inStream, inBuffer, inSize) != SZ_OK) {
+    res = SZ_ERROR_READ;
+    goto Done;
+  }
+
+  blockCount = (inSize + blockSize - 1) / blockSize;
+  tableSize = LZMA_PARALLEL_HEADER_SIZE + blockCount * 4;
+
+  // we allocate 105% of original size + 64KB per block for output buffer
+  outSize = tableSize + inSize / 20 * 21 + blockCount * (LZMA_HEADER_SIZE + (1 << 16));
+  outBuffer = (Byte *)MyAlloc(outSize);
+  if (outBuffer == 0) {
+    res = SZ_ERROR_MEM;
+    goto Done;
+  }
+
+  SetUi32(outBuffer, LZMA_PARALLEL_SIGNATURE);
+  SetUi32(outBuffer + 4, (UInt32)blockSize);
+  SetUi32(outBuffer + 8, (UInt32)blockCount);
+  SetUi32(outBuffer + 12, (UInt32)inSize);
+
+  outPos = tableSize;
+  for (block = 0; block < blockCount; block++) {
+    size_t blockStart = block * blockSize;
+    size_t blockLength = inSize - blockStart < blockSize ? inSize - blockStart : blockSize;
+    size_t outSizeProcessed = outSize - outPos - LZMA_HEADER_SIZE;
+    size_t outPropsSize = LZMA_PROPS_SIZE;
+    int i;
+
+    for (i = 0; i < 8; i++)
+      outBuffer[outPos + LZMA_PROPS_SIZE + i] = (Byte)((UInt64)blockLength >> (8 * i));
+
+    res = LzmaEncode(outBuffer + outPos + LZMA_HEADER_SIZE, &outSizeProcessed,
+        inBuffer + blockStart, blockLength,
+        props, outBuffer + outPos, &outPropsSize, 0,
+        NULL, &g_Alloc, &g_Alloc);
+
+    if (res != SZ_OK)
+      goto Done;
+
+    SetUi32(outBuffer + LZMA_PARALLEL_HEADER_SIZE + block * 4, (UInt32)(LZMA_HEADER_SIZE + outSizeProcessed));
+    outPos += LZMA_HEADER_SIZE + outSizeProcessed;
+  }
+
+  res = SZ_OK;
+  if (outStream->Write(outStream, outBuffer, outPos) != outPos)
+    res = SZ_ERROR_WRITE;
+
+Done:
+  MyFree(outBuffer);
+  MyFree(inBuffer);
+
+  return res;
+}
+
+static SRes DecodeParallel(ISeqOutStream *outStream, ISeqInStream *inStream, UInt64 fileSize)
+{
+  SRes res;
+  size_t inSize = (size_t)fileSize;
+  Byte *inBuffer = 0;
+  Byte *outBuffer = 0;
+  size_t outSize;
+  size_t blockSize;
+  size_t blockCount;
+  size_t block;
+  size_t inPos;
+  ELzmaStatus status;
+
+  if (inSize < LZMA_PARALLEL_HEADER_SIZE)
+    return SZ_ERROR_INPUT_EOF;
+
+  inBuffer = (Byte *)MyAlloc(inSize);
+  if (inBuffer == 0)
+    return SZ_ERROR_MEM;
+
+  if (SeqInStream_Read(inStream, inBuffer, inSize) != SZ_OK) {
+    res = SZ_ERROR_READ;
+    goto Done;
+  }
+
+  blockSize = GetUi32(inBuffer + 4);
+  blockCount = GetUi32(inBuffer + 8);
+  outSize = GetUi32(inBuffer + 12);
+  if (GetUi32(inBuffer) != LZMA_PARALLEL_SIGNATURE || blockSize == 0 ||
+      blockCount != (outSize + blockSize - 1) / blockSize ||
+      blockCount > (inSize - LZMA_PARALLEL_HEADER_SIZE) / 4) {
+    res = SZ_ERROR_DATA;
+    goto Done;
+  }
+
+  if (outSize == 0) {
+    res = SZ_OK;
+    goto Done;
+  }
+
+  outBuffer = (Byte *)MyAlloc(outSize);
+  if (outBuffer == 0) {
+    res = SZ_ERROR_MEM;
+    goto Done;
+  }
+
+  inPos = LZMA_PARALLEL_HEADER_SIZE + blockCount * 4;
+  for (block = 0; block < blockCount; block++) {
+    size_t encodedSize = GetUi32(inBuffer + LZMA_PARALLEL_HEADER_SIZE + block * 4);
+    size_t blockStart = block * blockSize;
+    size_t blockLength = outSize - blockStart < blockSize ? outSize - blockStart : blockSize;
+    size_t decodedSize = blockLength;
+    size_t inSizePure;
+
+    if (encodedSize < LZMA_HEADER_SIZE || encodedSize > inSize - inPos ||
+        GetUi64(inBuffer + inPos + LZMA_PROPS_SIZE) != blockLength) {
+      res = SZ_ERROR_DATA;
+      goto Done;
+    }
+
+    inSizePure = encodedSize - LZMA_HEADER_SIZE;
+    res = LzmaDecode(outBuffer + blockStart, &decodedSize, inBuffer + inPos + LZMA_HEADER_SIZE, &inSizePure,
+        inBuffer + inPos, LZMA_PROPS_SIZE, LZMA_FINISH_END, &status, &g_Alloc);
+
+    if (res != SZ_OK)
+      goto Done;
+    if (decodedSize != blockLength) {
+      res = SZ_ERROR_DATA;
+      goto Done;
+    }
+
+    inPos += encodedSize;
+  }
+
+  if (outStream->Write(outStream, outBuffer, outSize) != outSize)
+    res = SZ_ERROR_WRITE;
+
+Done:
+  MyFree(outBuffer);
+  MyFree(inBuffer);
+
+  return res;
+}
+
 int main2(int numArgs, const char *args[], char *rs)
 {
   CFileSeqInStream inStream;
@@ -272,6 +449,18 @@ int main2(int numArgs, const char *args[], char *rs)
       modeWasSet = True;
     } else if (strcmp(args[param], "--f86") == 0) {
       mConType = X86Converter;
+    } else if (strcmp(args[param], "--parallel") == 0) {
+      mParallel = True;
+    } else if (strcmp(args[param], "--block-size") == 0) {
+      if (numArgs < (param + 2)) {
+        return PrintUserError(rs);
+      }
+      AsciiStringToUint64(args[param + 1],FALSE,&mBlockSize);
+      if ((mBlockSize == 0) || (mBlockSize > 0x3FFFFF)) {
+        return PrintError(rs, kInvalidParamValMessage);
+      }
+      mBlockSize *= 1024;
+      param++;
     } else if (strcmp(args[param], "-o") == 0 ||
                strcmp(args[param], "--output") == 0) {
       if (numArgs < (param + 2)) {
@@ -342,6 +531,10 @@ int main2(int numArgs, const char *args[], char *rs)
     return PrintUserError(rs);
   }
 
+  if (mParallel && (mConType != NoConverter)) {
+    return PrintError(rs, "--f86 can not be used with --parallel");
+  }
+
   {
     size_t t4 = sizeof(UInt32);
     size_t t8 = sizeof(UInt64);
@@ -364,14 +557,22 @@ int main2(int numArgs, const char *args[], char *rs)
     if (!mQuietMode) {
       printf("Encoding\n");
     }
-    res = Encode(&outStream.vt, &inStream.vt, fileSize, &props);
+    if (mParallel) {
+      res = EncodeParallel(&outStream.vt, &inStream.vt, fileSize, &props);
+    } else {
+      res = Encode(&outStream.vt, &inStream.vt, fileSize, &props);
+    }
   }
   else
   {
     if (!mQuietMode) {
       printf("Decoding\n");
     }
-    res = Decode(&outStream.vt, &inStream.vt, fileSize);
+    if (mParallel) {
+      res = DecodeParallel(&outStream.vt, &inStream.vt, fileSize);
+    } else {
+      res = Decode(&outStream.vt, &inStream.vt, fileSize);
+    }
   }
 
   File_Close(&outStream.file);
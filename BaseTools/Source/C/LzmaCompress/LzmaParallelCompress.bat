@@ -0,0 +1,26 @@
+@REM @file
+@REM This script will exec LzmaCompress tool with --parallel option that enables
+@REM the multi-block format, whose blocks can be decoded in parallel.
+@REM
+@REM Copyright (c) 2026, agent <agent@local>. All rights reserved.<BR>
+@REM SPDX-License-Identifier: BSD-2-Clause-Patent
+@REM
+
+@echo off
+@setlocal
+
+:Begin
+if "%1"=="" goto End
+if "%1"=="-e" (
+  set FLAG=--parallel
+)
+if "%1"=="-d" (
+  set FLAG=--parallel
+)
+set ARGS=%ARGS% %1
+shift
+goto Begin
+
+:End
+LzmaCompress %ARGS% %FLAG%
+@echo on
@@ -48,6 +48,11 @@ gAutoGenImageDefFileName = "%(module_name)sImgDefs.h"
 gAutoGenIdfFileName = "%(module_name)sIdf.hpk"
 gInfSpecVersion = "0x00010017"
 
+## Placeholders of the platform build directory and of the workspace directory
+#  in the files of the libraries saved in the cache shared by the platforms
+gSharedCachePlatformBuildDir = "$(SHARED_CACHE_BUILD_DIR)"
+gSharedCacheWorkspaceDir = "$(SHARED_CACHE_WORKSPACE)"
+
 #
 # Match name = variable
 #
@@ -1725,6 +1730,167 @@ class ModuleAutoGen(AutoGen):
                     self.CacheCopyFile(FileDir, self.BuildDir, File)
                 else:
                     self.CacheCopyFile(CacheFileDir, self.BuildDir, File)
+
+    ## Replace the directories of the platform and of the workspace in a path or
+    #  in the content of a file by placeholders, so that it is the same for all
+    #  the platforms and workspaces
+    def SharedCacheNormalize(self, Content):
+        Content = Content.replace(self.PlatformInfo.BuildDir, gSharedCachePlatformBuildDir)
+        return Content.replace(self.WorkspaceDir, gSharedCacheWorkspaceDir)
+
+    ## Replace the placeholders of SharedCacheNormalize by the directories of
+    #  the platform and of the workspace
+    def SharedCacheExpand(self, Content):
+        Content = Content.replace(gSharedCachePlatformBuildDir, self.PlatformInfo.BuildDir)
+        return Content.replace(gSharedCacheWorkspaceDir, self.WorkspaceDir)
+
+    ## Return whether a file of the build directory is saved in the shared cache
+    #
+    # The makefile and the hash files refer to the platform, and are generated
+    # again by each platform.
+    #
+    def IsSharedCacheFile(self, File):
+        if File in GenMake.BuildFile._FILE_NAME_.values() or File in [self.Name + ".makefile", "AutoGenTimeStamp"]:
+            return False
+        for Tag in [".hash.", ".hashchain.", ".HashFileList.", ".ModuleHashPair"]:
+            if Tag in File:
+                return False
+        return True
+
+    ## Return whether a file of the build directory lists dependencies, by path
+    def IsSharedCacheTextFile(self, File):
+        return File in ["deps.txt", "dependency", "deps_target"] or File.endswith(".deps")
+
+    def GetSharedCacheFileHash(self, File):
+        if File not in GlobalData.gFileHashDict:
+            try:
+                with open(LongFilePath(File), 'rb') as f:
+                    GlobalData.gFileHashDict[File] = hashlib.md5(f.read()).hexdigest()
+            except IOError:
+                GlobalData.gFileHashDict[File] = 0
+        if not GlobalData.gFileHashDict[File]:
+            return None
+        return GlobalData.gFileHashDict[File]
+
+    ## Return the key of the library in the cache shared by the platforms
+    #
+    # The key is the hash of the makefile, of the AutoGen files and of the
+    # source files of the library, in which the directories of the platform and
+    # of the workspace are replaced. The makefile holds the build options and
+    # the AutoGen files hold the PCD values, so the platforms building the
+    # library from the same sources, with the same options and PCD values, get
+    # the same key. The header files are checked against the dependency list
+    # saved with each build result of the key.
+    #
+    #   @retval     string      The key
+    #   @retval     None        The module is not saved in the shared cache
+    #
+    @cached_property
+    def SharedCacheKey(self):
+        if not self.IsLibrary or self.IsBinaryModule or self.CustomMakefile:
+            return None
+
+        # see .inc as binary file, do not share it
+        for f_ext in self.SourceFileList:
+            if '.inc' in str(f_ext):
+                return None
+
+        m = hashlib.md5()
+        m.update(("%s_%s_%s" % (self.BuildTarget, self.ToolChain, self.Arch)).encode('utf-8'))
+
+        # Add Makefile, without the platform macros if the build options do
+        # not use them
+        try:
+            with open(LongFilePath(path.join(self.BuildDir, self.Name + ".makefile")), 'r') as f:
+                MakefilePath = f.read().strip()
+            with open(LongFilePath(MakefilePath), 'r') as f:
+                Lines = f.readlines()
+        except:
+            EdkLogger.quiet("[cache warning]: fail to load makefile of module: %s[%s]" % (self.MetaFile.Path, self.Arch))
+            return None
+        if "$(PLATFORM_" not in "".join(Lines):
+            Lines = [Line for Line in Lines if not Line.startswith("PLATFORM_")]
+        m.update(self.SharedCacheNormalize("".join(Lines)).encode('utf-8'))
+
+        # Add AutoGen files and source files
+        FileSet = set(str(File) for File in self.AutoGenFileList)
+        FileSet.update(File.Path for File in self.SourceFileList)
+        for File in sorted(FileSet):
+            FileHash = self.GetSharedCacheFileHash(File)
+            if FileHash is None:
+                EdkLogger.quiet("[cache warning]: file %s is missing for module: %s[%s]" % (File, self.MetaFile.Path, self.Arch))
+                return None
+            m.update(self.SharedCacheNormalize(File).encode('utf-8'))
+            m.update(FileHash.encode('utf-8'))
+
+        return m.hexdigest()
+
+    ## Return the header files the library was built with, and their hash
+    def GetSharedCacheDependency(self):
+        try:
+            with open(LongFilePath(path.join(self.BuildDir, "deps.txt")), 'r') as f:
+                Lines = f.readlines()
+        except:
+            EdkLogger.quiet("[cache warning]: fail to load deps.txt of module: %s[%s]" % (self.MetaFile.Path, self.Arch))
+            return None
+
+        # Skip the AutoGen files in BuildDir which already been included in
+        # the key
+        Dependency = []
+        BuildDirStr = path.abspath(self.BuildDir).lower()
+        for File in sorted(set(Line.strip() for Line in Lines if Line.strip())):
+            if BuildDirStr in path.abspath(File).lower():
+                continue
+            FileHash = self.GetSharedCacheFileHash(File)
+            if FileHash is None:
+                EdkLogger.quiet("[cache warning]: header file %s is missing for module: %s[%s]" % (File, self.MetaFile.Path, self.Arch))
+                return None
+            Dependency.append((self.SharedCacheNormalize(File), FileHash))
+        return Dependency
+
+    ## Save the build result of the library in the cache shared by the platforms
+    #
+    # The build result is saved in <cache>/Shared/<arch>/<name>/<key>/<hash>,
+    # where the hash is the one of the list of the header files the library was
+    # built with, which is saved with it.
+    #
+    def CopyModuleToSharedCache(self):
+        if not self.SharedCacheKey:
+            return
+        Dependency = self.GetSharedCacheDependency()
+        if Dependency is None:
+            return
+
+        DependencyStr = json.dumps(Dependency, indent=2)
+        KeyDir = path.join(GlobalData.gBinCacheDest, "Shared", self.Arch, self.Name, self.SharedCacheKey)
+        EntryDir = path.join(KeyDir, hashlib.md5(DependencyStr.encode('utf-8')).hexdigest())
+        if path.exists(LongFilePath(EntryDir)):
+            return
+
+        # Build the entry aside and rename it, so that the builds sharing the
+        # cache never see an incomplete entry
+        CreateDirectory(KeyDir)
+        TempDir = tempfile.mkdtemp(dir=KeyDir)
+        FilesDir = path.join(TempDir, "Files")
+        try:
+            for Root, Dirs, Files in os.walk(self.BuildDir):
+                for File in Files:
+                    if not self.IsSharedCacheFile(File):
+                        continue
+                    SrcFile = path.join(Root, File)
+                    if self.IsSharedCacheTextFile(File):
+                        with open(LongFilePath(SrcFile), 'r') as f:
+                            Content = f.read()
+                        SaveFileOnChange(path.join(FilesDir, path.relpath(SrcFile, self.BuildDir)), self.SharedCacheNormalize(Content), False)
+                    else:
+                        self.CacheCopyFile(FilesDir, self.BuildDir, SrcFile)
+            SaveFileOnChange(path.join(TempDir, "Dependency.json"), DependencyStr, False)
+            os.rename(TempDir, EntryDir)
+        except OSError:
+            # The same entry might be saved by another build at the same time
+            shutil.rmtree(TempDir, ignore_errors=True)
+            if not path.exists(LongFilePath(EntryDir)):
+                EdkLogger.quiet("[cache warning]: fail to save module %s[%s] in the shared cache" % (self.MetaFile.Path, self.Arch))
     ## Create makefile for the module and its dependent libraries
     #
     #   @param      CreateLibraryMakeFile   Flag indicating if or not the makefiles of
@@ -2137,6 +2303,50 @@ class ModuleAutoGen(AutoGen):
 
         return True
 
+    ## Restore the build result of the library from the cache shared by the
+    #  platforms, if one was built with the same header files
+    def CanSkipbySharedCache(self):
+        if not self.SharedCacheKey:
+            return False
+
+        KeyDir = path.join(GlobalData.gBinCacheSource, "Shared", self.Arch, self.Name, self.SharedCacheKey)
+        if not path.isdir(LongFilePath(KeyDir)):
+            return False
+
+        for Entry in sorted(os.listdir(LongFilePath(KeyDir))):
+            # Skip the entries being saved
+            if len(Entry) != 32:
+                continue
+            EntryDir = path.join(KeyDir, Entry)
+            try:
+                with open(LongFilePath(path.join(EntryDir, "Dependency.json")), 'r') as f:
+                    Dependency = json.load(f)
+            except:
+                EdkLogger.quiet("[cache error]: fail to load dependency file of: %s" % EntryDir)
+                continue
+
+            HashMiss = False
+            for (File, FileHash) in Dependency:
+                if self.GetSharedCacheFileHash(self.SharedCacheExpand(File)) != FileHash:
+                    HashMiss = True
+                    break
+            if HashMiss:
+                continue
+
+            FilesDir = path.join(EntryDir, "Files")
+            for Root, Dirs, Files in os.walk(FilesDir):
+                for File in Files:
+                    SrcFile = path.join(Root, File)
+                    if self.IsSharedCacheTextFile(File):
+                        with open(LongFilePath(SrcFile), 'r') as f:
+                            Content = f.read()
+                        SaveFileOnChange(path.join(self.BuildDir, path.relpath(SrcFile, FilesDir)), self.SharedCacheExpand(Content), False)
+                    else:
+                        self.CacheCopyFile(self.BuildDir, FilesDir, SrcFile)
+            return True
+
+        return False
+
     ## Decide whether we can skip the left autogen and make process
     def CanSkipbyMakeCache(self):
         # For --binary-source only
@@ -2166,6 +2376,12 @@ class ModuleAutoGen(AutoGen):
                 GlobalData.gModuleMakeCacheStatus[(self.MetaFile.Path, self.Arch)] = False
                 return False
 
+        # The libraries might have been built by another platform
+        if self.CanSkipbySharedCache():
+            print("[cache hit]: SharedCache:", self.MetaFile.Path, self.Arch)
+            GlobalData.gModuleMakeCacheStatus[(self.MetaFile.Path, self.Arch)] = True
+            return True
+
         ModuleCacheDir = path.join(GlobalData.gBinCacheSource, self.PlatformInfo.OutputDir, self.BuildTarget + "_" + self.ToolChain, self.Arch, self.SourceDir, self.MetaFile.BaseName)
         FfsDir = path.join(GlobalData.gBinCacheSource, self.PlatformInfo.OutputDir, self.BuildTarget + "_" + self.ToolChain, TAB_FV_DIRECTORY, "Ffs", self.Guid + self.Name)
 
@@ -94,7 +94,7 @@ class FV (object):
                                 GenFdsGlobalVariable.ErrorLogger("Capsule %s in FD region can't contain a FV %s in FD region." % (self.CapsuleName, self.UiFvName.upper()))
         if not Flag:
             GenFdsGlobalVariable.InfLogger( "\nGenerating %s FV" %self.UiFvName)
-        GenFdsGlobalVariable.LargeFileInFvFlags.append(False)
+        GenFdsGlobalVariable.ThreadState.LargeFileInFvFlags.append(False)
         FFSGuid = None
 
         if self.FvBaseAddress is not None:
@@ -152,7 +152,7 @@ class FV (object):
             OrigFvInfo = None
             if os.path.exists (FvInfoFileName):
                 OrigFvInfo = open(FvInfoFileName, 'r').read()
-            if GenFdsGlobalVariable.LargeFileInFvFlags[-1]:
+            if GenFdsGlobalVariable.ThreadState.LargeFileInFvFlags[-1]:
                 FFSGuid = GenFdsGlobalVariable.EFI_FIRMWARE_FILE_SYSTEM3_GUID
             GenFdsGlobalVariable.GenerateFirmwareVolume(
                                     FvOutputFile,
@@ -184,7 +184,7 @@ class FV (object):
                     for FfsFile in self.FfsList:
                         FileName = FfsFile.GenFfs(MacroDict, FvChildAddr, BaseAddress, IsMakefile=Flag, FvName=self.UiFvName)
 
-                    if GenFdsGlobalVariable.LargeFileInFvFlags[-1]:
+                    if GenFdsGlobalVariable.ThreadState.LargeFileInFvFlags[-1]:
                         FFSGuid = GenFdsGlobalVariable.EFI_FIRMWARE_FILE_SYSTEM3_GUID;
                     #Update GenFv again
                     GenFdsGlobalVariable.GenerateFirmwareVolume(
@@ -226,7 +226,7 @@ class FV (object):
                         self.FvAlignment = str (FvAlignmentValue)
                     FvFileObj.close()
                     GenFdsGlobalVariable.ImageBinDict[self.UiFvName.upper() + 'fv'] = FvOutputFile
-                    GenFdsGlobalVariable.LargeFileInFvFlags.pop()
+                    GenFdsGlobalVariable.ThreadState.LargeFileInFvFlags.pop()
                 else:
                     GenFdsGlobalVariable.ErrorLogger("Invalid FV file %s." % self.UiFvName)
             else:
@@ -18,6 +18,8 @@ from glob import glob
 from struct import unpack
 from linecache import getlines
 from io import BytesIO
+from concurrent.futures import ThreadPoolExecutor
+import multiprocessing
 
 import Common.LongFilePathOs as os
 from Common.TargetTxtClassObject import TargetTxtDict,gDefaultTargetTxtFile
@@ -33,7 +35,7 @@ from Common.BuildToolError import FatalError, GENFDS_ERROR, CODE_ERROR, FORMAT_I
 from Workspace.WorkspaceDatabase import WorkspaceDatabase
 
 from .FdfParser import FdfParser, Warning
-from .GenFdsGlobalVariable import GenFdsGlobalVariable
+from .GenFdsGlobalVariable import GenFdsGlobalVariable, GenFdsThreadState
 from .FfsFileStatement import FileStatement
 import Common.DataType as DataType
 from struct import Struct
@@ -94,8 +96,10 @@ def resetFdsGlobalVariable():
     GenFdsGlobalVariable.CopyList   = []
     GenFdsGlobalVariable.ModuleFile = ''
     GenFdsGlobalVariable.EnableGenfdsMultiThread = True
+    GenFdsGlobalVariable.ThreadNumber = 1
+    GenFdsGlobalVariable.CacheDir = ''
 
-    GenFdsGlobalVariable.LargeFileInFvFlags = []
+    GenFdsGlobalVariable.ThreadState = GenFdsThreadState()
     GenFdsGlobalVariable.EFI_FIRMWARE_FILE_SYSTEM3_GUID = '5473C07A-3DCB-4dca-BD6F-1E9689E7349A'
     GenFdsGlobalVariable.LARGE_FILE_SIZE = 0x1000000
 
@@ -144,6 +148,13 @@ def GenFdsApi(FdsCommandDict, WorkSpaceDataBase=None):
                 GenFdsGlobalVariable.EnableGenfdsMultiThread = False
         os.chdir(GenFdsGlobalVariable.WorkSpaceDir)
 
+        GenFdsGlobalVariable.ThreadNumber = FdsCommandDict.get("ThreadNumber")
+        if not GenFdsGlobalVariable.ThreadNumber:
+            try:
+                GenFdsGlobalVariable.ThreadNumber = multiprocessing.cpu_count()
+            except (ImportError, NotImplementedError):
+                GenFdsGlobalVariable.ThreadNumber = 1
+
         # set multiple workspace
         PackagesPath = os.getenv("PACKAGES_PATH")
         mws.setWs(GenFdsGlobalVariable.WorkSpaceDir, PackagesPath)
@@ -407,6 +418,7 @@ def OptionsToCommandDict(Options):
     FdsCommandDict["debug"] = Options.debug
     FdsCommandDict["Workspace"] = Options.Workspace
     FdsCommandDict["GenfdsMultiThread"] = not Options.NoGenfdsMultiThread
+    FdsCommandDict["ThreadNumber"] = Options.ThreadNumber
     FdsCommandDict["fdf_file"] = [PathClass(Options.filename)] if Options.filename else []
     FdsCommandDict["build_target"] = Options.BuildTarget
     FdsCommandDict["toolchain_tag"] = Options.ToolChain
@@ -465,6 +477,8 @@ def myOptionParser():
     Parser.add_option("--pcd", action="append", dest="OptionPcd", help="Set PCD value by command line. Format: \"PcdName=Value\" ")
     Parser.add_option("--genfds-multi-thread", action="store_true", dest="GenfdsMultiThread", default=True, help="Enable GenFds multi thread to generate ffs file.")
     Parser.add_option("--no-genfds-multi-thread", action="store_true", dest="NoGenfdsMultiThread", default=False, help="Disable GenFds multi thread to generate ffs file.")
+    Parser.add_option("-n", action="callback", type="int", dest="ThreadNumber", callback=SingleCheckCallback,
+                      help="Generate the FV images not depending on each other on the specified number of threads. Default is the number of processors.")
 
     Options, _ = Parser.parse_args()
     return Options
@@ -506,6 +520,7 @@ class GenFds(object):
                 FdObj.GenFd()
                 return
         elif GenFds.OnlyGenerateThisFd is None and GenFds.OnlyGenerateThisFv is None:
+            GenFds.GenIndependentFvs()
             for FdObj in GenFdsGlobalVariable.FdfParser.Profile.FdDict.values():
                 FdObj.GenFd()
 
@@ -534,6 +549,8 @@ class GenFds(object):
                 for OptRomObj in GenFdsGlobalVariable.FdfParser.Profile.OptRomDict.values():
                     OptRomObj.AddToBuffer(None)
 
+            GenFdsGlobalVariable.PruneToolCache()
+
     @staticmethod
     def GenFfsMakefile(OutputDir, FdfParserObject, WorkSpace, ArchList, GlobalData):
         GenFdsGlobalVariable.SetEnv(FdfParserObject, WorkSpace, ArchList, GlobalData)
@@ -549,6 +566,104 @@ class GenFds(object):
 
         return GenFdsGlobalVariable.FfsCmdDict
 
+    ## GetFvReferences()
+    #
+    #   Get what the generation of an FV depends on
+    #
+    #   @param  FvObj           The FV object
+    #   @retval tuple           (The names of the FVs in the FV, the INF files
+    #                           and the FILE statement GUIDs of the FV, whether
+    #                           an FD is in the FV)
+    #
+    @staticmethod
+    def GetFvReferences(FvObj):
+        FvNames = set()
+        FfsFiles = set()
+        HasFd = False
+        SectionList = []
+        for FfsObj in FvObj.FfsList:
+            if isinstance(FfsObj, FileStatement):
+                #
+                # The FFS file of a FILE statement is generated in a directory
+                # of the Ffs directory named after its GUID.
+                #
+                if FfsObj.NameGuid:
+                    FfsFiles.add(FfsObj.NameGuid.upper())
+                if FfsObj.FvName:
+                    FvNames.add(FfsObj.FvName.upper())
+                if FfsObj.FdName:
+                    HasFd = True
+                SectionList.extend(FfsObj.SectionList)
+            elif FfsObj.InfFileName:
+                FfsFiles.add(os.path.normcase(os.path.normpath(FfsObj.InfFileName)))
+        while SectionList:
+            SectionObj = SectionList.pop()
+            if getattr(SectionObj, 'FvName', None):
+                FvNames.add(SectionObj.FvName.upper())
+            SectionList.extend(getattr(SectionObj, 'SectionList', []))
+        return FvNames, FfsFiles, HasFd
+
+    ## GenIndependentFvs()
+    #
+    #   Generate the FVs not placed at an address, such as the FVs compressed
+    #   in other FVs, on several threads, before they are needed. The FVs
+    #   sharing modules or FILE statement GUIDs are not generated at the same
+    #   time, and an FV is generated after the FVs it contains.
+    #
+    @staticmethod
+    def GenIndependentFvs():
+        FvDict = GenFdsGlobalVariable.FdfParser.Profile.FvDict
+        if GenFdsGlobalVariable.ThreadNumber <= 1:
+            return
+        #
+        # Macros defined in an FV apply to the FVs it contains.
+        #
+        for FvObj in FvDict.values():
+            if FvObj.DefineVarDict:
+                return
+
+        RegionFvNames = set()
+        for FdObj in GenFdsGlobalVariable.FdfParser.Profile.FdDict.values():
+            for RegionObj in FdObj.RegionList:
+                if RegionObj.RegionType == BINARY_FILE_TYPE_FV:
+                    RegionFvNames.update(RegionData.upper() for RegionData in RegionObj.RegionDataList)
+
+        PendingFvs = {}
+        for FvName, FvObj in FvDict.items():
+            if FvName in RegionFvNames or FvObj.BaseAddress or FvObj.FvBaseAddress or FvObj.CapsuleName:
+                continue
+            FvNames, FfsFiles, HasFd = GenFds.GetFvReferences(FvObj)
+            if not HasFd:
+                PendingFvs[FvName] = (FvNames, FfsFiles)
+
+        #
+        # Leave the FVs containing FVs placed at an address to the FD generation.
+        #
+        Found = True
+        while Found:
+            Found = False
+            for FvName in list(PendingFvs):
+                if not PendingFvs[FvName][0] <= set(PendingFvs):
+                    del PendingFvs[FvName]
+                    Found = True
+
+        DoneFvs = set()
+        with ThreadPoolExecutor(max_workers=GenFdsGlobalVariable.ThreadNumber) as Executor:
+            while PendingFvs:
+                FvNameList = []
+                UsedFfsFiles = set()
+                for FvName, (FvNames, FfsFiles) in PendingFvs.items():
+                    if FvNames <= DoneFvs and not FfsFiles & UsedFfsFiles:
+                        FvNameList.append(FvName)
+                        UsedFfsFiles |= FfsFiles
+                FutureList = [Executor.submit(GenFdsGlobalVariable.CallWithStateLock, FvDict[FvName].AddToBuffer, BytesIO())
+                              for FvName in FvNameList]
+                for Future in FutureList:
+                    Future.result()
+                for FvName in FvNameList:
+                    del PendingFvs[FvName]
+                    DoneFvs.add(FvName)
+
     ## GetFvBlockSize()
     #
     #   @param  FvObj           Whose block size to get
@@ -14,6 +14,9 @@ from __future__ import absolute_import
 
 import Common.LongFilePathOs as os
 import sys
+import hashlib
+import shutil
+import threading
 from sys import stdout
 from subprocess import PIPE,Popen
 from struct import Struct
@@ -29,11 +32,21 @@ from AutoGen.BuildEngine import ToolBuildRule
 import Common.DataType as DataType
 from Common.Misc import PathClass,CreateDirectory
 from Common.LongFilePathSupport import OpenLongFilePath as open
+from Common.LongFilePathSupport import CopyLongFilePath
 from Common.MultipleWorkspace import MultipleWorkspace as mws
 import Common.GlobalData as GlobalData
 from Common.BuildToolError import *
 from AutoGen.AutoGen import CalculatePriorityValue
 
+## State of the FV generation kept per thread
+#
+# The FVs not depending on each other are generated on several threads.
+#
+class GenFdsThreadState(threading.local):
+    def __init__(self):
+        self.LargeFileInFvFlags = []
+        self.HoldsStateLock = False
+
 ## Global variables
 #
 #
@@ -73,6 +86,11 @@ class GenFdsGlobalVariable:
     CopyList   = []
     ModuleFile = ''
     EnableGenfdsMultiThread = True
+    ThreadNumber = 1
+    # Outputs of the external tools, named by the hash of their options and inputs
+    CacheDir = ''
+    # Names of the outputs in the cache used by this run
+    UsedCacheFiles = set()
 
     #
     # The list whose element are flags to indicate if large FFS or SECTION files exist in FV.
@@ -81,9 +99,16 @@ class GenFdsGlobalVariable:
     # if it is greater than 0xFFFFFF, the tail flag in list is set to true,
     # and EFI_FIRMWARE_FILE_SYSTEM3_GUID is passed to C GenFv.
     # At the end of generation of FV, pop the flag.
-    # List is used as a stack to handle nested FV generation.
+    # List is used as a stack to handle nested FV generation, one per thread.
+    #
+    ThreadState = GenFdsThreadState()
+    #
+    # The other state, such as ImageBinDict, FfsCmdDict, SecCmdList, CopyList,
+    # UsedCacheFiles and the FV address files, is shared by the threads. A
+    # thread generating an FV holds this lock, except while it waits for an
+    # external tool, so that only the tools run at the same time.
     #
-    LargeFileInFvFlags = []
+    StateLock = threading.Lock()
     EFI_FIRMWARE_FILE_SYSTEM3_GUID = '5473C07A-3DCB-4dca-BD6F-1E9689E7349A'
     LARGE_FILE_SIZE = 0x1000000
 
@@ -288,6 +313,10 @@ class GenFdsGlobalVariable:
         GenFdsGlobalVariable.FfsDir = os.path.join(GenFdsGlobalVariable.FvDir, 'Ffs')
         if not os.path.exists(GenFdsGlobalVariable.FfsDir):
             os.makedirs(GenFdsGlobalVariable.FfsDir)
+        GenFdsGlobalVariable.CacheDir = os.path.join(GenFdsGlobalVariable.FvDir, 'Cache')
+        if not os.path.exists(GenFdsGlobalVariable.CacheDir):
+            os.makedirs(GenFdsGlobalVariable.CacheDir)
+        GenFdsGlobalVariable.UsedCacheFiles = set()
 
         #
         # Create FV Address inf file
@@ -516,10 +545,10 @@ class GenFdsGlobalVariable:
                     GenFdsGlobalVariable.SecCmdList.append(' '.join(Cmd).strip())
             elif GenFdsGlobalVariable.NeedsUpdate(Output, list(Input) + [CommandFile]):
                 GenFdsGlobalVariable.DebugLogger(EdkLogger.DEBUG_5, "%s needs update because of newer %s" % (Output, Input))
-                GenFdsGlobalVariable.CallExternalTool(Cmd, "Failed to generate section")
+                GenFdsGlobalVariable.CallCachedExternalTool(Cmd, Output, "Failed to generate section")
                 if (os.path.getsize(Output) >= GenFdsGlobalVariable.LARGE_FILE_SIZE and
-                    GenFdsGlobalVariable.LargeFileInFvFlags):
-                    GenFdsGlobalVariable.LargeFileInFvFlags[-1] = True
+                    GenFdsGlobalVariable.ThreadState.LargeFileInFvFlags):
+                    GenFdsGlobalVariable.ThreadState.LargeFileInFvFlags[-1] = True
 
     @staticmethod
     def GetAlignment (AlignString):
@@ -700,7 +729,110 @@ class GenFdsGlobalVariable:
             if " ".join(Cmd).strip() not in GenFdsGlobalVariable.SecCmdList:
                 GenFdsGlobalVariable.SecCmdList.append(" ".join(Cmd).strip())
         else:
-            GenFdsGlobalVariable.CallExternalTool(Cmd, "Failed to call " + ToolPath, returnValue)
+            GenFdsGlobalVariable.CallCachedExternalTool(Cmd, Output, "Failed to call " + ToolPath, returnValue)
+
+    ## Get the name of the output of an external tool in the cache
+    #
+    #   The name is the hash of the tool, of its options and of the content of
+    #   its input files, but not of their paths, so that the same section is
+    #   found again when it is generated for another FV, or when its output
+    #   was removed.
+    #
+    #   @param  Cmd         The command line of the tool
+    #   @param  Output      The output file of the tool
+    #   @retval string      The name of the output in the cache
+    #
+    @staticmethod
+    def GetToolCacheKey(Cmd, Output):
+        m = hashlib.md5()
+        ToolPath = shutil.which(Cmd[0])
+        if ToolPath:
+            ToolStat = os.stat(ToolPath)
+            m.update(('%s %d %d' % (ToolPath, ToolStat.st_size, ToolStat.st_mtime)).encode())
+        else:
+            m.update(Cmd[0].encode())
+        for Arg in Cmd[1:]:
+            m.update(b'\0')
+            if Arg == Output:
+                m.update(b'<output>')
+            elif os.path.isfile(Arg):
+                with open(Arg, 'rb') as f:
+                    m.update(f.read())
+            else:
+                m.update(Arg.encode())
+        return m.hexdigest()
+
+    ## Call an external tool, unless it was called with the same options on
+    #  the same inputs before, in which case its output is copied from the cache
+    #
+    #   Only called once NeedsUpdate decided that the output must be built. If
+    #   the output exists, an input or the FDF file changed, so the tool is run
+    #   without hashing the inputs for the cache.
+    #
+    #   @param  Cmd         The command line of the tool
+    #   @param  Output      The output file of the tool
+    #   @param  errorMess   The error message if the tool fails
+    #   @param  returnValue If not empty, receives the return value of the tool
+    #
+    @staticmethod
+    def CallCachedExternalTool(Cmd, Output, errorMess, returnValue=[]):
+        if not GenFdsGlobalVariable.CacheDir or os.path.exists(Output):
+            GenFdsGlobalVariable.CallExternalTool(Cmd, errorMess, returnValue)
+            return
+
+        CacheKey = GenFdsGlobalVariable.GetToolCacheKey(Cmd, Output)
+        GenFdsGlobalVariable.UsedCacheFiles.add(CacheKey)
+        CacheFile = os.path.join(GenFdsGlobalVariable.CacheDir, CacheKey)
+        if os.path.isfile(CacheFile):
+            GenFdsGlobalVariable.DebugLogger(EdkLogger.DEBUG_5, "%s is found in cache %s" % (Output, CacheFile))
+            CopyLongFilePath(CacheFile, Output)
+            if returnValue != []:
+                returnValue[0] = 0
+            return
+
+        GenFdsGlobalVariable.CallExternalTool(Cmd, errorMess, returnValue)
+        if (returnValue == [] or returnValue[0] == 0) and os.path.isfile(Output):
+            #
+            # Several threads may cache the same output at the same time.
+            #
+            TempFile = '%s.%d' % (CacheFile, threading.get_ident())
+            CopyLongFilePath(Output, TempFile)
+            try:
+                os.rename(TempFile, CacheFile)
+            except OSError:
+                os.remove(TempFile)
+
+    ## Remove the outputs in the cache that were not used by this run
+    #
+    #   Only called once all the FDs, FVs and capsules of the FDF file were
+    #   generated, so that the cache does not grow with every change of the
+    #   sections.
+    #
+    @staticmethod
+    def PruneToolCache():
+        if not GenFdsGlobalVariable.CacheDir:
+            return
+        for CacheKey in os.listdir(GenFdsGlobalVariable.CacheDir):
+            if CacheKey not in GenFdsGlobalVariable.UsedCacheFiles:
+                try:
+                    os.remove(os.path.join(GenFdsGlobalVariable.CacheDir, CacheKey))
+                except OSError:
+                    pass
+
+    ## Call a function on a thread generating FVs, holding the state lock
+    #
+    #   @param  Function    The function to call
+    #   @param  Args        The arguments of the function
+    #   @retval object      The return value of the function
+    #
+    @staticmethod
+    def CallWithStateLock(Function, *Args):
+        with GenFdsGlobalVariable.StateLock:
+            GenFdsGlobalVariable.ThreadState.HoldsStateLock = True
+            try:
+                return Function(*Args)
+            finally:
+                GenFdsGlobalVariable.ThreadState.HoldsStateLock = False
 
     @staticmethod
     def CallExternalTool (cmd, errorMess, returnValue=[]):
@@ -722,11 +854,21 @@ class GenFdsGlobalVariable:
             if GenFdsGlobalVariable.SharpCounter % GenFdsGlobalVariable.SharpNumberPerLine == 0:
                 stdout.write('\n')
 
+        #
+        # Let the other threads generating FVs go on while the tool runs.
+        #
+        HoldsStateLock = GenFdsGlobalVariable.ThreadState.HoldsStateLock
+        if HoldsStateLock:
+            GenFdsGlobalVariable.StateLock.release()
         try:
-            PopenObject = Popen(' '.join(cmd), stdout=PIPE, stderr=PIPE, shell=True)
-        except Exception as X:
-            EdkLogger.error("GenFds", COMMAND_FAILURE, ExtraData="%s: %s" % (str(X), cmd[0]))
-        (out, error) = PopenObject.communicate()
+            try:
+                PopenObject = Popen(' '.join(cmd), stdout=PIPE, stderr=PIPE, shell=True)
+            except Exception as X:
+                EdkLogger.error("GenFds", COMMAND_FAILURE, ExtraData="%s: %s" % (str(X), cmd[0]))
+            (out, error) = PopenObject.communicate()
+        finally:
+            if HoldsStateLock:
+                GenFdsGlobalVariable.StateLock.acquire()
 
         while PopenObject.returncode is None:
             PopenObject.wait()
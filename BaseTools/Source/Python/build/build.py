@@ -2504,6 +2504,7 @@ class Build():
             Module.GenPreMakefileHashList()
             Module.GenMakefileHashList()
             Module.CopyModuleToCache()
+            Module.CopyModuleToSharedCache()
 
     def GenLocalPreMakeCache(self):
         for Module in self.PreMakeCacheMiss:
@@ -5509,6 +5509,73 @@ CryptoServiceTlsGetExportKey (
            );
 }
 
+/**
+  Gets the session of the TLS connection, which can be set on a new TLS
+  connection to the same server with TlsSetSession() to resume it.
+
+  The session is reference counted. The caller must release it with
+  TlsFreeSession() when it is no longer needed.
+
+  @param[in]   Tls          Pointer to the TLS object.
+  @param[out]  Session      Pointer to receive the TLS session.
+
+  @retval  EFI_SUCCESS             The session was returned successfully.
+  @retval  EFI_INVALID_PARAMETER   The parameter is invalid.
+  @retval  EFI_NOT_FOUND           The TLS connection has no resumable session.
+
+**/
+EFI_STATUS
+EFIAPI
+CryptoServiceTlsGetSession (
+  IN     VOID  *Tls,
+  OUT    VOID  **Session
+  )
+{
+  return CALL_BASECRYPTLIB (TlsGet.Services.Session, TlsGetSession, (Tls, Session), EFI_UNSUPPORTED);
+}
+
+/**
+  Set a session returned by TlsGetSession() on the TLS object, so that the
+  handshake tries to resume it instead of negotiating a new session.
+
+  This function must be called before the handshake starts. If the server
+  refuses to resume the session, a full handshake takes place.
+
+  @param[in]  Tls           Pointer to the TLS object.
+  @param[in]  Session       The TLS session to resume.
+
+  @retval  EFI_SUCCESS             The session was set successfully.
+  @retval  EFI_INVALID_PARAMETER   The parameter is invalid.
+  @retval  EFI_UNSUPPORTED         The session can't be set on the TLS object.
+
+**/
+EFI_STATUS
+EFIAPI
+CryptoServiceTlsSetSession (
+  IN     VOID  *Tls,
+  IN     VOID  *Session
+  )
+{
+  return CALL_BASECRYPTLIB (TlsSet.Services.Session, TlsSetSession, (Tls, Session), EFI_UNSUPPORTED);
+}
+
+/**
+  Release a TLS session returned by TlsGetSession().
+
+  If Session is NULL, nothing is done.
+
+  @param[in]  Session       The TLS session to release.
+
+**/
+VOID
+EFIAPI
+CryptoServiceTlsFreeSession (
+  IN     VOID  *Session
+  )
+{
+  CALL_VOID_BASECRYPTLIB (Tls.Services.FreeSession, TlsFreeSession, (Session));
+}
+
 /**
   Carries out the RSA-SSA signature generation with EMSA-PSS encoding scheme.
 
@@ -7116,4 +7183,10 @@ const EDKII_CRYPTO_PROTOCOL  mEdkiiCrypto = {
   CryptoServicePkcs1v2Decrypt,
   CryptoServiceRsaOaepEncrypt,
   CryptoServiceRsaOaepDecrypt,
+  /// TLS (continued)
+  CryptoServiceTlsFreeSession,
+  /// TLS Set (continued)
+  CryptoServiceTlsSetSession,
+  /// TLS Get (continued)
+  CryptoServiceTlsGetSession,
 };
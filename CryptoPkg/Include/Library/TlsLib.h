@@ -932,4 +932,62 @@ TlsGetExportKey (
   IN     UINTN       KeyBufferLen
   );
 
+/**
+  Gets the session of the TLS connection, which can be set on a new TLS
+  connection to the same server with TlsSetSession() to resume it.
+
+  The session is reference counted. The caller must release it with
+  TlsFreeSession() when it is no longer needed.
+
+  @param[in]   Tls          Pointer to the TLS object.
+  @param[out]  Session      Pointer to receive the TLS session.
+
+  @retval  EFI_SUCCESS             The session was returned successfully.
+  @retval  EFI_INVALID_PARAMETER   The parameter is invalid.
+  @retval  EFI_NOT_FOUND           The TLS connection has no resumable session.
+
+**/
+EFI_STATUS
+EFIAPI
+TlsGetSession (
+  IN     VOID  *Tls,
+  OUT    VOID  **Session
+  );
+
+/**
+  Set a session returned by TlsGetSession() on the TLS object, so that the
+  handshake tries to resume it instead of negotiating a new session.
+
+  This function must be called before the handshake starts. If the server
+  refuses to resume the session, a full handshake takes place.
+
+  @param[in]  Tls           Pointer to the TLS object.
+  @param[in]  Session       The TLS session to resume.
+
+  @retval  EFI_SUCCESS             The session was set successfully.
+  @retval  EFI_INVALID_PARAMETER   The parameter is invalid.
+  @retval  EFI_UNSUPPORTED         The session can't be set on the TLS object.
+
+**/
+EFI_STATUS
+EFIAPI
+TlsSetSession (
+  IN     VOID  *Tls,
+  IN     VOID  *Session
+  );
+
+/**
+  Release a TLS session returned by TlsGetSession().
+
+  If Session is NULL, nothing is done.
+
+  @param[in]  Session       The TLS session to release.
+
+**/
+VOID
+EFIAPI
+TlsFreeSession (
+  IN     VOID  *Session
+  );
+
 #endif // __TLS_LIB_H__
@@ -308,6 +308,7 @@ typedef struct {
       UINT8    Read           : 1;
       UINT8    Write          : 1;
       UINT8    Shutdown       : 1;
+      UINT8    FreeSession    : 1;
     } Services;
     UINT32    Family;
   } Tls;
@@ -327,6 +328,7 @@ typedef struct {
       UINT8    HostPrivateKeyEx   : 1;
       UINT8    SignatureAlgoList  : 1;
       UINT8    EcCurve            : 1;
+      UINT8    Session            : 1;
     } Services;
     UINT32    Family;
   } TlsSet;
@@ -346,6 +348,7 @@ typedef struct {
       UINT8    HostPrivateKey       : 1;
       UINT8    CertRevocationList   : 1;
       UINT8    ExportKey            : 1;
+      UINT8    Session              : 1;
     } Services;
     UINT32    Family;
   } TlsGet;
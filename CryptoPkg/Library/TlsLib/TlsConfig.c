@@ -1589,3 +1589,89 @@ TlsGetExportKey (
            ) == 1 ?
          EFI_SUCCESS : EFI_PROTOCOL_ERROR;
 }
+
+/**
+  Gets the session of the TLS connection, which can be set on a new TLS
+  connection to the same server with TlsSetSession() to resume it.
+
+  The session is reference counted. The caller must release it with
+  TlsFreeSession() when it is no longer needed.
+
+  @param[in]   Tls          Pointer to the TLS object.
+  @param[out]  Session      Pointer to receive the TLS session.
+
+  @retval  EFI_SUCCESS             The session was returned successfully.
+  @retval  EFI_INVALID_PARAMETER   The parameter is invalid.
+  @retval  EFI_NOT_FOUND           The TLS connection has no resumable session.
+
+**/
+EFI_STATUS
+EFIAPI
+TlsGetSession (
+  IN     VOID  *Tls,
+  OUT    VOID  **Session
+  )
+{
+  TLS_CONNECTION  *TlsConn;
+  SSL_SESSION     *SslSession;
+
+  TlsConn = (TLS_CONNECTION *)Tls;
+
+  if ((TlsConn == NULL) || (TlsConn->Ssl == NULL) || (Session == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  SslSession = SSL_get1_session (TlsConn->Ssl);
+  if (SslSession == NULL) {
+    return EFI_NOT_FOUND;
+  }
+
+  //
+  // With TLS 1.3, the session becomes resumable only after the server
+  // sends a NewSessionTicket message.
+  //
+  if (SSL_SESSION_is_resumable (SslSession) != 1) {
+    SSL_SESSION_free (SslSession);
+    return EFI_NOT_FOUND;
+  }
+
+  *Session = SslSession;
+  return EFI_SUCCESS;
+}
+
+/**
+  Set a session returned by TlsGetSession() on the TLS object, so that the
+  handshake tries to resume it instead of negotiating a new session.
+
+  This function must be called before the handshake starts. If the server
+  refuses to resume the session, a full handshake takes place.
+
+  @param[in]  Tls           Pointer to the TLS object.
+  @param[in]  Session       The TLS session to resume.
+
+  @retval  EFI_SUCCESS             The session was set successfully.
+  @retval  EFI_INVALID_PARAMETER   The parameter is invalid.
+  @retval  EFI_UNSUPPORTED         The session can't be set on the TLS object.
+
+**/
+EFI_STATUS
+EFIAPI
+TlsSetSession (
+  IN     VOID  *Tls,
+  IN     VOID  *Session
+  )
+{
+  TLS_CONNECTION  *TlsConn;
+
+  TlsConn = (TLS_CONNECTION *)Tls;
+
+  if ((TlsConn == NULL) || (TlsConn->Ssl == NULL) || (Session == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (SSL_set_session (TlsConn->Ssl, (SSL_SESSION *)Session) != 1) {
+    return EFI_UNSUPPORTED;
+  }
+
+  return EFI_SUCCESS;
+}
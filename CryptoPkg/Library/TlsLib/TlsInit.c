@@ -261,3 +261,22 @@ TlsNew (
     );
   return (VOID *)TlsConn;
 }
+
+/**
+  Release a TLS session returned by TlsGetSession().
+
+  If Session is NULL, nothing is done.
+
+  @param[in]  Session       The TLS session to release.
+
+**/
+VOID
+EFIAPI
+TlsFreeSession (
+  IN     VOID  *Session
+  )
+{
+  if (Session != NULL) {
+    SSL_SESSION_free ((SSL_SESSION *)Session);
+  }
+}
@@ -108,3 +108,20 @@ TlsNew (
   ASSERT (FALSE);
   return NULL;
 }
+
+/**
+  Release a TLS session returned by TlsGetSession().
+
+  If Session is NULL, nothing is done.
+
+  @param[in]  Session       The TLS session to release.
+
+**/
+VOID
+EFIAPI
+TlsFreeSession (
+  IN     VOID  *Session
+  )
+{
+  ASSERT (FALSE);
+}
@@ -1183,9 +1183,11 @@ AhciDmaTransfer (
   UINT32                         Retry;
   EFI_STATUS                     RecoveryStatus;
   BOOLEAN                        DoRetry;
+  BOOLEAN                        UseBounceBuffer;
 
-  Map   = NULL;
-  PciIo = Instance->PciIo;
+  Map             = NULL;
+  UseBounceBuffer = FALSE;
+  PciIo           = Instance->PciIo;
 
   if (PciIo == NULL) {
     return EFI_INVALID_PARAMETER;
@@ -1199,8 +1201,20 @@ AhciDmaTransfer (
   //
   // DMA buffer allocation. Needs to be done only once for both sync and async
   // DMA transfers irrespective of number of retries.
+  // The blocking transfers copy their data through the preallocated bounce
+  // buffer when it is available, which avoids allocating and mapping a new
+  // bounce buffer for every command.
   //
-  if ((Task == NULL) || ((Task != NULL) && (Task->Map == NULL))) {
+  if ((Task == NULL) && (AhciRegisters->BounceBuffer != NULL) &&
+      !AhciRegisters->BounceBufferInUse && (DataCount <= AHCI_BOUNCE_BUFFER_SIZE))
+  {
+    AhciRegisters->BounceBufferInUse = TRUE;
+    UseBounceBuffer                  = TRUE;
+    PhyAddr                          = AhciRegisters->BounceBufferPciAddr;
+    if (!Read) {
+      CopyMem (AhciRegisters->BounceBuffer, MemoryAddr, DataCount);
+    }
+  } else if ((Task == NULL) || ((Task != NULL) && (Task->Map == NULL))) {
     if (Read) {
       Flag = EfiPciIoOperationBusMasterWrite;
     } else {
@@ -1370,10 +1384,21 @@ AhciDmaTransfer (
       Timeout
       );
 
-    PciIo->Unmap (
-             PciIo,
-             (Task != NULL) ? Task->Map : Map
-             );
+    if (UseBounceBuffer) {
+      //
+      // The bounce buffer holds no valid data when the read failed.
+      //
+      if (Read && !EFI_ERROR (Status)) {
+        CopyMem (MemoryAddr, AhciRegisters->BounceBuffer, DataCount);
+      }
+
+      AhciRegisters->BounceBufferInUse = FALSE;
+    } else {
+      PciIo->Unmap (
+               PciIo,
+               (Task != NULL) ? Task->Map : Map
+               );
+    }
 
     if (Task != NULL) {
       Task->Packet->Asb->AtaStatus = 0x01;
@@ -2200,6 +2225,82 @@ AhciPacketCommandExecute (
   return Status;
 }
 
+/**
+  Preallocate the bounce buffer which the blocking DMA transfers copy their
+  data through.
+
+  The bounce buffer is only set up when an IOMMU is present. In that case
+  PciIo->Map() allocates, maps and unmaps a bounce buffer for every command,
+  while copying through a buffer that stays mapped for the life of the
+  controller is much cheaper. Without an IOMMU the caller's buffer is mapped
+  directly, so the bounce buffer would only add a copy. Failing to set it up
+  is not an error.
+
+  @param  PciIo                 The PCI IO protocol instance.
+  @param  AhciRegisters         The pointer to the EFI_AHCI_REGISTERS.
+  @param  Support64Bit          Whether the HBA supports 64-bit addressing.
+
+**/
+VOID
+AhciCreateBounceBuffer (
+  IN     EFI_PCI_IO_PROTOCOL  *PciIo,
+  IN OUT EFI_AHCI_REGISTERS   *AhciRegisters,
+  IN     BOOLEAN              Support64Bit
+  )
+{
+  EFI_STATUS            Status;
+  VOID                  *IoMmu;
+  VOID                  *Buffer;
+  UINTN                 Bytes;
+  EFI_PHYSICAL_ADDRESS  BounceBufferPciAddr;
+
+  AhciRegisters->BounceBuffer      = NULL;
+  AhciRegisters->MapBounceBuffer   = NULL;
+  AhciRegisters->BounceBufferInUse = FALSE;
+
+  Status = gBS->LocateProtocol (&gEdkiiIoMmuProtocolGuid, NULL, &IoMmu);
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  Buffer = NULL;
+  Status = PciIo->AllocateBuffer (
+                    PciIo,
+                    AllocateAnyPages,
+                    EfiBootServicesData,
+                    EFI_SIZE_TO_PAGES (AHCI_BOUNCE_BUFFER_SIZE),
+                    &Buffer,
+                    0
+                    );
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  Bytes  = AHCI_BOUNCE_BUFFER_SIZE;
+  Status = PciIo->Map (
+                    PciIo,
+                    EfiPciIoOperationBusMasterCommonBuffer,
+                    Buffer,
+                    &Bytes,
+                    &BounceBufferPciAddr,
+                    &AhciRegisters->MapBounceBuffer
+                    );
+  if (EFI_ERROR (Status) || (Bytes != AHCI_BOUNCE_BUFFER_SIZE)) {
+    PciIo->FreeBuffer (PciIo, EFI_SIZE_TO_PAGES (AHCI_BOUNCE_BUFFER_SIZE), Buffer);
+    return;
+  }
+
+  if ((!Support64Bit) && (BounceBufferPciAddr + AHCI_BOUNCE_BUFFER_SIZE > 0x100000000ULL)) {
+    PciIo->Unmap (PciIo, AhciRegisters->MapBounceBuffer);
+    PciIo->FreeBuffer (PciIo, EFI_SIZE_TO_PAGES (AHCI_BOUNCE_BUFFER_SIZE), Buffer);
+    return;
+  }
+
+  AhciRegisters->BounceBuffer        = Buffer;
+  AhciRegisters->BounceBufferPciAddr = BounceBufferPciAddr;
+  DEBUG ((DEBUG_INFO, "AHCI: Using a %u bytes preallocated DMA bounce buffer\n", AHCI_BOUNCE_BUFFER_SIZE));
+}
+
 /**
   Allocate transfer-related data struct which is used at AHCI mode.
 
@@ -2410,6 +2511,8 @@ AhciCreateTransferDescriptor (
 
   AhciRegisters->AhciCommandTablePciAddr = (EFI_AHCI_COMMAND_TABLE *)(UINTN)AhciCommandTablePciAddr;
 
+  AhciCreateBounceBuffer (PciIo, AhciRegisters, Support64Bit);
+
   return EFI_SUCCESS;
   //
   // Map error or unable to map the whole CmdList buffer into a contiguous region.
@@ -196,6 +196,14 @@ typedef union {
 
 #define AHCI_COMMAND_RETRIES  (PcdGet32 (PcdAhciCommandRetryCount))
 
+//
+// Size of the preallocated bounce buffer which the blocking DMA transfers copy
+// their data through when an IOMMU is present. The non-blocking transfers
+// still map the buffer of each command, and the driver issues no NCQ
+// commands: it uses a single command slot per port.
+//
+#define AHCI_BOUNCE_BUFFER_SIZE  SIZE_1MB
+
 #pragma pack(1)
 //
 // Command List structure includes total 32 entries.
@@ -325,6 +333,10 @@ typedef struct {
   VOID                      *MapRFis;
   VOID                      *MapCmdList;
   VOID                      *MapCommandTable;
+  VOID                      *BounceBuffer;
+  EFI_PHYSICAL_ADDRESS      BounceBufferPciAddr;
+  VOID                      *MapBounceBuffer;
+  BOOLEAN                   BounceBufferInUse;
 } EFI_AHCI_REGISTERS;
 
 /**
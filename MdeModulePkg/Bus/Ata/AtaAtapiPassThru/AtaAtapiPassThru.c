@@ -952,6 +952,18 @@ AtaAtapiPassThruStop (
   //
   if (Instance->Mode == EfiAtaAhciMode) {
     AhciRegisters = &Instance->AhciRegisters;
+    if (AhciRegisters->BounceBuffer != NULL) {
+      PciIo->Unmap (
+               PciIo,
+               AhciRegisters->MapBounceBuffer
+               );
+      PciIo->FreeBuffer (
+               PciIo,
+               EFI_SIZE_TO_PAGES (AHCI_BOUNCE_BUFFER_SIZE),
+               AhciRegisters->BounceBuffer
+               );
+    }
+
     PciIo->Unmap (
              PciIo,
              AhciRegisters->MapCommandTable
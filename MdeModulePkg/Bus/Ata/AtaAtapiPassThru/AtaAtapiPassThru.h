@@ -20,6 +20,7 @@
 #include <Protocol/AtaPassThru.h>
 #include <Protocol/ScsiPassThruExt.h>
 #include <Protocol/AtaAtapiPolicy.h>
+#include <Protocol/IoMmu.h>
 
 #include <Library/DebugLib.h>
 #include <Library/BaseLib.h>
@@ -328,6 +328,287 @@ CoreReadImageFile (
   return EFI_SUCCESS;
 }
 
+/**
+  Get the memory type of the code of an image from its subsystem.
+
+  @param  Subsystem              The subsystem of the image.
+  @param  MemoryType             The memory type of the code of the image.
+
+  @retval EFI_SUCCESS            The memory type is returned.
+  @retval EFI_UNSUPPORTED        The subsystem is not supported.
+
+**/
+EFI_STATUS
+CoreGetImageCodeMemoryType (
+  IN  UINT16           Subsystem,
+  OUT EFI_MEMORY_TYPE  *MemoryType
+  )
+{
+  switch (Subsystem) {
+    case EFI_IMAGE_SUBSYSTEM_EFI_APPLICATION:
+      *MemoryType = EfiLoaderCode;
+      break;
+    case EFI_IMAGE_SUBSYSTEM_EFI_BOOT_SERVICE_DRIVER:
+      *MemoryType = EfiBootServicesCode;
+      break;
+    case EFI_IMAGE_SUBSYSTEM_EFI_RUNTIME_DRIVER:
+    case EFI_IMAGE_SUBSYSTEM_SAL_RUNTIME_DRIVER:
+      *MemoryType = EfiRuntimeServicesCode;
+      break;
+    default:
+      return EFI_UNSUPPORTED;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Read the PE32 section of a firmware file straight into pages allocated the
+  way CoreLoadPeImage() allocates the pages of the image, so that the image
+  can be loaded where it is read instead of being copied once more.
+
+  Only the headers of the image are read first, to size the pages. The
+  section stream of the file is cached by the firmware volume, so that a
+  compressed file is still decompressed once.
+
+  @param  DeviceHandle           The handle of the firmware volume.
+  @param  FilePath               The firmware file device path node.
+  @param  FHand                  The image file handle to describe the pages in.
+  @param  AuthenticationStatus   The authentication status of the section.
+
+  @retval EFI_SUCCESS            The image is read in pages.
+  @retval Others                 The image cannot be loaded where it is read,
+                                 it must be read with GetFileBufferByFilePath().
+
+**/
+EFI_STATUS
+CoreReadFvImageInPages (
+  IN     EFI_HANDLE                DeviceHandle,
+  IN     EFI_DEVICE_PATH_PROTOCOL  *FilePath,
+  IN OUT IMAGE_FILE_HANDLE         *FHand,
+  OUT    UINT32                    *AuthenticationStatus
+  )
+{
+  EFI_STATUS                           Status;
+  EFI_FIRMWARE_VOLUME2_PROTOCOL        *Fv;
+  EFI_GUID                             *NameGuid;
+  UINT8                                *Header;
+  UINTN                                HeaderSize;
+  UINTN                                FileSize;
+  UINT32                               PeCoffHeaderOffset;
+  EFI_IMAGE_OPTIONAL_HEADER_PTR_UNION  Hdr;
+  UINT16                               Subsystem;
+  UINT16                               Characteristics;
+  UINT32                               SectionAlignment;
+  UINT32                               SizeOfImage;
+  UINT64                               ImageBase;
+  EFI_MEMORY_TYPE                      MemoryType;
+  UINTN                                Size;
+  UINTN                                NumberOfPages;
+  EFI_PHYSICAL_ADDRESS                 Pages;
+  VOID                                 *Source;
+
+  if (PcdGet64 (PcdLoadModuleAtFixAddressEnable) != 0) {
+    return EFI_UNSUPPORTED;
+  }
+
+  NameGuid = EfiGetNameGuidFromFwVolDevicePathNode ((CONST MEDIA_FW_VOL_FILEPATH_DEVICE_PATH *)FilePath);
+  if (NameGuid == NULL) {
+    return EFI_UNSUPPORTED;
+  }
+
+  Status = CoreHandleProtocol (DeviceHandle, &gEfiFirmwareVolume2ProtocolGuid, (VOID **)&Fv);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Header = AllocatePool (EFI_PAGE_SIZE);
+  if (Header == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // Read the headers only. The size of the whole section is returned.
+  //
+  FileSize = EFI_PAGE_SIZE;
+  Status   = Fv->ReadSection (
+                   Fv,
+                   NameGuid,
+                   EFI_SECTION_PE32,
+                   0,
+                   (VOID **)&Header,
+                   &FileSize,
+                   AuthenticationStatus
+                   );
+  if (EFI_ERROR (Status)) {
+    goto Done;
+  }
+
+  Status     = EFI_UNSUPPORTED;
+  HeaderSize = MIN (FileSize, EFI_PAGE_SIZE);
+
+  PeCoffHeaderOffset = 0;
+  if ((HeaderSize >= sizeof (EFI_IMAGE_DOS_HEADER)) &&
+      (((EFI_IMAGE_DOS_HEADER *)Header)->e_magic == EFI_IMAGE_DOS_SIGNATURE))
+  {
+    PeCoffHeaderOffset = ((EFI_IMAGE_DOS_HEADER *)Header)->e_lfanew;
+  }
+
+  if ((HeaderSize < sizeof (EFI_IMAGE_NT_HEADERS64)) ||
+      (PeCoffHeaderOffset > HeaderSize - sizeof (EFI_IMAGE_NT_HEADERS64)))
+  {
+    goto Done;
+  }
+
+  Hdr.Pe32 = (EFI_IMAGE_NT_HEADERS32 *)(Header + PeCoffHeaderOffset);
+  if (Hdr.Pe32->Signature != EFI_IMAGE_NT_SIGNATURE) {
+    goto Done;
+  }
+
+  Characteristics = Hdr.Pe32->FileHeader.Characteristics;
+  if (Hdr.Pe32->OptionalHeader.Magic == EFI_IMAGE_NT_OPTIONAL_HDR32_MAGIC) {
+    Subsystem        = Hdr.Pe32->OptionalHeader.Subsystem;
+    SectionAlignment = Hdr.Pe32->OptionalHeader.SectionAlignment;
+    SizeOfImage      = Hdr.Pe32->OptionalHeader.SizeOfImage;
+    ImageBase        = Hdr.Pe32->OptionalHeader.ImageBase;
+  } else if (Hdr.Pe32Plus->OptionalHeader.Magic == EFI_IMAGE_NT_OPTIONAL_HDR64_MAGIC) {
+    Subsystem        = Hdr.Pe32Plus->OptionalHeader.Subsystem;
+    SectionAlignment = Hdr.Pe32Plus->OptionalHeader.SectionAlignment;
+    SizeOfImage      = Hdr.Pe32Plus->OptionalHeader.SizeOfImage;
+    ImageBase        = Hdr.Pe32Plus->OptionalHeader.ImageBase;
+  } else {
+    goto Done;
+  }
+
+  //
+  // Leave the images loaded at the address they are linked at, and the
+  // images larger in the file than in memory, to CoreLoadPeImage().
+  //
+  if (((Characteristics & EFI_IMAGE_FILE_RELOCS_STRIPPED) != 0) ||
+      (PcdGetBool (PcdImageLargeAddressLoad) && (ImageBase >= 0x100000)) ||
+      (SectionAlignment == 0) || ((SectionAlignment & (SectionAlignment - 1)) != 0) ||
+      (FileSize > SizeOfImage))
+  {
+    goto Done;
+  }
+
+  Status = CoreGetImageCodeMemoryType (Subsystem, &MemoryType);
+  if (EFI_ERROR (Status)) {
+    goto Done;
+  }
+
+  if (SectionAlignment > EFI_PAGE_SIZE) {
+    Size = (UINTN)SizeOfImage + SectionAlignment;
+  } else {
+    Size = (UINTN)SizeOfImage;
+  }
+
+  NumberOfPages = EFI_SIZE_TO_PAGES (Size);
+  Status        = CoreAllocatePages (AllocateAnyPages, MemoryType, NumberOfPages, &Pages);
+  if (EFI_ERROR (Status)) {
+    goto Done;
+  }
+
+  //
+  // Read the whole section at the address the image is loaded at.
+  //
+  Source = (VOID *)(UINTN)((Pages + SectionAlignment - 1) & ~((UINTN)SectionAlignment - 1));
+  Size   = FileSize;
+  Status = Fv->ReadSection (
+                 Fv,
+                 NameGuid,
+                 EFI_SECTION_PE32,
+                 0,
+                 &Source,
+                 &Size,
+                 AuthenticationStatus
+                 );
+  if ((Status != EFI_SUCCESS) || (Size != FileSize)) {
+    CoreFreePages (Pages, NumberOfPages);
+    Status = EFI_UNSUPPORTED;
+    goto Done;
+  }
+
+  FHand->Source        = Source;
+  FHand->SourceSize    = FileSize;
+  FHand->Pages         = Pages;
+  FHand->NumberOfPages = NumberOfPages;
+  FHand->MemoryType    = MemoryType;
+
+Done:
+  FreePool (Header);
+  return Status;
+}
+
+/**
+  Check whether an image read by CoreReadFvImageInPages() can be loaded where
+  it is read.
+
+  This is the case when every section of the image is at the same offset in
+  the file and in memory, like in the images produced by GenFw, so that
+  PeCoffLoaderLoadImage() has nothing to move. The sections must also be in
+  order, so that the zeroed end of a section does not overlap the next one.
+
+  @param  Image                  The image being loaded, with the image
+                                 context, memory types and pages filled in.
+  @param  FHand                  The image file handle.
+
+  @retval TRUE                   The image can be loaded where it is read.
+  @retval FALSE                  The image must be copied to other pages.
+
+**/
+BOOLEAN
+CoreIsImageLoadableInPlace (
+  IN LOADED_IMAGE_PRIVATE_DATA  *Image,
+  IN IMAGE_FILE_HANDLE          *FHand
+  )
+{
+  EFI_IMAGE_OPTIONAL_HEADER_PTR_UNION  Hdr;
+  EFI_IMAGE_SECTION_HEADER             *Section;
+  UINTN                                NumberOfSections;
+  UINTN                                Index;
+  UINT32                               End;
+
+  if ((FHand->NumberOfPages == 0) ||
+      (FHand->NumberOfPages != Image->NumberOfPages) ||
+      (FHand->MemoryType != Image->ImageContext.ImageCodeMemoryType) ||
+      Image->ImageContext.IsTeImage ||
+      Image->ImageContext.RelocationsStripped ||
+      (FHand->SourceSize > Image->ImageContext.ImageSize) ||
+      ((UINTN)FHand->Source != (UINTN)((FHand->Pages + Image->ImageContext.SectionAlignment - 1) &
+                                       ~((UINTN)Image->ImageContext.SectionAlignment - 1))))
+  {
+    return FALSE;
+  }
+
+  //
+  // The section headers were checked to be within the file by
+  // PeCoffLoaderGetImageInfo().
+  //
+  Hdr.Pe32 = (EFI_IMAGE_NT_HEADERS32 *)((UINT8 *)FHand->Source + Image->ImageContext.PeCoffHeaderOffset);
+  Section  = (EFI_IMAGE_SECTION_HEADER *)(
+                                          (UINT8 *)Hdr.Pe32 +
+                                          sizeof (UINT32) +
+                                          sizeof (EFI_IMAGE_FILE_HEADER) +
+                                          Hdr.Pe32->FileHeader.SizeOfOptionalHeader
+                                          );
+  NumberOfSections = Hdr.Pe32->FileHeader.NumberOfSections;
+
+  End = (UINT32)Image->ImageContext.SizeOfHeaders;
+  for (Index = 0; Index < NumberOfSections; Index++, Section++) {
+    if (((Section->SizeOfRawData != 0) && (Section->PointerToRawData != Section->VirtualAddress)) ||
+        (Section->VirtualAddress < End) ||
+        (Section->Misc.VirtualSize > MAX_UINT32 - Section->VirtualAddress))
+    {
+      return FALSE;
+    }
+
+    End = Section->VirtualAddress + Section->Misc.VirtualSize;
+  }
+
+  return TRUE;
+}
+
 /**
   To check memory usage bit map array to figure out if the memory range the image will be loaded in is available or not. If
   memory range is available, the function will mark the corresponding bits to 1 which indicates the memory range is used.
@@ -581,10 +862,12 @@ CoreLoadPeImage (
   IN  UINT32                    Attribute
   )
 {
-  EFI_STATUS  Status;
-  BOOLEAN     DstBufAlocated;
-  UINTN       Size;
+  EFI_STATUS         Status;
+  BOOLEAN            DstBufAlocated;
+  UINTN              Size;
+  IMAGE_FILE_HANDLE  *FHand;
 
+  FHand = (IMAGE_FILE_HANDLE *)Pe32Handle;
   ZeroMem (&Image->ImageContext, sizeof (Image->ImageContext));
 
   Image->ImageContext.Handle    = Pe32Handle;
@@ -659,11 +942,19 @@ CoreLoadPeImage (
     // no modules whose preferred load addresses are below 1MB.
     //
     Status = EFI_OUT_OF_RESOURCES;
-    //
-    // If Loading Module At Fixed Address feature is enabled, the module should be loaded to
-    // a specified address.
-    //
-    if (PcdGet64 (PcdLoadModuleAtFixAddressEnable) != 0 ) {
+    if (CoreIsImageLoadableInPlace (Image, FHand)) {
+      //
+      // The file was read in pages of the right type and size, and the image
+      // has the same layout in the file and in memory: load it where it is.
+      //
+      Image->ImageContext.ImageAddress = FHand->Pages;
+      FHand->NumberOfPages             = 0;
+      Status                           = EFI_SUCCESS;
+    } else if (PcdGet64 (PcdLoadModuleAtFixAddressEnable) != 0 ) {
+      //
+      // If Loading Module At Fixed Address feature is enabled, the module should be loaded to
+      // a specified address.
+      //
       Status = GetPeCoffImageFixLoadingAssignedAddress (&(Image->ImageContext));
 
       if (EFI_ERROR (Status)) {
@@ -1242,24 +1533,34 @@ CoreLoadImageCommon (
       }
     }
 
+    //
+    // Read an image in a firmware volume straight into the pages it may be
+    // loaded in, unless the caller provides them.
+    //
+    if (ImageIsFromFv && (DstBuffer == 0)) {
+      CoreReadFvImageInPages (DeviceHandle, HandleFilePath, &FHand, &AuthenticationStatus);
+    }
+
     //
     // Get the source file buffer by its device path.
     //
-    FHand.Source = GetFileBufferByFilePath (
-                     BootPolicy,
-                     FilePath,
-                     &FHand.SourceSize,
-                     &AuthenticationStatus
-                     );
     if (FHand.Source == NULL) {
-      Status = EFI_NOT_FOUND;
-    } else {
-      FHand.FreeBuffer = TRUE;
-      if (ImageIsFromLoadFile) {
-        //
-        // LoadFile () may cause the device path of the Handle be updated.
-        //
-        OriginalFilePath = AppendDevicePath (DevicePathFromHandle (DeviceHandle), Node);
+      FHand.Source = GetFileBufferByFilePath (
+                       BootPolicy,
+                       FilePath,
+                       &FHand.SourceSize,
+                       &AuthenticationStatus
+                       );
+      if (FHand.Source == NULL) {
+        Status = EFI_NOT_FOUND;
+      } else {
+        FHand.FreeBuffer = TRUE;
+        if (ImageIsFromLoadFile) {
+          //
+          // LoadFile () may cause the device path of the Handle be updated.
+          //
+          OriginalFilePath = AppendDevicePath (DevicePathFromHandle (DeviceHandle), Node);
+        }
       }
     }
   }
@@ -1476,6 +1777,14 @@ Done:
     CoreFreePool (FHand.Source);
   }
 
+  //
+  // Free the pages the source file was read in, unless the image was loaded
+  // in them.
+  //
+  if (FHand.NumberOfPages != 0) {
+    CoreFreePages (FHand.Pages, FHand.NumberOfPages);
+  }
+
   if (OriginalFilePath != InputFilePath) {
     CoreFreePool (OriginalFilePath);
   }
@@ -14,10 +14,18 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 //
 #define IMAGE_FILE_HANDLE_SIGNATURE  SIGNATURE_32('i','m','g','f')
 typedef struct {
-  UINTN      Signature;
-  BOOLEAN    FreeBuffer;
-  VOID       *Source;
-  UINTN      SourceSize;
+  UINTN                   Signature;
+  BOOLEAN                 FreeBuffer;
+  VOID                    *Source;
+  UINTN                   SourceSize;
+  //
+  // The pages the source file was read in, when the image may be loaded in
+  // them without being copied. NumberOfPages is 0 otherwise, or once the
+  // image owns the pages.
+  //
+  EFI_PHYSICAL_ADDRESS    Pages;
+  UINTN                   NumberOfPages;
+  EFI_MEMORY_TYPE         MemoryType;
 } IMAGE_FILE_HANDLE;
 
 #endif
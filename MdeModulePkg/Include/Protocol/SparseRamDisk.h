@@ -0,0 +1,141 @@
+/** @file
+  This file defines the EDKII Sparse RAM Disk Protocol.
+
+  A sparse RAM disk is registered before its content is in memory. The RAM
+  disk driver publishes the Block I/O protocols at once, and asks the
+  producer of the content to fill each chunk of the RAM disk the first time
+  the chunk is accessed, and in the background until the whole RAM disk is
+  filled. So a RAM disk image downloaded from the network can be booted while
+  the download continues.
+
+  A RAM disk a chunk of which cannot be filled is unregistered. A RAM disk
+  not filled yet when ExitBootServices() is called is removed from the NFIT,
+  as no chunk is filled after that.
+
+  A sparse RAM disk is unregistered with EFI_RAM_DISK_PROTOCOL.Unregister().
+
+  Copyright (c) 2026, agent <agent@local>. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef EDKII_SPARSE_RAM_DISK_H_
+#define EDKII_SPARSE_RAM_DISK_H_
+
+#include <Protocol/DevicePath.h>
+
+#define EDKII_SPARSE_RAM_DISK_PROTOCOL_GUID \
+  { \
+    0x3c7d2e91, 0x6a4b, 0x4f08, {0x9d, 0x35, 0xe1, 0x52, 0x0b, 0xa8, 0x74, 0xc6} \
+  }
+
+typedef struct _EDKII_SPARSE_RAM_DISK_PROTOCOL EDKII_SPARSE_RAM_DISK_PROTOCOL;
+
+/**
+  Fill a part of a sparse RAM disk with its content.
+
+  This function is called at TPL_CALLBACK. If Wait is TRUE, it must not return
+  before the whole part is filled or an error occurs. If Wait is FALSE, it only
+  starts or continues filling the part without waiting for the device the
+  content comes from, and it is called again for the same part until it
+  returns another status than EFI_NOT_READY. A part whose fill is started is
+  always finished before another part is filled.
+
+  @param[in]  Context        The context given when the RAM disk was registered.
+  @param[in]  Offset         The offset of the part in the RAM disk.
+  @param[in]  Length         The size of the part in bytes.
+  @param[out] Buffer         The memory of the RAM disk to fill the part in.
+  @param[in]  Wait           Whether to wait until the part is filled.
+
+  @retval EFI_SUCCESS        The part is filled.
+  @retval EFI_NOT_READY      Wait is FALSE, and the part is not filled yet.
+  @retval Others             The part could not be filled.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_SPARSE_RAM_DISK_FILL)(
+  IN  VOID     *Context,
+  IN  UINT64   Offset,
+  IN  UINTN    Length,
+  OUT VOID     *Buffer,
+  IN  BOOLEAN  Wait
+  );
+
+/**
+  Notify the producer of a sparse RAM disk that its content is not needed any
+  more, because the whole RAM disk is filled, a part could not be filled, or
+  the RAM disk is unregistered.
+
+  The fill function is not called after this function. This function is
+  called at TPL_CALLBACK or below, and it must not unregister the RAM disk.
+  It is not called once ExitBootServices() is called.
+
+  @param[in]  Context        The context given when the RAM disk was registered.
+  @param[in]  Status         EFI_SUCCESS if the whole RAM disk is filled,
+                             EFI_ABORTED if the RAM disk is unregistered
+                             before, or the error returned by the fill
+                             function, in which case the RAM disk is
+                             unregistered next.
+**/
+typedef
+VOID
+(EFIAPI *EDKII_SPARSE_RAM_DISK_COMPLETE)(
+  IN  VOID        *Context,
+  IN  EFI_STATUS  Status
+  );
+
+/**
+  Register a sparse RAM disk with specified address, size and type.
+
+  The memory of the RAM disk is provided by the caller, like for
+  EFI_RAM_DISK_PROTOCOL.Register(), but its content is filled by the Fill
+  function, one chunk at a time. The RAM disk is only left in the NFIT if it
+  is filled when ExitBootServices() is called, so the OS never finds a RAM
+  disk only partly in memory.
+
+  @param[in]  RamDiskBase    The base address of registered RAM disk.
+  @param[in]  RamDiskSize    The size of registered RAM disk.
+  @param[in]  RamDiskType    The type of registered RAM disk.
+  @param[in]  ParentDevicePath
+                             Pointer to the parent device path. If there is no
+                             parent device path then ParentDevicePath is NULL.
+  @param[in]  ChunkSize      The size of the parts the RAM disk is filled in.
+  @param[in]  Fill           The function filling a part of the RAM disk.
+  @param[in]  Complete       The function notified when the content of the
+                             RAM disk is not needed any more. Optional.
+  @param[in]  Context        The context passed to Fill and Complete.
+  @param[out] DevicePath     On return, points to a pointer to the device path
+                             of the RAM disk device, allocated with the boot
+                             service AllocatePool().
+
+  @retval EFI_SUCCESS             The RAM disk is registered successfully.
+  @retval EFI_INVALID_PARAMETER   DevicePath, RamDiskType or Fill is NULL.
+                                  RamDiskSize or ChunkSize is 0.
+  @retval EFI_ALREADY_STARTED     A Device Path Protocol instance to be created
+                                  is already present in the handle database.
+  @retval EFI_OUT_OF_RESOURCES    The RAM disk register operation fails due to
+                                  resource limitation.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_SPARSE_RAM_DISK_REGISTER)(
+  IN  UINT64                          RamDiskBase,
+  IN  UINT64                          RamDiskSize,
+  IN  EFI_GUID                        *RamDiskType,
+  IN  EFI_DEVICE_PATH                 *ParentDevicePath     OPTIONAL,
+  IN  UINT32                          ChunkSize,
+  IN  EDKII_SPARSE_RAM_DISK_FILL      Fill,
+  IN  EDKII_SPARSE_RAM_DISK_COMPLETE  Complete              OPTIONAL,
+  IN  VOID                            *Context,
+  OUT EFI_DEVICE_PATH_PROTOCOL        **DevicePath
+  );
+
+///
+/// EDKII Sparse RAM Disk Protocol registers RAM disks filled on demand.
+///
+struct _EDKII_SPARSE_RAM_DISK_PROTOCOL {
+  EDKII_SPARSE_RAM_DISK_REGISTER    Register;
+};
+
+extern EFI_GUID  gEdkiiSparseRamDiskProtocolGuid;
+
+#endif /* EDKII_SPARSE_RAM_DISK_H_ */
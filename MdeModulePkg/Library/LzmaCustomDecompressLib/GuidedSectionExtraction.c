@@ -52,46 +52,36 @@ LzmaGuidedSectionGetInfo (
   OUT UINT16      *SectionAttribute
   )
 {
+  CONST EFI_GUID  *SectionGuid;
+  CONST UINT8     *Data;
+  UINT32          DataSize;
+
   ASSERT (InputSection != NULL);
   ASSERT (OutputBufferSize != NULL);
   ASSERT (ScratchBufferSize != NULL);
   ASSERT (SectionAttribute != NULL);
 
   if (IS_SECTION2 (InputSection)) {
-    if (!CompareGuid (
-           &gLzmaCustomDecompressGuid,
-           &(((EFI_GUID_DEFINED_SECTION2 *)InputSection)->SectionDefinitionGuid)
-           ))
-    {
-      return RETURN_INVALID_PARAMETER;
-    }
-
+    SectionGuid       = &(((EFI_GUID_DEFINED_SECTION2 *)InputSection)->SectionDefinitionGuid);
     *SectionAttribute = ((EFI_GUID_DEFINED_SECTION2 *)InputSection)->Attributes;
-
-    return LzmaUefiDecompressGetInfo (
-             (UINT8 *)InputSection + ((EFI_GUID_DEFINED_SECTION2 *)InputSection)->DataOffset,
-             SECTION2_SIZE (InputSection) - ((EFI_GUID_DEFINED_SECTION2 *)InputSection)->DataOffset,
-             OutputBufferSize,
-             ScratchBufferSize
-             );
+    Data              = (UINT8 *)InputSection + ((EFI_GUID_DEFINED_SECTION2 *)InputSection)->DataOffset;
+    DataSize          = SECTION2_SIZE (InputSection) - ((EFI_GUID_DEFINED_SECTION2 *)InputSection)->DataOffset;
   } else {
-    if (!CompareGuid (
-           &gLzmaCustomDecompressGuid,
-           &(((EFI_GUID_DEFINED_SECTION *)InputSection)->SectionDefinitionGuid)
-           ))
-    {
-      return RETURN_INVALID_PARAMETER;
-    }
-
+    SectionGuid       = &(((EFI_GUID_DEFINED_SECTION *)InputSection)->SectionDefinitionGuid);
     *SectionAttribute = ((EFI_GUID_DEFINED_SECTION *)InputSection)->Attributes;
+    Data              = (UINT8 *)InputSection + ((EFI_GUID_DEFINED_SECTION *)InputSection)->DataOffset;
+    DataSize          = SECTION_SIZE (InputSection) - ((EFI_GUID_DEFINED_SECTION *)InputSection)->DataOffset;
+  }
 
-    return LzmaUefiDecompressGetInfo (
-             (UINT8 *)InputSection + ((EFI_GUID_DEFINED_SECTION *)InputSection)->DataOffset,
-             SECTION_SIZE (InputSection) - ((EFI_GUID_DEFINED_SECTION *)InputSection)->DataOffset,
-             OutputBufferSize,
-             ScratchBufferSize
-             );
+  if (CompareGuid (&gLzmaCustomDecompressGuid, SectionGuid)) {
+    return LzmaUefiDecompressGetInfo (Data, DataSize, OutputBufferSize, ScratchBufferSize);
+  }
+
+  if (CompareGuid (&gLzmaParallelCustomDecompressGuid, SectionGuid)) {
+    return LzmaParallelDecompressGetInfo (Data, DataSize, OutputBufferSize, ScratchBufferSize);
   }
+
+  return RETURN_INVALID_PARAMETER;
 }
 
 /**
@@ -136,54 +126,42 @@ LzmaGuidedSectionExtraction (
   OUT       UINT32  *AuthenticationStatus
   )
 {
+  CONST EFI_GUID  *SectionGuid;
+  CONST UINT8     *Data;
+  UINTN           DataSize;
+
   ASSERT (OutputBuffer != NULL);
   ASSERT (InputSection != NULL);
 
   if (IS_SECTION2 (InputSection)) {
-    if (!CompareGuid (
-           &gLzmaCustomDecompressGuid,
-           &(((EFI_GUID_DEFINED_SECTION2 *)InputSection)->SectionDefinitionGuid)
-           ))
-    {
-      return RETURN_INVALID_PARAMETER;
-    }
-
-    //
-    // Authentication is set to Zero, which may be ignored.
-    //
-    *AuthenticationStatus = 0;
-
-    return LzmaUefiDecompress (
-             (UINT8 *)InputSection + ((EFI_GUID_DEFINED_SECTION2 *)InputSection)->DataOffset,
-             SECTION2_SIZE (InputSection) - ((EFI_GUID_DEFINED_SECTION2 *)InputSection)->DataOffset,
-             *OutputBuffer,
-             ScratchBuffer
-             );
+    SectionGuid = &(((EFI_GUID_DEFINED_SECTION2 *)InputSection)->SectionDefinitionGuid);
+    Data        = (UINT8 *)InputSection + ((EFI_GUID_DEFINED_SECTION2 *)InputSection)->DataOffset;
+    DataSize    = SECTION2_SIZE (InputSection) - ((EFI_GUID_DEFINED_SECTION2 *)InputSection)->DataOffset;
   } else {
-    if (!CompareGuid (
-           &gLzmaCustomDecompressGuid,
-           &(((EFI_GUID_DEFINED_SECTION *)InputSection)->SectionDefinitionGuid)
-           ))
-    {
-      return RETURN_INVALID_PARAMETER;
-    }
-
-    //
-    // Authentication is set to Zero, which may be ignored.
-    //
+    SectionGuid = &(((EFI_GUID_DEFINED_SECTION *)InputSection)->SectionDefinitionGuid);
+    Data        = (UINT8 *)InputSection + ((EFI_GUID_DEFINED_SECTION *)InputSection)->DataOffset;
+    DataSize    = SECTION_SIZE (InputSection) - ((EFI_GUID_DEFINED_SECTION *)InputSection)->DataOffset;
+  }
+
+  //
+  // Authentication is set to Zero, which may be ignored.
+  //
+  if (CompareGuid (&gLzmaCustomDecompressGuid, SectionGuid)) {
     *AuthenticationStatus = 0;
+    return LzmaUefiDecompress (Data, DataSize, *OutputBuffer, ScratchBuffer);
+  }
 
-    return LzmaUefiDecompress (
-             (UINT8 *)InputSection + ((EFI_GUID_DEFINED_SECTION *)InputSection)->DataOffset,
-             SECTION_SIZE (InputSection) - ((EFI_GUID_DEFINED_SECTION *)InputSection)->DataOffset,
-             *OutputBuffer,
-             ScratchBuffer
-             );
+  if (CompareGuid (&gLzmaParallelCustomDecompressGuid, SectionGuid)) {
+    *AuthenticationStatus = 0;
+    return LzmaParallelDecompress (Data, DataSize, *OutputBuffer, ScratchBuffer);
   }
+
+  return RETURN_INVALID_PARAMETER;
 }
 
 /**
-  Register LzmaDecompress and LzmaDecompressGetInfo handlers with LzmaCustomerDecompressGuid.
+  Register LzmaDecompress and LzmaDecompressGetInfo handlers with LzmaCustomerDecompressGuid
+  and LzmaParallelCustomDecompressGuid.
 
   @retval  RETURN_SUCCESS            Register successfully.
   @retval  RETURN_OUT_OF_RESOURCES   No enough memory to store this handler.
@@ -194,8 +172,19 @@ LzmaDecompressLibConstructor (
   VOID
   )
 {
+  RETURN_STATUS  Status;
+
+  Status = ExtractGuidedSectionRegisterHandlers (
+             &gLzmaCustomDecompressGuid,
+             LzmaGuidedSectionGetInfo,
+             LzmaGuidedSectionExtraction
+             );
+  if (RETURN_ERROR (Status)) {
+    return Status;
+  }
+
   return ExtractGuidedSectionRegisterHandlers (
-           &gLzmaCustomDecompressGuid,
+           &gLzmaParallelCustomDecompressGuid,
            LzmaGuidedSectionGetInfo,
            LzmaGuidedSectionExtraction
            );
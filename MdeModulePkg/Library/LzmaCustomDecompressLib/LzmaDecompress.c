@@ -11,12 +11,15 @@
 #include "Sdk/C/7zVersion.h"
 #include "Sdk/C/LzmaDec.h"
 
-#define SCRATCH_BUFFER_REQUEST_SIZE  SIZE_64KB
-
 typedef struct {
   ISzAlloc    Functions;
   VOID        *Buffer;
   UINTN       BufferSize;
+  //
+  // Whether an allocation failure may ASSERT(). ASSERT() is not safe on an
+  // application processor.
+  //
+  BOOLEAN     AssertOnFailure;
 } ISzAllocWithData;
 
 /**
@@ -44,7 +47,10 @@ SzAlloc (
     Private->BufferSize -= Size;
     return Addr;
   } else {
-    ASSERT (FALSE);
+    if (Private->AssertOnFailure) {
+      ASSERT (FALSE);
+    }
+
     return NULL;
   }
 }
@@ -94,6 +100,62 @@ GetDecodedSizeOfBuf (
   return DecodedSize;
 }
 
+/**
+  Decompresses a Lzma compressed source buffer with the scratch buffer of
+  SCRATCH_BUFFER_REQUEST_SIZE bytes.
+
+  @param  Source           The source buffer containing the compressed data.
+  @param  SourceSize       The size of source buffer.
+  @param  Destination      The destination buffer to store the decompressed data
+  @param  Scratch          The scratch buffer.
+  @param  AssertOnFailure  Whether the scratch buffer being too small ASSERT()s.
+
+  @retval  RETURN_SUCCESS           Decompression completed successfully.
+  @retval  RETURN_INVALID_PARAMETER The source buffer is corrupted.
+**/
+RETURN_STATUS
+LzmaDecompressWorker (
+  IN CONST VOID  *Source,
+  IN UINTN       SourceSize,
+  IN OUT VOID    *Destination,
+  IN OUT VOID    *Scratch,
+  IN BOOLEAN     AssertOnFailure
+  )
+{
+  SRes              LzmaResult;
+  ELzmaStatus       Status;
+  SizeT             DecodedBufSize;
+  SizeT             EncodedDataSize;
+  ISzAllocWithData  AllocFuncs;
+
+  AllocFuncs.Functions.Alloc = SzAlloc;
+  AllocFuncs.Functions.Free  = SzFree;
+  AllocFuncs.Buffer          = Scratch;
+  AllocFuncs.BufferSize      = SCRATCH_BUFFER_REQUEST_SIZE;
+  AllocFuncs.AssertOnFailure = AssertOnFailure;
+
+  DecodedBufSize  = (SizeT)GetDecodedSizeOfBuf ((UINT8 *)Source);
+  EncodedDataSize = (SizeT)(SourceSize - LZMA_HEADER_SIZE);
+
+  LzmaResult = LzmaDecode (
+                 Destination,
+                 &DecodedBufSize,
+                 (Byte *)((UINT8 *)Source + LZMA_HEADER_SIZE),
+                 &EncodedDataSize,
+                 Source,
+                 LZMA_PROPS_SIZE,
+                 LZMA_FINISH_END,
+                 &Status,
+                 &(AllocFuncs.Functions)
+                 );
+
+  if (LzmaResult == SZ_OK) {
+    return RETURN_SUCCESS;
+  } else {
+    return RETURN_INVALID_PARAMETER;
+  }
+}
+
 //
 // LZMA functions and data as defined in local LzmaDecompressLibInternal.h
 //
@@ -186,35 +248,33 @@ LzmaUefiDecompress (
   IN OUT VOID    *Scratch
   )
 {
-  SRes              LzmaResult;
-  ELzmaStatus       Status;
-  SizeT             DecodedBufSize;
-  SizeT             EncodedDataSize;
-  ISzAllocWithData  AllocFuncs;
-
-  AllocFuncs.Functions.Alloc = SzAlloc;
-  AllocFuncs.Functions.Free  = SzFree;
-  AllocFuncs.Buffer          = Scratch;
-  AllocFuncs.BufferSize      = SCRATCH_BUFFER_REQUEST_SIZE;
+  return LzmaDecompressWorker (Source, SourceSize, Destination, Scratch, TRUE);
+}
 
-  DecodedBufSize  = (SizeT)GetDecodedSizeOfBuf ((UINT8 *)Source);
-  EncodedDataSize = (SizeT)(SourceSize - LZMA_HEADER_SIZE);
+/**
+  Decompresses a Lzma compressed source buffer, without reporting the errors
+  through ASSERT() or DEBUG(), so that it can run on an application processor.
 
-  LzmaResult = LzmaDecode (
-                 Destination,
-                 &DecodedBufSize,
-                 (Byte *)((UINT8 *)Source + LZMA_HEADER_SIZE),
-                 &EncodedDataSize,
-                 Source,
-                 LZMA_PROPS_SIZE,
-                 LZMA_FINISH_END,
-                 &Status,
-                 &(AllocFuncs.Functions)
-                 );
+  @param  Source      The source buffer containing the compressed data.
+  @param  SourceSize  The size of source buffer.
+  @param  Destination The destination buffer to store the decompressed data
+  @param  Scratch     A temporary scratch buffer of SCRATCH_BUFFER_REQUEST_SIZE
+                      bytes that is used to perform the decompression.
 
-  if (LzmaResult == SZ_OK) {
-    return RETURN_SUCCESS;
-  } else {
-    return RETURN_INVALID_PARAMETER;
-  }
+  @retval  RETURN_SUCCESS Decompression completed successfully, and
+                          the uncompressed buffer is returned in Destination.
+  @retval  RETURN_INVALID_PARAMETER
+                          The source buffer specified by Source is corrupted
+                          (not in a valid compressed format), or the scratch
+                          buffer is too small.
+**/
+RETURN_STATUS
+LzmaUefiDecompressApSafe (
+  IN CONST VOID  *Source,
+  IN UINTN       SourceSize,
+  IN OUT VOID    *Destination,
+  IN OUT VOID    *Scratch
+  )
+{
+  return LzmaDecompressWorker (Source, SourceSize, Destination, Scratch, FALSE);
 }
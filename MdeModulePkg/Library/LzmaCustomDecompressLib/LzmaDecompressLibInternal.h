@@ -17,6 +17,23 @@
 #include <Library/ExtractGuidedSectionLib.h>
 #include <Guid/LzmaDecompress.h>
 
+#define SCRATCH_BUFFER_REQUEST_SIZE  SIZE_64KB
+
+#define LZMA_PARALLEL_SIGNATURE  SIGNATURE_32 ('L', 'Z', 'M', 'P')
+
+///
+/// The header of the data of a LZMA parallel GUIDed section. It is followed by
+/// the encoded size of each block, as UINT32, and then by the blocks. Each block
+/// is a complete LZMA stream, which decodes to BlockSize bytes, except the last
+/// one which decodes to the rest of the data.
+///
+typedef struct {
+  UINT32    Signature;
+  UINT32    BlockSize;
+  UINT32    BlockCount;
+  UINT32    DecodedSize;
+} LZMA_PARALLEL_HEADER;
+
 /**
   Given a Lzma compressed source buffer, this function retrieves the size of
   the uncompressed buffer and the size of the scratch buffer required
@@ -91,4 +108,123 @@ LzmaUefiDecompress (
   IN OUT VOID    *Scratch
   );
 
+/**
+  Decompresses a Lzma compressed source buffer, without reporting the errors
+  through ASSERT() or DEBUG(), so that it can run on an application processor.
+
+  @param  Source      The source buffer containing the compressed data.
+  @param  SourceSize  The size of source buffer.
+  @param  Destination The destination buffer to store the decompressed data
+  @param  Scratch     A temporary scratch buffer of SCRATCH_BUFFER_REQUEST_SIZE
+                      bytes that is used to perform the decompression.
+
+  @retval  RETURN_SUCCESS Decompression completed successfully, and
+                          the uncompressed buffer is returned in Destination.
+  @retval  RETURN_INVALID_PARAMETER
+                          The source buffer specified by Source is corrupted
+                          (not in a valid compressed format), or the scratch
+                          buffer is too small.
+**/
+RETURN_STATUS
+LzmaUefiDecompressApSafe (
+  IN CONST VOID  *Source,
+  IN UINTN       SourceSize,
+  IN OUT VOID    *Destination,
+  IN OUT VOID    *Scratch
+  );
+
+/**
+  Given a LZMA parallel compressed source buffer, this function retrieves the
+  size of the uncompressed buffer and the size of the scratch buffer required
+  to decompress the compressed source buffer.
+
+  @param  Source          The source buffer containing the compressed data.
+  @param  SourceSize      The size, in bytes, of the source buffer.
+  @param  DestinationSize A pointer to the size, in bytes, of the uncompressed buffer
+                          that will be generated when the compressed buffer specified
+                          by Source and SourceSize is decompressed.
+  @param  ScratchSize     A pointer to the size, in bytes, of the scratch buffer that
+                          is required to decompress the compressed buffer specified
+                          by Source and SourceSize.
+
+  @retval  RETURN_SUCCESS The size of the uncompressed data was returned
+                          in DestinationSize and the size of the scratch
+                          buffer was returned in ScratchSize.
+  @retval  RETURN_INVALID_PARAMETER
+                          The header of the source buffer is corrupted.
+**/
+RETURN_STATUS
+EFIAPI
+LzmaParallelDecompressGetInfo (
+  IN  CONST VOID  *Source,
+  IN  UINT32      SourceSize,
+  OUT UINT32      *DestinationSize,
+  OUT UINT32      *ScratchSize
+  );
+
+/**
+  Decompresses a LZMA parallel compressed source buffer.
+
+  The blocks are decompressed on all the processors available at the same time.
+
+  @param  Source      The source buffer containing the compressed data.
+  @param  SourceSize  The size of source buffer.
+  @param  Destination The destination buffer to store the decompressed data
+  @param  Scratch     A temporary scratch buffer that is used to perform the decompression.
+
+  @retval  RETURN_SUCCESS Decompression completed successfully, and
+                          the uncompressed buffer is returned in Destination.
+  @retval  RETURN_INVALID_PARAMETER
+                          The source buffer specified by Source is corrupted
+                          (not in a valid compressed format).
+**/
+RETURN_STATUS
+EFIAPI
+LzmaParallelDecompress (
+  IN CONST VOID  *Source,
+  IN UINTN       SourceSize,
+  IN OUT VOID    *Destination,
+  IN OUT VOID    *Scratch
+  );
+
+/**
+  Get the number of processors which can decompress the blocks of a LZMA
+  parallel compressed buffer at the same time, including the calling processor.
+
+  @return The number of processors.
+**/
+UINTN
+LzmaParallelGetProcessorCount (
+  VOID
+  );
+
+/**
+  Run a procedure on all the enabled application processors, and return when
+  all of them have returned.
+
+  The procedure is not run on the calling processor. If there is no application
+  processor, or they cannot be started, this function returns at once.
+
+  @param  Procedure   The procedure to run.
+  @param  Argument    The argument passed to the procedure.
+**/
+VOID
+LzmaParallelStartupAllAps (
+  IN EFI_AP_PROCEDURE  Procedure,
+  IN VOID              *Argument
+  );
+
+/**
+  Take the next value of a counter shared by the processors decompressing the
+  blocks, and increment the counter.
+
+  @param  Counter     The counter.
+
+  @return The value of the counter before it was incremented.
+**/
+UINT32
+LzmaParallelTakeNext (
+  IN OUT volatile UINT32  *Counter
+  );
+
 #endif
@@ -0,0 +1,312 @@
+/** @file
+  LZMA parallel decompress interfaces.
+
+  The data of a LZMA parallel GUIDed section is split in blocks compressed
+  independently, so that each processor available can decompress a block at
+  the same time.
+
+  Copyright (c) 2026, agent <agent@local>. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "LzmaDecompressLibInternal.h"
+#include "Sdk/C/7zTypes.h"
+#include "Sdk/C/LzmaDec.h"
+
+#define LZMA_BLOCK_HEADER_SIZE  (LZMA_PROPS_SIZE + 8)
+
+//
+// The maximum number of processors decompressing the blocks at the same time,
+// which bounds the size of the scratch buffer.
+//
+#define LZMA_PARALLEL_MAX_PROCESSORS  32
+
+///
+/// The state shared by the processors decompressing the blocks, at the start
+/// of the scratch buffer.
+///
+typedef struct {
+  CONST UINT8         *Blocks;
+  UINT8               *Destination;
+  UINT8               *Scratch;
+  UINT32              *Offset;
+  UINT32              BlockSize;
+  UINT32              BlockCount;
+  UINT32              SlotCount;
+  volatile UINT32     NextSlot;
+  volatile UINT32     NextBlock;
+  volatile BOOLEAN    Failed;
+} LZMA_PARALLEL_CONTEXT;
+
+/**
+  Get the number of scratch buffers, one for each processor decompressing the
+  blocks at the same time.
+
+  @param  BlockCount  The number of blocks.
+
+  @return The number of scratch buffers.
+**/
+UINT32
+LzmaParallelGetSlotCount (
+  IN UINT32  BlockCount
+  )
+{
+  UINTN  ProcessorCount;
+
+  ProcessorCount = LzmaParallelGetProcessorCount ();
+  ProcessorCount = MIN (ProcessorCount, LZMA_PARALLEL_MAX_PROCESSORS);
+  return (UINT32)MAX (MIN (ProcessorCount, BlockCount), 1);
+}
+
+/**
+  Get the size of the shared state and of the block offsets at the start of
+  the scratch buffer.
+
+  @param  BlockCount  The number of blocks.
+
+  @return The size, in bytes, aligned on 8 bytes.
+**/
+UINTN
+LzmaParallelGetContextSize (
+  IN UINT32  BlockCount
+  )
+{
+  return ALIGN_VALUE (
+           sizeof (LZMA_PARALLEL_CONTEXT) + ((UINTN)BlockCount + 1) * sizeof (UINT32),
+           sizeof (UINT64)
+           );
+}
+
+/**
+  Check the header of a LZMA parallel compressed buffer.
+
+  @param  Source      The source buffer containing the compressed data.
+  @param  SourceSize  The size, in bytes, of the source buffer.
+
+  @retval  TRUE       The header is valid.
+  @retval  FALSE      The header is corrupted.
+**/
+BOOLEAN
+LzmaParallelCheckHeader (
+  IN CONST VOID  *Source,
+  IN UINTN       SourceSize
+  )
+{
+  LZMA_PARALLEL_HEADER  Header;
+
+  if (SourceSize < sizeof (LZMA_PARALLEL_HEADER)) {
+    return FALSE;
+  }
+
+  CopyMem (&Header, Source, sizeof (Header));
+  if ((Header.Signature != LZMA_PARALLEL_SIGNATURE) || (Header.BlockSize == 0)) {
+    return FALSE;
+  }
+
+  if (Header.BlockCount != (UINT32)DivU64x32 ((UINT64)Header.DecodedSize + Header.BlockSize - 1, Header.BlockSize)) {
+    return FALSE;
+  }
+
+  return (BOOLEAN)(Header.BlockCount <= (SourceSize - sizeof (LZMA_PARALLEL_HEADER)) / sizeof (UINT32));
+}
+
+/**
+  Decompress the blocks not decompressed yet, one after the other.
+
+  This function runs on all the processors at the same time, each with its
+  own scratch buffer. It returns when no block is left, or when a block could
+  not be decompressed. It must not use ASSERT() or DEBUG(), which are not
+  safe on the application processors, so the calling processor reports the
+  errors.
+
+  @param  Buffer      Points to the LZMA_PARALLEL_CONTEXT.
+**/
+VOID
+EFIAPI
+LzmaParallelDecompressBlocks (
+  IN OUT VOID  *Buffer
+  )
+{
+  LZMA_PARALLEL_CONTEXT  *Context;
+  UINT32                 Slot;
+  UINT32                 Index;
+  RETURN_STATUS          Status;
+
+  Context = (LZMA_PARALLEL_CONTEXT *)Buffer;
+
+  Slot = LzmaParallelTakeNext (&Context->NextSlot);
+  if (Slot >= Context->SlotCount) {
+    return;
+  }
+
+  while (!Context->Failed) {
+    Index = LzmaParallelTakeNext (&Context->NextBlock);
+    if (Index >= Context->BlockCount) {
+      break;
+    }
+
+    Status = LzmaUefiDecompressApSafe (
+               Context->Blocks + Context->Offset[Index],
+               Context->Offset[Index + 1] - Context->Offset[Index],
+               Context->Destination + (UINTN)Index * Context->BlockSize,
+               Context->Scratch + (UINTN)Slot * SCRATCH_BUFFER_REQUEST_SIZE
+               );
+    if (RETURN_ERROR (Status)) {
+      Context->Failed = TRUE;
+    }
+  }
+}
+
+/**
+  Given a LZMA parallel compressed source buffer, this function retrieves the
+  size of the uncompressed buffer and the size of the scratch buffer required
+  to decompress the compressed source buffer.
+
+  @param  Source          The source buffer containing the compressed data.
+  @param  SourceSize      The size, in bytes, of the source buffer.
+  @param  DestinationSize A pointer to the size, in bytes, of the uncompressed buffer
+                          that will be generated when the compressed buffer specified
+                          by Source and SourceSize is decompressed.
+  @param  ScratchSize     A pointer to the size, in bytes, of the scratch buffer that
+                          is required to decompress the compressed buffer specified
+                          by Source and SourceSize.
+
+  @retval  RETURN_SUCCESS The size of the uncompressed data was returned
+                          in DestinationSize and the size of the scratch
+                          buffer was returned in ScratchSize.
+  @retval  RETURN_INVALID_PARAMETER
+                          The header of the source buffer is corrupted.
+**/
+RETURN_STATUS
+EFIAPI
+LzmaParallelDecompressGetInfo (
+  IN  CONST VOID  *Source,
+  IN  UINT32      SourceSize,
+  OUT UINT32      *DestinationSize,
+  OUT UINT32      *ScratchSize
+  )
+{
+  CONST LZMA_PARALLEL_HEADER  *Header;
+  UINT64                      Size;
+
+  if (!LzmaParallelCheckHeader (Source, SourceSize)) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  Header = (CONST LZMA_PARALLEL_HEADER *)Source;
+  Size   = LzmaParallelGetContextSize (ReadUnaligned32 (&Header->BlockCount)) +
+           MultU64x32 (LzmaParallelGetSlotCount (ReadUnaligned32 (&Header->BlockCount)), SCRATCH_BUFFER_REQUEST_SIZE);
+  if (Size > MAX_UINT32) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  *DestinationSize = ReadUnaligned32 (&Header->DecodedSize);
+  *ScratchSize     = (UINT32)Size;
+  return RETURN_SUCCESS;
+}
+
+/**
+  Decompresses a LZMA parallel compressed source buffer.
+
+  The blocks are decompressed on all the processors available at the same time.
+
+  @param  Source      The source buffer containing the compressed data.
+  @param  SourceSize  The size of source buffer.
+  @param  Destination The destination buffer to store the decompressed data
+  @param  Scratch     A temporary scratch buffer that is used to perform the decompression.
+
+  @retval  RETURN_SUCCESS Decompression completed successfully, and
+                          the uncompressed buffer is returned in Destination.
+  @retval  RETURN_INVALID_PARAMETER
+                          The source buffer specified by Source is corrupted
+                          (not in a valid compressed format).
+**/
+RETURN_STATUS
+EFIAPI
+LzmaParallelDecompress (
+  IN CONST VOID  *Source,
+  IN UINTN       SourceSize,
+  IN OUT VOID    *Destination,
+  IN OUT VOID    *Scratch
+  )
+{
+  LZMA_PARALLEL_HEADER   Header;
+  LZMA_PARALLEL_CONTEXT  *Context;
+  CONST UINT8            *EncodedSize;
+  UINTN                  BlocksSize;
+  UINT32                 DecodedSize;
+  UINT32                 BlockScratchSize;
+  UINT32                 Index;
+  RETURN_STATUS          Status;
+
+  if (!LzmaParallelCheckHeader (Source, SourceSize)) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  CopyMem (&Header, Source, sizeof (Header));
+  if (Header.BlockCount == 0) {
+    return RETURN_SUCCESS;
+  }
+
+  ASSERT (Scratch != NULL);
+  Context              = (LZMA_PARALLEL_CONTEXT *)Scratch;
+  Context->Offset      = (UINT32 *)(Context + 1);
+  Context->Scratch     = (UINT8 *)Scratch + LzmaParallelGetContextSize (Header.BlockCount);
+  Context->Destination = (UINT8 *)Destination;
+  Context->BlockSize   = Header.BlockSize;
+  Context->BlockCount  = Header.BlockCount;
+  Context->SlotCount   = LzmaParallelGetSlotCount (Header.BlockCount);
+  Context->NextSlot    = 0;
+  Context->NextBlock   = 0;
+  Context->Failed      = FALSE;
+
+  //
+  // Locate the blocks, and check that each one decodes to its part of the
+  // destination buffer exactly, before any processor starts to decode them.
+  //
+  EncodedSize     = (CONST UINT8 *)Source + sizeof (LZMA_PARALLEL_HEADER);
+  Context->Blocks = EncodedSize + (UINTN)Header.BlockCount * sizeof (UINT32);
+  BlocksSize      = SourceSize - (Context->Blocks - (CONST UINT8 *)Source);
+
+  Context->Offset[0] = 0;
+  for (Index = 0; Index < Header.BlockCount; Index++) {
+    Context->Offset[Index + 1] = ReadUnaligned32 ((CONST UINT32 *)EncodedSize + Index);
+    if ((Context->Offset[Index + 1] < LZMA_BLOCK_HEADER_SIZE) ||
+        (Context->Offset[Index + 1] > BlocksSize - Context->Offset[Index]))
+    {
+      return RETURN_INVALID_PARAMETER;
+    }
+
+    Context->Offset[Index + 1] += Context->Offset[Index];
+
+    Status = LzmaUefiDecompressGetInfo (
+               Context->Blocks + Context->Offset[Index],
+               Context->Offset[Index + 1] - Context->Offset[Index],
+               &DecodedSize,
+               &BlockScratchSize
+               );
+    if (RETURN_ERROR (Status) ||
+        (DecodedSize != MIN (Header.BlockSize, Header.DecodedSize - Index * Header.BlockSize)))
+    {
+      return RETURN_INVALID_PARAMETER;
+    }
+  }
+
+  //
+  // Let the application processors decode the blocks, and then decode on the
+  // calling processor, with the first scratch buffer, the blocks left when
+  // there are no application processors or they could not be started.
+  //
+  LzmaParallelStartupAllAps (LzmaParallelDecompressBlocks, Context);
+
+  Context->NextSlot = 0;
+  LzmaParallelDecompressBlocks (Context);
+
+  if (Context->Failed) {
+    DEBUG ((DEBUG_ERROR, "%a: Failed to decompress a LZMA block\n", __func__));
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  return RETURN_SUCCESS;
+}
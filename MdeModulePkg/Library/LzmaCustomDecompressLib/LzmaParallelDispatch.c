@@ -0,0 +1,61 @@
+/** @file
+  Decompress the blocks of a LZMA parallel GUIDed section on the calling
+  processor only, for the phases where no multi-processor service is used.
+
+  Copyright (c) 2026, agent <agent@local>. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "LzmaDecompressLibInternal.h"
+
+/**
+  Get the number of processors which can decompress the blocks of a LZMA
+  parallel compressed buffer at the same time, including the calling processor.
+
+  @return The number of processors.
+**/
+UINTN
+LzmaParallelGetProcessorCount (
+  VOID
+  )
+{
+  return 1;
+}
+
+/**
+  Run a procedure on all the enabled application processors, and return when
+  all of them have returned.
+
+  The procedure is not run on the calling processor. If there is no application
+  processor, or they cannot be started, this function returns at once.
+
+  @param  Procedure   The procedure to run.
+  @param  Argument    The argument passed to the procedure.
+**/
+VOID
+LzmaParallelStartupAllAps (
+  IN EFI_AP_PROCEDURE  Procedure,
+  IN VOID              *Argument
+  )
+{
+}
+
+/**
+  Take the next value of a counter shared by the processors decompressing the
+  blocks, and increment the counter.
+
+  Only the calling processor decompresses the blocks, so the counter is not
+  shared.
+
+  @param  Counter     The counter.
+
+  @return The value of the counter before it was incremented.
+**/
+UINT32
+LzmaParallelTakeNext (
+  IN OUT volatile UINT32  *Counter
+  )
+{
+  return (*Counter)++;
+}
@@ -0,0 +1,114 @@
+/** @file
+  Decompress the blocks of a LZMA parallel GUIDed section on all the
+  processors started by the PEI MP Services PPI.
+
+  Copyright (c) 2026, agent <agent@local>. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "LzmaDecompressLibInternal.h"
+#include <Library/PeiServicesLib.h>
+#include <Library/PeiServicesTablePointerLib.h>
+#include <Library/SynchronizationLib.h>
+#include <Ppi/MpServices.h>
+
+/**
+  Get the number of processors which can decompress the blocks of a LZMA
+  parallel compressed buffer at the same time, including the calling processor.
+
+  @return The number of processors.
+**/
+UINTN
+LzmaParallelGetProcessorCount (
+  VOID
+  )
+{
+  EFI_STATUS               Status;
+  EFI_PEI_MP_SERVICES_PPI  *MpServices;
+  UINTN                    NumberOfProcessors;
+  UINTN                    NumberOfEnabledProcessors;
+
+  Status = PeiServicesLocatePpi (
+             &gEfiPeiMpServicesPpiGuid,
+             0,
+             NULL,
+             (VOID **)&MpServices
+             );
+  if (EFI_ERROR (Status)) {
+    return 1;
+  }
+
+  Status = MpServices->GetNumberOfProcessors (
+                         GetPeiServicesTablePointer (),
+                         MpServices,
+                         &NumberOfProcessors,
+                         &NumberOfEnabledProcessors
+                         );
+  if (EFI_ERROR (Status) || (NumberOfEnabledProcessors == 0)) {
+    return 1;
+  }
+
+  return NumberOfEnabledProcessors;
+}
+
+/**
+  Run a procedure on all the enabled application processors, and return when
+  all of them have returned.
+
+  The procedure is not run on the calling processor. If there is no application
+  processor, or they cannot be started, this function returns at once.
+
+  @param  Procedure   The procedure to run.
+  @param  Argument    The argument passed to the procedure.
+**/
+VOID
+LzmaParallelStartupAllAps (
+  IN EFI_AP_PROCEDURE  Procedure,
+  IN VOID              *Argument
+  )
+{
+  EFI_STATUS               Status;
+  EFI_PEI_MP_SERVICES_PPI  *MpServices;
+
+  Status = PeiServicesLocatePpi (
+             &gEfiPeiMpServicesPpiGuid,
+             0,
+             NULL,
+             (VOID **)&MpServices
+             );
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  //
+  // The PEI MP Services always block until all the processors have returned.
+  //
+  Status = MpServices->StartupAllAPs (
+                         GetPeiServicesTablePointer (),
+                         MpServices,
+                         Procedure,
+                         FALSE,
+                         0,
+                         Argument
+                         );
+  if (EFI_ERROR (Status) && (Status != EFI_NOT_STARTED)) {
+    DEBUG ((DEBUG_WARN, "%a: Failed to start the APs - %r\n", __func__, Status));
+  }
+}
+
+/**
+  Take the next value of a counter shared by the processors decompressing the
+  blocks, and increment the counter.
+
+  @param  Counter     The counter.
+
+  @return The value of the counter before it was incremented.
+**/
+UINT32
+LzmaParallelTakeNext (
+  IN OUT volatile UINT32  *Counter
+  )
+{
+  return InterlockedIncrement (Counter) - 1;
+}
@@ -186,6 +186,16 @@ DiskIoDriverBindingStart (
     goto ErrorExit;
   }
 
+  Status = DiskIoCacheCreate (Instance);
+  if (EFI_ERROR (Status)) {
+    goto ErrorExit;
+  }
+
+  //
+  // Pick up the partition probe regions read ahead when the Block I/O 2 was installed.
+  //
+  DiskIoPrefetchComplete (Instance, ControllerHandle);
+
   //
   // Install protocol interfaces for the Disk IO device.
   //
@@ -217,6 +227,7 @@ ErrorExit:
     }
 
     if (Instance != NULL) {
+      DiskIoCacheDestroy (Instance);
       FreePool (Instance);
     }
 
@@ -229,6 +240,13 @@ ErrorExit:
   }
 
 ErrorExit1:
+  if (EFI_ERROR (Status)) {
+    //
+    // Drop the partition probe regions read ahead for a disk not started.
+    //
+    DiskIoPrefetchRelease (ControllerHandle);
+  }
+
   gBS->RestoreTPL (OldTpl);
   return Status;
 }
@@ -319,6 +337,11 @@ DiskIoDriverBindingStop (
   }
 
   if (!EFI_ERROR (Status)) {
+    //
+    // The reset above terminated the prefetch reads still outstanding.
+    //
+    DiskIoPrefetchRelease (ControllerHandle);
+
     do {
       EfiAcquireLock (&Instance->TaskQueueLock);
       AllTaskDone = IsListEmpty (&Instance->TaskQueue);
@@ -347,6 +370,7 @@ DiskIoDriverBindingStop (
       ASSERT_EFI_ERROR (Status);
     }
 
+    DiskIoCacheDestroy (Instance);
     FreePool (Instance);
   }
 
@@ -432,6 +456,15 @@ DiskIo2OnReadWriteComplete (
     CopyMem (Subtask->Buffer, Subtask->WorkingBuffer + Subtask->Offset, Subtask->Length);
   }
 
+  //
+  // Blocks read by non-blocking requests are not inserted into the block cache
+  // because a write to the same blocks may have been issued after the read.
+  // Drop the blocks of the completed write in case a blocking read refilled them.
+  //
+  if (Subtask->Write) {
+    DiskIoCacheInvalidate (Instance, Subtask->Lba, Subtask->Length);
+  }
+
   DiskIoDestroySubtask (Instance, Subtask);
 
   if (EFI_ERROR (TransactionStatus) || IsListEmpty (&Task->Subtasks)) {
@@ -850,6 +883,8 @@ DiskIo2ReadWriteDisk (
   BOOLEAN                 Blocking;
   BOOLEAN                 SubtaskBlocking;
   LIST_ENTRY              *SubtasksPtr;
+  UINT64                  Lba;
+  UINT32                  UnderRun;
 
   Task     = NULL;
   BlockIo  = Instance->BlockIo;
@@ -864,7 +899,24 @@ DiskIo2ReadWriteDisk (
     //
     while (!DiskIo2RemoveCompletedTask (Instance)) {
     }
+  }
 
+  //
+  // Complete the read directly when all the requested blocks are cached.
+  //
+  if (!Write && (Instance->Cache != NULL)) {
+    Lba = DivU64x32Remainder (Offset, Media->BlockSize, &UnderRun);
+    if (DiskIoCacheRead (Instance, MediaId, Lba, UnderRun, BufferSize, Buffer)) {
+      if (!Blocking) {
+        Token->TransactionStatus = EFI_SUCCESS;
+        gBS->SignalEvent (Token->Event);
+      }
+
+      return EFI_SUCCESS;
+    }
+  }
+
+  if (Blocking) {
     SubtasksPtr = &Subtasks;
   } else {
     DiskIo2RemoveCompletedTask (Instance);
@@ -919,6 +971,8 @@ DiskIo2ReadWriteDisk (
         CopyMem (Subtask->WorkingBuffer + Subtask->Offset, Subtask->Buffer, Subtask->Length);
       }
 
+      DiskIoCacheInvalidate (Instance, Subtask->Lba, Subtask->Length);
+
       if (SubtaskBlocking) {
         Status = BlockIo->WriteBlocks (
                             BlockIo,
@@ -942,15 +996,28 @@ DiskIo2ReadWriteDisk (
       // Read
       //
       if (SubtaskBlocking) {
-        Status = BlockIo->ReadBlocks (
-                            BlockIo,
-                            MediaId,
-                            Subtask->Lba,
-                            (Subtask->Length % Media->BlockSize == 0) ? Subtask->Length : Media->BlockSize,
-                            (Subtask->WorkingBuffer != NULL) ? Subtask->WorkingBuffer : Subtask->Buffer
-                            );
-        if (!EFI_ERROR (Status) && (Subtask->WorkingBuffer != NULL)) {
-          CopyMem (Subtask->Buffer, Subtask->WorkingBuffer + Subtask->Offset, Subtask->Length);
+        if (DiskIoCacheRead (Instance, MediaId, Subtask->Lba, Subtask->Offset, Subtask->Length, Subtask->Buffer)) {
+          Status = EFI_SUCCESS;
+        } else {
+          Status = BlockIo->ReadBlocks (
+                              BlockIo,
+                              MediaId,
+                              Subtask->Lba,
+                              (Subtask->Length % Media->BlockSize == 0) ? Subtask->Length : Media->BlockSize,
+                              (Subtask->WorkingBuffer != NULL) ? Subtask->WorkingBuffer : Subtask->Buffer
+                              );
+          if (!EFI_ERROR (Status)) {
+            DiskIoCacheFill (
+              Instance,
+              MediaId,
+              Subtask->Lba,
+              (Subtask->Length % Media->BlockSize == 0) ? Subtask->Length : Media->BlockSize,
+              (Subtask->WorkingBuffer != NULL) ? Subtask->WorkingBuffer : Subtask->Buffer
+              );
+            if (Subtask->WorkingBuffer != NULL) {
+              CopyMem (Subtask->Buffer, Subtask->WorkingBuffer + Subtask->Offset, Subtask->Length);
+            }
+          }
         }
       } else {
         Status = BlockIo2->ReadBlocksEx (
@@ -1312,5 +1379,10 @@ InitializeDiskIo (
              );
   ASSERT_EFI_ERROR (Status);
 
+  if (!EFI_ERROR (Status)) {
+    Status = DiskIoPrefetchInitialize ();
+    ASSERT_EFI_ERROR (Status);
+  }
+
   return Status;
 }
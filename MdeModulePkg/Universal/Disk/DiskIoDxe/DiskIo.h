@@ -24,6 +24,62 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/MemoryAllocationLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 
+//
+// Number of hash buckets used to look up cached blocks by LBA.
+//
+#define DISK_IO_CACHE_HASH_SIZE  64
+
+typedef struct {
+  LIST_ENTRY    HashLink;                   /// < link in the hash bucket, valid entries only
+  LIST_ENTRY    LruLink;                    /// < link in the LRU list, most recently used first
+  BOOLEAN       Valid;
+  UINT64        Lba;
+  UINT8         *Data;
+} DISK_IO_CACHE_ENTRY;
+
+//
+// Block cache laid on a physical (non logical-partition) Block I/O device.
+// Partition children access the disk through the parent Disk I/O, so they
+// share the cache of the physical device.
+//
+typedef struct {
+  EFI_LOCK               Lock;
+  UINT32                 MediaId;
+  UINT32                 BlockSize;
+  UINTN                  EntryCount;
+  DISK_IO_CACHE_ENTRY    *Entries;
+  UINT8                  *DataBuffer;
+  LIST_ENTRY             HashTable[DISK_IO_CACHE_HASH_SIZE];
+  LIST_ENTRY             LruList;
+  UINT64                 Hits;
+  UINT64                 Misses;
+} DISK_IO_CACHE;
+
+//
+// Sizes of the leading and trailing regions of a disk read ahead for
+// partition probing: MBR, primary GPT, El Torito and UDF descriptors live
+// in the head, the backup GPT lives in the tail.
+//
+#define DISK_IO_PREFETCH_HEAD_SIZE  SIZE_64KB
+#define DISK_IO_PREFETCH_TAIL_SIZE  SIZE_32KB
+
+typedef struct {
+  EFI_LBA                Lba;
+  UINTN                  Length;
+  UINT8                  *Buffer;
+  volatile BOOLEAN       Done;
+  EFI_BLOCK_IO2_TOKEN    BlockIo2Token;
+} DISK_IO_PREFETCH_RANGE;
+
+typedef struct {
+  LIST_ENTRY                Link;
+  EFI_HANDLE                Handle;
+  EFI_BLOCK_IO2_PROTOCOL    *BlockIo2;
+  UINT32                    MediaId;
+  BOOLEAN                   Stale;
+  DISK_IO_PREFETCH_RANGE    Range[2];
+} DISK_IO_PREFETCH;
+
 #define DISK_IO_PRIVATE_DATA_SIGNATURE  SIGNATURE_32 ('d', 's', 'k', 'I')
 typedef struct {
   UINT32                    Signature;
@@ -37,6 +93,8 @@ typedef struct {
 
   EFI_LOCK                  TaskQueueLock;
   LIST_ENTRY                TaskQueue;
+
+  DISK_IO_CACHE             *Cache;         /// < NULL when the block cache is disabled
 } DISK_IO_PRIVATE_DATA;
 #define DISK_IO_PRIVATE_DATA_FROM_DISK_IO(a)   CR (a, DISK_IO_PRIVATE_DATA, DiskIo,  DISK_IO_PRIVATE_DATA_SIGNATURE)
 #define DISK_IO_PRIVATE_DATA_FROM_DISK_IO2(a)  CR (a, DISK_IO_PRIVATE_DATA, DiskIo2, DISK_IO_PRIVATE_DATA_SIGNATURE)
@@ -335,6 +393,136 @@ DiskIo2FlushDiskEx (
   IN OUT EFI_DISK_IO2_TOKEN  *Token
   );
 
+//
+// Block cache functions
+//
+
+/**
+  Create the block cache for the Disk I/O instance.
+
+  The cache is only created for physical Block I/O devices and when
+  PcdDiskIoCacheBlockNum is not zero.
+
+  @param Instance    Pointer to the DISK_IO_PRIVATE_DATA.
+
+  @retval EFI_SUCCESS           The cache is created or caching is not required.
+  @retval EFI_OUT_OF_RESOURCES  There is not enough memory to create the cache.
+**/
+EFI_STATUS
+DiskIoCacheCreate (
+  IN DISK_IO_PRIVATE_DATA  *Instance
+  );
+
+/**
+  Destroy the block cache of the Disk I/O instance.
+
+  @param Instance    Pointer to the DISK_IO_PRIVATE_DATA.
+**/
+VOID
+DiskIoCacheDestroy (
+  IN DISK_IO_PRIVATE_DATA  *Instance
+  );
+
+/**
+  Read data from the block cache.
+
+  The read only succeeds when every block touched by the request is cached.
+
+  @param Instance    Pointer to the DISK_IO_PRIVATE_DATA.
+  @param MediaId     ID of the medium to be read.
+  @param Lba         The starting logical block address to read from.
+  @param Offset      The starting byte offset to read from the LBA.
+  @param Length      The number of bytes to read.
+  @param Buffer      The buffer to receive the data.
+
+  @retval TRUE       All the data is read from the cache.
+  @retval FALSE      The data is not (completely) cached.
+**/
+BOOLEAN
+DiskIoCacheRead (
+  IN  DISK_IO_PRIVATE_DATA  *Instance,
+  IN  UINT32                MediaId,
+  IN  UINT64                Lba,
+  IN  UINT32                Offset,
+  IN  UINTN                 Length,
+  OUT UINT8                 *Buffer
+  );
+
+/**
+  Insert blocks which were just read from the device into the block cache.
+
+  @param Instance    Pointer to the DISK_IO_PRIVATE_DATA.
+  @param MediaId     ID of the medium the data was read from.
+  @param Lba         The starting logical block address of the data.
+  @param Length      The number of bytes in Buffer, a multiple of block size.
+  @param Buffer      The block data.
+**/
+VOID
+DiskIoCacheFill (
+  IN DISK_IO_PRIVATE_DATA  *Instance,
+  IN UINT32                MediaId,
+  IN UINT64                Lba,
+  IN UINTN                 Length,
+  IN UINT8                 *Buffer
+  );
+
+/**
+  Invalidate the cached blocks covered by a write request.
+
+  @param Instance    Pointer to the DISK_IO_PRIVATE_DATA.
+  @param Lba         The starting logical block address of the write.
+  @param Length      The number of bytes written.
+**/
+VOID
+DiskIoCacheInvalidate (
+  IN DISK_IO_PRIVATE_DATA  *Instance,
+  IN UINT64                Lba,
+  IN UINTN                 Length
+  );
+
+//
+// Probe region prefetch functions
+//
+
+/**
+  Register the notification that starts the probe region prefetch of the disks.
+
+  @retval EFI_SUCCESS    The notification is registered or the block cache is disabled.
+  @retval others         The notification cannot be registered.
+**/
+EFI_STATUS
+DiskIoPrefetchInitialize (
+  VOID
+  );
+
+/**
+  Insert the prefetched probe regions of the disk into the block cache of the
+  Disk I/O instance, and drop the prefetch records of the disk.
+
+  @param Instance    Pointer to the DISK_IO_PRIVATE_DATA.
+  @param Handle      The handle of the disk.
+**/
+VOID
+DiskIoPrefetchComplete (
+  IN DISK_IO_PRIVATE_DATA  *Instance,
+  IN EFI_HANDLE            Handle
+  );
+
+/**
+  Free the prefetch records of the disk, and the records of the disks whose
+  Block I/O 2 protocol was removed or reinstalled.
+
+  A record whose reads are still outstanding is only marked stale, because
+  the device may still write its buffers. It is freed once the reads are
+  completed.
+
+  @param Handle      The handle of the disk, or NULL.
+**/
+VOID
+DiskIoPrefetchRelease (
+  IN EFI_HANDLE  Handle OPTIONAL
+  );
+
 //
 // EFI Component Name Functions
 //
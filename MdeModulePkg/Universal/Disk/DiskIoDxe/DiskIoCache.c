@@ -0,0 +1,397 @@
+/** @file
+  Bounded LRU block cache of the DiskIo driver.
+
+  The cache is only laid on physical Block I/O devices. Partition children
+  read the disk through the Disk I/O protocol of their parent, so all the
+  consumers of one disk (partition probing, file systems, boot manager
+  scans) share the cache of that disk.
+
+  The cache is write-through: writes always go to the device and the
+  affected blocks are dropped from the cache. The whole cache is dropped
+  when the media changes. A Block I/O reinstall disconnects the driver,
+  which destroys the cache with the instance.
+
+Copyright (c) 2026, agent <agent@local>. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "DiskIo.h"
+
+/**
+  Drop an entry from the cache and move it to the tail of the LRU list
+  so that it is reused first.
+
+  @param Cache    Pointer to the DISK_IO_CACHE.
+  @param Entry    The entry to drop.
+**/
+VOID
+DiskIoCacheDropEntry (
+  IN DISK_IO_CACHE        *Cache,
+  IN DISK_IO_CACHE_ENTRY  *Entry
+  )
+{
+  if (Entry->Valid) {
+    RemoveEntryList (&Entry->HashLink);
+    Entry->Valid = FALSE;
+  }
+
+  RemoveEntryList (&Entry->LruLink);
+  InsertTailList (&Cache->LruList, &Entry->LruLink);
+}
+
+/**
+  Drop all the cached blocks when the media is changed or removed.
+
+  Must be called with the cache lock held.
+
+  @param Instance    Pointer to the DISK_IO_PRIVATE_DATA.
+  @param Cache       Pointer to the DISK_IO_CACHE.
+**/
+VOID
+DiskIoCacheCheckMedia (
+  IN DISK_IO_PRIVATE_DATA  *Instance,
+  IN DISK_IO_CACHE         *Cache
+  )
+{
+  EFI_BLOCK_IO_MEDIA  *Media;
+  UINTN               Index;
+
+  Media = Instance->BlockIo->Media;
+  if (Media->MediaPresent && (Media->MediaId == Cache->MediaId) && (Media->BlockSize == Cache->BlockSize)) {
+    return;
+  }
+
+  DEBUG ((DEBUG_BLKIO, "DiskIo: Media changed, drop the block cache\n"));
+  for (Index = 0; Index < Cache->EntryCount; Index++) {
+    DiskIoCacheDropEntry (Cache, &Cache->Entries[Index]);
+  }
+
+  Cache->MediaId = Media->MediaId;
+  //
+  // Don't cache anything until the instance is restarted with the new block size.
+  //
+  if (Media->BlockSize != Cache->BlockSize) {
+    Cache->MediaId = (UINT32)~Media->MediaId;
+  }
+}
+
+/**
+  Find the cached entry of a block.
+
+  Must be called with the cache lock held.
+
+  @param Cache    Pointer to the DISK_IO_CACHE.
+  @param Lba      The logical block address to look for.
+
+  @return The cache entry or NULL if the block is not cached.
+**/
+DISK_IO_CACHE_ENTRY *
+DiskIoCacheLookup (
+  IN DISK_IO_CACHE  *Cache,
+  IN UINT64         Lba
+  )
+{
+  LIST_ENTRY           *Bucket;
+  LIST_ENTRY           *Link;
+  DISK_IO_CACHE_ENTRY  *Entry;
+
+  Bucket = &Cache->HashTable[Lba % DISK_IO_CACHE_HASH_SIZE];
+  for (Link = GetFirstNode (Bucket); !IsNull (Bucket, Link); Link = GetNextNode (Bucket, Link)) {
+    Entry = BASE_CR (Link, DISK_IO_CACHE_ENTRY, HashLink);
+    if (Entry->Lba == Lba) {
+      return Entry;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Create the block cache for the Disk I/O instance.
+
+  The cache is only created for physical Block I/O devices and when
+  PcdDiskIoCacheBlockNum is not zero.
+
+  @param Instance    Pointer to the DISK_IO_PRIVATE_DATA.
+
+  @retval EFI_SUCCESS           The cache is created or caching is not required.
+  @retval EFI_OUT_OF_RESOURCES  There is not enough memory to create the cache.
+**/
+EFI_STATUS
+DiskIoCacheCreate (
+  IN DISK_IO_PRIVATE_DATA  *Instance
+  )
+{
+  EFI_BLOCK_IO_MEDIA   *Media;
+  DISK_IO_CACHE        *Cache;
+  DISK_IO_CACHE_ENTRY  *Entry;
+  UINTN                EntryCount;
+  UINTN                Index;
+
+  Instance->Cache = NULL;
+  Media           = Instance->BlockIo->Media;
+  EntryCount      = PcdGet32 (PcdDiskIoCacheBlockNum);
+  if ((EntryCount == 0) || Media->LogicalPartition || (Media->BlockSize == 0)) {
+    return EFI_SUCCESS;
+  }
+
+  Cache = AllocateZeroPool (sizeof (DISK_IO_CACHE));
+  if (Cache == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Cache->Entries    = AllocateZeroPool (EntryCount * sizeof (DISK_IO_CACHE_ENTRY));
+  Cache->DataBuffer = AllocatePages (EFI_SIZE_TO_PAGES (EntryCount * Media->BlockSize));
+  if ((Cache->Entries == NULL) || (Cache->DataBuffer == NULL)) {
+    if (Cache->Entries != NULL) {
+      FreePool (Cache->Entries);
+    }
+
+    if (Cache->DataBuffer != NULL) {
+      FreePages (Cache->DataBuffer, EFI_SIZE_TO_PAGES (EntryCount * Media->BlockSize));
+    }
+
+    FreePool (Cache);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  EfiInitializeLock (&Cache->Lock, TPL_NOTIFY);
+  Cache->MediaId    = Media->MediaId;
+  Cache->BlockSize  = Media->BlockSize;
+  Cache->EntryCount = EntryCount;
+  for (Index = 0; Index < DISK_IO_CACHE_HASH_SIZE; Index++) {
+    InitializeListHead (&Cache->HashTable[Index]);
+  }
+
+  InitializeListHead (&Cache->LruList);
+  for (Index = 0; Index < EntryCount; Index++) {
+    Entry       = &Cache->Entries[Index];
+    Entry->Data = Cache->DataBuffer + Index * Media->BlockSize;
+    InsertTailList (&Cache->LruList, &Entry->LruLink);
+  }
+
+  Instance->Cache = Cache;
+  return EFI_SUCCESS;
+}
+
+/**
+  Destroy the block cache of the Disk I/O instance.
+
+  @param Instance    Pointer to the DISK_IO_PRIVATE_DATA.
+**/
+VOID
+DiskIoCacheDestroy (
+  IN DISK_IO_PRIVATE_DATA  *Instance
+  )
+{
+  DISK_IO_CACHE  *Cache;
+
+  Cache = Instance->Cache;
+  if (Cache == NULL) {
+    return;
+  }
+
+  DEBUG ((
+    DEBUG_INFO,
+    "DiskIo: Block cache statistics: Hits/Misses = %ld/%ld\n",
+    Cache->Hits,
+    Cache->Misses
+    ));
+
+  FreePages (Cache->DataBuffer, EFI_SIZE_TO_PAGES (Cache->EntryCount * Cache->BlockSize));
+  FreePool (Cache->Entries);
+  FreePool (Cache);
+  Instance->Cache = NULL;
+}
+
+/**
+  Read data from the block cache.
+
+  The read only succeeds when every block touched by the request is cached.
+
+  @param Instance    Pointer to the DISK_IO_PRIVATE_DATA.
+  @param MediaId     ID of the medium to be read.
+  @param Lba         The starting logical block address to read from.
+  @param Offset      The starting byte offset to read from the LBA.
+  @param Length      The number of bytes to read.
+  @param Buffer      The buffer to receive the data.
+
+  @retval TRUE       All the data is read from the cache.
+  @retval FALSE      The data is not (completely) cached.
+**/
+BOOLEAN
+DiskIoCacheRead (
+  IN  DISK_IO_PRIVATE_DATA  *Instance,
+  IN  UINT32                MediaId,
+  IN  UINT64                Lba,
+  IN  UINT32                Offset,
+  IN  UINTN                 Length,
+  OUT UINT8                 *Buffer
+  )
+{
+  DISK_IO_CACHE        *Cache;
+  DISK_IO_CACHE_ENTRY  *Entry;
+  UINT64               BlockCount;
+  UINT64               Index;
+  UINTN                CopyLength;
+
+  Cache = Instance->Cache;
+  if ((Cache == NULL) || (Length == 0)) {
+    return FALSE;
+  }
+
+  BlockCount = DivU64x32 (Offset + Length + Cache->BlockSize - 1, Cache->BlockSize);
+  if (BlockCount > Cache->EntryCount) {
+    return FALSE;
+  }
+
+  EfiAcquireLock (&Cache->Lock);
+  DiskIoCacheCheckMedia (Instance, Cache);
+  if (MediaId != Cache->MediaId) {
+    EfiReleaseLock (&Cache->Lock);
+    return FALSE;
+  }
+
+  //
+  // Check all the blocks before copying so a partial hit costs nothing.
+  //
+  for (Index = 0; Index < BlockCount; Index++) {
+    if (DiskIoCacheLookup (Cache, Lba + Index) == NULL) {
+      Cache->Misses++;
+      EfiReleaseLock (&Cache->Lock);
+      return FALSE;
+    }
+  }
+
+  for (Index = 0; Index < BlockCount; Index++) {
+    Entry      = DiskIoCacheLookup (Cache, Lba + Index);
+    CopyLength = MIN (Length, Cache->BlockSize - Offset);
+    CopyMem (Buffer, Entry->Data + Offset, CopyLength);
+    Buffer += CopyLength;
+    Length -= CopyLength;
+    Offset  = 0;
+
+    RemoveEntryList (&Entry->LruLink);
+    InsertHeadList (&Cache->LruList, &Entry->LruLink);
+  }
+
+  Cache->Hits++;
+  EfiReleaseLock (&Cache->Lock);
+  return TRUE;
+}
+
+/**
+  Insert blocks which were just read from the device into the block cache.
+
+  @param Instance    Pointer to the DISK_IO_PRIVATE_DATA.
+  @param MediaId     ID of the medium the data was read from.
+  @param Lba         The starting logical block address of the data.
+  @param Length      The number of bytes in Buffer, a multiple of block size.
+  @param Buffer      The block data.
+**/
+VOID
+DiskIoCacheFill (
+  IN DISK_IO_PRIVATE_DATA  *Instance,
+  IN UINT32                MediaId,
+  IN UINT64                Lba,
+  IN UINTN                 Length,
+  IN UINT8                 *Buffer
+  )
+{
+  DISK_IO_CACHE        *Cache;
+  DISK_IO_CACHE_ENTRY  *Entry;
+  UINTN                BlockCount;
+
+  Cache = Instance->Cache;
+  if (Cache == NULL) {
+    return;
+  }
+
+  //
+  // Bulk data transfers would only flush the metadata blocks out of the cache.
+  //
+  BlockCount = Length / Cache->BlockSize;
+  if ((BlockCount == 0) || (BlockCount > Cache->EntryCount / 4)) {
+    return;
+  }
+
+  EfiAcquireLock (&Cache->Lock);
+  DiskIoCacheCheckMedia (Instance, Cache);
+  if (MediaId != Cache->MediaId) {
+    EfiReleaseLock (&Cache->Lock);
+    return;
+  }
+
+  for ( ; BlockCount > 0; BlockCount--, Lba++, Buffer += Cache->BlockSize) {
+    Entry = DiskIoCacheLookup (Cache, Lba);
+    if (Entry == NULL) {
+      //
+      // Reuse the least recently used entry.
+      //
+      Entry = BASE_CR (GetPreviousNode (&Cache->LruList, &Cache->LruList), DISK_IO_CACHE_ENTRY, LruLink);
+      DiskIoCacheDropEntry (Cache, Entry);
+      Entry->Lba   = Lba;
+      Entry->Valid = TRUE;
+      InsertHeadList (&Cache->HashTable[Lba % DISK_IO_CACHE_HASH_SIZE], &Entry->HashLink);
+    }
+
+    CopyMem (Entry->Data, Buffer, Cache->BlockSize);
+    RemoveEntryList (&Entry->LruLink);
+    InsertHeadList (&Cache->LruList, &Entry->LruLink);
+  }
+
+  EfiReleaseLock (&Cache->Lock);
+}
+
+/**
+  Invalidate the cached blocks covered by a write request.
+
+  @param Instance    Pointer to the DISK_IO_PRIVATE_DATA.
+  @param Lba         The starting logical block address of the write.
+  @param Length      The number of bytes written.
+**/
+VOID
+DiskIoCacheInvalidate (
+  IN DISK_IO_PRIVATE_DATA  *Instance,
+  IN UINT64                Lba,
+  IN UINTN                 Length
+  )
+{
+  DISK_IO_CACHE        *Cache;
+  DISK_IO_CACHE_ENTRY  *Entry;
+  UINT64               BlockCount;
+  UINTN                Index;
+
+  Cache = Instance->Cache;
+  if (Cache == NULL) {
+    return;
+  }
+
+  BlockCount = DivU64x32 (Length + Cache->BlockSize - 1, Cache->BlockSize);
+  if (BlockCount == 0) {
+    BlockCount = 1;
+  }
+
+  EfiAcquireLock (&Cache->Lock);
+  if (BlockCount > Cache->EntryCount) {
+    //
+    // Walk the entries instead of the range for large writes.
+    //
+    for (Index = 0; Index < Cache->EntryCount; Index++) {
+      Entry = &Cache->Entries[Index];
+      if (Entry->Valid && (Entry->Lba >= Lba) && (Entry->Lba - Lba < BlockCount)) {
+        DiskIoCacheDropEntry (Cache, Entry);
+      }
+    }
+  } else {
+    for ( ; BlockCount > 0; BlockCount--, Lba++) {
+      Entry = DiskIoCacheLookup (Cache, Lba);
+      if (Entry != NULL) {
+        DiskIoCacheDropEntry (Cache, Entry);
+      }
+    }
+  }
+
+  EfiReleaseLock (&Cache->Lock);
+}
@@ -0,0 +1,382 @@
+/** @file
+  Asynchronous prefetch of the partition probe regions of the disks.
+
+  Partition drivers probe each disk in turn: the MBR, the primary and backup
+  GPT, and the El Torito/UDF volume descriptors all live in the first and the
+  last blocks of the media. Bus drivers usually install the Block I/O 2
+  protocols of all the disks behind a controller before any of the disks is
+  connected further. Issuing non-blocking reads of the probe regions as soon
+  as a Block I/O 2 protocol appears lets the reads of all the disks proceed
+  in parallel. When the DiskIo driver starts on the disk, it inserts the data
+  of the completed reads into the block cache, so that the subsequent probes
+  are served from memory. The regions whose read is still outstanding are
+  read synchronously when they are probed.
+
+Copyright (c) 2026, agent <agent@local>. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "DiskIo.h"
+
+LIST_ENTRY  mDiskIoPrefetchList = INITIALIZE_LIST_HEAD_VARIABLE (mDiskIoPrefetchList);
+VOID        *mDiskIoPrefetchRegistration;
+
+//
+// Protects mDiskIoPrefetchList against the completion of the prefetch reads.
+//
+EFI_LOCK  mDiskIoPrefetchLock = EFI_INITIALIZE_LOCK_VARIABLE (TPL_NOTIFY);
+
+/**
+  Free the prefetch record. All the reads of the record must be completed.
+
+  @param Prefetch    Pointer to the DISK_IO_PREFETCH.
+**/
+VOID
+DiskIoFreePrefetch (
+  IN DISK_IO_PREFETCH  *Prefetch
+  )
+{
+  UINTN                   Index;
+  DISK_IO_PREFETCH_RANGE  *Range;
+
+  for (Index = 0; Index < ARRAY_SIZE (Prefetch->Range); Index++) {
+    Range = &Prefetch->Range[Index];
+    if (Range->Buffer != NULL) {
+      FreeAlignedPages (Range->Buffer, EFI_SIZE_TO_PAGES (Range->Length));
+    }
+
+    if (Range->BlockIo2Token.Event != NULL) {
+      gBS->CloseEvent (Range->BlockIo2Token.Event);
+    }
+  }
+
+  FreePool (Prefetch);
+}
+
+/**
+  Check whether all the reads of the prefetch record are completed.
+
+  @param Prefetch    Pointer to the DISK_IO_PREFETCH.
+
+  @retval TRUE       All the reads are completed.
+  @retval FALSE      A read is still outstanding.
+**/
+BOOLEAN
+DiskIoPrefetchDone (
+  IN DISK_IO_PREFETCH  *Prefetch
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < ARRAY_SIZE (Prefetch->Range); Index++) {
+    if (!Prefetch->Range[Index].Done) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  The callback for the BlockIo2 ReadBlocksEx of a prefetch range.
+
+  The record is freed here if it became stale while the read was outstanding.
+
+  @param  Event                 Event whose notification function is being invoked.
+  @param  Context               The pointer to the notification function's context,
+                                which points to the DISK_IO_PREFETCH instance.
+**/
+VOID
+EFIAPI
+DiskIoOnPrefetchComplete (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  DISK_IO_PREFETCH  *Prefetch;
+  UINTN             Index;
+
+  Prefetch = (DISK_IO_PREFETCH *)Context;
+
+  EfiAcquireLock (&mDiskIoPrefetchLock);
+  for (Index = 0; Index < ARRAY_SIZE (Prefetch->Range); Index++) {
+    if (Prefetch->Range[Index].BlockIo2Token.Event == Event) {
+      Prefetch->Range[Index].Done = TRUE;
+    }
+  }
+
+  if (Prefetch->Stale && DiskIoPrefetchDone (Prefetch)) {
+    RemoveEntryList (&Prefetch->Link);
+    DiskIoFreePrefetch (Prefetch);
+  }
+
+  EfiReleaseLock (&mDiskIoPrefetchLock);
+}
+
+/**
+  Free the prefetch records of the disk, and the records of the disks whose
+  Block I/O 2 protocol was removed or reinstalled.
+
+  A record whose reads are still outstanding is only marked stale, because
+  the device may still write its buffers. It is freed once the reads are
+  completed.
+
+  @param Handle      The handle of the disk, or NULL.
+**/
+VOID
+DiskIoPrefetchRelease (
+  IN EFI_HANDLE  Handle OPTIONAL
+  )
+{
+  EFI_STATUS              Status;
+  LIST_ENTRY              *Link;
+  DISK_IO_PREFETCH        *Prefetch;
+  EFI_BLOCK_IO2_PROTOCOL  *BlockIo2;
+
+  EfiAcquireLock (&mDiskIoPrefetchLock);
+  for (Link = GetFirstNode (&mDiskIoPrefetchList); !IsNull (&mDiskIoPrefetchList, Link); ) {
+    Prefetch = BASE_CR (Link, DISK_IO_PREFETCH, Link);
+    Link     = GetNextNode (&mDiskIoPrefetchList, Link);
+
+    if (Prefetch->Handle == Handle) {
+      Prefetch->Stale = TRUE;
+    } else if (!Prefetch->Stale) {
+      Status = gBS->HandleProtocol (Prefetch->Handle, &gEfiBlockIo2ProtocolGuid, (VOID **)&BlockIo2);
+      if (EFI_ERROR (Status) || (BlockIo2 != Prefetch->BlockIo2)) {
+        Prefetch->Stale = TRUE;
+      }
+    }
+
+    if (Prefetch->Stale && DiskIoPrefetchDone (Prefetch)) {
+      RemoveEntryList (&Prefetch->Link);
+      DiskIoFreePrefetch (Prefetch);
+    }
+  }
+
+  EfiReleaseLock (&mDiskIoPrefetchLock);
+}
+
+/**
+  Issue the non-blocking read of one prefetch range.
+
+  @param Prefetch    Pointer to the DISK_IO_PREFETCH.
+  @param Range       The range to read.
+  @param Lba         The starting logical block address of the range.
+  @param BlockCount  The number of blocks in the range.
+**/
+VOID
+DiskIoIssuePrefetch (
+  IN DISK_IO_PREFETCH        *Prefetch,
+  IN DISK_IO_PREFETCH_RANGE  *Range,
+  IN EFI_LBA                 Lba,
+  IN UINTN                   BlockCount
+  )
+{
+  EFI_BLOCK_IO2_PROTOCOL  *BlockIo2;
+  EFI_STATUS              Status;
+
+  BlockIo2      = Prefetch->BlockIo2;
+  Range->Lba    = Lba;
+  Range->Length = BlockCount * BlockIo2->Media->BlockSize;
+  Range->Done   = TRUE;
+  if (BlockCount == 0) {
+    return;
+  }
+
+  Range->Buffer = AllocateAlignedPages (
+                    EFI_SIZE_TO_PAGES (Range->Length),
+                    MAX (BlockIo2->Media->IoAlign, 1)
+                    );
+  if (Range->Buffer == NULL) {
+    Range->BlockIo2Token.TransactionStatus = EFI_OUT_OF_RESOURCES;
+    return;
+  }
+
+  Status = gBS->CreateEvent (
+                  EVT_NOTIFY_SIGNAL,
+                  TPL_NOTIFY,
+                  DiskIoOnPrefetchComplete,
+                  Prefetch,
+                  &Range->BlockIo2Token.Event
+                  );
+  if (EFI_ERROR (Status)) {
+    Range->BlockIo2Token.TransactionStatus = Status;
+    return;
+  }
+
+  Range->Done = FALSE;
+  Status      = BlockIo2->ReadBlocksEx (
+                            BlockIo2,
+                            Prefetch->MediaId,
+                            Lba,
+                            &Range->BlockIo2Token,
+                            Range->Length,
+                            Range->Buffer
+                            );
+  if (EFI_ERROR (Status)) {
+    Range->BlockIo2Token.TransactionStatus = Status;
+    Range->Done                            = TRUE;
+  }
+}
+
+/**
+  Start prefetching the probe regions of the disks whose Block I/O 2 protocol
+  was just installed.
+
+  @param  Event                 Event whose notification function is being invoked.
+  @param  Context               The pointer to the notification function's context.
+**/
+VOID
+EFIAPI
+DiskIoOnBlockIo2Installed (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  EFI_STATUS              Status;
+  UINTN                   BufferSize;
+  EFI_HANDLE              Handle;
+  EFI_BLOCK_IO2_PROTOCOL  *BlockIo2;
+  EFI_BLOCK_IO_MEDIA      *Media;
+  DISK_IO_PREFETCH        *Prefetch;
+  UINTN                   BlockCount;
+  UINTN                   HeadBlocks;
+  UINTN                   TailBlocks;
+
+  while (TRUE) {
+    BufferSize = sizeof (EFI_HANDLE);
+    Status     = gBS->LocateHandle (
+                        ByRegisterNotify,
+                        NULL,
+                        mDiskIoPrefetchRegistration,
+                        &BufferSize,
+                        &Handle
+                        );
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    Status = gBS->HandleProtocol (Handle, &gEfiBlockIo2ProtocolGuid, (VOID **)&BlockIo2);
+    if (EFI_ERROR (Status)) {
+      continue;
+    }
+
+    Media = BlockIo2->Media;
+    if (Media->LogicalPartition || !Media->MediaPresent || (Media->BlockSize == 0)) {
+      continue;
+    }
+
+    //
+    // A reinstalled Block I/O 2 makes the data of an earlier prefetch stale.
+    //
+    DiskIoPrefetchRelease (Handle);
+
+    //
+    // Each range is filled into the block cache at once, so keep it within
+    // the limit of a single cache fill.
+    //
+    BlockCount = PcdGet32 (PcdDiskIoCacheBlockNum) / 4;
+    HeadBlocks = MIN (BlockCount, DISK_IO_PREFETCH_HEAD_SIZE / Media->BlockSize);
+    TailBlocks = MIN (BlockCount, DISK_IO_PREFETCH_TAIL_SIZE / Media->BlockSize);
+    if (Media->LastBlock + 1 <= HeadBlocks) {
+      HeadBlocks = (UINTN)Media->LastBlock + 1;
+      TailBlocks = 0;
+    } else if (Media->LastBlock + 1 - HeadBlocks < TailBlocks) {
+      TailBlocks = (UINTN)(Media->LastBlock + 1 - HeadBlocks);
+    }
+
+    if (HeadBlocks == 0) {
+      continue;
+    }
+
+    Prefetch = AllocateZeroPool (sizeof (DISK_IO_PREFETCH));
+    if (Prefetch == NULL) {
+      break;
+    }
+
+    Prefetch->Handle   = Handle;
+    Prefetch->BlockIo2 = BlockIo2;
+    Prefetch->MediaId  = Media->MediaId;
+    EfiAcquireLock (&mDiskIoPrefetchLock);
+    InsertTailList (&mDiskIoPrefetchList, &Prefetch->Link);
+    EfiReleaseLock (&mDiskIoPrefetchLock);
+
+    DEBUG ((DEBUG_BLKIO, "DiskIo: Prefetch %Lu/%Lu head/tail blocks of handle %p\n", (UINT64)HeadBlocks, (UINT64)TailBlocks, Handle));
+    DiskIoIssuePrefetch (Prefetch, &Prefetch->Range[0], 0, HeadBlocks);
+    DiskIoIssuePrefetch (Prefetch, &Prefetch->Range[1], Media->LastBlock + 1 - TailBlocks, TailBlocks);
+  }
+}
+
+/**
+  Register the notification that starts the probe region prefetch of the disks.
+
+  @retval EFI_SUCCESS    The notification is registered or the block cache is disabled.
+  @retval others         The notification cannot be registered.
+**/
+EFI_STATUS
+DiskIoPrefetchInitialize (
+  VOID
+  )
+{
+  EFI_EVENT  Event;
+
+  if (PcdGet32 (PcdDiskIoCacheBlockNum) == 0) {
+    return EFI_SUCCESS;
+  }
+
+  Event = EfiCreateProtocolNotifyEvent (
+            &gEfiBlockIo2ProtocolGuid,
+            TPL_CALLBACK,
+            DiskIoOnBlockIo2Installed,
+            NULL,
+            &mDiskIoPrefetchRegistration
+            );
+  return (Event == NULL) ? EFI_OUT_OF_RESOURCES : EFI_SUCCESS;
+}
+
+/**
+  Insert the prefetched probe regions of the disk into the block cache of the
+  Disk I/O instance, and drop the prefetch records of the disk.
+
+  The regions whose read is still outstanding are not waited for. They are
+  left out of the cache, so they are read synchronously when they are probed.
+
+  @param Instance    Pointer to the DISK_IO_PRIVATE_DATA.
+  @param Handle      The handle of the disk.
+**/
+VOID
+DiskIoPrefetchComplete (
+  IN DISK_IO_PRIVATE_DATA  *Instance,
+  IN EFI_HANDLE            Handle
+  )
+{
+  LIST_ENTRY              *Link;
+  DISK_IO_PREFETCH        *Prefetch;
+  DISK_IO_PREFETCH_RANGE  *Range;
+  UINTN                   Index;
+
+  EfiAcquireLock (&mDiskIoPrefetchLock);
+  for (Link = GetFirstNode (&mDiskIoPrefetchList); !IsNull (&mDiskIoPrefetchList, Link); Link = GetNextNode (&mDiskIoPrefetchList, Link)) {
+    Prefetch = BASE_CR (Link, DISK_IO_PREFETCH, Link);
+    if ((Prefetch->Handle != Handle) || Prefetch->Stale || (Prefetch->BlockIo2 != Instance->BlockIo2)) {
+      continue;
+    }
+
+    for (Index = 0; Index < ARRAY_SIZE (Prefetch->Range); Index++) {
+      Range = &Prefetch->Range[Index];
+      if (!Range->Done) {
+        DEBUG ((DEBUG_BLKIO, "DiskIo: Prefetch of LBA 0x%lx of handle %p is not completed yet\n", Range->Lba, Handle));
+        continue;
+      }
+
+      if ((Range->Buffer != NULL) && !EFI_ERROR (Range->BlockIo2Token.TransactionStatus)) {
+        DiskIoCacheFill (Instance, Prefetch->MediaId, Range->Lba, Range->Length, Range->Buffer);
+      }
+    }
+  }
+
+  EfiReleaseLock (&mDiskIoPrefetchLock);
+
+  DiskIoPrefetchRelease (Handle);
+}
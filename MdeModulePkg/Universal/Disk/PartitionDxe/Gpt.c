@@ -32,6 +32,8 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
   @param[in]  DiskIo      Disk Io protocol.
   @param[in]  Lba         The starting Lba of the Partition Table
   @param[out] PartHeader  Stores the partition table that is read
+  @param[out] PartEntry   Optional. Returns the partition entry array of a
+                          valid table, which the caller must free.
 
   @retval TRUE      The partition table is valid
   @retval FALSE     The partition table is not valid
@@ -42,16 +44,22 @@ PartitionValidGptTable (
   IN  EFI_BLOCK_IO_PROTOCOL       *BlockIo,
   IN  EFI_DISK_IO_PROTOCOL        *DiskIo,
   IN  EFI_LBA                     Lba,
-  OUT EFI_PARTITION_TABLE_HEADER  *PartHeader
+  OUT EFI_PARTITION_TABLE_HEADER  *PartHeader,
+  OUT VOID                        **PartEntry OPTIONAL
   );
 
 /**
   Check if the CRC field in the Partition table header is valid
   for Partition entry array.
 
-  @param[in]  BlockIo     Parent BlockIo interface
-  @param[in]  DiskIo      Disk Io Protocol.
-  @param[in]  PartHeader  Partition table header structure
+  @param[in]  BlockIo         Parent BlockIo interface
+  @param[in]  DiskIo          Disk Io Protocol.
+  @param[in]  PartHeader      Partition table header structure
+  @param[in]  Prefetched      Optional. The data following the header which
+                              was read together with it.
+  @param[in]  PrefetchedSize  The size of Prefetched in bytes.
+  @param[out] PartEntry       Optional. Returns the partition entry array if
+                              the CRC is valid, which the caller must free.
 
   @retval TRUE      the CRC is valid
   @retval FALSE     the CRC is invalid
@@ -61,7 +69,10 @@ BOOLEAN
 PartitionCheckGptEntryArrayCRC (
   IN  EFI_BLOCK_IO_PROTOCOL       *BlockIo,
   IN  EFI_DISK_IO_PROTOCOL        *DiskIo,
-  IN  EFI_PARTITION_TABLE_HEADER  *PartHeader
+  IN  EFI_PARTITION_TABLE_HEADER  *PartHeader,
+  IN  CONST UINT8                 *Prefetched OPTIONAL,
+  IN  UINTN                       PrefetchedSize,
+  OUT VOID                        **PartEntry OPTIONAL
   );
 
 /**
@@ -285,10 +296,10 @@ PartitionInstallGptChildHandles (
   //
   // Check primary and backup partition tables
   //
-  if (!PartitionValidGptTable (BlockIo, DiskIo, PRIMARY_PART_HEADER_LBA, PrimaryHeader)) {
+  if (!PartitionValidGptTable (BlockIo, DiskIo, PRIMARY_PART_HEADER_LBA, PrimaryHeader, (VOID **)&PartEntry)) {
     DEBUG ((DEBUG_INFO, " Not Valid primary partition table\n"));
 
-    if (!PartitionValidGptTable (BlockIo, DiskIo, LastBlock, BackupHeader)) {
+    if (!PartitionValidGptTable (BlockIo, DiskIo, LastBlock, BackupHeader, NULL)) {
       DEBUG ((DEBUG_INFO, " Not Valid backup partition table\n"));
       goto Done;
     } else {
@@ -298,18 +309,18 @@ PartitionInstallGptChildHandles (
         DEBUG ((DEBUG_INFO, " Restore primary partition table error\n"));
       }
 
-      if (PartitionValidGptTable (BlockIo, DiskIo, BackupHeader->AlternateLBA, PrimaryHeader)) {
+      if (PartitionValidGptTable (BlockIo, DiskIo, BackupHeader->AlternateLBA, PrimaryHeader, (VOID **)&PartEntry)) {
         DEBUG ((DEBUG_INFO, " Restore backup partition table success\n"));
       }
     }
-  } else if (!PartitionValidGptTable (BlockIo, DiskIo, PrimaryHeader->AlternateLBA, BackupHeader)) {
+  } else if (!PartitionValidGptTable (BlockIo, DiskIo, PrimaryHeader->AlternateLBA, BackupHeader, NULL)) {
     DEBUG ((DEBUG_INFO, " Valid primary and !Valid backup partition table\n"));
     DEBUG ((DEBUG_INFO, " Restore backup partition table by the primary\n"));
     if (!PartitionRestoreGptTable (BlockIo, DiskIo, PrimaryHeader)) {
       DEBUG ((DEBUG_INFO, " Restore backup partition table error\n"));
     }
 
-    if (PartitionValidGptTable (BlockIo, DiskIo, PrimaryHeader->AlternateLBA, BackupHeader)) {
+    if (PartitionValidGptTable (BlockIo, DiskIo, PrimaryHeader->AlternateLBA, BackupHeader, NULL)) {
       DEBUG ((DEBUG_INFO, " Restore backup partition table success\n"));
     }
   }
@@ -317,25 +328,28 @@ PartitionInstallGptChildHandles (
   DEBUG ((DEBUG_INFO, " Valid primary and Valid backup partition table\n"));
 
   //
-  // Read the EFI Partition Entries
+  // Read the EFI Partition Entries, unless they were already read when the
+  // primary partition table was validated.
   //
-  PartEntry = AllocatePool (PrimaryHeader->NumberOfPartitionEntries * PrimaryHeader->SizeOfPartitionEntry);
   if (PartEntry == NULL) {
-    DEBUG ((DEBUG_ERROR, "Allocate pool error\n"));
-    goto Done;
-  }
+    PartEntry = AllocatePool (PrimaryHeader->NumberOfPartitionEntries * PrimaryHeader->SizeOfPartitionEntry);
+    if (PartEntry == NULL) {
+      DEBUG ((DEBUG_ERROR, "Allocate pool error\n"));
+      goto Done;
+    }
 
-  Status = DiskIo->ReadDisk (
-                     DiskIo,
-                     MediaId,
-                     MultU64x32 (PrimaryHeader->PartitionEntryLBA, BlockSize),
-                     PrimaryHeader->NumberOfPartitionEntries * (PrimaryHeader->SizeOfPartitionEntry),
-                     PartEntry
-                     );
-  if (EFI_ERROR (Status)) {
-    GptValidStatus = Status;
-    DEBUG ((DEBUG_ERROR, " Partition Entry ReadDisk error\n"));
-    goto Done;
+    Status = DiskIo->ReadDisk (
+                       DiskIo,
+                       MediaId,
+                       MultU64x32 (PrimaryHeader->PartitionEntryLBA, BlockSize),
+                       PrimaryHeader->NumberOfPartitionEntries * (PrimaryHeader->SizeOfPartitionEntry),
+                       PartEntry
+                       );
+    if (EFI_ERROR (Status)) {
+      GptValidStatus = Status;
+      DEBUG ((DEBUG_ERROR, " Partition Entry ReadDisk error\n"));
+      goto Done;
+    }
   }
 
   DEBUG ((DEBUG_INFO, " Partition entries read block success\n"));
@@ -458,6 +472,8 @@ Done:
   @param[in]  DiskIo      Disk Io protocol.
   @param[in]  Lba         The starting Lba of the Partition Table
   @param[out] PartHeader  Stores the partition table that is read
+  @param[out] PartEntry   Optional. Returns the partition entry array of a
+                          valid table, which the caller must free.
 
   @retval TRUE      The partition table is valid
   @retval FALSE     The partition table is not valid
@@ -468,17 +484,31 @@ PartitionValidGptTable (
   IN  EFI_BLOCK_IO_PROTOCOL       *BlockIo,
   IN  EFI_DISK_IO_PROTOCOL        *DiskIo,
   IN  EFI_LBA                     Lba,
-  OUT EFI_PARTITION_TABLE_HEADER  *PartHeader
+  OUT EFI_PARTITION_TABLE_HEADER  *PartHeader,
+  OUT VOID                        **PartEntry OPTIONAL
   )
 {
   EFI_STATUS                  Status;
   UINT32                      BlockSize;
   EFI_PARTITION_TABLE_HEADER  *PartHdr;
   UINT32                      MediaId;
+  UINTN                       PrefetchSize;
 
   BlockSize = BlockIo->Media->BlockSize;
   MediaId   = BlockIo->Media->MediaId;
-  PartHdr   = AllocateZeroPool (BlockSize);
+
+  //
+  // The partition entry array of the primary table normally follows the
+  // header, so read the minimum sized array together with the header.
+  //
+  PrefetchSize = ALIGN_VALUE (PARTITION_GPT_ENTRY_ARRAY_PROBE_SIZE, BlockSize);
+  if ((Lba != PRIMARY_PART_HEADER_LBA) ||
+      (BlockIo->Media->LastBlock < Lba + PrefetchSize / BlockSize))
+  {
+    PrefetchSize = 0;
+  }
+
+  PartHdr = AllocateZeroPool (BlockSize + PrefetchSize);
 
   if (PartHdr == NULL) {
     DEBUG ((DEBUG_ERROR, "Allocate pool error\n"));
@@ -492,7 +522,7 @@ PartitionValidGptTable (
                      DiskIo,
                      MediaId,
                      MultU64x32 (Lba, BlockSize),
-                     BlockSize,
+                     BlockSize + PrefetchSize,
                      PartHdr
                      );
   if (EFI_ERROR (Status)) {
@@ -520,7 +550,7 @@ PartitionValidGptTable (
   }
 
   CopyMem (PartHeader, PartHdr, sizeof (EFI_PARTITION_TABLE_HEADER));
-  if (!PartitionCheckGptEntryArrayCRC (BlockIo, DiskIo, PartHeader)) {
+  if (!PartitionCheckGptEntryArrayCRC (BlockIo, DiskIo, PartHeader, (UINT8 *)PartHdr + BlockSize, PrefetchSize, PartEntry)) {
     FreePool (PartHdr);
     return FALSE;
   }
@@ -534,9 +564,14 @@ PartitionValidGptTable (
   Check if the CRC field in the Partition table header is valid
   for Partition entry array.
 
-  @param[in]  BlockIo     Parent BlockIo interface
-  @param[in]  DiskIo      Disk Io Protocol.
-  @param[in]  PartHeader  Partition table header structure
+  @param[in]  BlockIo         Parent BlockIo interface
+  @param[in]  DiskIo          Disk Io Protocol.
+  @param[in]  PartHeader      Partition table header structure
+  @param[in]  Prefetched      Optional. The data following the header which
+                              was read together with it.
+  @param[in]  PrefetchedSize  The size of Prefetched in bytes.
+  @param[out] PartEntry       Optional. Returns the partition entry array if
+                              the CRC is valid, which the caller must free.
 
   @retval TRUE      the CRC is valid
   @retval FALSE     the CRC is invalid
@@ -546,7 +581,10 @@ BOOLEAN
 PartitionCheckGptEntryArrayCRC (
   IN  EFI_BLOCK_IO_PROTOCOL       *BlockIo,
   IN  EFI_DISK_IO_PROTOCOL        *DiskIo,
-  IN  EFI_PARTITION_TABLE_HEADER  *PartHeader
+  IN  EFI_PARTITION_TABLE_HEADER  *PartHeader,
+  IN  CONST UINT8                 *Prefetched OPTIONAL,
+  IN  UINTN                       PrefetchedSize,
+  OUT VOID                        **PartEntry OPTIONAL
   )
 {
   EFI_STATUS  Status;
@@ -554,39 +592,59 @@ PartitionCheckGptEntryArrayCRC (
   UINT32      Crc;
   UINTN       Size;
 
-  //
-  // Read the EFI Partition Entries
-  //
-  Ptr = AllocatePool (PartHeader->NumberOfPartitionEntries * PartHeader->SizeOfPartitionEntry);
-  if (Ptr == NULL) {
-    DEBUG ((DEBUG_ERROR, " Allocate pool error\n"));
-    return FALSE;
-  }
+  Size = PartHeader->NumberOfPartitionEntries * PartHeader->SizeOfPartitionEntry;
 
-  Status = DiskIo->ReadDisk (
-                     DiskIo,
-                     BlockIo->Media->MediaId,
-                     MultU64x32 (PartHeader->PartitionEntryLBA, BlockIo->Media->BlockSize),
-                     PartHeader->NumberOfPartitionEntries * PartHeader->SizeOfPartitionEntry,
-                     Ptr
-                     );
-  if (EFI_ERROR (Status)) {
-    FreePool (Ptr);
-    return FALSE;
-  }
+  if ((Prefetched != NULL) && (PartHeader->PartitionEntryLBA == PartHeader->MyLBA + 1) &&
+      (Size <= PrefetchedSize))
+  {
+    //
+    // The EFI Partition Entries were read together with the header
+    //
+    Ptr = AllocateCopyPool (Size, Prefetched);
+    if (Ptr == NULL) {
+      DEBUG ((DEBUG_ERROR, " Allocate pool error\n"));
+      return FALSE;
+    }
+  } else {
+    //
+    // Read the EFI Partition Entries
+    //
+    Ptr = AllocatePool (Size);
+    if (Ptr == NULL) {
+      DEBUG ((DEBUG_ERROR, " Allocate pool error\n"));
+      return FALSE;
+    }
 
-  Size = PartHeader->NumberOfPartitionEntries * PartHeader->SizeOfPartitionEntry;
+    Status = DiskIo->ReadDisk (
+                       DiskIo,
+                       BlockIo->Media->MediaId,
+                       MultU64x32 (PartHeader->PartitionEntryLBA, BlockIo->Media->BlockSize),
+                       Size,
+                       Ptr
+                       );
+    if (EFI_ERROR (Status)) {
+      FreePool (Ptr);
+      return FALSE;
+    }
+  }
 
   Status = gBS->CalculateCrc32 (Ptr, Size, &Crc);
-  if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "CheckPEntryArrayCRC: Crc calculation failed\n"));
+  if (EFI_ERROR (Status) || (PartHeader->PartitionEntryArrayCRC32 != Crc)) {
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_ERROR, "CheckPEntryArrayCRC: Crc calculation failed\n"));
+    }
+
     FreePool (Ptr);
     return FALSE;
   }
 
-  FreePool (Ptr);
+  if (PartEntry != NULL) {
+    *PartEntry = Ptr;
+  } else {
+    FreePool (Ptr);
+  }
 
-  return (BOOLEAN)(PartHeader->PartitionEntryArrayCRC32 == Crc);
+  return TRUE;
 }
 
 /**
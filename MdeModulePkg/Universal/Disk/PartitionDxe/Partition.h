@@ -36,6 +36,14 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <IndustryStandard/ElTorito.h>
 #include <IndustryStandard/Udf.h>
 
+//
+// The minimum size of the GPT partition entry array required by the UEFI
+// specification. This much data following the primary GPT header is read
+// together with the header, so that the usual layout with the entry array
+// starting at LBA 2 is validated with a single disk read.
+//
+#define PARTITION_GPT_ENTRY_ARRAY_PROBE_SIZE  SIZE_16KB
+
 //
 // Partition private data
 //
@@ -137,6 +137,7 @@ RamDiskBlkIoReadBlocks (
 {
   RAM_DISK_PRIVATE_DATA  *PrivateData;
   UINTN                  NumberOfBlocks;
+  EFI_STATUS             Status;
 
   PrivateData = RAM_DISK_PRIVATE_FROM_BLKIO (This);
 
@@ -165,6 +166,17 @@ RamDiskBlkIoReadBlocks (
     return EFI_INVALID_PARAMETER;
   }
 
+  if (PrivateData->Sparse != NULL) {
+    Status = RamDiskSparseFillRange (
+               PrivateData,
+               MultU64x32 (Lba, PrivateData->Media.BlockSize),
+               BufferSize
+               );
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
+
   CopyMem (
     Buffer,
     (VOID *)(UINTN)(PrivateData->StartingAddr + MultU64x32 (Lba, PrivateData->Media.BlockSize)),
@@ -211,6 +223,7 @@ RamDiskBlkIoWriteBlocks (
 {
   RAM_DISK_PRIVATE_DATA  *PrivateData;
   UINTN                  NumberOfBlocks;
+  EFI_STATUS             Status;
 
   PrivateData = RAM_DISK_PRIVATE_FROM_BLKIO (This);
 
@@ -243,6 +256,20 @@ RamDiskBlkIoWriteBlocks (
     return EFI_INVALID_PARAMETER;
   }
 
+  //
+  // Fill the chunks first, so that the parts of them not written are kept.
+  //
+  if (PrivateData->Sparse != NULL) {
+    Status = RamDiskSparseFillRange (
+               PrivateData,
+               MultU64x32 (Lba, PrivateData->Media.BlockSize),
+               BufferSize
+               );
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
+
   CopyMem (
     (VOID *)(UINTN)(PrivateData->StartingAddr + MultU64x32 (Lba, PrivateData->Media.BlockSize)),
     Buffer,
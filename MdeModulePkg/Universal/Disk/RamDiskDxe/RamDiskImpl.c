@@ -179,6 +179,8 @@ UnregisterAllRamDisks (
 
       RemoveEntryList (&PrivateData->ThisInstance);
 
+      RamDiskSparseDestroy (PrivateData);
+
       if (RamDiskCreateHii == PrivateData->CreateMethod) {
         //
         // If a RAM disk is created within HII, then the RamDiskDxe driver
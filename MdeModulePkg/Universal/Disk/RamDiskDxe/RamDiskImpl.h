@@ -26,6 +26,7 @@
 #include <Library/PcdLib.h>
 #include <Library/DxeServicesLib.h>
 #include <Protocol/RamDisk.h>
+#include <Protocol/SparseRamDisk.h>
 #include <Protocol/BlockIo.h>
 #include <Protocol/BlockIo2.h>
 #include <Protocol/HiiConfigAccess.h>
@@ -35,6 +36,7 @@
 #include <Guid/MdeModuleHii.h>
 #include <Guid/RamDiskHii.h>
 #include <Guid/FileInfo.h>
+#include <Guid/EventGroup.h>
 #include <IndustryStandard/Acpi61.h>
 
 #include "RamDiskNVData.h"
@@ -48,6 +50,12 @@
 //
 #define RAM_DISK_DEFAULT_BLOCK_SIZE  512
 
+//
+// Interval of the timer filling a sparse RAM disk in the background. Each
+// tick goes on with the current chunk without waiting for the producer.
+//
+#define RAM_DISK_SPARSE_FILL_INTERVAL  EFI_TIMER_PERIOD_MILLISECONDS (1)
+
 //
 // RamDiskDxe driver maintains a list of registered RAM disks.
 //
@@ -67,6 +75,38 @@ typedef enum _RAM_DISK_CREATE_METHOD {
   RamDiskCreateHii
 } RAM_DISK_CREATE_METHOD;
 
+//
+// The state of a sparse RAM disk, whose content is filled one chunk at a time
+// by the producer of the RAM disk.
+//
+typedef struct {
+  EDKII_SPARSE_RAM_DISK_FILL        Fill;
+  EDKII_SPARSE_RAM_DISK_COMPLETE    Complete;
+  VOID                              *Context;
+
+  UINT32                            ChunkSize;
+  UINTN                             ChunkCount;
+  UINTN                             FilledCount;
+  UINTN                             NextChunk;      // Next chunk to fill in the background.
+  UINT8                             *Bitmap;        // One bit per chunk, set once it is filled.
+
+  EFI_EVENT                         FillTimer;
+  EFI_EVENT                         ExitBootServicesEvent;
+  BOOLEAN                           Completed;      // No chunk is filled any more.
+
+  //
+  // The chunk the background fill started to fill without waiting, which is
+  // finished before any other chunk is filled.
+  //
+  BOOLEAN                           Pending;
+  UINTN                             PendingChunk;
+
+  //
+  // Signaled to unregister the RAM disk once a chunk could not be filled.
+  //
+  EFI_EVENT                         UnregisterEvent;
+} RAM_DISK_SPARSE_DATA;
+
 //
 // RamDiskDxe driver maintains a list of registered RAM disks.
 // The struct contains the list entry and the information of each RAM
@@ -91,6 +131,8 @@ typedef struct {
   EFI_QUESTION_ID             CheckBoxId;
   BOOLEAN                     CheckBoxChecked;
 
+  RAM_DISK_SPARSE_DATA        *Sparse;              // NULL unless the RAM disk is sparse.
+
   LIST_ENTRY                  ThisInstance;
 } RAM_DISK_PRIVATE_DATA;
 
@@ -190,6 +232,110 @@ RamDiskUnregister (
   IN  EFI_DEVICE_PATH_PROTOCOL  *DevicePath
   );
 
+/**
+  Register a sparse RAM disk with specified address, size and type.
+
+  @param[in]  RamDiskBase    The base address of registered RAM disk.
+  @param[in]  RamDiskSize    The size of registered RAM disk.
+  @param[in]  RamDiskType    The type of registered RAM disk.
+  @param[in]  ParentDevicePath
+                             Pointer to the parent device path. If there is no
+                             parent device path then ParentDevicePath is NULL.
+  @param[in]  ChunkSize      The size of the parts the RAM disk is filled in.
+  @param[in]  Fill           The function filling a part of the RAM disk.
+  @param[in]  Complete       The function notified when the content of the
+                             RAM disk is not needed any more. Optional.
+  @param[in]  Context        The context passed to Fill and Complete.
+  @param[out] DevicePath     On return, points to a pointer to the device path
+                             of the RAM disk device.
+
+  @retval EFI_SUCCESS             The RAM disk is registered successfully.
+  @retval EFI_INVALID_PARAMETER   DevicePath, RamDiskType or Fill is NULL.
+                                  RamDiskSize or ChunkSize is 0.
+  @retval EFI_ALREADY_STARTED     A Device Path Protocol instance to be created
+                                  is already present in the handle database.
+  @retval EFI_OUT_OF_RESOURCES    The RAM disk register operation fails due to
+                                  resource limitation.
+
+**/
+EFI_STATUS
+EFIAPI
+RamDiskRegisterSparse (
+  IN  UINT64                          RamDiskBase,
+  IN  UINT64                          RamDiskSize,
+  IN  EFI_GUID                        *RamDiskType,
+  IN  EFI_DEVICE_PATH                 *ParentDevicePath     OPTIONAL,
+  IN  UINT32                          ChunkSize,
+  IN  EDKII_SPARSE_RAM_DISK_FILL      Fill,
+  IN  EDKII_SPARSE_RAM_DISK_COMPLETE  Complete              OPTIONAL,
+  IN  VOID                            *Context,
+  OUT EFI_DEVICE_PATH_PROTOCOL        **DevicePath
+  );
+
+/**
+  Create the state of a sparse RAM disk.
+
+  @param[in] PrivateData     Points to RAM disk private data.
+  @param[in] ChunkSize       The size of the parts the RAM disk is filled in.
+  @param[in] Fill            The function filling a part of the RAM disk.
+  @param[in] Complete        The function notified when the content of the
+                             RAM disk is not needed any more. Optional.
+  @param[in] Context         The context passed to Fill and Complete.
+
+  @retval EFI_SUCCESS             The state is created.
+  @retval EFI_OUT_OF_RESOURCES    Failed to allocate the state.
+
+**/
+EFI_STATUS
+RamDiskSparseCreate (
+  IN RAM_DISK_PRIVATE_DATA           *PrivateData,
+  IN UINT32                          ChunkSize,
+  IN EDKII_SPARSE_RAM_DISK_FILL      Fill,
+  IN EDKII_SPARSE_RAM_DISK_COMPLETE  Complete OPTIONAL,
+  IN VOID                            *Context
+  );
+
+/**
+  Start filling a sparse RAM disk in the background.
+
+  @param[in] PrivateData     Points to RAM disk private data.
+
+**/
+VOID
+RamDiskSparseStart (
+  IN RAM_DISK_PRIVATE_DATA  *PrivateData
+  );
+
+/**
+  Destroy the state of a sparse RAM disk, notifying its producer first if
+  the RAM disk is not filled yet.
+
+  @param[in] PrivateData     Points to RAM disk private data.
+
+**/
+VOID
+RamDiskSparseDestroy (
+  IN RAM_DISK_PRIVATE_DATA  *PrivateData
+  );
+
+/**
+  Make sure the given range of a sparse RAM disk is filled.
+
+  @param[in] PrivateData     Points to RAM disk private data.
+  @param[in] Offset          The offset of the range in the RAM disk.
+  @param[in] Length          The size of the range in bytes.
+
+  @retval EFI_SUCCESS             The range is filled.
+  @retval EFI_DEVICE_ERROR        A chunk of the range could not be filled.
+
+**/
+EFI_STATUS
+RamDiskSparseFillRange (
+  IN RAM_DISK_PRIVATE_DATA  *PrivateData,
+  IN UINT64                 Offset,
+  IN UINTN                  Length
+  );
+
 /**
   Initialize the BlockIO protocol of a RAM disk device.
 
@@ -599,4 +745,19 @@ RamDiskPublishNfit (
   IN RAM_DISK_PRIVATE_DATA  *PrivateData
   );
 
+/**
+  Unpublish the RAM disk NVDIMM Firmware Interface Table (NFIT) from the
+  ACPI table.
+
+  @param[in] PrivateData          Points to RAM disk private data.
+
+  @retval EFI_SUCCESS             The RAM disk NFIT has been unpublished.
+  @retval others                  The RAM disk NFIT has not been unpublished.
+
+**/
+EFI_STATUS
+RamDiskUnpublishNfit (
+  IN RAM_DISK_PRIVATE_DATA  *PrivateData
+  );
+
 #endif
@@ -559,25 +559,24 @@ RamDiskUnpublishNfit (
 }
 
 /**
-  Register a RAM disk with specified address, size and type.
+  Register a RAM disk with specified address, size and type, which is sparse
+  if Fill is not NULL.
 
   @param[in]  RamDiskBase    The base address of registered RAM disk.
   @param[in]  RamDiskSize    The size of registered RAM disk.
-  @param[in]  RamDiskType    The type of registered RAM disk. The GUID can be
-                             any of the values defined in section 9.3.6.9, or a
-                             vendor defined GUID.
+  @param[in]  RamDiskType    The type of registered RAM disk.
   @param[in]  ParentDevicePath
                              Pointer to the parent device path. If there is no
                              parent device path then ParentDevicePath is NULL.
+  @param[in]  ChunkSize      The size of the parts a sparse RAM disk is filled
+                             in.
+  @param[in]  Fill           The function filling a part of a sparse RAM disk,
+                             or NULL.
+  @param[in]  Complete       The function notified when the content of a
+                             sparse RAM disk is not needed any more. Optional.
+  @param[in]  Context        The context passed to Fill and Complete.
   @param[out] DevicePath     On return, points to a pointer to the device path
                              of the RAM disk device.
-                             If ParentDevicePath is not NULL, the returned
-                             DevicePath is created by appending a RAM disk node
-                             to the parent device path. If ParentDevicePath is
-                             NULL, the returned DevicePath is a RAM disk device
-                             path without appending. This function is
-                             responsible for allocating the buffer DevicePath
-                             with the boot service AllocatePool().
 
   @retval EFI_SUCCESS             The RAM disk is registered successfully.
   @retval EFI_INVALID_PARAMETER   DevicePath or RamDiskType is NULL.
@@ -589,13 +588,16 @@ RamDiskUnpublishNfit (
 
 **/
 EFI_STATUS
-EFIAPI
-RamDiskRegister (
-  IN UINT64                     RamDiskBase,
-  IN UINT64                     RamDiskSize,
-  IN EFI_GUID                   *RamDiskType,
-  IN EFI_DEVICE_PATH            *ParentDevicePath     OPTIONAL,
-  OUT EFI_DEVICE_PATH_PROTOCOL  **DevicePath
+RamDiskRegisterInstance (
+  IN  UINT64                          RamDiskBase,
+  IN  UINT64                          RamDiskSize,
+  IN  EFI_GUID                        *RamDiskType,
+  IN  EFI_DEVICE_PATH                 *ParentDevicePath     OPTIONAL,
+  IN  UINT32                          ChunkSize,
+  IN  EDKII_SPARSE_RAM_DISK_FILL      Fill                  OPTIONAL,
+  IN  EDKII_SPARSE_RAM_DISK_COMPLETE  Complete              OPTIONAL,
+  IN  VOID                            *Context              OPTIONAL,
+  OUT EFI_DEVICE_PATH_PROTOCOL        **DevicePath
   )
 {
   EFI_STATUS                  Status;
@@ -693,6 +695,17 @@ RamDiskRegister (
   //
   RamDiskInitBlockIo (PrivateData);
 
+  //
+  // The content of a sparse RAM disk is filled as soon as the Block IO
+  // protocols are used.
+  //
+  if (Fill != NULL) {
+    Status = RamDiskSparseCreate (PrivateData, ChunkSize, Fill, Complete, Context);
+    if (EFI_ERROR (Status)) {
+      goto ErrorExit;
+    }
+  }
+
   //
   // Install EFI_DEVICE_PATH_PROTOCOL & EFI_BLOCK_IO(2)_PROTOCOL on a new
   // handle
@@ -716,6 +729,10 @@ RamDiskRegister (
   //
   InsertTailList (&RegisteredRamDisks, &PrivateData->ThisInstance);
 
+  if (PrivateData->Sparse != NULL) {
+    RamDiskSparseStart (PrivateData);
+  }
+
   gBS->ConnectController (PrivateData->Handle, NULL, NULL, TRUE);
 
   FreePool (RamDiskDevNode);
@@ -732,6 +749,14 @@ ErrorExit:
   }
 
   if (PrivateData != NULL) {
+    if (PrivateData->Sparse != NULL) {
+      //
+      // The producer is not notified, as the RAM disk is not registered.
+      //
+      PrivateData->Sparse->Completed = TRUE;
+      RamDiskSparseDestroy (PrivateData);
+    }
+
     if (PrivateData->DevicePath) {
       FreePool (PrivateData->DevicePath);
     }
@@ -742,6 +767,116 @@ ErrorExit:
   return Status;
 }
 
+/**
+  Register a RAM disk with specified address, size and type.
+
+  @param[in]  RamDiskBase    The base address of registered RAM disk.
+  @param[in]  RamDiskSize    The size of registered RAM disk.
+  @param[in]  RamDiskType    The type of registered RAM disk. The GUID can be
+                             any of the values defined in section 9.3.6.9, or a
+                             vendor defined GUID.
+  @param[in]  ParentDevicePath
+                             Pointer to the parent device path. If there is no
+                             parent device path then ParentDevicePath is NULL.
+  @param[out] DevicePath     On return, points to a pointer to the device path
+                             of the RAM disk device.
+                             If ParentDevicePath is not NULL, the returned
+                             DevicePath is created by appending a RAM disk node
+                             to the parent device path. If ParentDevicePath is
+                             NULL, the returned DevicePath is a RAM disk device
+                             path without appending. This function is
+                             responsible for allocating the buffer DevicePath
+                             with the boot service AllocatePool().
+
+  @retval EFI_SUCCESS             The RAM disk is registered successfully.
+  @retval EFI_INVALID_PARAMETER   DevicePath or RamDiskType is NULL.
+                                  RamDiskSize is 0.
+  @retval EFI_ALREADY_STARTED     A Device Path Protocol instance to be created
+                                  is already present in the handle database.
+  @retval EFI_OUT_OF_RESOURCES    The RAM disk register operation fails due to
+                                  resource limitation.
+
+**/
+EFI_STATUS
+EFIAPI
+RamDiskRegister (
+  IN UINT64                     RamDiskBase,
+  IN UINT64                     RamDiskSize,
+  IN EFI_GUID                   *RamDiskType,
+  IN EFI_DEVICE_PATH            *ParentDevicePath     OPTIONAL,
+  OUT EFI_DEVICE_PATH_PROTOCOL  **DevicePath
+  )
+{
+  return RamDiskRegisterInstance (
+           RamDiskBase,
+           RamDiskSize,
+           RamDiskType,
+           ParentDevicePath,
+           0,
+           NULL,
+           NULL,
+           NULL,
+           DevicePath
+           );
+}
+
+/**
+  Register a sparse RAM disk with specified address, size and type.
+
+  @param[in]  RamDiskBase    The base address of registered RAM disk.
+  @param[in]  RamDiskSize    The size of registered RAM disk.
+  @param[in]  RamDiskType    The type of registered RAM disk.
+  @param[in]  ParentDevicePath
+                             Pointer to the parent device path. If there is no
+                             parent device path then ParentDevicePath is NULL.
+  @param[in]  ChunkSize      The size of the parts the RAM disk is filled in.
+  @param[in]  Fill           The function filling a part of the RAM disk.
+  @param[in]  Complete       The function notified when the content of the
+                             RAM disk is not needed any more. Optional.
+  @param[in]  Context        The context passed to Fill and Complete.
+  @param[out] DevicePath     On return, points to a pointer to the device path
+                             of the RAM disk device.
+
+  @retval EFI_SUCCESS             The RAM disk is registered successfully.
+  @retval EFI_INVALID_PARAMETER   DevicePath, RamDiskType or Fill is NULL.
+                                  RamDiskSize or ChunkSize is 0.
+  @retval EFI_ALREADY_STARTED     A Device Path Protocol instance to be created
+                                  is already present in the handle database.
+  @retval EFI_OUT_OF_RESOURCES    The RAM disk register operation fails due to
+                                  resource limitation.
+
+**/
+EFI_STATUS
+EFIAPI
+RamDiskRegisterSparse (
+  IN  UINT64                          RamDiskBase,
+  IN  UINT64                          RamDiskSize,
+  IN  EFI_GUID                        *RamDiskType,
+  IN  EFI_DEVICE_PATH                 *ParentDevicePath     OPTIONAL,
+  IN  UINT32                          ChunkSize,
+  IN  EDKII_SPARSE_RAM_DISK_FILL      Fill,
+  IN  EDKII_SPARSE_RAM_DISK_COMPLETE  Complete              OPTIONAL,
+  IN  VOID                            *Context,
+  OUT EFI_DEVICE_PATH_PROTOCOL        **DevicePath
+  )
+{
+  if ((0 == ChunkSize) || (NULL == Fill)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  return RamDiskRegisterInstance (
+           RamDiskBase,
+           RamDiskSize,
+           RamDiskType,
+           ParentDevicePath,
+           ChunkSize,
+           Fill,
+           Complete,
+           Context,
+           DevicePath
+           );
+}
+
 /**
   Unregister a RAM disk specified by DevicePath.
 
@@ -839,6 +974,8 @@ RamDiskUnregister (
 
         RemoveEntryList (&PrivateData->ThisInstance);
 
+        RamDiskSparseDestroy (PrivateData);
+
         if (RamDiskCreateHii == PrivateData->CreateMethod) {
           //
           // If a RAM disk is created within HII, then the RamDiskDxe driver
@@ -0,0 +1,440 @@
+/** @file
+  Fill the content of a sparse RAM disk on demand and in the background.
+
+  Copyright (c) 2026, agent <agent@local>. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "RamDiskImpl.h"
+
+#define RAM_DISK_SPARSE_CHUNK_FILLED(Sparse, Index) \
+  (((Sparse)->Bitmap[(Index) / 8] & (1 << ((Index) % 8))) != 0)
+
+/**
+  Stop filling a sparse RAM disk and notify its producer.
+
+  @param[in] PrivateData     Points to RAM disk private data.
+  @param[in] Status          The status reported to the producer.
+
+**/
+VOID
+RamDiskSparseFinish (
+  IN RAM_DISK_PRIVATE_DATA  *PrivateData,
+  IN EFI_STATUS             Status
+  )
+{
+  RAM_DISK_SPARSE_DATA  *Sparse;
+
+  Sparse = PrivateData->Sparse;
+  if (Sparse->Completed) {
+    return;
+  }
+
+  Sparse->Completed = TRUE;
+  gBS->SetTimer (Sparse->FillTimer, TimerCancel, 0);
+
+  if (Sparse->Complete != NULL) {
+    Sparse->Complete (Sparse->Context, Status);
+  }
+}
+
+/**
+  Stop filling a sparse RAM disk a chunk of which could not be filled, and
+  unregister it.
+
+  The RAM disk is removed from the NFIT at once. It is unregistered from a
+  separate event, as its Block IO protocols may be in use by the caller.
+
+  @param[in] PrivateData     Points to RAM disk private data.
+  @param[in] Status          The error returned by the producer.
+
+**/
+VOID
+RamDiskSparseFail (
+  IN RAM_DISK_PRIVATE_DATA  *PrivateData,
+  IN EFI_STATUS             Status
+  )
+{
+  RamDiskSparseFinish (PrivateData, Status);
+
+  if (PrivateData->InNfit) {
+    RamDiskUnpublishNfit (PrivateData);
+    PrivateData->InNfit = FALSE;
+  }
+
+  gBS->SignalEvent (PrivateData->Sparse->UnregisterEvent);
+}
+
+/**
+  Unregister a sparse RAM disk a chunk of which could not be filled.
+
+  @param[in] Event      Event whose notification function is being invoked.
+  @param[in] Context    Points to RAM disk private data.
+
+**/
+VOID
+EFIAPI
+RamDiskSparseUnregisterNotify (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  RAM_DISK_PRIVATE_DATA  *PrivateData;
+
+  PrivateData = (RAM_DISK_PRIVATE_DATA *)Context;
+
+  DEBUG ((DEBUG_ERROR, "%a: Unregister the RAM disk at 0x%lx\n", __func__, PrivateData->StartingAddr));
+  RamDiskUnregister ((EFI_DEVICE_PATH_PROTOCOL *)PrivateData->DevicePath);
+}
+
+/**
+  Fill a chunk of a sparse RAM disk if it is not filled yet.
+
+  The caller must be at TPL_CALLBACK, so that the chunks are filled one at a
+  time. A chunk the background fill started to fill is finished first.
+
+  @param[in] PrivateData     Points to RAM disk private data.
+  @param[in] Index           The index of the chunk.
+  @param[in] Wait            Whether to wait until the chunk is filled.
+
+  @retval EFI_SUCCESS             The chunk is filled.
+  @retval EFI_NOT_READY           Wait is FALSE, and the chunk is not filled yet.
+  @retval EFI_DEVICE_ERROR        The chunk could not be filled.
+
+**/
+EFI_STATUS
+RamDiskSparseFillChunk (
+  IN RAM_DISK_PRIVATE_DATA  *PrivateData,
+  IN UINTN                  Index,
+  IN BOOLEAN                Wait
+  )
+{
+  RAM_DISK_SPARSE_DATA  *Sparse;
+  UINT64                Offset;
+  UINTN                 Length;
+  EFI_STATUS            Status;
+
+  Sparse = PrivateData->Sparse;
+  if (RAM_DISK_SPARSE_CHUNK_FILLED (Sparse, Index)) {
+    return EFI_SUCCESS;
+  }
+
+  if (Sparse->Completed) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  if (Sparse->Pending && (Sparse->PendingChunk != Index)) {
+    ASSERT (Wait);
+    Status = RamDiskSparseFillChunk (PrivateData, Sparse->PendingChunk, TRUE);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
+
+  Offset = MultU64x32 (Index, Sparse->ChunkSize);
+  Length = (UINTN)MIN (Sparse->ChunkSize, PrivateData->Size - Offset);
+  Status = Sparse->Fill (
+                     Sparse->Context,
+                     Offset,
+                     Length,
+                     (VOID *)(UINTN)(PrivateData->StartingAddr + Offset),
+                     Wait
+                     );
+  if (Status == EFI_NOT_READY) {
+    ASSERT (!Wait);
+    Sparse->Pending      = TRUE;
+    Sparse->PendingChunk = Index;
+    return EFI_NOT_READY;
+  }
+
+  Sparse->Pending = FALSE;
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: Failed to fill the RAM disk at 0x%lx - %r\n", __func__, Offset, Status));
+    RamDiskSparseFail (PrivateData, Status);
+    return EFI_DEVICE_ERROR;
+  }
+
+  Sparse->Bitmap[Index / 8] |= (UINT8)(1 << (Index % 8));
+  Sparse->FilledCount++;
+  if (Sparse->FilledCount == Sparse->ChunkCount) {
+    RamDiskSparseFinish (PrivateData, EFI_SUCCESS);
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Go on filling the next chunk of a sparse RAM disk not filled yet, without
+  waiting for the producer.
+
+  @param[in] Event      Event whose notification function is being invoked.
+  @param[in] Context    Points to RAM disk private data.
+
+**/
+VOID
+EFIAPI
+RamDiskSparseFillNotify (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  RAM_DISK_PRIVATE_DATA  *PrivateData;
+  RAM_DISK_SPARSE_DATA   *Sparse;
+
+  PrivateData = (RAM_DISK_PRIVATE_DATA *)Context;
+  Sparse      = PrivateData->Sparse;
+
+  if (Sparse->Pending) {
+    RamDiskSparseFillChunk (PrivateData, Sparse->PendingChunk, FALSE);
+    return;
+  }
+
+  //
+  // Skip the chunks already filled on demand.
+  //
+  while (!Sparse->Completed && (Sparse->NextChunk < Sparse->ChunkCount)) {
+    if (!RAM_DISK_SPARSE_CHUNK_FILLED (Sparse, Sparse->NextChunk)) {
+      RamDiskSparseFillChunk (PrivateData, Sparse->NextChunk, FALSE);
+      break;
+    }
+
+    Sparse->NextChunk++;
+  }
+}
+
+/**
+  Stop filling a sparse RAM disk when the boot services are exited. The
+  producer cannot do any I/O any more, so a RAM disk not filled yet is removed
+  from the NFIT, and the OS does not find it.
+
+  @param[in] Event      Event whose notification function is being invoked.
+  @param[in] Context    Points to RAM disk private data.
+
+**/
+VOID
+EFIAPI
+RamDiskSparseExitBootServicesNotify (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  RAM_DISK_PRIVATE_DATA  *PrivateData;
+  RAM_DISK_SPARSE_DATA   *Sparse;
+
+  PrivateData = (RAM_DISK_PRIVATE_DATA *)Context;
+  Sparse      = PrivateData->Sparse;
+
+  //
+  // Neither the fill function nor the complete function is called after this.
+  //
+  Sparse->Completed = TRUE;
+  gBS->SetTimer (Sparse->FillTimer, TimerCancel, 0);
+
+  if (Sparse->FilledCount != Sparse->ChunkCount) {
+    DEBUG ((
+      DEBUG_ERROR,
+      "%a: The RAM disk at 0x%lx is incomplete, %Lu of %Lu chunks are filled, remove it from the NFIT\n",
+      __func__,
+      PrivateData->StartingAddr,
+      (UINT64)Sparse->FilledCount,
+      (UINT64)Sparse->ChunkCount
+      ));
+
+    if (PrivateData->InNfit) {
+      RamDiskUnpublishNfit (PrivateData);
+      PrivateData->InNfit = FALSE;
+    }
+  }
+}
+
+/**
+  Create the state of a sparse RAM disk.
+
+  @param[in] PrivateData     Points to RAM disk private data.
+  @param[in] ChunkSize       The size of the parts the RAM disk is filled in.
+  @param[in] Fill            The function filling a part of the RAM disk.
+  @param[in] Complete        The function notified when the content of the
+                             RAM disk is not needed any more. Optional.
+  @param[in] Context         The context passed to Fill and Complete.
+
+  @retval EFI_SUCCESS             The state is created.
+  @retval EFI_OUT_OF_RESOURCES    Failed to allocate the state.
+
+**/
+EFI_STATUS
+RamDiskSparseCreate (
+  IN RAM_DISK_PRIVATE_DATA           *PrivateData,
+  IN UINT32                          ChunkSize,
+  IN EDKII_SPARSE_RAM_DISK_FILL      Fill,
+  IN EDKII_SPARSE_RAM_DISK_COMPLETE  Complete OPTIONAL,
+  IN VOID                            *Context
+  )
+{
+  EFI_STATUS            Status;
+  RAM_DISK_SPARSE_DATA  *Sparse;
+
+  ASSERT (PrivateData->Sparse == NULL);
+  ASSERT ((ChunkSize != 0) && (Fill != NULL));
+
+  Sparse = AllocateZeroPool (sizeof (RAM_DISK_SPARSE_DATA));
+  if (Sparse == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Sparse->Fill       = Fill;
+  Sparse->Complete   = Complete;
+  Sparse->Context    = Context;
+  Sparse->ChunkSize  = ChunkSize;
+  Sparse->ChunkCount = (UINTN)DivU64x32 (PrivateData->Size + ChunkSize - 1, ChunkSize);
+  Sparse->Bitmap     = AllocateZeroPool ((Sparse->ChunkCount + 7) / 8);
+  if (Sparse->Bitmap == NULL) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto ErrorExit;
+  }
+
+  Status = gBS->CreateEvent (
+                  EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  RamDiskSparseFillNotify,
+                  PrivateData,
+                  &Sparse->FillTimer
+                  );
+  if (EFI_ERROR (Status)) {
+    goto ErrorExit;
+  }
+
+  Status = gBS->CreateEventEx (
+                  EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  RamDiskSparseExitBootServicesNotify,
+                  PrivateData,
+                  &gEfiEventBeforeExitBootServicesGuid,
+                  &Sparse->ExitBootServicesEvent
+                  );
+  if (EFI_ERROR (Status)) {
+    goto ErrorExit;
+  }
+
+  Status = gBS->CreateEvent (
+                  EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  RamDiskSparseUnregisterNotify,
+                  PrivateData,
+                  &Sparse->UnregisterEvent
+                  );
+  if (EFI_ERROR (Status)) {
+    goto ErrorExit;
+  }
+
+  PrivateData->Sparse = Sparse;
+  return EFI_SUCCESS;
+
+ErrorExit:
+  if (Sparse->ExitBootServicesEvent != NULL) {
+    gBS->CloseEvent (Sparse->ExitBootServicesEvent);
+  }
+
+  if (Sparse->FillTimer != NULL) {
+    gBS->CloseEvent (Sparse->FillTimer);
+  }
+
+  if (Sparse->Bitmap != NULL) {
+    FreePool (Sparse->Bitmap);
+  }
+
+  FreePool (Sparse);
+  return Status;
+}
+
+/**
+  Start filling a sparse RAM disk in the background.
+
+  @param[in] PrivateData     Points to RAM disk private data.
+
+**/
+VOID
+RamDiskSparseStart (
+  IN RAM_DISK_PRIVATE_DATA  *PrivateData
+  )
+{
+  gBS->SetTimer (
+         PrivateData->Sparse->FillTimer,
+         TimerPeriodic,
+         RAM_DISK_SPARSE_FILL_INTERVAL
+         );
+}
+
+/**
+  Destroy the state of a sparse RAM disk, notifying its producer first if
+  the RAM disk is not filled yet.
+
+  @param[in] PrivateData     Points to RAM disk private data.
+
+**/
+VOID
+RamDiskSparseDestroy (
+  IN RAM_DISK_PRIVATE_DATA  *PrivateData
+  )
+{
+  RAM_DISK_SPARSE_DATA  *Sparse;
+
+  Sparse = PrivateData->Sparse;
+  if (Sparse == NULL) {
+    return;
+  }
+
+  RamDiskSparseFinish (PrivateData, EFI_ABORTED);
+
+  gBS->CloseEvent (Sparse->FillTimer);
+  gBS->CloseEvent (Sparse->ExitBootServicesEvent);
+  gBS->CloseEvent (Sparse->UnregisterEvent);
+  FreePool (Sparse->Bitmap);
+  FreePool (Sparse);
+  PrivateData->Sparse = NULL;
+}
+
+/**
+  Make sure the given range of a sparse RAM disk is filled.
+
+  @param[in] PrivateData     Points to RAM disk private data.
+  @param[in] Offset          The offset of the range in the RAM disk.
+  @param[in] Length          The size of the range in bytes.
+
+  @retval EFI_SUCCESS             The range is filled.
+  @retval EFI_DEVICE_ERROR        A chunk of the range could not be filled.
+
+**/
+EFI_STATUS
+RamDiskSparseFillRange (
+  IN RAM_DISK_PRIVATE_DATA  *PrivateData,
+  IN UINT64                 Offset,
+  IN UINTN                  Length
+  )
+{
+  RAM_DISK_SPARSE_DATA  *Sparse;
+  EFI_STATUS            Status;
+  EFI_TPL               OldTpl;
+  UINTN                 Index;
+  UINTN                 Last;
+
+  Sparse = PrivateData->Sparse;
+  if ((Length == 0) || (Sparse->FilledCount == Sparse->ChunkCount)) {
+    return EFI_SUCCESS;
+  }
+
+  //
+  // Keep the background fill from running while the chunks are filled.
+  //
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+
+  Status = EFI_SUCCESS;
+  Index  = (UINTN)DivU64x32 (Offset, Sparse->ChunkSize);
+  Last   = (UINTN)DivU64x32 (Offset + Length - 1, Sparse->ChunkSize);
+  for ( ; (Index <= Last) && !EFI_ERROR (Status); Index++) {
+    Status = RamDiskSparseFillChunk (PrivateData, Index, TRUE);
+  }
+
+  gBS->RestoreTPL (OldTpl);
+  return Status;
+}
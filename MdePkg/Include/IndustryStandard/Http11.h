@@ -74,6 +74,14 @@
 /// indicate its acceptance of range requests for a resource:
 ///
 #define HTTP_HEADER_ACCEPT_RANGES  "Accept-Ranges"
+#define HTTP_ACCEPT_RANGES_BYTES   "bytes"
+
+///
+/// Range Request Header
+/// The Range request-header field requests one or more sub-ranges of the entity
+/// instead of the entire entity, such as "bytes=0-499" for the first 500 bytes.
+///
+#define HTTP_HEADER_RANGE  "Range"
 
 ///
 /// Accept-Encoding Request Header
@@ -134,6 +142,13 @@
 ///
 #define HTTP_HEADER_CONTENT_LENGTH  "Content-Length"
 
+///
+/// Content-Range Header
+/// The Content-Range entity-header field is sent with a partial entity-body to
+/// specify where in the full entity-body the partial body should be applied.
+///
+#define HTTP_HEADER_CONTENT_RANGE  "Content-Range"
+
 ///
 /// Transfer-Encoding Header
 /// The Transfer-Encoding general-header field indicates what (if any) type of transformation
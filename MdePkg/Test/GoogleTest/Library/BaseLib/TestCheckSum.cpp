@@ -11,10 +11,65 @@ extern "C" {
   #include <Library/BaseLib.h>
 }
 
-// Precomputed crc32c and crc16-ansi for "hello" (without the null byte)
+// Precomputed crc32, crc32c and crc16-ansi for "hello" (without the null byte)
+constexpr STATIC UINT32  mHelloCrc32  = 0x3610A686;
 constexpr STATIC UINT32  mHelloCrc32c = 0x9A71BB4C;
 constexpr STATIC UINT16  mHelloCrc16  = 0x34F6;
 
+// Bitwise reference implementation of the ITU-T V.42 CRC32
+STATIC
+UINT32
+ReferenceCrc32 (
+  CONST UINT8  *Buffer,
+  UINTN        Length
+  )
+{
+  UINT32  Crc;
+  UINTN   Bit;
+
+  Crc = 0xFFFFFFFF;
+  while (Length-- != 0) {
+    Crc ^= *(Buffer++);
+    for (Bit = 0; Bit < 8; Bit++) {
+      Crc = ((Crc & 1) != 0) ? ((Crc >> 1) ^ 0xEDB88320) : (Crc >> 1);
+    }
+  }
+
+  return ~Crc;
+}
+
+TEST (Crc32, BasicCheck) {
+  // Note: The magic numbers below are precomputed checksums
+  // Check for basic operation on even and odd numbers of bytes
+  EXPECT_EQ (CalculateCrc32 ((VOID *)"hello", 5), mHelloCrc32);
+  EXPECT_EQ (
+    CalculateCrc32 ((VOID *)"longlonglonglonglong", sizeof ("longlonglonglonglong") - 1),
+    0x2AABD4A9U
+    );
+  EXPECT_EQ (CalculateCrc32 ((VOID *)"h", 1), 0x916B06E7U);
+
+  // Check if a checksum with no bytes correctly yields 0
+  EXPECT_EQ (CalculateCrc32 ((VOID *)"", 0), 0U);
+}
+
+TEST (Crc32, AlignmentCheck) {
+  // Check that every combination of buffer alignment and length, covering the
+  // unaligned head, the 8-byte blocks and the tail, matches the reference.
+  UINT8  Buffer[128];
+  UINTN  Offset;
+  UINTN  Length;
+
+  for (Length = 0; Length < sizeof (Buffer); Length++) {
+    Buffer[Length] = (UINT8)(Length * 37 + 11);
+  }
+
+  for (Offset = 0; Offset < 8; Offset++) {
+    for (Length = 0; Length <= sizeof (Buffer) - Offset; Length++) {
+      EXPECT_EQ (CalculateCrc32 (&Buffer[Offset], Length), ReferenceCrc32 (&Buffer[Offset], Length));
+    }
+  }
+}
+
 TEST (Crc32c, BasicCheck) {
   // Note: The magic numbers below are precomputed checksums
   // Check for basic operation on even and odd numbers of bytes
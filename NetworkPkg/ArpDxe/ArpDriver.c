@@ -42,6 +42,7 @@ ArpCreateService (
   )
 {
   EFI_STATUS  Status;
+  UINTN       Index;
 
   ASSERT (ArpService != NULL);
 
@@ -55,6 +56,10 @@ ArpCreateService (
   InitializeListHead (&ArpService->DeniedCacheTable);
   InitializeListHead (&ArpService->ResolvedCacheTable);
 
+  for (Index = 0; Index < ARP_CACHE_HASH_SIZE; Index++) {
+    InitializeListHead (&ArpService->ResolvedCacheHash[Index]);
+  }
+
   //
   // Init the servicebinding protocol members.
   //
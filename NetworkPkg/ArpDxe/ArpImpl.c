@@ -214,13 +214,7 @@ ArpOnFrameRcvdDpc (
   // Check whether the sender's address information is already in the cache.
   //
   MergeFlag  = FALSE;
-  CacheEntry = ArpFindNextCacheEntryInTable (
-                 &ArpService->ResolvedCacheTable,
-                 NULL,
-                 ByProtoAddress,
-                 &SenderAddress[Protocol],
-                 NULL
-                 );
+  CacheEntry = ArpFindResolvedCacheEntry (ArpService, &SenderAddress[Protocol]);
   if (CacheEntry != NULL) {
     //
     // Update the entry with the new information.
@@ -280,7 +274,7 @@ ArpOnFrameRcvdDpc (
     //
     // Add this entry into the ResolvedCacheTable
     //
-    InsertHeadList (&ArpService->ResolvedCacheTable, &CacheEntry->List);
+    ArpInsertResolvedCacheEntry (ArpService, CacheEntry);
   }
 
   if (Head->OpCode == ARP_OPCODE_REQUEST) {
@@ -519,7 +513,7 @@ ArpTimerHandler (
       //
       // Time out, remove it.
       //
-      RemoveEntryList (&CacheEntry->List);
+      ArpRemoveCacheEntry (CacheEntry);
       FreePool (CacheEntry);
     } else {
       //
@@ -703,6 +697,110 @@ ArpFindDeniedCacheEntry (
   return CacheEntry;
 }
 
+/**
+  Compute the hash bucket index of the protocol address.
+
+  @param[in]  ProtocolAddress        Pointer to the protocol address.
+
+  @return The index of the hash bucket.
+
+**/
+STATIC
+UINTN
+ArpHashProtoAddress (
+  IN NET_ARP_ADDRESS  *ProtocolAddress
+  )
+{
+  UINT32  Hash;
+  UINT8   Index;
+
+  Hash = ProtocolAddress->Type;
+  for (Index = 0; Index < ProtocolAddress->Length; Index++) {
+    Hash = Hash * 31 + ProtocolAddress->AddressPtr[Index];
+  }
+
+  return Hash & (ARP_CACHE_HASH_SIZE - 1);
+}
+
+/**
+  Find the CacheEntry in the ResolvedCacheTable by the protocol address. The
+  lookup goes through the hash index instead of walking the table.
+
+  @param[in]  ArpService             Pointer to the arp service context data.
+  @param[in]  ProtocolAddress        Pointer to the protocol address to match.
+
+  @return Pointer to the matched cache entry, if NULL no match is found.
+
+**/
+ARP_CACHE_ENTRY *
+ArpFindResolvedCacheEntry (
+  IN ARP_SERVICE_DATA  *ArpService,
+  IN NET_ARP_ADDRESS   *ProtocolAddress
+  )
+{
+  LIST_ENTRY       *Bucket;
+  LIST_ENTRY       *Entry;
+  ARP_CACHE_ENTRY  *CacheEntry;
+
+  ASSERT ((ProtocolAddress != NULL) && (ProtocolAddress->AddressPtr != NULL));
+
+  Bucket = &ArpService->ResolvedCacheHash[ArpHashProtoAddress (ProtocolAddress)];
+
+  NET_LIST_FOR_EACH (Entry, Bucket) {
+    CacheEntry = NET_LIST_USER_STRUCT (Entry, ARP_CACHE_ENTRY, HashLink);
+
+    if (ArpMatchAddress (ProtocolAddress, &CacheEntry->Addresses[Protocol])) {
+      return CacheEntry;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Insert the CacheEntry into the ResolvedCacheTable and its hash index. The
+  protocol address of the CacheEntry must be filled before.
+
+  @param[in]  ArpService             Pointer to the arp service context data.
+  @param[in]  CacheEntry             Pointer to the cache entry to insert.
+
+**/
+VOID
+ArpInsertResolvedCacheEntry (
+  IN ARP_SERVICE_DATA  *ArpService,
+  IN ARP_CACHE_ENTRY   *CacheEntry
+  )
+{
+  UINTN  Index;
+
+  ASSERT (IsListEmpty (&CacheEntry->HashLink));
+
+  Index = ArpHashProtoAddress (&CacheEntry->Addresses[Protocol]);
+
+  InsertHeadList (&ArpService->ResolvedCacheTable, &CacheEntry->List);
+  InsertHeadList (&ArpService->ResolvedCacheHash[Index], &CacheEntry->HashLink);
+}
+
+/**
+  Remove the CacheEntry from the cache table it is linked in, and from the
+  hash index if it is a resolved cache entry.
+
+  @param[in]  CacheEntry             Pointer to the cache entry to remove.
+
+**/
+VOID
+ArpRemoveCacheEntry (
+  IN ARP_CACHE_ENTRY  *CacheEntry
+  )
+{
+  RemoveEntryList (&CacheEntry->List);
+
+  if (!IsListEmpty (&CacheEntry->HashLink)) {
+    RemoveEntryList (&CacheEntry->HashLink);
+    InitializeListHead (&CacheEntry->HashLink);
+  }
+}
+
 /**
   Allocate a cache entry and initialize it.
 
@@ -732,6 +830,7 @@ ArpAllocCacheEntry (
   // Init the lists.
   //
   InitializeListHead (&CacheEntry->List);
+  InitializeListHead (&CacheEntry->HashLink);
   InitializeListHead (&CacheEntry->UserRequestList);
 
   for (Index = 0; Index < 2; Index++) {
@@ -1299,7 +1398,7 @@ MATCHED:
     //
     // Delete this entry.
     //
-    RemoveEntryList (&CacheEntry->List);
+    ArpRemoveCacheEntry (CacheEntry);
     ASSERT (IsListEmpty (&CacheEntry->UserRequestList));
     FreePool (CacheEntry);
 
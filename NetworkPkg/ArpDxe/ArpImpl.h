@@ -46,6 +46,12 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define ARP_DEFAULT_RETRY_INTERVAL   (5   * TICKS_PER_MS)
 #define ARP_PERIODIC_TIMER_INTERVAL  (500 * TICKS_PER_MS)
 
+//
+// Number of the hash buckets indexing the resolved cache entries by the
+// protocol address. It must be a power of two.
+//
+#define ARP_CACHE_HASH_SIZE  64
+
 //
 // ARP packet head definition.
 //
@@ -162,6 +168,7 @@ struct _ARP_SERVICE_DATA {
   LIST_ENTRY                              PendingRequestTable;
   LIST_ENTRY                              DeniedCacheTable;
   LIST_ENTRY                              ResolvedCacheTable;
+  LIST_ENTRY                              ResolvedCacheHash[ARP_CACHE_HASH_SIZE];
 
   EFI_EVENT                               PeriodicTimer;
 };
@@ -207,6 +214,7 @@ typedef enum {
 //
 typedef struct {
   LIST_ENTRY         List;
+  LIST_ENTRY         HashLink;
 
   UINT32             RetryCount;
   UINT32             DefaultDecayTime;
@@ -528,6 +536,48 @@ ArpFindNextCacheEntryInTable (
   IN NET_ARP_ADDRESS  *HardwareAddress OPTIONAL
   );
 
+/**
+  Find the CacheEntry in the ResolvedCacheTable by the protocol address. The
+  lookup goes through the hash index instead of walking the table.
+
+  @param[in]  ArpService             Pointer to the arp service context data.
+  @param[in]  ProtocolAddress        Pointer to the protocol address to match.
+
+  @return Pointer to the matched cache entry, if NULL no match is found.
+
+**/
+ARP_CACHE_ENTRY *
+ArpFindResolvedCacheEntry (
+  IN ARP_SERVICE_DATA  *ArpService,
+  IN NET_ARP_ADDRESS   *ProtocolAddress
+  );
+
+/**
+  Insert the CacheEntry into the ResolvedCacheTable and its hash index. The
+  protocol address of the CacheEntry must be filled before.
+
+  @param[in]  ArpService             Pointer to the arp service context data.
+  @param[in]  CacheEntry             Pointer to the cache entry to insert.
+
+**/
+VOID
+ArpInsertResolvedCacheEntry (
+  IN ARP_SERVICE_DATA  *ArpService,
+  IN ARP_CACHE_ENTRY   *CacheEntry
+  );
+
+/**
+  Remove the CacheEntry from the cache table it is linked in, and from the
+  hash index if it is a resolved cache entry.
+
+  @param[in]  CacheEntry             Pointer to the cache entry to remove.
+
+**/
+VOID
+ArpRemoveCacheEntry (
+  IN ARP_CACHE_ENTRY  *CacheEntry
+  );
+
 /**
   Allocate a cache entry and initialize it.
 
@@ -1102,6 +1102,18 @@ Dhcp6SendSolicitMsg   (
     }
   }
 
+  //
+  // Ask for the two message exchange if configured so. The rapid commit option
+  // carries no data, which Dhcp6AppendOption does not accept.
+  // See details in the section-17.1.1 of rfc-3315.
+  //
+  if (Instance->Config->RapidCommit) {
+    WriteUnaligned16 ((UINT16 *)Cursor, HTONS (Dhcp6OptRapidCommit));
+    WriteUnaligned16 ((UINT16 *)(Cursor + 2), 0);
+    Cursor         += 4;
+    Packet->Length += 4;
+  }
+
   ASSERT (Packet->Size > Packet->Length + 8);
 
   //
@@ -2319,7 +2331,11 @@ Dhcp6HandleReplyMsg (
              Dhcp6OptRapidCommit
              );
 
-  if (((Option != NULL) && !Instance->Config->RapidCommit) || ((Option == NULL) && Instance->Config->RapidCommit)) {
+  //
+  // A reply without the rapid commit option is still valid when the server
+  // answered the solicit with an advertise and the request was then sent.
+  //
+  if ((Option != NULL) && !Instance->Config->RapidCommit) {
     return EFI_DEVICE_ERROR;
   }
 
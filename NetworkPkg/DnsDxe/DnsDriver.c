@@ -370,6 +370,13 @@ DnsUnload (
       gBS->CloseEvent (mDriverData->Timer);
     }
 
+    if (mDriverData->BeforeExitBootServicesEvent != NULL) {
+      gBS->CloseEvent (mDriverData->BeforeExitBootServicesEvent);
+    }
+
+    StoreDnsCache (FALSE);
+    StoreDnsCache (TRUE);
+
     while (!IsListEmpty (&mDriverData->Dns4CacheList)) {
       Entry = NetListRemoveHead (&mDriverData->Dns4CacheList);
       ASSERT (Entry != NULL);
@@ -493,6 +500,23 @@ DnsDriverEntryPoint (
   InitializeListHead (&mDriverData->Dns6CacheList);
   InitializeListHead (&mDriverData->Dns6ServerList);
 
+  RestoreDnsCache (FALSE);
+  RestoreDnsCache (TRUE);
+
+  if (PcdGetBool (PcdNetworkDiscoveryCache)) {
+    //
+    // Store the new answers once, rather than on every response.
+    //
+    gBS->CreateEventEx (
+           EVT_NOTIFY_SIGNAL,
+           TPL_CALLBACK,
+           DnsOnBeforeExitBootServices,
+           NULL,
+           &gEfiEventBeforeExitBootServicesGuid,
+           &mDriverData->BeforeExitBootServicesEvent
+           );
+  }
+
   return Status;
 
 Error4:
@@ -771,6 +795,8 @@ Dns4DriverBindingStop (
 
     DnsDestroyService (DnsSb);
 
+    StoreDnsCache (FALSE);
+
     if (gDnsControllerNameTable != NULL) {
       FreeUnicodeStringTable (gDnsControllerNameTable);
       gDnsControllerNameTable = NULL;
@@ -1036,6 +1062,8 @@ Dns6DriverBindingStop (
 
     DnsDestroyService (DnsSb);
 
+    StoreDnsCache (TRUE);
+
     if (gDnsControllerNameTable != NULL) {
       FreeUnicodeStringTable (gDnsControllerNameTable);
       gDnsControllerNameTable = NULL;
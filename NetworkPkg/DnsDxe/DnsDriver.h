@@ -39,6 +39,14 @@ struct _DNS_DRIVER_DATA {
 
   LIST_ENTRY    Dns6CacheList;
   LIST_ENTRY    Dns6ServerList;
+
+  //
+  // Whether new answers were added to the caches since they were stored,
+  // and the event to store them before the OS takes over.
+  //
+  BOOLEAN       Dns4CacheChanged;
+  BOOLEAN       Dns6CacheChanged;
+  EFI_EVENT     BeforeExitBootServicesEvent;
 };
 
 struct _DNS_SERVICE {
@@ -942,6 +942,221 @@ UpdateDns6Cache (
   return EFI_SUCCESS;
 }
 
+/**
+  Store the Dns4 or Dns6 cache in a variable, so that the answers can be used
+  again in the next boot until their TTL expires.
+
+  Nothing is stored unless PcdNetworkDiscoveryCache is TRUE and new answers
+  were added to the cache since it was last stored.
+
+  @param  IsIp6              If TRUE, store the Dns6 cache, otherwise the Dns4 cache.
+
+  @retval EFI_SUCCESS        The cache is stored, or storing it is not enabled.
+  @retval Others             Failed to store the cache.
+
+**/
+EFI_STATUS
+StoreDnsCache (
+  IN BOOLEAN  IsIp6
+  )
+{
+  EFI_STATUS        Status;
+  LIST_ENTRY        *CacheList;
+  LIST_ENTRY        *Entry;
+  DNS4_CACHE        *Item4;
+  DNS6_CACHE        *Item6;
+  CHAR16            *HostName;
+  VOID              *IpAddress;
+  UINT32            Timeout;
+  UINTN             AddressSize;
+  UINTN             DataSize;
+  UINTN             Count;
+  UINT8             *Data;
+  UINT8             *Cursor;
+  DNS_STORED_CACHE  *Stored;
+  EFI_TIME          Time;
+  UINT64            Now;
+  BOOLEAN           *Changed;
+
+  Changed = IsIp6 ? &mDriverData->Dns6CacheChanged : &mDriverData->Dns4CacheChanged;
+  if (!PcdGetBool (PcdNetworkDiscoveryCache) || !*Changed) {
+    return EFI_SUCCESS;
+  }
+
+  Status = gRT->GetTime (&Time, NULL);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Now = NetLibTimeToSeconds (&Time);
+
+  if (IsIp6) {
+    CacheList   = &mDriverData->Dns6CacheList;
+    AddressSize = sizeof (EFI_IPv6_ADDRESS);
+  } else {
+    CacheList   = &mDriverData->Dns4CacheList;
+    AddressSize = sizeof (EFI_IPv4_ADDRESS);
+  }
+
+  //
+  // Two passes over the list: size the variable, then fill it.
+  //
+  Data     = NULL;
+  Cursor   = NULL;
+  DataSize = 0;
+  do {
+    Count = 0;
+    NET_LIST_FOR_EACH (Entry, CacheList) {
+      if (Count == DNS_STORED_CACHE_MAX_NUM) {
+        break;
+      }
+
+      if (IsIp6) {
+        Item6     = NET_LIST_USER_STRUCT (Entry, DNS6_CACHE, AllCacheLink);
+        HostName  = Item6->DnsCache.HostName;
+        IpAddress = Item6->DnsCache.IpAddress;
+        Timeout   = Item6->DnsCache.Timeout;
+      } else {
+        Item4     = NET_LIST_USER_STRUCT (Entry, DNS4_CACHE, AllCacheLink);
+        HostName  = Item4->DnsCache.HostName;
+        IpAddress = Item4->DnsCache.IpAddress;
+        Timeout   = Item4->DnsCache.Timeout;
+      }
+
+      if (Data == NULL) {
+        DataSize += sizeof (DNS_STORED_CACHE) + AddressSize + StrSize (HostName);
+      } else {
+        Stored               = (DNS_STORED_CACHE *)Cursor;
+        Stored->Expiry       = Now + Timeout;
+        Stored->HostNameSize = (UINT32)StrSize (HostName);
+        Cursor              += sizeof (DNS_STORED_CACHE);
+        CopyMem (Cursor, IpAddress, AddressSize);
+        Cursor += AddressSize;
+        CopyMem (Cursor, HostName, Stored->HostNameSize);
+        Cursor += Stored->HostNameSize;
+      }
+
+      Count++;
+    }
+
+    if ((Data != NULL) || (DataSize == 0)) {
+      break;
+    }
+
+    Data = AllocatePool (DataSize);
+    if (Data == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    Cursor = Data;
+  } while (TRUE);
+
+  Status = gRT->SetVariable (
+                  IsIp6 ? EDKII_DNS6_CACHE_VARIABLE : EDKII_DNS4_CACHE_VARIABLE,
+                  &gEdkiiNetworkDiscoveryCacheGuid,
+                  (DataSize == 0) ? 0 : EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS,
+                  DataSize,
+                  Data
+                  );
+  if (Data != NULL) {
+    FreePool (Data);
+  }
+
+  if (Status == EFI_NOT_FOUND) {
+    //
+    // There was nothing to delete.
+    //
+    Status = EFI_SUCCESS;
+  }
+
+  if (!EFI_ERROR (Status)) {
+    *Changed = FALSE;
+  }
+
+  return Status;
+}
+
+/**
+  Restore the Dns4 or Dns6 cache stored by StoreDnsCache() in a previous boot,
+  dropping the entries whose TTL expired meanwhile.
+
+  Nothing is restored unless PcdNetworkDiscoveryCache is TRUE.
+
+  @param  IsIp6              If TRUE, restore the Dns6 cache, otherwise the Dns4 cache.
+
+**/
+VOID
+RestoreDnsCache (
+  IN BOOLEAN  IsIp6
+  )
+{
+  EFI_STATUS            Status;
+  CHAR16                *VariableName;
+  UINT8                 *Data;
+  UINTN                 DataSize;
+  UINTN                 AddressSize;
+  UINTN                 Offset;
+  DNS_STORED_CACHE      *Stored;
+  CHAR16                *HostName;
+  EFI_DNS4_CACHE_ENTRY  Dns4CacheEntry;
+  EFI_DNS6_CACHE_ENTRY  Dns6CacheEntry;
+  EFI_TIME              Time;
+  UINT64                Now;
+
+  if (!PcdGetBool (PcdNetworkDiscoveryCache)) {
+    return;
+  }
+
+  Status = gRT->GetTime (&Time, NULL);
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  Now          = NetLibTimeToSeconds (&Time);
+  VariableName = IsIp6 ? EDKII_DNS6_CACHE_VARIABLE : EDKII_DNS4_CACHE_VARIABLE;
+  AddressSize  = IsIp6 ? sizeof (EFI_IPv6_ADDRESS) : sizeof (EFI_IPv4_ADDRESS);
+
+  Status = GetVariable2 (VariableName, &gEdkiiNetworkDiscoveryCacheGuid, (VOID **)&Data, &DataSize);
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  Offset = 0;
+  while (DataSize - Offset >= sizeof (DNS_STORED_CACHE) + AddressSize) {
+    Stored   = (DNS_STORED_CACHE *)(Data + Offset);
+    HostName = (CHAR16 *)(Data + Offset + sizeof (DNS_STORED_CACHE) + AddressSize);
+
+    //
+    // Stop at the first malformed entry, the rest cannot be located reliably.
+    //
+    if ((Stored->HostNameSize < sizeof (CHAR16)) ||
+        ((Stored->HostNameSize % sizeof (CHAR16)) != 0) ||
+        (Stored->HostNameSize > DataSize - Offset - sizeof (DNS_STORED_CACHE) - AddressSize) ||
+        (HostName[Stored->HostNameSize / sizeof (CHAR16) - 1] != L'\0'))
+    {
+      break;
+    }
+
+    if ((Stored->Expiry > Now) && (Stored->Expiry - Now <= MAX_UINT32)) {
+      if (IsIp6) {
+        Dns6CacheEntry.HostName  = HostName;
+        Dns6CacheEntry.IpAddress = (EFI_IPv6_ADDRESS *)(Stored + 1);
+        Dns6CacheEntry.Timeout   = (UINT32)(Stored->Expiry - Now);
+        UpdateDns6Cache (&mDriverData->Dns6CacheList, FALSE, TRUE, Dns6CacheEntry);
+      } else {
+        Dns4CacheEntry.HostName  = HostName;
+        Dns4CacheEntry.IpAddress = (EFI_IPv4_ADDRESS *)(Stored + 1);
+        Dns4CacheEntry.Timeout   = (UINT32)(Stored->Expiry - Now);
+        UpdateDns4Cache (&mDriverData->Dns4CacheList, FALSE, TRUE, Dns4CacheEntry);
+      }
+    }
+
+    Offset += sizeof (DNS_STORED_CACHE) + AddressSize + Stored->HostNameSize;
+  }
+
+  FreePool (Data);
+}
+
 /**
   Add Dns4 ServerIp to common list of addresses of all configured DNSv4 server.
 
@@ -1638,6 +1853,18 @@ ParseDnsResponse (
     AnswerSectionNum++;
   }
 
+  //
+  // Remember the new answers for the next boot as well. The cache is stored
+  // once, when the driver stops or the OS takes over.
+  //
+  if (IpCount != 0) {
+    if (Instance->Service->IpVersion == IP_VERSION_6) {
+      mDriverData->Dns6CacheChanged = TRUE;
+    } else {
+      mDriverData->Dns4CacheChanged = TRUE;
+    }
+  }
+
   if (Instance->Service->IpVersion == IP_VERSION_4) {
     ASSERT (Dns4TokenEntry != NULL);
 
@@ -2273,3 +2500,21 @@ DnsOnTimerUpdate (
     }
   }
 }
+
+/**
+  Store the DNS caches before the OS takes over, if they changed.
+
+  @param  Event                 The event signaled before ExitBootServices.
+  @param  Context               NULL
+
+**/
+VOID
+EFIAPI
+DnsOnBeforeExitBootServices (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  StoreDnsCache (FALSE);
+  StoreDnsCache (TRUE);
+}
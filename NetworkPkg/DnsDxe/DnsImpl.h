@@ -44,6 +44,9 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #include <Protocol/Ip4Config2.h>
 
+#include <Guid/EventGroup.h>
+#include <Guid/NetworkDiscoveryCache.h>
+
 #include "DnsDriver.h"
 #include "DnsDhcp.h"
 
@@ -83,6 +86,11 @@ extern EFI_DNS6_PROTOCOL             mDns6Protocol;
 
 #define DNS_TIME_TO_GETMAP  5
 
+//
+// The maximum number of DNS cache entries stored across boots per IP version.
+//
+#define DNS_STORED_CACHE_MAX_NUM  32
+
 #pragma pack(1)
 
 typedef union _DNS_FLAGS DNS_FLAGS;
@@ -97,6 +105,15 @@ typedef struct {
   EFI_DNS6_CACHE_ENTRY    DnsCache;
 } DNS6_CACHE;
 
+//
+// A DNS cache entry stored across boots. It is followed by the IP address and
+// the Null-terminated host name. The sizes keep the host names 16-bit aligned.
+//
+typedef struct {
+  UINT64    Expiry;
+  UINT32    HostNameSize;
+} DNS_STORED_CACHE;
+
 typedef struct {
   LIST_ENTRY          AllServerLink;
   EFI_IPv4_ADDRESS    Dns4ServerIp;
@@ -515,6 +532,38 @@ UpdateDns6Cache (
   IN EFI_DNS6_CACHE_ENTRY  DnsCacheEntry
   );
 
+/**
+  Store the Dns4 or Dns6 cache in a variable, so that the answers can be used
+  again in the next boot until their TTL expires.
+
+  Nothing is stored unless PcdNetworkDiscoveryCache is TRUE and new answers
+  were added to the cache since it was last stored.
+
+  @param  IsIp6              If TRUE, store the Dns6 cache, otherwise the Dns4 cache.
+
+  @retval EFI_SUCCESS        The cache is stored, or storing it is not enabled.
+  @retval Others             Failed to store the cache.
+
+**/
+EFI_STATUS
+StoreDnsCache (
+  IN BOOLEAN  IsIp6
+  );
+
+/**
+  Restore the Dns4 or Dns6 cache stored by StoreDnsCache() in a previous boot,
+  dropping the entries whose TTL expired meanwhile.
+
+  Nothing is restored unless PcdNetworkDiscoveryCache is TRUE.
+
+  @param  IsIp6              If TRUE, restore the Dns6 cache, otherwise the Dns4 cache.
+
+**/
+VOID
+RestoreDnsCache (
+  IN BOOLEAN  IsIp6
+  );
+
 /**
   Add Dns4 ServerIp to common list of addresses of all configured DNSv4 server.
 
@@ -709,6 +758,20 @@ DnsOnTimerUpdate (
   IN VOID       *Context
   );
 
+/**
+  Store the DNS caches before the OS takes over, if they changed.
+
+  @param  Event                 The event signaled before ExitBootServices.
+  @param  Context               NULL
+
+**/
+VOID
+EFIAPI
+DnsOnBeforeExitBootServices (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  );
+
 /**
   Retrieve mode data of this DNS instance.
 
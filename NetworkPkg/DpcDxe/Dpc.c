@@ -27,6 +27,13 @@ EFI_DPC_PROTOCOL  mDpc = {
   DpcDispatchDpc
 };
 
+//
+// The EDKII_DPC_STATISTICS_PROTOCOL instance that is installed onto mDpcHandle
+//
+EDKII_DPC_STATISTICS_PROTOCOL  mDpcStatisticsProtocol = {
+  DpcGetStatistics
+};
+
 //
 // Global variables used to measure the DPC Queue Depths
 //
@@ -34,19 +41,96 @@ UINTN  mDpcQueueDepth    = 0;
 UINTN  mMaxDpcQueueDepth = 0;
 
 //
-// Free list of DPC entries.  As DPCs are queued, entries are removed from this
-// free list.  As DPC entries are dispatched, DPC entries are added to the free list.
-// If the free list is empty and a DPC is queued, the free list is grown by allocating
-// an additional set of DPC entries.
+// The statistics of the DPC queues. The latencies are kept in performance
+// counter ticks, and converted to nanoseconds when they are retrieved.
 //
-LIST_ENTRY  mDpcEntryFreeList = INITIALIZE_LIST_HEAD_VARIABLE (mDpcEntryFreeList);
+EDKII_DPC_STATISTICS  mDpcStatistics;
+
+//
+// Whether the performance counter counts down, and the values it starts and
+// ends at before it rolls over.
+//
+BOOLEAN  mDpcCounterCountsDown = FALSE;
+UINT64   mDpcCounterStart      = 0;
+UINT64   mDpcCounterEnd        = 0;
 
 //
 // An array of DPC queues.  A DPC queue is allocated for every level EFI_TPL value.
-// As DPCs are queued, they are added to the end of the linked list.
-// As DPCs are dispatched, they are removed from the beginning of the linked list.
+// As DPCs are queued, they are added to the tail of the ring.
+// As DPCs are dispatched, they are removed from the head of the ring.
+//
+DPC_QUEUE  mDpcQueue[TPL_HIGH_LEVEL + 1];
+
 //
-LIST_ENTRY  mDpcQueue[TPL_HIGH_LEVEL + 1];
+// The batch of DPCs being invoked at every level EFI_TPL value. A DPC calling
+// DispatchDpc() invokes the rest of the current batch first, so that the DPCs
+// are still invoked in the order they were queued.
+//
+DPC_BATCH  *mDpcBatch[TPL_HIGH_LEVEL + 1];
+
+/**
+  Double the size of a DPC queue.
+
+  The function is called at TPL_HIGH_LEVEL, and lowers the TPL to OriginalTpl
+  to allocate and free the memory.
+
+  @param  Queue         The DPC queue to grow.
+  @param  OriginalTpl   The TPL of the caller of DpcQueueDpc().
+
+  @retval EFI_SUCCESS            The DPC queue is grown, or another caller grew it
+                                 while the TPL was lowered.
+  @retval EFI_OUT_OF_RESOURCES   Failed to allocate memory.
+
+**/
+EFI_STATUS
+DpcGrowQueue (
+  IN DPC_QUEUE  *Queue,
+  IN EFI_TPL    OriginalTpl
+  )
+{
+  DPC_ENTRY  *Entries;
+  DPC_ENTRY  *OldEntries;
+  UINTN      Size;
+  UINTN      Index;
+
+  Size = (Queue->Size == 0) ? DPC_QUEUE_INITIAL_SIZE : Queue->Size * 2;
+
+  //
+  // Lower the TPL level to perform a memory allocation
+  //
+  gBS->RestoreTPL (OriginalTpl);
+  Entries = AllocatePool (Size * sizeof (DPC_ENTRY));
+  gBS->RaiseTPL (TPL_HIGH_LEVEL);
+
+  if (Entries == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  if (Queue->Size >= Size) {
+    //
+    // The queue was grown while the TPL was lowered.
+    //
+    OldEntries = Entries;
+  } else {
+    for (Index = 0; Index < Queue->Tail - Queue->Head; Index++) {
+      Entries[Index] = Queue->Entries[(Queue->Head + Index) & (Queue->Size - 1)];
+    }
+
+    OldEntries     = Queue->Entries;
+    Queue->Entries = Entries;
+    Queue->Tail    = Queue->Tail - Queue->Head;
+    Queue->Head    = 0;
+    Queue->Size    = Size;
+  }
+
+  if (OldEntries != NULL) {
+    gBS->RestoreTPL (OriginalTpl);
+    FreePool (OldEntries);
+    gBS->RaiseTPL (TPL_HIGH_LEVEL);
+  }
+
+  return EFI_SUCCESS;
+}
 
 /**
   Add a Deferred Procedure Call to the end of the DPC queue.
@@ -75,8 +159,9 @@ DpcQueueDpc (
 {
   EFI_STATUS  ReturnStatus;
   EFI_TPL     OriginalTpl;
+  DPC_QUEUE   *Queue;
   DPC_ENTRY   *DpcEntry;
-  UINTN       Index;
+  UINT64      QueueTime;
 
   //
   // Make sure DpcTpl is valid
@@ -98,82 +183,56 @@ DpcQueueDpc (
   ReturnStatus = EFI_SUCCESS;
 
   //
-  // Raise the TPL level to TPL_HIGH_LEVEL for DPC list operation and save the
+  // Reading the performance counter may be costly, e.g. an I/O port read
+  // trapped by the hypervisor, so it is only done for the latency statistics.
+  //
+  QueueTime = 0;
+  if (PcdGetBool (PcdDpcLatencyStatistics)) {
+    QueueTime = GetPerformanceCounter ();
+  }
+
+  //
+  // Raise the TPL level to TPL_HIGH_LEVEL for DPC queue operation and save the
   // current TPL value so it can be restored when this function returns.
   //
   OriginalTpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
 
   //
-  // Check to see if there are any entries in the DPC free list
+  // Check to see if there is a free entry in the DPC queue
   //
-  if (IsListEmpty (&mDpcEntryFreeList)) {
+  Queue = &mDpcQueue[DpcTpl];
+  while (Queue->Tail - Queue->Head == Queue->Size) {
     //
     // If the current TPL is greater than TPL_NOTIFY, then memory allocations
-    // can not be performed, so the free list can not be expanded.  In this case
+    // can not be performed, so the queue can not be expanded.  In this case
     // return EFI_OUT_OF_RESOURCES.
     //
     if (OriginalTpl > TPL_NOTIFY) {
       ReturnStatus = EFI_OUT_OF_RESOURCES;
-      goto Done;
+      break;
     }
 
-    //
-    // Add 64 DPC entries to the free list
-    //
-    for (Index = 0; Index < 64; Index++) {
-      //
-      // Lower the TPL level to perform a memory allocation
-      //
-      gBS->RestoreTPL (OriginalTpl);
-
-      //
-      // Allocate a new DPC entry
-      //
-      DpcEntry = AllocatePool (sizeof (DPC_ENTRY));
-
-      //
-      // Raise the TPL level back to TPL_HIGH_LEVEL for DPC list operations
-      //
-      gBS->RaiseTPL (TPL_HIGH_LEVEL);
-
-      //
-      // If the allocation of a DPC entry fails, and the free list is empty,
-      // then return EFI_OUT_OF_RESOURCES.
-      //
-      if (DpcEntry == NULL) {
-        if (IsListEmpty (&mDpcEntryFreeList)) {
-          ReturnStatus = EFI_OUT_OF_RESOURCES;
-          goto Done;
-        }
-      }
-
-      //
-      // Add the newly allocated DPC entry to the DPC free list
-      //
-      InsertTailList (&mDpcEntryFreeList, &DpcEntry->ListEntry);
+    ReturnStatus = DpcGrowQueue (Queue, OriginalTpl);
+    if (EFI_ERROR (ReturnStatus)) {
+      break;
     }
   }
 
-  //
-  // Retrieve the first node from the free list of DPCs
-  //
-  DpcEntry = (DPC_ENTRY *)(GetFirstNode (&mDpcEntryFreeList));
-
-  //
-  // Remove the first node from the free list of DPCs
-  //
-  RemoveEntryList (&DpcEntry->ListEntry);
+  if (EFI_ERROR (ReturnStatus)) {
+    mDpcStatistics.QueueFailures++;
+    goto Done;
+  }
 
   //
-  // Fill in the DPC entry with the DpcProcedure and DpcContext
+  // Fill in the DPC entry at the tail of the queue
   //
+  DpcEntry               = &Queue->Entries[Queue->Tail & (Queue->Size - 1)];
   DpcEntry->DpcProcedure = DpcProcedure;
   DpcEntry->DpcContext   = DpcContext;
+  DpcEntry->QueueTime    = QueueTime;
+  Queue->Tail++;
 
-  //
-  // Add the DPC entry to the end of the list for the specified DplTpl.
-  //
-  InsertTailList (&mDpcQueue[DpcTpl], &DpcEntry->ListEntry);
+  mDpcStatistics.Queued++;
 
   //
   // Increment the measured DPC queue depth across all TPLs
@@ -196,12 +255,46 @@ Done:
   return ReturnStatus;
 }
 
+/**
+  Return the performance counter ticks elapsed between two readings of the
+  counter, allowing for the counter to roll over in between.
+
+  @param  Begin  The earlier counter value.
+  @param  End    The later counter value.
+
+  @return The number of ticks from Begin to End.
+
+**/
+UINT64
+DpcElapsedTicks (
+  IN UINT64  Begin,
+  IN UINT64  End
+  )
+{
+  if (mDpcCounterCountsDown) {
+    if (Begin >= End) {
+      return Begin - End;
+    }
+
+    return (Begin - mDpcCounterEnd) + (mDpcCounterStart - End) + 1;
+  }
+
+  if (End >= Begin) {
+    return End - Begin;
+  }
+
+  return (mDpcCounterEnd - Begin) + (End - mDpcCounterStart) + 1;
+}
+
 /**
   Dispatch the queue of DPCs.  ALL DPCs that have been queued with a DpcTpl
   value greater than or equal to the current TPL are invoked in the order that
   they were queued.  DPCs with higher DpcTpl values are invoked before DPCs with
   lower DpcTpl values.
 
+  The DPCs are taken off a queue in batches, so that the TPL is raised to
+  TPL_HIGH_LEVEL and restored once per batch instead of once per DPC.
+
   @param  This  Protocol instance pointer.
 
   @retval EFI_SUCCESS    One or more DPCs were invoked.
@@ -217,7 +310,14 @@ DpcDispatchDpc (
   EFI_STATUS  ReturnStatus;
   EFI_TPL     OriginalTpl;
   EFI_TPL     Tpl;
+  DPC_QUEUE   *Queue;
+  DPC_BATCH   LocalBatch;
+  DPC_BATCH   *Batch;
   DPC_ENTRY   *DpcEntry;
+  UINT64      Latency;
+  UINT64      TotalLatency;
+  UINT64      MaxLatency;
+  UINTN       Dispatched;
 
   //
   // Assume that no DPCs will be invoked
@@ -225,62 +325,85 @@ DpcDispatchDpc (
   ReturnStatus = EFI_NOT_FOUND;
 
   //
-  // Raise the TPL level to TPL_HIGH_LEVEL for DPC list operation and save the
+  // Raise the TPL level to TPL_HIGH_LEVEL for DPC queue operation and save the
   // current TPL value so it can be restored when this function returns.
   //
   OriginalTpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
 
   //
-  // Check to see if there are 1 or more DPCs currently queued
+  // Loop from TPL_HIGH_LEVEL down to the current TPL value
   //
-  if (mDpcQueueDepth > 0) {
-    //
-    // Loop from TPL_HIGH_LEVEL down to the current TPL value
-    //
-    for (Tpl = TPL_HIGH_LEVEL; Tpl >= OriginalTpl; Tpl--) {
+  for (Tpl = TPL_HIGH_LEVEL; Tpl >= OriginalTpl; Tpl--) {
+    Queue = &mDpcQueue[Tpl];
+
+    while (TRUE) {
       //
-      // Check to see if the DPC queue is empty
+      // Finish the batch being invoked at this TPL first. Otherwise take the
+      // next batch off the DPC queue.
       //
-      while (!IsListEmpty (&mDpcQueue[Tpl])) {
-        //
-        // Retrieve the first DPC entry from the DPC queue specified by Tpl
-        //
-        DpcEntry = (DPC_ENTRY *)(GetFirstNode (&mDpcQueue[Tpl]));
+      Batch = mDpcBatch[Tpl];
+      if (Batch == NULL) {
+        if (Queue->Tail == Queue->Head) {
+          break;
+        }
 
-        //
-        // Remove the first DPC entry from the DPC queue specified by Tpl
-        //
-        RemoveEntryList (&DpcEntry->ListEntry);
+        Batch        = &LocalBatch;
+        Batch->Count = 0;
+        Batch->Next  = 0;
+        while ((Queue->Tail != Queue->Head) && (Batch->Count < DPC_DISPATCH_BATCH_SIZE)) {
+          Batch->Entries[Batch->Count++] = Queue->Entries[Queue->Head & (Queue->Size - 1)];
+          Queue->Head++;
+        }
 
         //
         // Decrement the measured DPC Queue Depth across all TPLs
         //
-        mDpcQueueDepth--;
+        mDpcQueueDepth -= Batch->Count;
+        mDpcBatch[Tpl]  = Batch;
+        mDpcStatistics.Batches++;
+      }
 
-        //
-        // Lower the TPL to TPL value of the current DPC queue
-        //
-        gBS->RestoreTPL (Tpl);
+      //
+      // Lower the TPL to TPL value of the current DPC queue, and invoke the
+      // DPCs of the batch passing in their contexts. Only the callers at this
+      // TPL touch the batch, so it needs no protection.
+      //
+      gBS->RestoreTPL (Tpl);
+
+      Dispatched   = 0;
+      TotalLatency = 0;
+      MaxLatency   = 0;
+      while (Batch->Next < Batch->Count) {
+        DpcEntry = &Batch->Entries[Batch->Next++];
+
+        if (PcdGetBool (PcdDpcLatencyStatistics)) {
+          Latency       = DpcElapsedTicks (DpcEntry->QueueTime, GetPerformanceCounter ());
+          TotalLatency += Latency;
+          MaxLatency    = MAX (MaxLatency, Latency);
+        }
+
+        Dispatched++;
 
-        //
-        // Invoke the DPC passing in its context
-        //
         (DpcEntry->DpcProcedure)(DpcEntry->DpcContext);
+      }
 
-        //
-        // At least one DPC has been invoked, so set the return status to EFI_SUCCESS
-        //
-        ReturnStatus = EFI_SUCCESS;
+      //
+      // Raise the TPL level back to TPL_HIGH_LEVEL for DPC queue operations
+      //
+      gBS->RaiseTPL (TPL_HIGH_LEVEL);
 
-        //
-        // Raise the TPL level back to TPL_HIGH_LEVEL for DPC list operations
-        //
-        gBS->RaiseTPL (TPL_HIGH_LEVEL);
+      if (mDpcBatch[Tpl] == Batch) {
+        mDpcBatch[Tpl] = NULL;
+      }
 
+      if (Dispatched != 0) {
         //
-        // Add the invoked DPC entry to the DPC free list
+        // At least one DPC has been invoked, so set the return status to EFI_SUCCESS
         //
-        InsertTailList (&mDpcEntryFreeList, &DpcEntry->ListEntry);
+        ReturnStatus                 = EFI_SUCCESS;
+        mDpcStatistics.Dispatched   += Dispatched;
+        mDpcStatistics.TotalLatency += TotalLatency;
+        mDpcStatistics.MaxLatency    = MAX (mDpcStatistics.MaxLatency, MaxLatency);
       }
     }
   }
@@ -293,6 +416,49 @@ DpcDispatchDpc (
   return ReturnStatus;
 }
 
+/**
+  Retrieve the statistics of the DPC queues.
+
+  @param[in]   This              Protocol instance pointer.
+  @param[out]  Statistics        The statistics of the DPC queues.
+  @param[in]   Reset             Whether to reset the statistics after retrieving them.
+
+  @retval EFI_SUCCESS            The statistics are retrieved.
+  @retval EFI_INVALID_PARAMETER  Statistics is NULL.
+
+**/
+EFI_STATUS
+EFIAPI
+DpcGetStatistics (
+  IN  EDKII_DPC_STATISTICS_PROTOCOL  *This,
+  OUT EDKII_DPC_STATISTICS           *Statistics,
+  IN  BOOLEAN                        Reset
+  )
+{
+  EFI_TPL  OriginalTpl;
+
+  if (Statistics == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  OriginalTpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
+
+  CopyMem (Statistics, &mDpcStatistics, sizeof (EDKII_DPC_STATISTICS));
+  Statistics->MaxQueueDepth = mMaxDpcQueueDepth;
+
+  if (Reset) {
+    ZeroMem (&mDpcStatistics, sizeof (EDKII_DPC_STATISTICS));
+    mMaxDpcQueueDepth = mDpcQueueDepth;
+  }
+
+  gBS->RestoreTPL (OriginalTpl);
+
+  Statistics->TotalLatency = GetTimeInNanoSecond (Statistics->TotalLatency);
+  Statistics->MaxLatency   = GetTimeInNanoSecond (Statistics->MaxLatency);
+
+  return EFI_SUCCESS;
+}
+
 /**
   The entry point for DPC driver which installs the EFI_DPC_PROTOCOL onto a new handle.
 
@@ -312,7 +478,7 @@ DpcDriverEntryPoint (
   )
 {
   EFI_STATUS  Status;
-  UINTN       Index;
+  EFI_TPL     OriginalTpl;
 
   //
   // ASSERT() if the EFI_DPC_PROTOCOL is already present in the handle database
@@ -320,12 +486,24 @@ DpcDriverEntryPoint (
   ASSERT_PROTOCOL_ALREADY_INSTALLED (NULL, &gEfiDpcProtocolGuid);
 
   //
-  // Initialize the DPC queue for all possible TPL values
+  // Preallocate the DPC queues for the TPL levels the DPCs are queued at.
+  // The DPC queues of the other TPL levels are allocated on their first use.
   //
-  for (Index = 0; Index <= TPL_HIGH_LEVEL; Index++) {
-    InitializeListHead (&mDpcQueue[Index]);
+  OriginalTpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
+  Status      = DpcGrowQueue (&mDpcQueue[TPL_CALLBACK], OriginalTpl);
+  if (!EFI_ERROR (Status)) {
+    Status = DpcGrowQueue (&mDpcQueue[TPL_NOTIFY], OriginalTpl);
   }
 
+  gBS->RestoreTPL (OriginalTpl);
+
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  GetPerformanceCounterProperties (&mDpcCounterStart, &mDpcCounterEnd);
+  mDpcCounterCountsDown = (BOOLEAN)(mDpcCounterEnd < mDpcCounterStart);
+
   //
   // Install the EFI_DPC_PROTOCOL instance onto a new handle
   //
@@ -333,6 +511,8 @@ DpcDriverEntryPoint (
                   &mDpcHandle,
                   &gEfiDpcProtocolGuid,
                   &mDpc,
+                  &gEdkiiDpcStatisticsProtocolGuid,
+                  &mDpcStatisticsProtocol,
                   NULL
                   );
   ASSERT_EFI_ERROR (Status);
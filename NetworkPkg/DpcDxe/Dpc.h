@@ -17,22 +17,60 @@ Abstract:
 
 #include <Uefi.h>
 #include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
 #include <Library/UefiDriverEntryPoint.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/MemoryAllocationLib.h>
+#include <Library/TimerLib.h>
+#include <Library/PcdLib.h>
 #include <Protocol/Dpc.h>
+#include <Protocol/DpcStatistics.h>
 
 //
-// Internal data structure for managing DPCs.  A DPC entry is either on the free
-// list or on a DPC queue at a specific EFI_TPL.
+// The number of entries preallocated for the DPC queues of the TPL levels
+// defined by the UEFI Specification. A DPC queue is doubled when it is full.
+//
+#define DPC_QUEUE_INITIAL_SIZE  64
+
+//
+// The maximum number of DPCs taken off a DPC queue at a time for dispatch.
+//
+#define DPC_DISPATCH_BATCH_SIZE  16
+
+//
+// Internal data structure for managing DPCs.
 //
 typedef struct {
-  LIST_ENTRY           ListEntry;
   EFI_DPC_PROCEDURE    DpcProcedure;
   VOID                 *DpcContext;
+  //
+  // The performance counter when the DPC was queued.
+  //
+  UINT64               QueueTime;
 } DPC_ENTRY;
 
+//
+// A DPC queue at a specific EFI_TPL. The queue is a ring of Size entries, Size
+// being zero or a power of 2. The queued DPCs are the entries from Head to
+// Tail, the indexes counting up freely and wrapping around the ring.
+//
+typedef struct {
+  DPC_ENTRY    *Entries;
+  UINTN        Size;
+  UINTN        Head;
+  UINTN        Tail;
+} DPC_QUEUE;
+
+//
+// A batch of DPCs taken off a DPC queue, being invoked at the TPL of the queue.
+//
+typedef struct {
+  DPC_ENTRY    Entries[DPC_DISPATCH_BATCH_SIZE];
+  UINTN        Count;
+  UINTN        Next;
+} DPC_BATCH;
+
 /**
   Add a Deferred Procedure Call to the end of the DPC queue.
 
@@ -76,4 +114,23 @@ DpcDispatchDpc (
   IN EFI_DPC_PROTOCOL  *This
   );
 
+/**
+  Retrieve the statistics of the DPC queues.
+
+  @param[in]   This              Protocol instance pointer.
+  @param[out]  Statistics        The statistics of the DPC queues.
+  @param[in]   Reset             Whether to reset the statistics after retrieving them.
+
+  @retval EFI_SUCCESS            The statistics are retrieved.
+  @retval EFI_INVALID_PARAMETER  Statistics is NULL.
+
+**/
+EFI_STATUS
+EFIAPI
+DpcGetStatistics (
+  IN  EDKII_DPC_STATISTICS_PROTOCOL  *This,
+  OUT EDKII_DPC_STATISTICS           *Statistics,
+  IN  BOOLEAN                        Reset
+  );
+
 #endif
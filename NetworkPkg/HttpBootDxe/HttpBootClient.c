@@ -597,21 +597,22 @@ HttpBootHttpIoCallback (
 }
 
 /**
-  Create a HttpIo instance for the file download.
+  Create and configure a HTTP_IO to the boot file server.
 
   @param[in]    Private        The pointer to the driver's private data.
+  @param[out]   HttpIo         The HTTP_IO to create.
 
   @retval EFI_SUCCESS          Successfully created.
   @retval Others               Failed to create HttpIo.
 
 **/
 EFI_STATUS
-HttpBootCreateHttpIo (
-  IN     HTTP_BOOT_PRIVATE_DATA  *Private
+HttpBootConfigHttpIo (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  OUT    HTTP_IO                 *HttpIo
   )
 {
   HTTP_IO_CONFIG_DATA  ConfigData;
-  EFI_STATUS           Status;
   EFI_HANDLE           ImageHandle;
   UINT32               TimeoutValue;
 
@@ -636,15 +637,34 @@ HttpBootCreateHttpIo (
     ImageHandle = Private->Ip6Nic->ImageHandle;
   }
 
-  Status = HttpIoCreateIo (
-             ImageHandle,
-             Private->Controller,
-             Private->UsingIpv6 ? IP_VERSION_6 : IP_VERSION_4,
-             &ConfigData,
-             HttpBootHttpIoCallback,
-             (VOID *)Private,
-             &Private->HttpIo
-             );
+  return HttpIoCreateIo (
+           ImageHandle,
+           Private->Controller,
+           Private->UsingIpv6 ? IP_VERSION_6 : IP_VERSION_4,
+           &ConfigData,
+           HttpBootHttpIoCallback,
+           (VOID *)Private,
+           HttpIo
+           );
+}
+
+/**
+  Create a HttpIo instance for the file download.
+
+  @param[in]    Private        The pointer to the driver's private data.
+
+  @retval EFI_SUCCESS          Successfully created.
+  @retval Others               Failed to create HttpIo.
+
+**/
+EFI_STATUS
+HttpBootCreateHttpIo (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private
+  )
+{
+  EFI_STATUS  Status;
+
+  Status = HttpBootConfigHttpIo (Private, &Private->HttpIo);
   if (EFI_ERROR (Status)) {
     return Status;
   }
@@ -901,6 +921,736 @@ HttpBootGetBootFileCallback (
   return EFI_SUCCESS;
 }
 
+/**
+  Build the header of a request for the boot file. The header holds the Host,
+  Accept and User-Agent fields, and the Authorization field if the server asked
+  for it, with room for the fields the caller adds.
+
+  @param[in]   Private         The pointer to the driver's private data.
+  @param[in]   ExtraCount      The number of header fields the caller adds.
+  @param[out]  HttpIoHeader    The header built. The caller frees it with
+                               HttpIoFreeHeader().
+
+  @retval EFI_SUCCESS              The header is built.
+  @retval EFI_UNSUPPORTED          The server asked for an unsupported
+                                   authentication scheme.
+  @retval EFI_OUT_OF_RESOURCES     Could not allocate needed resources.
+  @retval Others                   Failed to build the header.
+
+**/
+EFI_STATUS
+HttpBootBuildRequestHeader (
+  IN  HTTP_BOOT_PRIVATE_DATA  *Private,
+  IN  UINTN                   ExtraCount,
+  OUT HTTP_IO_HEADER          **HttpIoHeader
+  )
+{
+  EFI_STATUS      Status;
+  HTTP_IO_HEADER  *Header;
+  CHAR8           *HostName;
+  CHAR8           *AuthValue;
+  UINTN           AuthValueSize;
+
+  if ((Private->AuthData != NULL) && (Private->AuthScheme != NULL) &&
+      (CompareMem (Private->AuthScheme, "Basic", 5) != 0))
+  {
+    return EFI_UNSUPPORTED;
+  }
+
+  Header = HttpIoCreateHeader (((Private->AuthData != NULL) ? 4 : 3) + ExtraCount);
+  if (Header == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // Add HTTP header field 1: Host
+  //
+  HostName = NULL;
+  Status   = HttpUrlGetHostName (
+               Private->BootFileUri,
+               Private->BootFileUriParser,
+               &HostName
+               );
+  if (EFI_ERROR (Status)) {
+    goto ON_ERROR;
+  }
+
+  Status = HttpIoSetHeader (
+             Header,
+             HTTP_HEADER_HOST,
+             HostName
+             );
+  FreePool (HostName);
+  if (EFI_ERROR (Status)) {
+    goto ON_ERROR;
+  }
+
+  //
+  // Add HTTP header field 2: Accept
+  //
+  Status = HttpIoSetHeader (
+             Header,
+             HTTP_HEADER_ACCEPT,
+             "*/*"
+             );
+  if (EFI_ERROR (Status)) {
+    goto ON_ERROR;
+  }
+
+  //
+  // Add HTTP header field 3: User-Agent
+  //
+  Status = HttpIoSetHeader (
+             Header,
+             HTTP_HEADER_USER_AGENT,
+             HTTP_USER_AGENT_EFI_HTTP_BOOT
+             );
+  if (EFI_ERROR (Status)) {
+    goto ON_ERROR;
+  }
+
+  //
+  // Add HTTP header field 4: Authorization
+  //
+  if (Private->AuthData != NULL) {
+    AuthValueSize = AsciiStrSize ("Basic ") + AsciiStrLen (Private->AuthData);
+    AuthValue     = AllocatePool (AuthValueSize);
+    if (AuthValue == NULL) {
+      Status = EFI_OUT_OF_RESOURCES;
+      goto ON_ERROR;
+    }
+
+    AsciiSPrint (AuthValue, AuthValueSize, "%a %a", "Basic", Private->AuthData);
+    Status = HttpIoSetHeader (
+               Header,
+               HTTP_HEADER_AUTHORIZATION,
+               AuthValue
+               );
+    FreePool (AuthValue);
+    if (EFI_ERROR (Status)) {
+      goto ON_ERROR;
+    }
+  }
+
+  *HttpIoHeader = Header;
+  return EFI_SUCCESS;
+
+ON_ERROR:
+  HttpIoFreeHeader (Header);
+  return Status;
+}
+
+/**
+  Send the Range request for the rest of the part of the boot file assigned
+  to a connection, creating the HTTP_IO of the connection first if needed.
+
+  @param[in]       Private         The pointer to the driver's private data.
+  @param[in, out]  Connection      The connection to send the request on.
+  @param[in]       Url             The URL of the boot file.
+
+  @retval EFI_SUCCESS              The request is sent.
+  @retval Others                   Failed to send the request.
+
+**/
+EFI_STATUS
+HttpBootRangeSendRequest (
+  IN     HTTP_BOOT_PRIVATE_DATA      *Private,
+  IN OUT HTTP_BOOT_RANGE_CONNECTION  *Connection,
+  IN     CHAR16                      *Url
+  )
+{
+  EFI_STATUS      Status;
+  HTTP_IO_HEADER  *HttpIoHeader;
+  CHAR8           RangeValue[HTTP_BOOT_RANGE_VALUE_LEN];
+
+  if (!Connection->Created) {
+    Status = HttpBootConfigHttpIo (Private, &Connection->HttpIo);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    Connection->Created = TRUE;
+  }
+
+  //
+  // The same header as HttpBootGetBootFile(), plus the Range.
+  //
+  Status = HttpBootBuildRequestHeader (Private, 1, &HttpIoHeader);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  AsciiSPrint (
+    RangeValue,
+    sizeof (RangeValue),
+    "%a=%Lu-%Lu",
+    HTTP_ACCEPT_RANGES_BYTES,
+    (UINT64)Connection->Start,
+    (UINT64)(Connection->End - 1)
+    );
+  Status = HttpIoSetHeader (HttpIoHeader, HTTP_HEADER_RANGE, RangeValue);
+  if (EFI_ERROR (Status)) {
+    goto ON_EXIT;
+  }
+
+  Connection->RequestData.Method = HttpMethodGet;
+  Connection->RequestData.Url    = Url;
+  Status                         = HttpIoSendRequest (
+                                     &Connection->HttpIo,
+                                     &Connection->RequestData,
+                                     HttpIoHeader->HeaderCount,
+                                     HttpIoHeader->Headers,
+                                     0,
+                                     NULL
+                                     );
+
+ON_EXIT:
+  HttpIoFreeHeader (HttpIoHeader);
+  return Status;
+}
+
+/**
+  Check that the server sends exactly the requested part of the boot file in
+  the response header of a Range request, and free the header.
+
+  @param[in]       Connection      The connection the response is received on.
+  @param[in, out]  ResponseData    The response header received.
+
+  @retval EFI_SUCCESS              The server sends the requested part.
+  @retval EFI_UNSUPPORTED          The server doesn't send the requested part.
+  @retval Others                   The response reports an error.
+
+**/
+EFI_STATUS
+HttpBootRangeCheckHeader (
+  IN     HTTP_BOOT_RANGE_CONNECTION  *Connection,
+  IN OUT HTTP_IO_RESPONSE_DATA       *ResponseData
+  )
+{
+  EFI_STATUS       Status;
+  EFI_HTTP_HEADER  *HttpHeader;
+  UINTN            ContentLength;
+  CHAR8            ContentRange[HTTP_BOOT_RANGE_VALUE_LEN];
+
+  if (EFI_ERROR (ResponseData->Status)) {
+    Status = (ResponseData->Status == EFI_HTTP_ERROR) ? EFI_UNSUPPORTED : ResponseData->Status;
+    goto ON_EXIT;
+  }
+
+  //
+  // A server may ignore the Range and send the whole file with status 200.
+  //
+  Status = EFI_UNSUPPORTED;
+  if (ResponseData->Response.StatusCode != HTTP_STATUS_206_PARTIAL_CONTENT) {
+    goto ON_EXIT;
+  }
+
+  if (EFI_ERROR (HttpIoGetContentLength (ResponseData->HeaderCount, ResponseData->Headers, &ContentLength)) ||
+      (ContentLength != Connection->End - Connection->Start))
+  {
+    goto ON_EXIT;
+  }
+
+  AsciiSPrint (
+    ContentRange,
+    sizeof (ContentRange),
+    "%a %Lu-%Lu/",
+    HTTP_ACCEPT_RANGES_BYTES,
+    (UINT64)Connection->Start,
+    (UINT64)(Connection->End - 1)
+    );
+  HttpHeader = HttpFindHeader (ResponseData->HeaderCount, ResponseData->Headers, HTTP_HEADER_CONTENT_RANGE);
+  if ((HttpHeader == NULL) ||
+      (AsciiStrnCmp (HttpHeader->FieldValue, ContentRange, AsciiStrLen (ContentRange)) != 0))
+  {
+    goto ON_EXIT;
+  }
+
+  Status = EFI_SUCCESS;
+
+ON_EXIT:
+  if (ResponseData->Headers != NULL) {
+    HttpFreeHeaderFields (ResponseData->Headers, ResponseData->HeaderCount);
+    ResponseData->Headers = NULL;
+  }
+
+  return Status;
+}
+
+/**
+  Receive the response header of a Range request, and check that the server
+  sends exactly the requested part of the boot file.
+
+  @param[in, out]  Connection      The connection to receive the response on.
+
+  @retval EFI_SUCCESS              The server sends the requested part.
+  @retval EFI_UNSUPPORTED          The server doesn't send the requested part.
+  @retval Others                   Failed to receive the response header.
+
+**/
+EFI_STATUS
+HttpBootRangeRecvHeader (
+  IN OUT HTTP_BOOT_RANGE_CONNECTION  *Connection
+  )
+{
+  EFI_STATUS             Status;
+  HTTP_IO_RESPONSE_DATA  ResponseData;
+
+  ZeroMem (&ResponseData, sizeof (HTTP_IO_RESPONSE_DATA));
+  Status = HttpIoRecvResponse (&Connection->HttpIo, TRUE, &ResponseData);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  return HttpBootRangeCheckHeader (Connection, &ResponseData);
+}
+
+/**
+  Download the boot file with several Range requests, each one on its own
+  connection, directly into the caller's buffer.
+
+  The requests are in flight at the same time, so the throughput is not
+  bounded by the window of a single TCP connection. A part of the file which
+  fails to download is resumed from the last byte received.
+
+  @param[in]       Private         The pointer to the driver's private data.
+  @param[in]       Url             The URL of the boot file.
+  @param[in]       FileSize        The size of the boot file.
+  @param[out]      Buffer          The memory buffer to transfer the file to.
+
+  @retval EFI_SUCCESS              The file was loaded.
+  @retval EFI_UNSUPPORTED          The server doesn't send the requested ranges, the file
+                                   has to be downloaded with a single request.
+  @retval EFI_OUT_OF_RESOURCES     Could not allocate needed resources.
+  @retval Others                   Unexpected error happened.
+
+**/
+EFI_STATUS
+HttpBootGetBootFileByRanges (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  IN     CHAR16                  *Url,
+  IN     UINTN                   FileSize,
+  OUT UINT8                      *Buffer
+  )
+{
+  EFI_STATUS                  Status;
+  HTTP_BOOT_RANGE_CONNECTION  *Connections;
+  HTTP_BOOT_RANGE_CONNECTION  *Connection;
+  HTTP_IO_RESPONSE_DATA       ResponseBody;
+  UINTN                       Count;
+  UINTN                       Index;
+  UINTN                       Next;
+  UINTN                       ReceivedSize;
+
+  //
+  // No more connections than parts of the file.
+  //
+  Count = MIN (
+            PcdGet8 (PcdHttpBootRangeConnections),
+            (FileSize + HTTP_BOOT_RANGE_SIZE - 1) / HTTP_BOOT_RANGE_SIZE
+            );
+  if (Count == 0) {
+    return EFI_UNSUPPORTED;
+  }
+
+  Connections = AllocateZeroPool (Count * sizeof (HTTP_BOOT_RANGE_CONNECTION));
+  if (Connections == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // Visit the connections in turn. All the requests are sent before any
+  // response is waited for, and while one connection is being read, the
+  // others keep receiving into their TCP buffers.
+  //
+  Status       = EFI_SUCCESS;
+  Next         = 0;
+  ReceivedSize = 0;
+  while (!EFI_ERROR (Status) && (ReceivedSize < FileSize)) {
+    for (Index = 0; (Index < Count) && !EFI_ERROR (Status); Index++) {
+      Connection = &Connections[Index];
+
+      switch (Connection->State) {
+        case HttpBootRangeIdle:
+          if (Connection->Start == Connection->End) {
+            //
+            // Assign the next part of the file to the connection.
+            //
+            if (Next == FileSize) {
+              break;
+            }
+
+            Connection->Start   = Next;
+            Connection->End     = MIN (Next + HTTP_BOOT_RANGE_SIZE, FileSize);
+            Connection->Retries = 0;
+            Next                = Connection->End;
+          }
+
+          Status = HttpBootRangeSendRequest (Private, Connection, Url);
+          if (!EFI_ERROR (Status)) {
+            Connection->State = HttpBootRangeRequested;
+          }
+
+          break;
+
+        case HttpBootRangeRequested:
+          Status = HttpBootRangeRecvHeader (Connection);
+          if (!EFI_ERROR (Status)) {
+            Connection->State = HttpBootRangeReceiving;
+          }
+
+          break;
+
+        case HttpBootRangeReceiving:
+          ZeroMem (&ResponseBody, sizeof (HTTP_IO_RESPONSE_DATA));
+          ResponseBody.Body       = (CHAR8 *)Buffer + Connection->Start;
+          ResponseBody.BodyLength = Connection->End - Connection->Start;
+          Status                  = HttpIoRecvResponse (
+                                      &Connection->HttpIo,
+                                      FALSE,
+                                      &ResponseBody
+                                      );
+          if (!EFI_ERROR (Status) && EFI_ERROR (ResponseBody.Status)) {
+            Status = ResponseBody.Status;
+          }
+
+          if (EFI_ERROR (Status)) {
+            break;
+          }
+
+          Connection->Start += ResponseBody.BodyLength;
+          ReceivedSize      += ResponseBody.BodyLength;
+          if (Connection->Start == Connection->End) {
+            Connection->State = HttpBootRangeIdle;
+          }
+
+          if (Private->HttpBootCallback != NULL) {
+            Status = Private->HttpBootCallback->Callback (
+                                                  Private->HttpBootCallback,
+                                                  HttpBootHttpEntityBody,
+                                                  TRUE,
+                                                  (UINT32)ResponseBody.BodyLength,
+                                                  ResponseBody.Body
+                                                  );
+            if (EFI_ERROR (Status)) {
+              goto ON_EXIT;
+            }
+          }
+
+          break;
+
+        default:
+          ASSERT (FALSE);
+          break;
+      }
+
+      if (EFI_ERROR (Status) && (Status != EFI_UNSUPPORTED) &&
+          (Status != EFI_OUT_OF_RESOURCES) &&
+          (Connection->Retries < HTTP_BOOT_RANGE_MAX_RETRY))
+      {
+        //
+        // Drop the connection, the rest of its part is requested again on a
+        // new one.
+        //
+        DEBUG ((
+          DEBUG_WARN,
+          "HttpBootGetBootFileByRanges: resume from byte %Lu after %r.\n",
+          (UINT64)Connection->Start,
+          Status
+          ));
+        HttpIoDestroyIo (&Connection->HttpIo);
+        Connection->Created = FALSE;
+        Connection->State   = HttpBootRangeIdle;
+        Connection->Retries++;
+        Status = EFI_SUCCESS;
+      }
+    }
+  }
+
+ON_EXIT:
+  for (Index = 0; Index < Count; Index++) {
+    if (Connections[Index].Created) {
+      HttpIoDestroyIo (&Connections[Index].HttpIo);
+    }
+  }
+
+  FreePool (Connections);
+  return Status;
+}
+
+/**
+  Prepare to stream the boot file into a sparse RAM disk instead of
+  downloading it.
+
+  @param[in]       Private         The pointer to the driver's private data.
+
+  @retval EFI_SUCCESS              The boot file can be streamed.
+  @retval EFI_NOT_FOUND            No sparse RAM disk protocol instance was found.
+  @retval EFI_OUT_OF_RESOURCES     Could not allocate needed resources.
+
+**/
+EFI_STATUS
+HttpBootStartRamDiskStream (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private
+  )
+{
+  EFI_STATUS  Status;
+  VOID        *SparseRamDisk;
+  UINTN       UrlSize;
+
+  ASSERT (!Private->RamDiskStreaming);
+
+  Status = gBS->LocateProtocol (&gEdkiiSparseRamDiskProtocolGuid, NULL, &SparseRamDisk);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  UrlSize             = AsciiStrSize (Private->BootFileUri);
+  Private->RamDiskUrl = AllocatePool (UrlSize * sizeof (CHAR16));
+  if (Private->RamDiskUrl == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  AsciiStrToUnicodeStrS (Private->BootFileUri, Private->RamDiskUrl, UrlSize);
+  ZeroMem (&Private->RamDiskConnection, sizeof (HTTP_BOOT_RANGE_CONNECTION));
+  Private->RamDiskStreaming = TRUE;
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Release the resources used to stream the boot file into a sparse RAM disk.
+
+  @param[in]       Private         The pointer to the driver's private data.
+
+**/
+VOID
+HttpBootStopRamDiskStream (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private
+  )
+{
+  if (Private->RamDiskConnection.Created) {
+    HttpIoDestroyIo (&Private->RamDiskConnection.HttpIo);
+    Private->RamDiskConnection.Created = FALSE;
+  }
+
+  if (Private->RamDiskUrl != NULL) {
+    FreePool (Private->RamDiskUrl);
+    Private->RamDiskUrl = NULL;
+  }
+
+  Private->RamDiskFilling   = FALSE;
+  Private->RamDiskStreaming = FALSE;
+}
+
+/**
+  Go on downloading a part of the boot file streamed into a sparse RAM disk,
+  without waiting for the network.
+
+  @param[in]       Private         The pointer to the driver's private data.
+  @param[in]       Offset          The offset of the part in the boot file.
+  @param[out]      Buffer          The memory buffer to transfer the part to.
+
+  @retval EFI_SUCCESS              The part was downloaded.
+  @retval EFI_NOT_READY            The part is still being downloaded.
+  @retval Others                   The request failed.
+
+**/
+EFI_STATUS
+HttpBootFillRamDiskStep (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  IN     UINT64                  Offset,
+  OUT    VOID                    *Buffer
+  )
+{
+  EFI_STATUS                  Status;
+  HTTP_BOOT_RANGE_CONNECTION  *Connection;
+  HTTP_IO_RESPONSE_DATA       *Response;
+
+  Connection = &Private->RamDiskConnection;
+  Response   = &Private->RamDiskResponse;
+
+  switch (Connection->State) {
+    case HttpBootRangeIdle:
+      Status = HttpBootRangeSendRequest (Private, Connection, Private->RamDiskUrl);
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+
+      ZeroMem (Response, sizeof (HTTP_IO_RESPONSE_DATA));
+      Status = HttpIoStartResponse (&Connection->HttpIo, TRUE, Response);
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+
+      Connection->State = HttpBootRangeRequested;
+      return EFI_NOT_READY;
+
+    case HttpBootRangeRequested:
+      Status = HttpIoPollResponse (&Connection->HttpIo, Response);
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+
+      Status = HttpBootRangeCheckHeader (Connection, Response);
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+
+      Connection->State = HttpBootRangeReceiving;
+      break;
+
+    default:
+      Status = HttpIoPollResponse (&Connection->HttpIo, Response);
+      if (!EFI_ERROR (Status) && EFI_ERROR (Response->Status)) {
+        Status = Response->Status;
+      }
+
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+
+      Connection->Start += Response->BodyLength;
+      if (Connection->Start == Connection->End) {
+        Connection->State = HttpBootRangeIdle;
+        return EFI_SUCCESS;
+      }
+
+      break;
+  }
+
+  //
+  // Receive the rest of the message-body.
+  //
+  ZeroMem (Response, sizeof (HTTP_IO_RESPONSE_DATA));
+  Response->Body       = (CHAR8 *)Buffer + (Connection->Start - (UINTN)Offset);
+  Response->BodyLength = Connection->End - Connection->Start;
+  Status               = HttpIoStartResponse (&Connection->HttpIo, FALSE, Response);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  return EFI_NOT_READY;
+}
+
+/**
+  Download a part of the boot file streamed into a sparse RAM disk, with a
+  Range request.
+
+  The connection is kept open for the next part, and a part which fails to
+  download is resumed on a new connection from the last byte received. When
+  Wait is FALSE, each call either sends the request or checks once for the
+  response, without waiting for the network.
+
+  @param[in]       Context         The pointer to the driver's private data.
+  @param[in]       Offset          The offset of the part in the boot file.
+  @param[in]       Length          The size of the part in bytes.
+  @param[out]      Buffer          The memory buffer to transfer the part to.
+  @param[in]       Wait            Whether to wait until the part is downloaded.
+
+  @retval EFI_SUCCESS              The part was downloaded.
+  @retval EFI_NOT_READY            Wait is FALSE, and the part is still being
+                                   downloaded.
+  @retval Others                   The part could not be downloaded.
+
+**/
+EFI_STATUS
+EFIAPI
+HttpBootFillRamDisk (
+  IN     VOID     *Context,
+  IN     UINT64   Offset,
+  IN     UINTN    Length,
+  OUT    VOID     *Buffer,
+  IN     BOOLEAN  Wait
+  )
+{
+  EFI_STATUS                  Status;
+  HTTP_BOOT_PRIVATE_DATA      *Private;
+  HTTP_BOOT_RANGE_CONNECTION  *Connection;
+
+  Private    = (HTTP_BOOT_PRIVATE_DATA *)Context;
+  Connection = &Private->RamDiskConnection;
+  if (!Private->RamDiskStreaming) {
+    return EFI_ABORTED;
+  }
+
+  //
+  // The sparse RAM disk asks for the same part until it is downloaded.
+  //
+  if (!Private->RamDiskFilling) {
+    Connection->Start       = (UINTN)Offset;
+    Connection->End         = (UINTN)Offset + Length;
+    Connection->State       = HttpBootRangeIdle;
+    Connection->Retries     = 0;
+    Private->RamDiskFilling = TRUE;
+  }
+
+  do {
+    Status = HttpBootFillRamDiskStep (Private, Offset, Buffer);
+    if (EFI_ERROR (Status) && (Status != EFI_NOT_READY)) {
+      if ((Status == EFI_UNSUPPORTED) || (Status == EFI_OUT_OF_RESOURCES) ||
+          (Connection->Retries >= HTTP_BOOT_RANGE_MAX_RETRY))
+      {
+        break;
+      }
+
+      DEBUG ((
+        DEBUG_WARN,
+        "HttpBootFillRamDisk: resume from byte %Lu after %r.\n",
+        (UINT64)Connection->Start,
+        Status
+        ));
+      HttpIoDestroyIo (&Connection->HttpIo);
+      Connection->Created = FALSE;
+      Connection->State   = HttpBootRangeIdle;
+      Connection->Retries++;
+      Status = EFI_NOT_READY;
+    }
+  } while (Wait && (Status == EFI_NOT_READY));
+
+  if (Status != EFI_NOT_READY) {
+    Private->RamDiskFilling = FALSE;
+  }
+
+  return Status;
+}
+
+/**
+  Stop the HTTP Boot service once the boot file streamed into a sparse RAM
+  disk is not needed any more.
+
+  @param[in]       Context         The pointer to the driver's private data.
+  @param[in]       Status          Whether the whole boot file was downloaded.
+
+**/
+VOID
+EFIAPI
+HttpBootCompleteRamDisk (
+  IN     VOID        *Context,
+  IN     EFI_STATUS  Status
+  )
+{
+  HTTP_BOOT_PRIVATE_DATA  *Private;
+
+  Private = (HTTP_BOOT_PRIVATE_DATA *)Context;
+
+  DEBUG ((
+    EFI_ERROR (Status) ? DEBUG_ERROR : DEBUG_INFO,
+    "HTTP Boot: RAM disk stream completed - %r\n",
+    Status
+    ));
+
+  //
+  // The RAM disk is unregistered, so the boot from it fails.
+  //
+  if (EFI_ERROR (Status) && (Status != EFI_ABORTED)) {
+    AsciiPrint ("\n  Error: Could not download the RAM disk image - %r.\n", Status);
+  }
+
+  HttpBootStopRamDiskStream (Private);
+  HttpBootStop (Private);
+}
+
 /**
   This function download the boot file by using UEFI HTTP protocol.
 
@@ -937,7 +1687,6 @@ HttpBootGetBootFile (
 {
   EFI_STATUS               Status;
   EFI_HTTP_STATUS_CODE     StatusCode;
-  CHAR8                    *HostName;
   EFI_HTTP_REQUEST_DATA    *RequestData;
   HTTP_IO_RESPONSE_DATA    *ResponseData;
   HTTP_IO_RESPONSE_DATA    ResponseBody;
@@ -952,7 +1701,6 @@ HttpBootGetBootFile (
   CHAR16                   *Url;
   BOOLEAN                  IdentityMode;
   UINTN                    ReceivedSize;
-  CHAR8                    BaseAuthValue[80];
   EFI_HTTP_HEADER          *HttpHeader;
   CHAR8                    *Data;
 
@@ -985,6 +1733,28 @@ HttpBootGetBootFile (
     }
   }
 
+  //
+  // Download a boot file bigger than one Range in parts if the server
+  // accepts the Range requests, so that the parts arrive in parallel.
+  //
+  if (!HeaderOnly && (Buffer != NULL) && Private->AcceptRanges &&
+      (Private->BootFileSize > HTTP_BOOT_RANGE_SIZE) &&
+      (*BufferSize >= Private->BootFileSize))
+  {
+    Status = HttpBootGetBootFileByRanges (Private, Url, Private->BootFileSize, Buffer);
+    if (Status != EFI_UNSUPPORTED) {
+      if (!EFI_ERROR (Status)) {
+        *BufferSize = Private->BootFileSize;
+        *ImageType  = Private->ImageType;
+      }
+
+      FreePool (Url);
+      return Status;
+    }
+
+    Private->AcceptRanges = FALSE;
+  }
+
   //
   // Not found in cache, try to download it through HTTP.
   //
@@ -1015,86 +1785,9 @@ HttpBootGetBootFile (
   //       User-Agent
   //       [Authorization]
   //
-  HttpIoHeader = HttpIoCreateHeader ((Private->AuthData != NULL) ? 4 : 3);
-  if (HttpIoHeader == NULL) {
-    Status = EFI_OUT_OF_RESOURCES;
-    goto ERROR_2;
-  }
-
-  //
-  // Add HTTP header field 1: Host
-  //
-  HostName = NULL;
-  Status   = HttpUrlGetHostName (
-               Private->BootFileUri,
-               Private->BootFileUriParser,
-               &HostName
-               );
+  Status = HttpBootBuildRequestHeader (Private, 0, &HttpIoHeader);
   if (EFI_ERROR (Status)) {
-    goto ERROR_3;
-  }
-
-  Status = HttpIoSetHeader (
-             HttpIoHeader,
-             HTTP_HEADER_HOST,
-             HostName
-             );
-  FreePool (HostName);
-  if (EFI_ERROR (Status)) {
-    goto ERROR_3;
-  }
-
-  //
-  // Add HTTP header field 2: Accept
-  //
-  Status = HttpIoSetHeader (
-             HttpIoHeader,
-             HTTP_HEADER_ACCEPT,
-             "*/*"
-             );
-  if (EFI_ERROR (Status)) {
-    goto ERROR_3;
-  }
-
-  //
-  // Add HTTP header field 3: User-Agent
-  //
-  Status = HttpIoSetHeader (
-             HttpIoHeader,
-             HTTP_HEADER_USER_AGENT,
-             HTTP_USER_AGENT_EFI_HTTP_BOOT
-             );
-  if (EFI_ERROR (Status)) {
-    goto ERROR_3;
-  }
-
-  //
-  // Add HTTP header field 4: Authorization
-  //
-  if (Private->AuthData != NULL) {
-    ASSERT (HttpIoHeader->MaxHeaderCount == 4);
-
-    if ((Private->AuthScheme != NULL) && (CompareMem (Private->AuthScheme, "Basic", 5) != 0)) {
-      Status = EFI_UNSUPPORTED;
-      goto ERROR_3;
-    }
-
-    AsciiSPrint (
-      BaseAuthValue,
-      sizeof (BaseAuthValue),
-      "%a %a",
-      "Basic",
-      Private->AuthData
-      );
-
-    Status = HttpIoSetHeader (
-               HttpIoHeader,
-               HTTP_HEADER_AUTHORIZATION,
-               BaseAuthValue
-               );
-    if (EFI_ERROR (Status)) {
-      goto ERROR_3;
-    }
+    goto ERROR_2;
   }
 
   //
@@ -1237,6 +1930,19 @@ HttpBootGetBootFile (
     goto ERROR_5;
   }
 
+  //
+  // Remember whether the server accepts the Range requests for the file.
+  //
+  if (HeaderOnly) {
+    HttpHeader = HttpFindHeader (
+                   ResponseData->HeaderCount,
+                   ResponseData->Headers,
+                   HTTP_HEADER_ACCEPT_RANGES
+                   );
+    Private->AcceptRanges = (BOOLEAN)((HttpHeader != NULL) &&
+                                      (AsciiStrStr (HttpHeader->FieldValue, HTTP_ACCEPT_RANGES_BYTES) != NULL));
+  }
+
   //
   // 3.2 Cache the response header.
   //
@@ -14,6 +14,20 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define HTTP_USER_AGENT_EFI_HTTP_BOOT          "UefiHttpBoot/1.0"
 #define HTTP_BOOT_AUTHENTICATION_INFO_MAX_LEN  255
 
+//
+// Size of the part of the boot file each Range request fetches, and the
+// number of times a part is resumed after a failure.
+//
+#define HTTP_BOOT_RANGE_SIZE       SIZE_4MB
+#define HTTP_BOOT_RANGE_MAX_RETRY  3
+#define HTTP_BOOT_RANGE_VALUE_LEN  48
+
+//
+// Size of the parts a streamed RAM disk image is downloaded in, each one when
+// it is first read or in the background.
+//
+#define HTTP_BOOT_RAM_DISK_CHUNK_SIZE  SIZE_1MB
+
 //
 // Record the data length and start address of a data block.
 //
@@ -58,6 +72,25 @@ typedef struct {
   HTTP_BOOT_PRIVATE_DATA     *Private;
 } HTTP_BOOT_CALLBACK_DATA;
 
+//
+// State of a connection downloading the boot file with Range requests.
+//
+typedef enum {
+  HttpBootRangeIdle,                          // No request is outstanding.
+  HttpBootRangeRequested,                     // Waiting for the response header.
+  HttpBootRangeReceiving                      // Receiving the message-body.
+} HTTP_BOOT_RANGE_STATE;
+
+typedef struct {
+  HTTP_IO                  HttpIo;
+  BOOLEAN                  Created;
+  HTTP_BOOT_RANGE_STATE    State;
+  EFI_HTTP_REQUEST_DATA    RequestData;
+  UINTN                    Start;             // Next byte of the part to receive.
+  UINTN                    End;               // One past the last byte of the part.
+  UINTN                    Retries;
+} HTTP_BOOT_RANGE_CONNECTION;
+
 /**
   Discover all the boot information for boot file.
 
@@ -86,6 +119,118 @@ HttpBootCreateHttpIo (
   IN     HTTP_BOOT_PRIVATE_DATA  *Private
   );
 
+/**
+  Create and configure a HTTP_IO to the boot file server.
+
+  @param[in]    Private        The pointer to the driver's private data.
+  @param[out]   HttpIo         The HTTP_IO to create.
+
+  @retval EFI_SUCCESS          Successfully created.
+  @retval Others               Failed to create HttpIo.
+
+**/
+EFI_STATUS
+HttpBootConfigHttpIo (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  OUT    HTTP_IO                 *HttpIo
+  );
+
+/**
+  Download the boot file with several Range requests, each one on its own
+  connection, directly into the caller's buffer.
+
+  The requests are in flight at the same time, so the throughput is not
+  bounded by the window of a single TCP connection. A part of the file which
+  fails to download is resumed from the last byte received.
+
+  @param[in]       Private         The pointer to the driver's private data.
+  @param[in]       Url             The URL of the boot file.
+  @param[in]       FileSize        The size of the boot file.
+  @param[out]      Buffer          The memory buffer to transfer the file to.
+
+  @retval EFI_SUCCESS              The file was loaded.
+  @retval EFI_UNSUPPORTED          The server doesn't send the requested ranges, the file
+                                   has to be downloaded with a single request.
+  @retval EFI_OUT_OF_RESOURCES     Could not allocate needed resources.
+  @retval Others                   Unexpected error happened.
+
+**/
+EFI_STATUS
+HttpBootGetBootFileByRanges (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  IN     CHAR16                  *Url,
+  IN     UINTN                   FileSize,
+  OUT UINT8                      *Buffer
+  );
+
+/**
+  Prepare to stream the boot file into a sparse RAM disk instead of
+  downloading it.
+
+  @param[in]       Private         The pointer to the driver's private data.
+
+  @retval EFI_SUCCESS              The boot file can be streamed.
+  @retval EFI_NOT_FOUND            No sparse RAM disk protocol instance was found.
+  @retval EFI_OUT_OF_RESOURCES     Could not allocate needed resources.
+
+**/
+EFI_STATUS
+HttpBootStartRamDiskStream (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private
+  );
+
+/**
+  Release the resources used to stream the boot file into a sparse RAM disk.
+
+  @param[in]       Private         The pointer to the driver's private data.
+
+**/
+VOID
+HttpBootStopRamDiskStream (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private
+  );
+
+/**
+  Download a part of the boot file streamed into a sparse RAM disk, with a
+  Range request.
+
+  @param[in]       Context         The pointer to the driver's private data.
+  @param[in]       Offset          The offset of the part in the boot file.
+  @param[in]       Length          The size of the part in bytes.
+  @param[out]      Buffer          The memory buffer to transfer the part to.
+  @param[in]       Wait            Whether to wait until the part is downloaded.
+
+  @retval EFI_SUCCESS              The part was downloaded.
+  @retval EFI_NOT_READY            Wait is FALSE, and the part is still being
+                                   downloaded.
+  @retval Others                   The part could not be downloaded.
+
+**/
+EFI_STATUS
+EFIAPI
+HttpBootFillRamDisk (
+  IN     VOID     *Context,
+  IN     UINT64   Offset,
+  IN     UINTN    Length,
+  OUT    VOID     *Buffer,
+  IN     BOOLEAN  Wait
+  );
+
+/**
+  Stop the HTTP Boot service once the boot file streamed into a sparse RAM
+  disk is not needed any more.
+
+  @param[in]       Context         The pointer to the driver's private data.
+  @param[in]       Status          Whether the whole boot file was downloaded.
+
+**/
+VOID
+EFIAPI
+HttpBootCompleteRamDisk (
+  IN     VOID        *Context,
+  IN     EFI_STATUS  Status
+  );
+
 /**
   This function download the boot file by using UEFI HTTP protocol.
 
@@ -669,6 +669,30 @@ HttpBootDhcp4CallBack (
 
       break;
 
+    case Dhcp4RcvdAck:
+      if (Private->OfferNum != 0) {
+        break;
+      }
+
+      //
+      // No offer is received in the INIT-REBOOT state, so the boot information
+      // has to be taken from the ACK. Abort and fall back to the D.O.R.A process
+      // if the ACK does not have it.
+      //
+      Status = EFI_ABORTED;
+      if (Packet->Length > HTTP_BOOT_DHCP4_PACKET_MAX_SIZE) {
+        break;
+      }
+
+      if (!EFI_ERROR (HttpBootCacheDhcp4Offer (Private, Packet))) {
+        HttpBootSelectDhcpOffer (Private);
+        if (Private->SelectIndex != 0) {
+          Status = EFI_SUCCESS;
+        }
+      }
+
+      break;
+
     default:
       break;
   }
@@ -796,6 +820,357 @@ HttpBootSetIp4Policy (
   return EFI_SUCCESS;
 }
 
+/**
+  Check a DHCPOFFER received by the DHCPv4 discovery run on a network interface
+  during the race.
+
+  @param[in]  Context           Pointer to the HTTP_BOOT_DHCP4_PROBE of the interface.
+  @param[in]  Packet            The DHCPOFFER packet received.
+
+  @retval TRUE                  The offer lets the interface find its boot URI.
+  @retval FALSE                 Wait for more DHCPOFFER packets.
+
+**/
+BOOLEAN
+EFIAPI
+HttpBootDhcp4ProbeOffer (
+  IN VOID              *Context,
+  IN EFI_DHCP4_PACKET  *Packet
+  )
+{
+  HTTP_BOOT_DHCP4_PROBE  *Probe;
+
+  Probe = (HTTP_BOOT_DHCP4_PROBE *)Context;
+
+  if ((Packet->Length > HTTP_BOOT_DHCP4_PACKET_MAX_SIZE) ||
+      EFI_ERROR (HttpBootCacheDhcp4Packet (&Probe->Cache.Packet.Offer, Packet)) ||
+      EFI_ERROR (HttpBootParseDhcp4Packet (&Probe->Cache)))
+  {
+    return FALSE;
+  }
+
+  if (Probe->Cache.UriParser != NULL) {
+    FreePool (Probe->Cache.UriParser);
+    Probe->Cache.UriParser = NULL;
+  }
+
+  //
+  // An offer without a boot URI only helps when the boot option has one.
+  //
+  if ((Probe->Cache.OfferType != HttpOfferTypeDhcpOnly) &&
+      (Probe->Cache.OfferType != HttpOfferTypeDhcpDns))
+  {
+    return TRUE;
+  }
+
+  return Probe->HasFilePathUri;
+}
+
+/**
+  Race the DHCPv4 discovery on all the network interfaces managed by this driver
+  which have not taken part in a race yet, and record the winner and the losers
+  in their RaceState.
+
+  @param[in]  Private           Pointer to HTTP boot driver private data of the
+                                interface asked to boot.
+
+**/
+VOID
+HttpBootDhcp4Race (
+  IN HTTP_BOOT_PRIVATE_DATA  *Private
+  )
+{
+  EFI_STATUS              Status;
+  EFI_HANDLE              *Handles;
+  UINTN                   HandleCount;
+  UINTN                   Index;
+  UINT32                  *Id;
+  HTTP_BOOT_PRIVATE_DATA  *Candidate;
+  NET_DHCP4_PROBE         *Probes;
+  HTTP_BOOT_DHCP4_PROBE   *Contexts;
+  HTTP_BOOT_DHCP4_PROBE   *Context;
+  UINTN                   ProbeCount;
+  UINTN                   Winner;
+
+  Status = gBS->LocateHandleBuffer (ByProtocol, &gEfiCallerIdGuid, NULL, &HandleCount, &Handles);
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  Probes   = AllocateZeroPool (HandleCount * sizeof (NET_DHCP4_PROBE));
+  Contexts = AllocateZeroPool (HandleCount * sizeof (HTTP_BOOT_DHCP4_PROBE));
+  if ((Probes == NULL) || (Contexts == NULL)) {
+    goto ON_EXIT;
+  }
+
+  //
+  // Set up a discovery on every idle interface.
+  //
+  ProbeCount = 0;
+  for (Index = 0; Index < HandleCount; Index++) {
+    Status = gBS->HandleProtocol (Handles[Index], &gEfiCallerIdGuid, (VOID **)&Id);
+    if (EFI_ERROR (Status)) {
+      continue;
+    }
+
+    Candidate = HTTP_BOOT_PRIVATE_DATA_FROM_ID (Id);
+    if ((Candidate->Ip4Nic == NULL) || (Candidate->Dhcp4 == NULL) ||
+        (Candidate->RaceState != HttpBootRaceNone) ||
+        ((Candidate != Private) && Candidate->Started))
+    {
+      continue;
+    }
+
+    //
+    // Only the interface asked to boot knows the URI of its boot option. The
+    // FilePathUri of the others is left from an earlier boot attempt, if any.
+    //
+    Context                          = &Contexts[ProbeCount];
+    Context->Private                 = Candidate;
+    Context->HasFilePathUri          = (BOOLEAN)((Candidate == Private) && (Private->FilePathUri != NULL));
+    Context->Cache.Packet.Offer.Size = HTTP_CACHED_DHCP4_PACKET_MAX_SIZE;
+
+    Probes[ProbeCount].Dhcp4            = Candidate->Dhcp4;
+    Probes[ProbeCount].OptionCount      = HttpBootBuildDhcp4Options (Candidate, Context->OptList, Context->Buffer);
+    Probes[ProbeCount].OptionList       = Context->OptList;
+    Probes[ProbeCount].DiscoverTryCount = HTTP_BOOT_DHCP_RETRIES;
+    Probes[ProbeCount].DiscoverTimeout  = mHttpDhcpTimeout;
+    Probes[ProbeCount].CheckOffer       = HttpBootDhcp4ProbeOffer;
+    Probes[ProbeCount].Context          = Context;
+    ProbeCount++;
+  }
+
+  Winner = NetLibDhcp4Race (Probes, ProbeCount);
+
+  //
+  // An interface whose discovery could not be started keeps no outcome.
+  //
+  for (Index = 0; Index < ProbeCount; Index++) {
+    if (!EFI_ERROR (Probes[Index].Status)) {
+      Contexts[Index].Private->RaceState = (Index == Winner) ? HttpBootRaceWon : HttpBootRaceLost;
+    }
+  }
+
+ON_EXIT:
+  if (Probes != NULL) {
+    FreePool (Probes);
+  }
+
+  if (Contexts != NULL) {
+    FreePool (Contexts);
+  }
+
+  FreePool (Handles);
+}
+
+/**
+  End the part of a network interface in the race when its boot attempt is over.
+  If the interface won the race but failed to boot, the interfaces which lost to
+  it run their own DHCPv4 discovery on their next boot attempt.
+
+  @param[in]  Private           Pointer to HTTP boot driver private data.
+  @param[in]  Failed            TRUE if the boot attempt failed.
+
+**/
+VOID
+HttpBootDhcp4EndRace (
+  IN HTTP_BOOT_PRIVATE_DATA  *Private,
+  IN BOOLEAN                 Failed
+  )
+{
+  EFI_STATUS              Status;
+  EFI_HANDLE              *Handles;
+  UINTN                   HandleCount;
+  UINTN                   Index;
+  UINT32                  *Id;
+  HTTP_BOOT_PRIVATE_DATA  *Candidate;
+
+  if (Private->RaceState != HttpBootRaceWon) {
+    return;
+  }
+
+  Private->RaceState = HttpBootRaceNone;
+  if (!Failed) {
+    return;
+  }
+
+  Status = gBS->LocateHandleBuffer (ByProtocol, &gEfiCallerIdGuid, NULL, &HandleCount, &Handles);
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  for (Index = 0; Index < HandleCount; Index++) {
+    Status = gBS->HandleProtocol (Handles[Index], &gEfiCallerIdGuid, (VOID **)&Id);
+    if (EFI_ERROR (Status)) {
+      continue;
+    }
+
+    Candidate = HTTP_BOOT_PRIVATE_DATA_FROM_ID (Id);
+    if (Candidate->RaceState == HttpBootRaceLost) {
+      Candidate->RaceState = HttpBootRaceNone;
+    }
+  }
+
+  FreePool (Handles);
+}
+
+/**
+  Retrieve the DHCPv4 lease remembered for the network interface, if it has
+  not expired yet.
+
+  @param[in]   Private           Pointer to HTTP boot driver private data.
+  @param[out]  ClientAddress     The IPv4 address leased to the interface.
+
+  @retval TRUE                   A valid lease is found.
+  @retval FALSE                  No valid lease is found.
+
+**/
+BOOLEAN
+HttpBootGetDhcp4Lease (
+  IN  HTTP_BOOT_PRIVATE_DATA  *Private,
+  OUT EFI_IPv4_ADDRESS        *ClientAddress
+  )
+{
+  EFI_STATUS             Status;
+  CHAR16                 *MacString;
+  HTTP_BOOT_DHCP4_LEASE  Lease;
+  UINTN                  DataSize;
+  EFI_TIME               Time;
+
+  if (!PcdGetBool (PcdNetworkDiscoveryCache)) {
+    return FALSE;
+  }
+
+  Status = NetLibGetMacString (Private->Controller, NULL, &MacString);
+  if (EFI_ERROR (Status)) {
+    return FALSE;
+  }
+
+  DataSize = sizeof (Lease);
+  Status   = gRT->GetVariable (
+                    MacString,
+                    &gEdkiiNetworkDiscoveryCacheGuid,
+                    NULL,
+                    &DataSize,
+                    &Lease
+                    );
+  FreePool (MacString);
+  if (EFI_ERROR (Status) || (DataSize != sizeof (Lease))) {
+    return FALSE;
+  }
+
+  if (Lease.LeaseTime != MAX_UINT32) {
+    Status = gRT->GetTime (&Time, NULL);
+    if (EFI_ERROR (Status) || (NetLibTimeToSeconds (&Time) >= Lease.Granted + Lease.LeaseTime)) {
+      return FALSE;
+    }
+  }
+
+  if (IP4_IS_UNSPECIFIED (NTOHL (EFI_IP4 (Lease.ClientAddress)))) {
+    return FALSE;
+  }
+
+  CopyMem (ClientAddress, &Lease.ClientAddress, sizeof (EFI_IPv4_ADDRESS));
+  return TRUE;
+}
+
+/**
+  Remember the DHCPv4 lease of the network interface for the next boot, or
+  forget it.
+
+  The variable is not written again while the remembered lease has the same
+  address, server and options, and less than half of it has elapsed, so that
+  the usual boot does not write the non-volatile storage.
+
+  @param[in]  Private           Pointer to HTTP boot driver private data.
+  @param[in]  Mode              The mode data of the bound DHCPv4 instance, or NULL
+                                to forget the lease.
+
+**/
+VOID
+HttpBootSetDhcp4Lease (
+  IN HTTP_BOOT_PRIVATE_DATA  *Private,
+  IN EFI_DHCP4_MODE_DATA     *Mode  OPTIONAL
+  )
+{
+  EFI_STATUS             Status;
+  CHAR16                 *MacString;
+  HTTP_BOOT_DHCP4_LEASE  Lease;
+  HTTP_BOOT_DHCP4_LEASE  Stored;
+  UINTN                  DataSize;
+  EFI_TIME               Time;
+  UINT64                 Now;
+
+  if (!PcdGetBool (PcdNetworkDiscoveryCache)) {
+    return;
+  }
+
+  Status = NetLibGetMacString (Private->Controller, NULL, &MacString);
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  if (Mode == NULL) {
+    gRT->SetVariable (MacString, &gEdkiiNetworkDiscoveryCacheGuid, 0, 0, NULL);
+    FreePool (MacString);
+    return;
+  }
+
+  Status = gRT->GetTime (&Time, NULL);
+  if (EFI_ERROR (Status)) {
+    FreePool (MacString);
+    return;
+  }
+
+  Now = NetLibTimeToSeconds (&Time);
+
+  ZeroMem (&Lease, sizeof (Lease));
+  CopyMem (&Lease.ClientAddress, &Mode->ClientAddress, sizeof (EFI_IPv4_ADDRESS));
+  CopyMem (&Lease.ServerAddress, &Mode->ServerAddress, sizeof (EFI_IPv4_ADDRESS));
+  Lease.LeaseTime = Mode->LeaseTime;
+  Lease.Granted   = Now;
+  if ((Mode->ReplyPacket != NULL) &&
+      (Mode->ReplyPacket->Length > sizeof (EFI_DHCP4_HEADER) + sizeof (UINT32)))
+  {
+    Lease.OptionsCrc = CalculateCrc32 (
+                         Mode->ReplyPacket->Dhcp4.Option,
+                         Mode->ReplyPacket->Length - sizeof (EFI_DHCP4_HEADER) - sizeof (UINT32)
+                         );
+  }
+
+  DataSize = sizeof (Stored);
+  Status   = gRT->GetVariable (
+                    MacString,
+                    &gEdkiiNetworkDiscoveryCacheGuid,
+                    NULL,
+                    &DataSize,
+                    &Stored
+                    );
+  if (!EFI_ERROR (Status) && (DataSize == sizeof (Stored)) &&
+      EFI_IP4_EQUAL (&Stored.ClientAddress, &Lease.ClientAddress) &&
+      EFI_IP4_EQUAL (&Stored.ServerAddress, &Lease.ServerAddress) &&
+      (Stored.OptionsCrc == Lease.OptionsCrc) &&
+      (Stored.LeaseTime == Lease.LeaseTime) &&
+      ((Stored.LeaseTime == MAX_UINT32) ||
+       ((Now >= Stored.Granted) && (Now - Stored.Granted < Stored.LeaseTime / 2))))
+  {
+    //
+    // The remembered lease is unchanged and still good for the next boot.
+    //
+    FreePool (MacString);
+    return;
+  }
+
+  gRT->SetVariable (
+         MacString,
+         &gEdkiiNetworkDiscoveryCacheGuid,
+         EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS,
+         sizeof (Lease),
+         &Lease
+         );
+  FreePool (MacString);
+}
+
 /**
   Start the D.O.R.A DHCPv4 process to acquire the IPv4 address and other Http boot information.
 
@@ -817,10 +1192,28 @@ HttpBootDhcp4Dora (
   EFI_DHCP4_CONFIG_DATA    Config;
   EFI_STATUS               Status;
   EFI_DHCP4_MODE_DATA      Mode;
+  BOOLEAN                  Reboot;
 
   Dhcp4 = Private->Dhcp4;
   ASSERT (Dhcp4 != NULL);
 
+  //
+  // Race the discovery on all the interfaces, unless this one already took part
+  // in a race. A loss is used for one boot attempt, a win is kept until
+  // HttpBootDhcp4EndRace() is called at the end of the boot attempt.
+  //
+  if (PcdGetBool (PcdNetworkBootRaceDiscovery)) {
+    if (Private->RaceState == HttpBootRaceNone) {
+      HttpBootDhcp4Race (Private);
+    }
+
+    if (Private->RaceState == HttpBootRaceLost) {
+      Private->RaceState = HttpBootRaceNone;
+      AsciiPrint ("\n  Another interface answered first, or no boot server answered.\n");
+      return EFI_NO_RESPONSE;
+    }
+  }
+
   Status = HttpBootSetIp4Policy (Private);
   if (EFI_ERROR (Status)) {
     return Status;
@@ -841,24 +1234,53 @@ HttpBootDhcp4Dora (
   Config.DiscoverTimeout  = mHttpDhcpTimeout;
 
   //
-  // Configure the DHCPv4 instance for HTTP boot.
+  // Start in the INIT-REBOOT state to request the remembered address again,
+  // instead of discovering the DHCP servers, if a valid lease is known.
   //
-  Status = Dhcp4->Configure (Dhcp4, &Config);
-  if (EFI_ERROR (Status)) {
-    goto ON_EXIT;
+  Reboot = HttpBootGetDhcp4Lease (Private, &Config.ClientAddress);
+  if (Reboot) {
+    Config.RequestTryCount = HTTP_BOOT_DHCP_REBOOT_RETRIES;
+    Config.RequestTimeout  = mHttpDhcpTimeout;
   }
 
-  //
-  // Initialize the record fields for DHCPv4 offer in private data.
-  //
-  Private->OfferNum = 0;
-  ZeroMem (Private->OfferCount, sizeof (Private->OfferCount));
-  ZeroMem (Private->OfferIndex, sizeof (Private->OfferIndex));
+  while (TRUE) {
+    //
+    // Configure the DHCPv4 instance for HTTP boot.
+    //
+    Status = Dhcp4->Configure (Dhcp4, &Config);
+    if (EFI_ERROR (Status)) {
+      goto ON_EXIT;
+    }
+
+    //
+    // Initialize the record fields for DHCPv4 offer in private data.
+    //
+    Private->OfferNum = 0;
+    ZeroMem (Private->OfferCount, sizeof (Private->OfferCount));
+    ZeroMem (Private->OfferIndex, sizeof (Private->OfferIndex));
+
+    //
+    // Start DHCPv4 D.O.R.A. process to acquire IPv4 address.
+    //
+    Status = Dhcp4->Start (Dhcp4, NULL);
+    if (!EFI_ERROR (Status) || !Reboot) {
+      break;
+    }
+
+    //
+    // The remembered lease is not usable any more, forget it and restart from
+    // the INIT state.
+    //
+    HttpBootSetDhcp4Lease (Private, NULL);
+    Dhcp4->Stop (Dhcp4);
+    Dhcp4->Configure (Dhcp4, NULL);
+
+    Reboot = FALSE;
+    ZeroMem (&Config.ClientAddress, sizeof (EFI_IPv4_ADDRESS));
+    Config.RequestTryCount = 0;
+    Config.RequestTimeout  = NULL;
+  }
 
-  //
-  // Start DHCPv4 D.O.R.A. process to acquire IPv4 address.
-  //
-  Status = Dhcp4->Start (Dhcp4, NULL);
   if (EFI_ERROR (Status)) {
     goto ON_EXIT;
   }
@@ -872,6 +1294,7 @@ HttpBootDhcp4Dora (
   }
 
   ASSERT (Mode.State == Dhcp4Bound);
+  HttpBootSetDhcp4Lease (Private, &Mode);
   CopyMem (&Private->StationIp, &Mode.ClientAddress, sizeof (EFI_IPv4_ADDRESS));
   CopyMem (&Private->SubnetMask, &Mode.SubnetMask, sizeof (EFI_IPv4_ADDRESS));
   CopyMem (&Private->GatewayIp, &Mode.RouterAddress, sizeof (EFI_IPv4_ADDRESS));
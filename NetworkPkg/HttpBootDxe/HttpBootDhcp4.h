@@ -91,8 +91,9 @@ typedef enum {
   HttpOfferTypeMax
 } HTTP_BOOT_OFFER_TYPE;
 
-#define HTTP_BOOT_DHCP_RETRIES   4
-#define HTTP_BOOT_OFFER_MAX_NUM  16
+#define HTTP_BOOT_DHCP_RETRIES         4
+#define HTTP_BOOT_DHCP_REBOOT_RETRIES  2
+#define HTTP_BOOT_OFFER_MAX_NUM        16
 
 // The array index of the DHCP4 option tag interested
 //
@@ -209,6 +210,49 @@ typedef struct {
   EFI_DHCP4_PACKET_OPTION    *OptList[HTTP_BOOT_DHCP4_TAG_INDEX_MAX];
 } HTTP_BOOT_DHCP4_PACKET_CACHE;
 
+///
+/// The outcome of the racing DHCPv4 discovery for a network interface, when
+/// PcdNetworkBootRaceDiscovery is TRUE.
+///
+typedef enum {
+  HttpBootRaceNone,
+  HttpBootRaceWon,
+  HttpBootRaceLost
+} HTTP_BOOT_RACE_STATE;
+
+///
+/// The context of the DHCPv4 discovery run on a network interface during the race.
+///
+typedef struct {
+  HTTP_BOOT_PRIVATE_DATA          *Private;
+  BOOLEAN                         HasFilePathUri;
+  EFI_DHCP4_PACKET_OPTION         *OptList[HTTP_BOOT_DHCP4_OPTION_MAX_NUM];
+  UINT8                           Buffer[HTTP_BOOT_DHCP4_OPTION_MAX_SIZE];
+  HTTP_BOOT_DHCP4_PACKET_CACHE    Cache;
+} HTTP_BOOT_DHCP4_PROBE;
+
+///
+/// The DHCPv4 lease remembered across boots when PcdNetworkDiscoveryCache is TRUE.
+/// It is rewritten only when the lease changes or half of it has elapsed, not
+/// on every boot.
+///
+typedef struct {
+  EFI_IPv4_ADDRESS    ClientAddress;
+  EFI_IPv4_ADDRESS    ServerAddress;
+  ///
+  /// The CRC32 of the options of the DHCPACK.
+  ///
+  UINT32              OptionsCrc;
+  ///
+  /// The duration of the lease in seconds, or MAX_UINT32 for an infinite lease.
+  ///
+  UINT32              LeaseTime;
+  ///
+  /// The time the lease was stored, in seconds as returned by NetLibTimeToSeconds().
+  ///
+  UINT64              Granted;
+} HTTP_BOOT_DHCP4_LEASE;
+
 /**
   Select an DHCPv4 or DHCP6 offer, and record SelectIndex and SelectProxyType.
 
@@ -234,6 +278,21 @@ HttpBootDhcp4Dora (
   IN HTTP_BOOT_PRIVATE_DATA  *Private
   );
 
+/**
+  End the part of a network interface in the race when its boot attempt is over.
+  If the interface won the race but failed to boot, the interfaces which lost to
+  it run their own DHCPv4 discovery on their next boot attempt.
+
+  @param[in]  Private           Pointer to HTTP boot driver private data.
+  @param[in]  Failed            TRUE if the boot attempt failed.
+
+**/
+VOID
+HttpBootDhcp4EndRace (
+  IN HTTP_BOOT_PRIVATE_DATA  *Private,
+  IN BOOLEAN                 Failed
+  );
+
 /**
   This function will register the default DNS addresses to the network device.
 
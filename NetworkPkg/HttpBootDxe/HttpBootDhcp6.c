@@ -498,6 +498,30 @@ HttpBootDhcp6CallBack (
 
       break;
 
+    case Dhcp6RcvdReply:
+      if (Private->OfferNum != 0) {
+        break;
+      }
+
+      //
+      // No advertise is received when the server commits the solicit rapidly,
+      // so the boot information has to be taken from the reply. Abort and fall
+      // back to the S.A.R.R process if the reply does not have it.
+      //
+      Status = EFI_ABORTED;
+      if (Packet->Length > HTTP_BOOT_DHCP6_PACKET_MAX_SIZE) {
+        break;
+      }
+
+      if (!EFI_ERROR (HttpBootCacheDhcp6Offer (Private, Packet))) {
+        HttpBootSelectDhcpOffer (Private);
+        if (Private->SelectIndex != 0) {
+          Status = EFI_SUCCESS;
+        }
+      }
+
+      break;
+
     default:
       break;
   }
@@ -982,7 +1006,7 @@ HttpBootDhcp6Sarr (
   Config.Dhcp6Callback         = HttpBootDhcp6CallBack;
   Config.CallbackContext       = Private;
   Config.IaInfoEvent           = NULL;
-  Config.RapidCommit           = FALSE;
+  Config.RapidCommit           = PcdGetBool (PcdNetworkDiscoveryCache);
   Config.ReconfigureAccept     = FALSE;
   Config.IaDescriptor.IaId     = Random;
   Config.IaDescriptor.Type     = EFI_DHCP6_IA_TYPE_NA;
@@ -992,27 +1016,41 @@ HttpBootDhcp6Sarr (
   Retransmit->Mrt              = 32;
   Retransmit->Mrd              = 60;
 
-  //
-  // Configure the DHCPv6 instance for HTTP boot.
-  //
-  Status = Dhcp6->Configure (Dhcp6, &Config);
-  FreePool (Retransmit);
-  if (EFI_ERROR (Status)) {
-    goto ON_EXIT;
-  }
+  while (TRUE) {
+    //
+    // Configure the DHCPv6 instance for HTTP boot.
+    //
+    Status = Dhcp6->Configure (Dhcp6, &Config);
+    if (EFI_ERROR (Status)) {
+      break;
+    }
 
-  //
-  // Initialize the record fields for DHCPv6 offer in private data.
-  //
-  Private->OfferNum    = 0;
-  Private->SelectIndex = 0;
-  ZeroMem (Private->OfferCount, sizeof (Private->OfferCount));
-  ZeroMem (Private->OfferIndex, sizeof (Private->OfferIndex));
+    //
+    // Initialize the record fields for DHCPv6 offer in private data.
+    //
+    Private->OfferNum    = 0;
+    Private->SelectIndex = 0;
+    ZeroMem (Private->OfferCount, sizeof (Private->OfferCount));
+    ZeroMem (Private->OfferIndex, sizeof (Private->OfferIndex));
 
-  //
-  // Start DHCPv6 S.A.R.R. process to acquire IPv6 address.
-  //
-  Status = Dhcp6->Start (Dhcp6);
+    //
+    // Start DHCPv6 S.A.R.R. process to acquire IPv6 address.
+    //
+    Status = Dhcp6->Start (Dhcp6);
+    if (!EFI_ERROR (Status) || !Config.RapidCommit || (Private->OfferNum == 0)) {
+      break;
+    }
+
+    //
+    // A server answered but the exchange failed, possibly because its rapid
+    // commit reply could not be used. Run the full S.A.R.R process once more.
+    //
+    Dhcp6->Stop (Dhcp6);
+    Dhcp6->Configure (Dhcp6, NULL);
+    Config.RapidCommit = FALSE;
+  }
+
+  FreePool (Retransmit);
   if (EFI_ERROR (Status)) {
     goto ON_EXIT;
   }
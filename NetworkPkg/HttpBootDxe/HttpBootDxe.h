@@ -53,6 +53,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Protocol/Ip4Config2.h>
 #include <Protocol/Ip6Config.h>
 #include <Protocol/RamDisk.h>
+#include <Protocol/SparseRamDisk.h>
 #include <Protocol/AdapterInformation.h>
 
 //
@@ -65,6 +66,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 // Consumed Guids
 //
 #include <Guid/HttpBootConfigHii.h>
+#include <Guid/NetworkDiscoveryCache.h>
 
 //
 // Driver Version
@@ -199,6 +201,7 @@ struct _HTTP_BOOT_PRIVATE_DATA {
   //
   BOOLEAN                                      UsingIpv6;
   BOOLEAN                                      Started;
+  HTTP_BOOT_RACE_STATE                         RaceState;
   EFI_IP_ADDRESS                               StationIp;
   EFI_IP_ADDRESS                               SubnetMask;
   EFI_IP_ADDRESS                               GatewayIp;
@@ -214,9 +217,25 @@ struct _HTTP_BOOT_PRIVATE_DATA {
   CHAR8                                        *BootFileUri;
   VOID                                         *BootFileUriParser;
   UINTN                                        BootFileSize;
+  BOOLEAN                                      AcceptRanges;
   BOOLEAN                                      NoGateway;
   HTTP_BOOT_IMAGE_TYPE                         ImageType;
 
+  //
+  // Data for streaming the boot file into a sparse RAM disk. The HTTP Boot
+  // service is kept started until the whole boot file is downloaded.
+  //
+  BOOLEAN                                      RamDiskStreaming;
+  CHAR16                                       *RamDiskUrl;
+  HTTP_BOOT_RANGE_CONNECTION                   RamDiskConnection;
+
+  //
+  // The part of the streamed boot file being filled, and its response being
+  // received without waiting.
+  //
+  BOOLEAN                                      RamDiskFilling;
+  HTTP_IO_RESPONSE_DATA                        RamDiskResponse;
+
   //
   // URI string extracted from the input FilePath parameter.
   //
@@ -397,6 +397,21 @@ HttpBootLoadFile (
     goto ON_EXIT;
   }
 
+  //
+  // A RAM disk image is streamed into the RAM disk once it is registered,
+  // instead of being downloaded into Buffer here.
+  //
+  if (PcdGetBool (PcdHttpBootStreamRamDisk) && Private->AcceptRanges &&
+      ((Private->ImageType == ImageTypeVirtualCd) || (Private->ImageType == ImageTypeVirtualDisk)))
+  {
+    Status = HttpBootStartRamDiskStream (Private);
+    if (!EFI_ERROR (Status)) {
+      *BufferSize = Private->BootFileSize;
+      *ImageType  = Private->ImageType;
+      goto ON_EXIT;
+    }
+  }
+
   //
   // Load the boot file into Buffer
   //
@@ -458,6 +473,13 @@ HttpBootStop (
     return EFI_NOT_STARTED;
   }
 
+  //
+  // The boot file streamed into a RAM disk is still being downloaded.
+  //
+  if (Private->RamDiskStreaming) {
+    return EFI_ACCESS_DENIED;
+  }
+
   if (Private->HttpCreated) {
     HttpIoDestroyIo (&Private->HttpIo);
     Private->HttpCreated = FALSE;
@@ -471,6 +493,7 @@ HttpBootStop (
   Private->BootFileUri       = NULL;
   Private->BootFileUriParser = NULL;
   Private->BootFileSize      = 0;
+  Private->AcceptRanges      = FALSE;
   Private->SelectIndex       = 0;
   Private->SelectProxyType   = HttpOfferTypeMax;
 
@@ -594,6 +617,13 @@ HttpBootDxeLoadFile (
   VirtualNic = HTTP_BOOT_VIRTUAL_NIC_FROM_LOADFILE (This);
   Private    = VirtualNic->Private;
 
+  //
+  // The boot file streamed into a RAM disk is still being downloaded.
+  //
+  if (Private->RamDiskStreaming) {
+    return EFI_ALREADY_STARTED;
+  }
+
   //
   // Check media status before HTTP boot start
   //
@@ -630,6 +660,7 @@ HttpBootDxeLoadFile (
       Status = EFI_WARN_FILE_SYSTEM;
     } else if (Status != EFI_BUFFER_TOO_SMALL) {
       HttpBootStop (Private);
+      HttpBootDhcp4EndRace (Private, TRUE);
     }
 
     return Status;
@@ -648,9 +679,15 @@ HttpBootDxeLoadFile (
   }
 
   //
-  // Stop the HTTP Boot service after the boot image is downloaded.
+  // Stop the HTTP Boot service after the boot image is downloaded. It is
+  // kept started for a RAM disk image still being streamed.
   //
-  HttpBootStop (Private);
+  if (!Private->RamDiskStreaming) {
+    HttpBootStop (Private);
+  }
+
+  HttpBootDhcp4EndRace (Private, EFI_ERROR (Status));
+
   return Status;
 }
 
@@ -709,7 +709,9 @@ HttpBootCheckImageType (
 }
 
 /**
-  This function register the RAM disk info to the system.
+  This function register the RAM disk info to the system. If the boot file is
+  streamed, the RAM disk is registered as a sparse RAM disk filled with HTTP
+  Range requests.
 
   @param[in]       Private         The pointer to the driver's private data.
   @param[in]       BufferSize      The size of Buffer in bytes.
@@ -730,10 +732,11 @@ HttpBootRegisterRamDisk (
   IN  HTTP_BOOT_IMAGE_TYPE    ImageType
   )
 {
-  EFI_RAM_DISK_PROTOCOL     *RamDisk;
-  EFI_STATUS                Status;
-  EFI_DEVICE_PATH_PROTOCOL  *DevicePath;
-  EFI_GUID                  *RamDiskType;
+  EFI_RAM_DISK_PROTOCOL           *RamDisk;
+  EDKII_SPARSE_RAM_DISK_PROTOCOL  *SparseRamDisk;
+  EFI_STATUS                      Status;
+  EFI_DEVICE_PATH_PROTOCOL        *DevicePath;
+  EFI_GUID                        *RamDiskType;
 
   ASSERT (Private != NULL);
   ASSERT (Buffer != NULL);
@@ -753,6 +756,33 @@ HttpBootRegisterRamDisk (
     return EFI_UNSUPPORTED;
   }
 
+  if (Private->RamDiskStreaming) {
+    //
+    // Register the RAM disk at once, its content is downloaded as it is read.
+    //
+    Status = gBS->LocateProtocol (&gEdkiiSparseRamDiskProtocolGuid, NULL, (VOID **)&SparseRamDisk);
+    if (!EFI_ERROR (Status)) {
+      Status = SparseRamDisk->Register (
+                                (UINTN)Buffer,
+                                (UINT64)BufferSize,
+                                RamDiskType,
+                                Private->UsingIpv6 ? Private->Ip6Nic->DevicePath : Private->Ip4Nic->DevicePath,
+                                HTTP_BOOT_RAM_DISK_CHUNK_SIZE,
+                                HttpBootFillRamDisk,
+                                HttpBootCompleteRamDisk,
+                                Private,
+                                &DevicePath
+                                );
+    }
+
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_ERROR, "HTTP Boot: Failed to register sparse RAM Disk - %r\n", Status));
+      HttpBootStopRamDiskStream (Private);
+    }
+
+    return Status;
+  }
+
   Status = RamDisk->Register (
                       (UINTN)Buffer,
                       (UINT64)BufferSize,
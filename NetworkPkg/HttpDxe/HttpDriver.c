@@ -67,6 +67,7 @@ HttpCreateService (
   HttpService->ControllerHandle            = Controller;
   HttpService->ChildrenNumber              = 0;
   InitializeListHead (&HttpService->ChildrenList);
+  InitializeListHead (&HttpService->IdleConnections);
 
   *ServiceData = HttpService;
   return EFI_SUCCESS;
@@ -86,10 +87,26 @@ HttpCleanService (
   IN BOOLEAN       UsingIpv6
   )
 {
+  LIST_ENTRY            *Entry;
+  LIST_ENTRY            *Next;
+  HTTP_IDLE_CONNECTION  *Connection;
+
   if (HttpService == NULL) {
     return;
   }
 
+  //
+  // Close the idle connections over the TCP service being stopped.
+  //
+  NET_LIST_FOR_EACH_SAFE (Entry, Next, &HttpService->IdleConnections) {
+    Connection = NET_LIST_USER_STRUCT (Entry, HTTP_IDLE_CONNECTION, Link);
+    if (Connection->LocalAddressIsIPv6 == UsingIpv6) {
+      RemoveEntryList (&Connection->Link);
+      HttpService->IdleConnectionNumber--;
+      HttpDestroyIdleConnection (HttpService, Connection);
+    }
+  }
+
   if (!UsingIpv6) {
     if (HttpService->Tcp4ChildHandle != NULL) {
       gBS->CloseProtocol (
@@ -414,6 +414,17 @@ EfiHttpRequest (
       }
     }
 
+    //
+    // Take over the idle connection to the same server left by another HTTP
+    // child, instead of connecting again. The checks below then reuse it as
+    // if this child had made it.
+    //
+    if ((HttpInstance->RemoteHost == NULL) && !HttpInstance->UseHttps &&
+        (HttpInstance->State == HTTP_STATE_HTTP_CONFIGED))
+    {
+      HttpTakeIdleConnection (HttpInstance, HostName, RemotePort);
+    }
+
     //
     // If Configure is TRUE, it indicates the first time to call Request();
     // If ReConfigure is TRUE, it indicates the request URL is not same
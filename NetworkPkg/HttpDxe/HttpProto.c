@@ -820,6 +820,8 @@ HttpCleanProtocol (
   IN  HTTP_PROTOCOL  *HttpInstance
   )
 {
+  HttpKeepIdleConnection (HttpInstance);
+
   HttpCloseConnection (HttpInstance);
 
   HttpCloseTcpConnCloseEvent (HttpInstance);
@@ -928,6 +930,355 @@ HttpCleanProtocol (
   TlsCloseTxRxEvent (HttpInstance);
 }
 
+/**
+  Keep the TCP connection of the HTTP child open in the idle connections of
+  the HTTP service, if no response data is pending on it.
+
+  @param[in, out]  HttpInstance       The HTTP child which is reset or destroyed.
+
+**/
+VOID
+HttpKeepIdleConnection (
+  IN OUT HTTP_PROTOCOL  *HttpInstance
+  )
+{
+  HTTP_SERVICE          *HttpService;
+  HTTP_IDLE_CONNECTION  *Connection;
+  EFI_TPL               OldTpl;
+
+  HttpService = HttpInstance->Service;
+
+  //
+  // Only the plain HTTP connections are kept, an HTTPS connection is closed.
+  // Its TLS child is created on the handle of the HTTP child, so it can't
+  // outlive the child, and its session was negotiated with the CA
+  // certificates, verify method and host name the user of that child set
+  // through the TLS and TLS Configuration protocols. A later HTTP child may
+  // set a different policy, which only a new handshake can enforce. Keeping
+  // HTTPS connections is deferred: TlsDxe resumes the TLS session of a new
+  // connection verified with the same host name, verify method and CA
+  // certificates, so the new handshake skips the key exchange and the
+  // certificate chain verification. A connection is reusable only between
+  // two messages.
+  //
+  if ((PcdGet8 (PcdHttpIdleConnections) == 0) ||
+      (HttpInstance->State != HTTP_STATE_TCP_CONNECTED) ||
+      HttpInstance->ConnectionClose ||
+      HttpInstance->UseHttps ||
+      HttpInstance->TlsAlreadyCreated ||
+      (HttpInstance->RemoteHost == NULL) ||
+      (NetMapGetCount (&HttpInstance->TxTokens) != 0) ||
+      (NetMapGetCount (&HttpInstance->RxTokens) != 0) ||
+      (HttpInstance->CacheBody != NULL) ||
+      ((HttpInstance->MsgParser != NULL) && !HttpIsMessageComplete (HttpInstance->MsgParser)))
+  {
+    return;
+  }
+
+  Connection = AllocateZeroPool (sizeof (HTTP_IDLE_CONNECTION));
+  if (Connection == NULL) {
+    return;
+  }
+
+  Connection->LocalAddressIsIPv6 = HttpInstance->LocalAddressIsIPv6;
+  Connection->RemoteHost         = HttpInstance->RemoteHost;
+  Connection->RemotePort         = HttpInstance->RemotePort;
+
+  //
+  // The TCP child stays opened BY_DRIVER on the controller, only the
+  // association with the HTTP child is removed.
+  //
+  if (!HttpInstance->LocalAddressIsIPv6) {
+    Connection->TcpChildHandle = HttpInstance->Tcp4ChildHandle;
+    CopyMem (&Connection->RemoteAddr, &HttpInstance->RemoteAddr, sizeof (EFI_IPv4_ADDRESS));
+    CopyMem (&Connection->IPv4Node, &HttpInstance->IPv4Node, sizeof (EFI_HTTPv4_ACCESS_POINT));
+
+    gBS->CloseProtocol (
+           HttpInstance->Tcp4ChildHandle,
+           &gEfiTcp4ProtocolGuid,
+           HttpService->Ip4DriverBindingHandle,
+           HttpInstance->Handle
+           );
+    HttpInstance->Tcp4ChildHandle = NULL;
+    HttpInstance->Tcp4            = NULL;
+  } else {
+    Connection->TcpChildHandle = HttpInstance->Tcp6ChildHandle;
+    CopyMem (&Connection->RemoteIpv6Addr, &HttpInstance->RemoteIpv6Addr, sizeof (EFI_IPv6_ADDRESS));
+    CopyMem (&Connection->Ipv6Node, &HttpInstance->Ipv6Node, sizeof (EFI_HTTPv6_ACCESS_POINT));
+
+    gBS->CloseProtocol (
+           HttpInstance->Tcp6ChildHandle,
+           &gEfiTcp6ProtocolGuid,
+           HttpService->Ip6DriverBindingHandle,
+           HttpInstance->Handle
+           );
+    HttpInstance->Tcp6ChildHandle = NULL;
+    HttpInstance->Tcp6            = NULL;
+  }
+
+  HttpInstance->RemoteHost = NULL;
+  HttpInstance->RemotePort = 0;
+  HttpInstance->State      = HTTP_STATE_TCP_CLOSED;
+
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+
+  InsertHeadList (&HttpService->IdleConnections, &Connection->Link);
+  HttpService->IdleConnectionNumber++;
+
+  //
+  // Close the least recently used connection if there are too many.
+  //
+  if (HttpService->IdleConnectionNumber > PcdGet8 (PcdHttpIdleConnections)) {
+    Connection = NET_LIST_TAIL (&HttpService->IdleConnections, HTTP_IDLE_CONNECTION, Link);
+    RemoveEntryList (&Connection->Link);
+    HttpService->IdleConnectionNumber--;
+  } else {
+    Connection = NULL;
+  }
+
+  gBS->RestoreTPL (OldTpl);
+
+  if (Connection != NULL) {
+    HttpDestroyIdleConnection (HttpService, Connection);
+  }
+}
+
+/**
+  Take over an idle connection to the remote host for the HTTP child.
+
+  @param[in, out]  HttpInstance       The HTTP child which has not connected yet.
+  @param[in]       HostName           The remote host of the request.
+  @param[in]       RemotePort         The remote port of the request.
+
+  @retval TRUE     The HTTP child takes over an idle connection.
+  @retval FALSE    There is no usable idle connection to the remote host.
+
+**/
+BOOLEAN
+HttpTakeIdleConnection (
+  IN OUT HTTP_PROTOCOL  *HttpInstance,
+  IN     CHAR8          *HostName,
+  IN     UINT16         RemotePort
+  )
+{
+  HTTP_SERVICE               *HttpService;
+  HTTP_IDLE_CONNECTION       *Connection;
+  LIST_ENTRY                 *Entry;
+  LIST_ENTRY                 *Next;
+  EFI_TCP4_CONNECTION_STATE  Tcp4State;
+  EFI_TCP6_CONNECTION_STATE  Tcp6State;
+  EFI_TCP4_PROTOCOL          *Tcp4;
+  EFI_TCP6_PROTOCOL          *Tcp6;
+  EFI_STATUS                 Status;
+  EFI_TPL                    OldTpl;
+  BOOLEAN                    SameNode;
+  BOOLEAN                    Established;
+
+  HttpService = HttpInstance->Service;
+  Connection  = NULL;
+  Tcp4        = NULL;
+  Tcp6        = NULL;
+
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+
+  NET_LIST_FOR_EACH_SAFE (Entry, Next, &HttpService->IdleConnections) {
+    Connection = NET_LIST_USER_STRUCT (Entry, HTTP_IDLE_CONNECTION, Link);
+    if (HttpInstance->LocalAddressIsIPv6) {
+      SameNode = (BOOLEAN)(CompareMem (&Connection->Ipv6Node, &HttpInstance->Ipv6Node, sizeof (EFI_HTTPv6_ACCESS_POINT)) == 0);
+    } else {
+      SameNode = (BOOLEAN)(CompareMem (&Connection->IPv4Node, &HttpInstance->IPv4Node, sizeof (EFI_HTTPv4_ACCESS_POINT)) == 0);
+    }
+
+    if (SameNode &&
+        (Connection->LocalAddressIsIPv6 == HttpInstance->LocalAddressIsIPv6) &&
+        (Connection->RemotePort == RemotePort) &&
+        (AsciiStrCmp (Connection->RemoteHost, HostName) == 0))
+    {
+      RemoveEntryList (&Connection->Link);
+      HttpService->IdleConnectionNumber--;
+      break;
+    }
+
+    Connection = NULL;
+  }
+
+  gBS->RestoreTPL (OldTpl);
+
+  if (Connection == NULL) {
+    return FALSE;
+  }
+
+  Status = HttpCreateTcpConnCloseEvent (HttpInstance);
+  if (EFI_ERROR (Status)) {
+    HttpDestroyIdleConnection (HttpService, Connection);
+    return FALSE;
+  }
+
+  //
+  // The server may have closed the connection while it was idle.
+  //
+  Established = FALSE;
+  if (!HttpInstance->LocalAddressIsIPv6) {
+    Status = gBS->OpenProtocol (
+                    Connection->TcpChildHandle,
+                    &gEfiTcp4ProtocolGuid,
+                    (VOID **)&Tcp4,
+                    HttpService->Ip4DriverBindingHandle,
+                    HttpInstance->Handle,
+                    EFI_OPEN_PROTOCOL_BY_CHILD_CONTROLLER
+                    );
+    if (!EFI_ERROR (Status)) {
+      Status = Tcp4->GetModeData (Tcp4, &Tcp4State, NULL, NULL, NULL, NULL);
+      if (!EFI_ERROR (Status) && (Tcp4State == Tcp4StateEstablished)) {
+        Established = TRUE;
+      } else {
+        gBS->CloseProtocol (
+               Connection->TcpChildHandle,
+               &gEfiTcp4ProtocolGuid,
+               HttpService->Ip4DriverBindingHandle,
+               HttpInstance->Handle
+               );
+      }
+    }
+  } else {
+    Status = gBS->OpenProtocol (
+                    Connection->TcpChildHandle,
+                    &gEfiTcp6ProtocolGuid,
+                    (VOID **)&Tcp6,
+                    HttpService->Ip6DriverBindingHandle,
+                    HttpInstance->Handle,
+                    EFI_OPEN_PROTOCOL_BY_CHILD_CONTROLLER
+                    );
+    if (!EFI_ERROR (Status)) {
+      Status = Tcp6->GetModeData (Tcp6, &Tcp6State, NULL, NULL, NULL, NULL);
+      if (!EFI_ERROR (Status) && (Tcp6State == Tcp6StateEstablished)) {
+        Established = TRUE;
+      } else {
+        gBS->CloseProtocol (
+               Connection->TcpChildHandle,
+               &gEfiTcp6ProtocolGuid,
+               HttpService->Ip6DriverBindingHandle,
+               HttpInstance->Handle
+               );
+      }
+    }
+  }
+
+  if (!Established) {
+    HttpCloseTcpConnCloseEvent (HttpInstance);
+    HttpDestroyIdleConnection (HttpService, Connection);
+    return FALSE;
+  }
+
+  //
+  // Replace the unconnected TCP child of the HTTP child with the connected one.
+  //
+  if (!HttpInstance->LocalAddressIsIPv6) {
+    gBS->CloseProtocol (
+           HttpInstance->Tcp4ChildHandle,
+           &gEfiTcp4ProtocolGuid,
+           HttpService->Ip4DriverBindingHandle,
+           HttpService->ControllerHandle
+           );
+    gBS->CloseProtocol (
+           HttpInstance->Tcp4ChildHandle,
+           &gEfiTcp4ProtocolGuid,
+           HttpService->Ip4DriverBindingHandle,
+           HttpInstance->Handle
+           );
+    NetLibDestroyServiceChild (
+      HttpService->ControllerHandle,
+      HttpService->Ip4DriverBindingHandle,
+      &gEfiTcp4ServiceBindingProtocolGuid,
+      HttpInstance->Tcp4ChildHandle
+      );
+
+    HttpInstance->Tcp4ChildHandle = Connection->TcpChildHandle;
+    HttpInstance->Tcp4            = Tcp4;
+    CopyMem (&HttpInstance->RemoteAddr, &Connection->RemoteAddr, sizeof (EFI_IPv4_ADDRESS));
+  } else {
+    gBS->CloseProtocol (
+           HttpInstance->Tcp6ChildHandle,
+           &gEfiTcp6ProtocolGuid,
+           HttpService->Ip6DriverBindingHandle,
+           HttpService->ControllerHandle
+           );
+    gBS->CloseProtocol (
+           HttpInstance->Tcp6ChildHandle,
+           &gEfiTcp6ProtocolGuid,
+           HttpService->Ip6DriverBindingHandle,
+           HttpInstance->Handle
+           );
+    NetLibDestroyServiceChild (
+      HttpService->ControllerHandle,
+      HttpService->Ip6DriverBindingHandle,
+      &gEfiTcp6ServiceBindingProtocolGuid,
+      HttpInstance->Tcp6ChildHandle
+      );
+
+    HttpInstance->Tcp6ChildHandle = Connection->TcpChildHandle;
+    HttpInstance->Tcp6            = Tcp6;
+    CopyMem (&HttpInstance->RemoteIpv6Addr, &Connection->RemoteIpv6Addr, sizeof (EFI_IPv6_ADDRESS));
+  }
+
+  HttpInstance->RemoteHost = Connection->RemoteHost;
+  HttpInstance->RemotePort = Connection->RemotePort;
+  HttpInstance->State      = HTTP_STATE_TCP_CONNECTED;
+
+  FreePool (Connection);
+  return TRUE;
+}
+
+/**
+  Close an idle connection and release its resources.
+
+  @param[in]  HttpService        The HTTP service which keeps the connection.
+  @param[in]  Connection         The idle connection, removed from the list.
+
+**/
+VOID
+HttpDestroyIdleConnection (
+  IN HTTP_SERVICE          *HttpService,
+  IN HTTP_IDLE_CONNECTION  *Connection
+  )
+{
+  //
+  // Destroying the TCP child aborts the connection, as HttpCloseConnection() does.
+  //
+  if (!Connection->LocalAddressIsIPv6) {
+    gBS->CloseProtocol (
+           Connection->TcpChildHandle,
+           &gEfiTcp4ProtocolGuid,
+           HttpService->Ip4DriverBindingHandle,
+           HttpService->ControllerHandle
+           );
+
+    NetLibDestroyServiceChild (
+      HttpService->ControllerHandle,
+      HttpService->Ip4DriverBindingHandle,
+      &gEfiTcp4ServiceBindingProtocolGuid,
+      Connection->TcpChildHandle
+      );
+  } else {
+    gBS->CloseProtocol (
+           Connection->TcpChildHandle,
+           &gEfiTcp6ProtocolGuid,
+           HttpService->Ip6DriverBindingHandle,
+           HttpService->ControllerHandle
+           );
+
+    NetLibDestroyServiceChild (
+      HttpService->ControllerHandle,
+      HttpService->Ip6DriverBindingHandle,
+      &gEfiTcp6ServiceBindingProtocolGuid,
+      Connection->TcpChildHandle
+      );
+  }
+
+  FreePool (Connection->RemoteHost);
+  FreePool (Connection);
+}
+
 /**
   Establish TCP connection with HTTP server.
 
@@ -1086,6 +1437,7 @@ HttpConfigureTcp4 (
   Tcp4Option->KeepAliveInterval   = HTTP_KEEP_ALIVE_INTERVAL;
   Tcp4Option->EnableNagle         = TRUE;
   Tcp4Option->EnableWindowScaling = TRUE;
+  Tcp4Option->EnableSelectiveAck  = TRUE;
   Tcp4CfgData->ControlOption      = Tcp4Option;
 
   if ((HttpInstance->State == HTTP_STATE_TCP_CONNECTED) ||
@@ -1170,6 +1522,7 @@ HttpConfigureTcp6 (
   Tcp6Option->KeepAliveInterval   = HTTP_KEEP_ALIVE_INTERVAL;
   Tcp6Option->EnableNagle         = TRUE;
   Tcp6Option->EnableWindowScaling = TRUE;
+  Tcp6Option->EnableSelectiveAck  = TRUE;
 
   if ((HttpInstance->State == HTTP_STATE_TCP_CONNECTED) ||
       (HttpInstance->State == HTTP_STATE_TCP_CLOSED))
@@ -60,8 +60,28 @@ typedef struct _HTTP_SERVICE {
   LIST_ENTRY                      ChildrenList;
   UINTN                           ChildrenNumber;
   INTN                            State;
+  LIST_ENTRY                      IdleConnections; // Most recently used first.
+  UINTN                           IdleConnectionNumber;
 } HTTP_SERVICE;
 
+//
+// A TCP connection kept open by the HTTP service after the HTTP child which
+// made it has been reset or destroyed, to be taken over by another HTTP
+// child requesting the same server. HTTPS connections are not kept yet, see
+// HttpKeepIdleConnection().
+//
+typedef struct {
+  LIST_ENTRY                 Link;
+  BOOLEAN                    LocalAddressIsIPv6;
+  EFI_HANDLE                 TcpChildHandle;
+  CHAR8                      *RemoteHost;
+  UINT16                     RemotePort;
+  EFI_IPv4_ADDRESS           RemoteAddr;
+  EFI_IPv6_ADDRESS           RemoteIpv6Addr;
+  EFI_HTTPv4_ACCESS_POINT    IPv4Node;
+  EFI_HTTPv6_ACCESS_POINT    Ipv6Node;
+} HTTP_IDLE_CONNECTION;
+
 typedef struct {
   EFI_TCP4_IO_TOKEN         Tx4Token;
   EFI_TCP4_TRANSMIT_DATA    Tx4Data;
@@ -334,6 +354,49 @@ HttpCleanProtocol (
   IN  HTTP_PROTOCOL  *HttpInstance
   );
 
+/**
+  Keep the TCP connection of the HTTP child open in the idle connections of
+  the HTTP service, if no response data is pending on it.
+
+  @param[in, out]  HttpInstance       The HTTP child which is reset or destroyed.
+
+**/
+VOID
+HttpKeepIdleConnection (
+  IN OUT HTTP_PROTOCOL  *HttpInstance
+  );
+
+/**
+  Take over an idle connection to the remote host for the HTTP child.
+
+  @param[in, out]  HttpInstance       The HTTP child which has not connected yet.
+  @param[in]       HostName           The remote host of the request.
+  @param[in]       RemotePort         The remote port of the request.
+
+  @retval TRUE     The HTTP child takes over an idle connection.
+  @retval FALSE    There is no usable idle connection to the remote host.
+
+**/
+BOOLEAN
+HttpTakeIdleConnection (
+  IN OUT HTTP_PROTOCOL  *HttpInstance,
+  IN     CHAR8          *HostName,
+  IN     UINT16         RemotePort
+  );
+
+/**
+  Close an idle connection and release its resources.
+
+  @param[in]  HttpService        The HTTP service which keeps the connection.
+  @param[in]  Connection         The idle connection, removed from the list.
+
+**/
+VOID
+HttpDestroyIdleConnection (
+  IN HTTP_SERVICE          *HttpService,
+  IN HTTP_IDLE_CONNECTION  *Connection
+  );
+
 /**
   Establish TCP connection with HTTP server.
 
@@ -90,12 +90,36 @@ IScsiExtScsiPassThruFunction (
     return EFI_INVALID_PARAMETER;
   }
 
+  Private = ISCSI_DRIVER_DATA_FROM_EXT_SCSI_PASS_THRU (This);
+
+  if (Private->Session->Failed) {
+    //
+    // The connection failed while completing the nonblocking requests. The
+    // session is reinstated here in the caller's context, the login can't
+    // run in a notification function or above TPL_CALLBACK.
+    //
+    if (EfiGetCurrentTpl () > TPL_CALLBACK) {
+      return EFI_DEVICE_ERROR;
+    }
+
+    if (EFI_ERROR (IScsiSessionReinstatement (Private->Session))) {
+      return EFI_DEVICE_ERROR;
+    }
+  }
+
+  if (Event != NULL) {
+    //
+    // Nonblocking I/O. The command is sent to the target and completed by
+    // the notification functions of the session.
+    //
+    return IScsiQueueScsiCommand (This, Lun, Packet, Event);
+  }
+
   Status = IScsiExecuteScsiCommand (This, Target, Lun, Packet);
   if ((Status != EFI_SUCCESS) && (Status != EFI_NOT_READY)) {
     //
     // Try to reinstate the session and re-execute the Scsi command.
     //
-    Private = ISCSI_DRIVER_DATA_FROM_EXT_SCSI_PASS_THRU (This);
     if (EFI_ERROR (IScsiSessionReinstatement (Private->Session))) {
       return EFI_DEVICE_ERROR;
     }
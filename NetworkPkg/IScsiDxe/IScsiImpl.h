@@ -107,6 +107,16 @@ struct _ISCSI_SESSION {
 
   LIST_ENTRY                     TcbList;
 
+  //
+  // The nonblocking requests not sent yet, the number of the nonblocking
+  // tasks sent and not completed, and whether the connection failed in a
+  // notification function, so the session is to be reinstated by the next
+  // caller.
+  //
+  LIST_ENTRY                     AsyncRequestList;
+  UINT32                         AsyncTaskNumber;
+  BOOLEAN                        Failed;
+
   //
   // Session-wide parameters
   //
@@ -157,6 +167,11 @@ struct _ISCSI_CONNECTION {
   BOOLEAN              Ipv6Flag;
   TCP_IO               TcpIo;
 
+  //
+  // The receive of the PDUs in the full feature phase.
+  //
+  ISCSI_PDU_RECEIVE    PduReceive;
+
   //
   // Connection-only parameters.
   //
@@ -190,6 +205,7 @@ struct _ISCSI_DRIVER_DATA {
   ISCSI_PRIVATE_PROTOCOL             IScsiIdentifier;
 
   EFI_EVENT                          ExitBootServiceEvent;
+  EFI_EVENT                          AsyncPollEvent;
 
   EFI_EXT_SCSI_PASS_THRU_PROTOCOL    IScsiExtScsiPassThru;
   EFI_EXT_SCSI_PASS_THRU_MODE        ExtScsiPassThruMode;
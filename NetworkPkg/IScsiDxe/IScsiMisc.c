@@ -1780,6 +1780,22 @@ IScsiCreateDriverData (
     return NULL;
   }
 
+  //
+  // Create a timer to drive the nonblocking SCSI requests.
+  //
+  Status = gBS->CreateEvent (
+                  EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  IScsiOnAsyncPoll,
+                  Private,
+                  &Private->AsyncPollEvent
+                  );
+  if (EFI_ERROR (Status)) {
+    gBS->CloseEvent (Private->ExitBootServiceEvent);
+    FreePool (Private);
+    return NULL;
+  }
+
   Private->ExtScsiPassThruHandle = NULL;
   CopyMem (&Private->IScsiExtScsiPassThru, &gIScsiExtScsiPassThruProtocolTemplate, sizeof (EFI_EXT_SCSI_PASS_THRU_PROTOCOL));
 
@@ -1787,7 +1803,9 @@ IScsiCreateDriverData (
   // 0 is designated to the TargetId, so use another value for the AdapterId.
   //
   Private->ExtScsiPassThruMode.AdapterId  = 2;
-  Private->ExtScsiPassThruMode.Attributes = EFI_EXT_SCSI_PASS_THRU_ATTRIBUTES_PHYSICAL | EFI_EXT_SCSI_PASS_THRU_ATTRIBUTES_LOGICAL;
+  Private->ExtScsiPassThruMode.Attributes = EFI_EXT_SCSI_PASS_THRU_ATTRIBUTES_PHYSICAL |
+                                            EFI_EXT_SCSI_PASS_THRU_ATTRIBUTES_LOGICAL |
+                                            EFI_EXT_SCSI_PASS_THRU_ATTRIBUTES_NONBLOCKIO;
   Private->ExtScsiPassThruMode.IoAlign    = 4;
   Private->IScsiExtScsiPassThru.Mode      = &Private->ExtScsiPassThruMode;
 
@@ -1841,6 +1859,10 @@ EXIT:
     gBS->CloseEvent (Private->ExitBootServiceEvent);
   }
 
+  if (Private->AsyncPollEvent != NULL) {
+    gBS->CloseEvent (Private->AsyncPollEvent);
+  }
+
   mCallbackInfo->Current = NULL;
 
   FreePool (Private);
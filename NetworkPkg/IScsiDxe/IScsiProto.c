@@ -311,6 +311,14 @@ IScsiDestroyConnection (
   IN ISCSI_CONNECTION  *Conn
   )
 {
+  //
+  // Cancel the receive before its token and event go away.
+  //
+  IScsiStopPduReceive (Conn);
+  if (Conn->PduReceive.Event != NULL) {
+    gBS->CloseEvent (Conn->PduReceive.Event);
+  }
+
   TcpIoDestroySocket (&Conn->TcpIo);
 
   NetbufQueFlush (&Conn->RspQue);
@@ -1283,6 +1291,104 @@ IScsiNbufExtFree (
 {
 }
 
+/**
+  Allocate the net buffer to receive the data segment of an iSCSI PDU into,
+  together with the padding bytes and the data digest, if any.
+
+  @param[in]   Header       The BHS of the iSCSI PDU.
+  @param[in]   Context      The context used to describe information on the caller provided
+                            buffer to receive data segment of the iSCSI pdu. It is optional.
+  @param[in]   DataDigest   Whether there will be data digest.
+  @param[in]   PadAndCRC32  The buffer to receive the padding bytes and the data digest
+                            into if the data segment is received into the caller provided
+                            buffer. It must stay valid until the data segment is received.
+  @param[out]  DataSeg      The net buffer to receive the data segment into.
+
+  @retval EFI_SUCCESS          The net buffer is allocated.
+  @retval EFI_OUT_OF_RESOURCES Failed to allocate memory.
+  @retval EFI_PROTOCOL_ERROR   Some kind of iSCSI protocol error occurred.
+
+**/
+EFI_STATUS
+IScsiNewDataSegBuffer (
+  IN  UINT8                    *Header,
+  IN  ISCSI_IN_BUFFER_CONTEXT  *Context  OPTIONAL,
+  IN  BOOLEAN                  DataDigest,
+  IN  UINT32                   *PadAndCRC32,
+  OUT NET_BUF                  **DataSeg
+  )
+{
+  UINT32        Len;
+  UINT32        PadLen;
+  UINT32        InDataOffset;
+  NET_FRAGMENT  Fragment[2];
+  UINT32        FragmentCount;
+
+  Len    = ISCSI_GET_DATASEG_LEN (Header);
+  PadLen = ISCSI_GET_PAD_LEN (Len);
+
+  switch (ISCSI_GET_OPCODE (Header)) {
+    case ISCSI_OPCODE_SCSI_DATA_IN:
+      //
+      // To reduce memory copy overhead, try to use the buffer described by Context
+      // if the PDU is an iSCSI SCSI data.
+      //
+      InDataOffset = ISCSI_GET_BUFFER_OFFSET (Header);
+      if ((Context == NULL) || ((InDataOffset + Len) > Context->InDataLen)) {
+        return EFI_PROTOCOL_ERROR;
+      }
+
+      Fragment[0].Len  = Len;
+      Fragment[0].Bulk = Context->InData + InDataOffset;
+
+      if (DataDigest || (PadLen != 0)) {
+        //
+        // The data segment is padded. Use two fragments to receive it:
+        // the first to receive the useful data; the second to receive the padding.
+        //
+        Fragment[1].Len  = PadLen + (DataDigest ? sizeof (UINT32) : 0);
+        Fragment[1].Bulk = (UINT8 *)PadAndCRC32 + (4 - PadLen);
+
+        FragmentCount = 2;
+      } else {
+        FragmentCount = 1;
+      }
+
+      *DataSeg = NetbufFromExt (&Fragment[0], FragmentCount, 0, 0, IScsiNbufExtFree, NULL);
+      if (*DataSeg == NULL) {
+        return EFI_OUT_OF_RESOURCES;
+      }
+
+      break;
+
+    case ISCSI_OPCODE_SCSI_RSP:
+    case ISCSI_OPCODE_NOP_IN:
+    case ISCSI_OPCODE_LOGIN_RSP:
+    case ISCSI_OPCODE_TEXT_RSP:
+    case ISCSI_OPCODE_ASYNC_MSG:
+    case ISCSI_OPCODE_REJECT:
+    case ISCSI_OPCODE_VENDOR_T0:
+    case ISCSI_OPCODE_VENDOR_T1:
+    case ISCSI_OPCODE_VENDOR_T2:
+      //
+      // Allocate buffer to receive the data segment.
+      //
+      Len     += PadLen + (DataDigest ? sizeof (UINT32) : 0);
+      *DataSeg = NetbufAlloc (Len);
+      if (*DataSeg == NULL) {
+        return EFI_OUT_OF_RESOURCES;
+      }
+
+      NetbufAllocSpace (*DataSeg, Len, NET_BUF_TAIL);
+      break;
+
+    default:
+      return EFI_PROTOCOL_ERROR;
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   Receive an iSCSI response PDU. An iSCSI response PDU contains an iSCSI PDU header and
   an optional data segment. The two parts will be put into two blocks of buffers in the
@@ -1319,9 +1425,6 @@ IScsiReceivePdu (
   UINT8         *Header;
   EFI_STATUS    Status;
   UINT32        PadLen;
-  UINT32        InDataOffset;
-  NET_FRAGMENT  Fragment[2];
-  UINT32        FragmentCount;
   NET_BUF       *DataSeg;
   UINT32        PadAndCRC32[2];
 
@@ -1382,67 +1485,9 @@ IScsiReceivePdu (
   //
   PadLen = ISCSI_GET_PAD_LEN (Len);
 
-  switch (ISCSI_GET_OPCODE (Header)) {
-    case ISCSI_OPCODE_SCSI_DATA_IN:
-      //
-      // To reduce memory copy overhead, try to use the buffer described by Context
-      // if the PDU is an iSCSI SCSI data.
-      //
-      InDataOffset = ISCSI_GET_BUFFER_OFFSET (Header);
-      if ((Context == NULL) || ((InDataOffset + Len) > Context->InDataLen)) {
-        Status = EFI_PROTOCOL_ERROR;
-        goto ON_EXIT;
-      }
-
-      Fragment[0].Len  = Len;
-      Fragment[0].Bulk = Context->InData + InDataOffset;
-
-      if (DataDigest || (PadLen != 0)) {
-        //
-        // The data segment is padded. Use two fragments to receive it:
-        // the first to receive the useful data; the second to receive the padding.
-        //
-        Fragment[1].Len  = PadLen + (DataDigest ? sizeof (UINT32) : 0);
-        Fragment[1].Bulk = (UINT8 *)PadAndCRC32 + (4 - PadLen);
-
-        FragmentCount = 2;
-      } else {
-        FragmentCount = 1;
-      }
-
-      DataSeg = NetbufFromExt (&Fragment[0], FragmentCount, 0, 0, IScsiNbufExtFree, NULL);
-      if (DataSeg == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        goto ON_EXIT;
-      }
-
-      break;
-
-    case ISCSI_OPCODE_SCSI_RSP:
-    case ISCSI_OPCODE_NOP_IN:
-    case ISCSI_OPCODE_LOGIN_RSP:
-    case ISCSI_OPCODE_TEXT_RSP:
-    case ISCSI_OPCODE_ASYNC_MSG:
-    case ISCSI_OPCODE_REJECT:
-    case ISCSI_OPCODE_VENDOR_T0:
-    case ISCSI_OPCODE_VENDOR_T1:
-    case ISCSI_OPCODE_VENDOR_T2:
-      //
-      // Allocate buffer to receive the data segment.
-      //
-      Len    += PadLen + (DataDigest ? sizeof (UINT32) : 0);
-      DataSeg = NetbufAlloc (Len);
-      if (DataSeg == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        goto ON_EXIT;
-      }
-
-      NetbufAllocSpace (DataSeg, Len, NET_BUF_TAIL);
-      break;
-
-    default:
-      Status = EFI_PROTOCOL_ERROR;
-      goto ON_EXIT;
+  Status = IScsiNewDataSegBuffer (Header, Context, DataDigest, PadAndCRC32, &DataSeg);
+  if (EFI_ERROR (Status)) {
+    goto ON_EXIT;
   }
 
   InsertTailList (NbufList, &DataSeg->List);
@@ -2112,6 +2157,34 @@ IScsiDelTcb (
   FreePool (Tcb);
 }
 
+/**
+  Find the task control block of the task with the initiator task tag.
+
+  @param[in]  Session           The iSCSI session.
+  @param[in]  InitiatorTaskTag  The initiator task tag.
+
+  @return The task control block, or NULL if there is no such task.
+
+**/
+ISCSI_TCB *
+IScsiFindTcb (
+  IN ISCSI_SESSION  *Session,
+  IN UINT32         InitiatorTaskTag
+  )
+{
+  LIST_ENTRY  *Entry;
+  ISCSI_TCB   *Tcb;
+
+  NET_LIST_FOR_EACH (Entry, &Session->TcbList) {
+    Tcb = NET_LIST_USER_STRUCT (Entry, ISCSI_TCB, Link);
+    if (Tcb->InitiatorTaskTag == InitiatorTaskTag) {
+      return Tcb;
+    }
+  }
+
+  return NULL;
+}
+
 /**
   Create a data segment, pad it, and calculate the CRC if needed.
 
@@ -2841,7 +2914,7 @@ IScsiOnScsiRspRcvd (
   Process the received NOP In PDU.
 
   @param[in]  Pdu            The NOP In PDU received.
-  @param[in]  Tcb            The task control block.
+  @param[in]  Conn           The connection on which the PDU is received.
 
   @retval EFI_SUCCESS        The NOP In PDU is processed and the related sequence
                              numbers are updated.
@@ -2850,8 +2923,8 @@ IScsiOnScsiRspRcvd (
 **/
 EFI_STATUS
 IScsiOnNopInRcvd (
-  IN NET_BUF    *Pdu,
-  IN ISCSI_TCB  *Tcb
+  IN NET_BUF           *Pdu,
+  IN ISCSI_CONNECTION  *Conn
   )
 {
   ISCSI_NOP_IN  *NopInHdr;
@@ -2867,103 +2940,95 @@ IScsiOnNopInRcvd (
   NopInHdr->MaxCmdSN = NTOHL (NopInHdr->MaxCmdSN);
 
   if (NopInHdr->InitiatorTaskTag == ISCSI_RESERVED_TAG) {
-    if (NopInHdr->StatSN != Tcb->Conn->ExpStatSN) {
+    if (NopInHdr->StatSN != Conn->ExpStatSN) {
       return EFI_PROTOCOL_ERROR;
     }
   } else {
-    Status = IScsiCheckSN (&Tcb->Conn->ExpStatSN, NopInHdr->StatSN);
+    Status = IScsiCheckSN (&Conn->ExpStatSN, NopInHdr->StatSN);
     if (EFI_ERROR (Status)) {
       return Status;
     }
   }
 
-  IScsiUpdateCmdSN (Tcb->Conn->Session, NopInHdr->MaxCmdSN, NopInHdr->ExpCmdSN);
+  IScsiUpdateCmdSN (Conn->Session, NopInHdr->MaxCmdSN, NopInHdr->ExpCmdSN);
 
   return EFI_SUCCESS;
 }
 
 /**
-  Execute the SCSI command issued through the EXT SCSI PASS THRU protocol.
+  Create the task control block of a SCSI command, send the SCSI Command PDU and
+  the unsolicited data to the target.
 
-  @param[in]       PassThru  The EXT SCSI PASS THRU protocol.
-  @param[in]       Target    The target ID.
+  @param[in]       Conn      The connection to send the command on.
   @param[in]       Lun       The LUN.
   @param[in, out]  Packet    The request packet containing IO request, SCSI command
                              buffer and buffers to read/write.
+  @param[in]       Event     The event to signal when the command completes. NULL
+                             for a blocking command.
+  @param[out]      Tcb       The task control block of the command.
 
-  @retval EFI_SUCCESS          The SCSI command is executed and the result is updated to
-                               the Packet.
-  @retval EFI_DEVICE_ERROR     Session state was not as required.
+  @retval EFI_SUCCESS          The SCSI command is sent.
   @retval EFI_OUT_OF_RESOURCES Failed to allocate memory.
-  @retval EFI_PROTOCOL_ERROR   There is no such data in the net buffer.
   @retval EFI_NOT_READY        The target can not accept new commands.
   @retval Others               Other errors as indicated.
 
 **/
 EFI_STATUS
-IScsiExecuteScsiCommand (
-  IN EFI_EXT_SCSI_PASS_THRU_PROTOCOL                 *PassThru,
-  IN UINT8                                           *Target,
-  IN UINT64                                          Lun,
-  IN OUT EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET  *Packet
+IScsiStartScsiCommand (
+  IN     ISCSI_CONNECTION                            *Conn,
+  IN     UINT64                                      Lun,
+  IN OUT EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET  *Packet,
+  IN     EFI_EVENT                                   Event OPTIONAL,
+  OUT    ISCSI_TCB                                   **Tcb
   )
 {
-  EFI_STATUS               Status;
-  ISCSI_DRIVER_DATA        *Private;
-  ISCSI_SESSION            *Session;
-  EFI_EVENT                TimeoutEvent;
-  ISCSI_CONNECTION         *Conn;
-  ISCSI_TCB                *Tcb;
-  NET_BUF                  *Pdu;
-  ISCSI_XFER_CONTEXT       *XferContext;
-  UINT8                    *Data;
-  ISCSI_IN_BUFFER_CONTEXT  InBufferContext;
-  UINT64                   Timeout;
-  UINT8                    *PduHdr;
-
-  Private      = ISCSI_DRIVER_DATA_FROM_EXT_SCSI_PASS_THRU (PassThru);
-  Session      = Private->Session;
-  Status       = EFI_SUCCESS;
-  Tcb          = NULL;
-  TimeoutEvent = NULL;
-  Timeout      = 0;
-
-  if (Session->State != SESSION_STATE_LOGGED_IN) {
-    Status = EFI_DEVICE_ERROR;
-    goto ON_EXIT;
-  }
+  EFI_STATUS          Status;
+  ISCSI_SESSION       *Session;
+  ISCSI_TCB           *NewTcb;
+  NET_BUF             *Pdu;
+  ISCSI_XFER_CONTEXT  *XferContext;
+  UINT8               *Data;
+  UINT8               *PduHdr;
 
-  Conn = NET_LIST_USER_STRUCT_S (
-           Session->Conns.ForwardLink,
-           ISCSI_CONNECTION,
-           Link,
-           ISCSI_CONNECTION_SIGNATURE
-           );
+  Session = Conn->Session;
 
-  if (Packet->Timeout != 0) {
-    Timeout = MultU64x32 (Packet->Timeout, 4);
+  if (Conn->PduReceive.NbufList == NULL) {
+    //
+    // The first command in the full feature phase, start to receive the
+    // PDUs of the tasks.
+    //
+    Status = IScsiStartPduReceive (Conn);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
   }
 
-  Status = IScsiNewTcb (Conn, &Tcb);
+  Status = IScsiNewTcb (Conn, &NewTcb);
   if (EFI_ERROR (Status)) {
-    goto ON_EXIT;
+    return Status;
   }
 
+  NewTcb->Lun                       = Lun;
+  NewTcb->Packet                    = Packet;
+  NewTcb->Event                     = Event;
+  NewTcb->InBufferContext.InData    = (UINT8 *)Packet->InDataBuffer;
+  NewTcb->InBufferContext.InDataLen = Packet->InTransferLength;
+
   //
   // Encapsulate the SCSI request packet into an iSCSI SCSI Command PDU.
   //
-  Pdu = IScsiNewScsiCmdPdu (Packet, Lun, Tcb);
+  Pdu = IScsiNewScsiCmdPdu (Packet, Lun, NewTcb);
   if (Pdu == NULL) {
     Status = EFI_OUT_OF_RESOURCES;
-    goto ON_EXIT;
+    goto ON_ERROR;
   }
 
-  XferContext = &Tcb->XferContext;
+  XferContext = &NewTcb->XferContext;
   PduHdr      = NetbufGetByte (Pdu, 0, NULL);
   if (PduHdr == NULL) {
     Status = EFI_PROTOCOL_ERROR;
     NetbufFree (Pdu);
-    goto ON_EXIT;
+    goto ON_ERROR;
   }
 
   XferContext->Offset = ISCSI_GET_DATASEG_LEN (PduHdr);
@@ -2976,7 +3041,7 @@ IScsiExecuteScsiCommand (
   NetbufFree (Pdu);
 
   if (EFI_ERROR (Status)) {
-    goto ON_EXIT;
+    goto ON_ERROR;
   }
 
   if (!Session->InitialR2T &&
@@ -2995,93 +3060,900 @@ IScsiExecuteScsiCommand (
                                        );
 
     Data   = (UINT8 *)Packet->OutDataBuffer + XferContext->Offset;
-    Status = IScsiSendDataOutPduSequence (Data, Lun, Tcb);
+    Status = IScsiSendDataOutPduSequence (Data, Lun, NewTcb);
     if (EFI_ERROR (Status)) {
-      goto ON_EXIT;
+      goto ON_ERROR;
     }
   }
 
-  InBufferContext.InData    = (UINT8 *)Packet->InDataBuffer;
-  InBufferContext.InDataLen = Packet->InTransferLength;
+  *Tcb = NewTcb;
 
-  while (!Tcb->StatusXferd) {
-    //
-    // Start the timeout timer.
-    //
-    if (Timeout != 0) {
-      Status = gBS->SetTimer (Conn->TimeoutEvent, TimerRelative, Timeout);
-      if (EFI_ERROR (Status)) {
-        goto ON_EXIT;
-      }
+  return EFI_SUCCESS;
 
-      TimeoutEvent = Conn->TimeoutEvent;
-    }
+ON_ERROR:
 
-    //
-    // Try to receive PDU from target.
-    //
-    Status = IScsiReceivePdu (Conn, &Pdu, &InBufferContext, FALSE, FALSE, TimeoutEvent);
-    if (EFI_ERROR (Status)) {
-      goto ON_EXIT;
-    }
+  IScsiDelTcb (NewTcb);
 
-    PduHdr = NetbufGetByte (Pdu, 0, NULL);
-    if (PduHdr == NULL) {
-      Status = EFI_PROTOCOL_ERROR;
-      NetbufFree (Pdu);
-      goto ON_EXIT;
-    }
+  return Status;
+}
 
-    switch (ISCSI_GET_OPCODE (PduHdr)) {
-      case ISCSI_OPCODE_SCSI_DATA_IN:
-        Status = IScsiOnDataInRcvd (Pdu, Tcb, Packet);
-        break;
+/**
+  Complete a nonblocking task: signal its event and destroy its task control block.
 
-      case ISCSI_OPCODE_R2T:
-        Status = IScsiOnR2TRcvd (Pdu, Tcb, Lun, Packet);
-        break;
+  @param[in]  Tcb  The task control block of the nonblocking task.
 
-      case ISCSI_OPCODE_SCSI_RSP:
-        Status = IScsiOnScsiRspRcvd (Pdu, Tcb, Packet);
-        break;
+**/
+VOID
+IScsiCompleteAsyncTask (
+  IN ISCSI_TCB  *Tcb
+  )
+{
+  ISCSI_SESSION  *Session;
 
-      case ISCSI_OPCODE_NOP_IN:
-        Status = IScsiOnNopInRcvd (Pdu, Tcb);
-        break;
+  ASSERT (Tcb->Event != NULL);
 
-      case ISCSI_OPCODE_VENDOR_T0:
-      case ISCSI_OPCODE_VENDOR_T1:
-      case ISCSI_OPCODE_VENDOR_T2:
-        //
-        // These messages are vendor specific. Skip them.
-        //
-        break;
+  Session = Tcb->Conn->Session;
+  Session->AsyncTaskNumber--;
 
-      default:
-        Status = EFI_PROTOCOL_ERROR;
-        break;
-    }
+  gBS->SignalEvent (Tcb->Event);
+  IScsiDelTcb (Tcb);
+}
 
-    NetbufFree (Pdu);
+/**
+  Fail all the nonblocking tasks of the session, including the ones not sent
+  to the target yet, and signal their events.
 
-    if (EFI_ERROR (Status)) {
-      break;
+  @param[in]  Session  The iSCSI session.
+
+**/
+VOID
+IScsiAbortAsyncTasks (
+  IN ISCSI_SESSION  *Session
+  )
+{
+  LIST_ENTRY           *Entry;
+  LIST_ENTRY           *NextEntry;
+  ISCSI_TCB            *Tcb;
+  ISCSI_ASYNC_REQUEST  *Request;
+  EFI_TPL              OldTpl;
+
+  NET_LIST_FOR_EACH_SAFE (Entry, NextEntry, &Session->TcbList) {
+    Tcb = NET_LIST_USER_STRUCT (Entry, ISCSI_TCB, Link);
+    if (Tcb->Event != NULL) {
+      Tcb->Packet->HostAdapterStatus = EFI_EXT_SCSI_STATUS_HOST_ADAPTER_OTHER;
+      IScsiCompleteAsyncTask (Tcb);
     }
   }
 
-ON_EXIT:
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
 
-  if (TimeoutEvent != NULL) {
-    gBS->SetTimer (TimeoutEvent, TimerCancel, 0);
-  }
+  while (!IsListEmpty (&Session->AsyncRequestList)) {
+    Request = NET_LIST_HEAD (&Session->AsyncRequestList, ISCSI_ASYNC_REQUEST, Link);
+    RemoveEntryList (&Request->Link);
 
-  if (Tcb != NULL) {
-    IScsiDelTcb (Tcb);
+    Request->Packet->HostAdapterStatus = EFI_EXT_SCSI_STATUS_HOST_ADAPTER_OTHER;
+    gBS->SignalEvent (Request->Event);
+    FreePool (Request);
+  }
+
+  gBS->RestoreTPL (OldTpl);
+}
+
+/**
+  Post the receive of the remaining part of the PDU segment being received on
+  the connection. The receive completes in the background, and the token is
+  processed by IScsiProcessPduReceive().
+
+  @param[in]  Conn  The iSCSI connection.
+
+  @retval EFI_SUCCESS  The receive is posted.
+  @retval Others       Other errors as indicated.
+
+**/
+EFI_STATUS
+IScsiPostPduReceive (
+  IN ISCSI_CONNECTION  *Conn
+  )
+{
+  ISCSI_PDU_RECEIVE  *Receive;
+  NET_FRAGMENT       *Fragment;
+  EFI_STATUS         Status;
+
+  Receive  = &Conn->PduReceive;
+  Fragment = &Receive->Fragment[Receive->CurrentFragment];
+
+  Receive->RxData.DataLength                      = Fragment->Len;
+  Receive->RxData.FragmentCount                   = 1;
+  Receive->RxData.FragmentTable[0].FragmentLength = Fragment->Len;
+  Receive->RxData.FragmentTable[0].FragmentBuffer = Fragment->Bulk;
+
+  //
+  // TCP sets the status of the token before signaling its event, so the
+  // token is completed once the status is no longer EFI_NOT_READY.
+  //
+  Receive->Token.Tcp4Token.CompletionToken.Status = EFI_NOT_READY;
+  Receive->Posted                                 = TRUE;
+
+  if (Conn->TcpIo.TcpVersion == TCP_VERSION_4) {
+    Status = Conn->TcpIo.Tcp.Tcp4->Receive (Conn->TcpIo.Tcp.Tcp4, &Receive->Token.Tcp4Token);
+  } else {
+    Status = Conn->TcpIo.Tcp.Tcp6->Receive (Conn->TcpIo.Tcp.Tcp6, &Receive->Token.Tcp6Token);
+  }
+
+  if (EFI_ERROR (Status)) {
+    Receive->Posted = FALSE;
   }
 
   return Status;
 }
 
+/**
+  Start to receive a segment of the PDU, the BHS or the data segment, into
+  the net buffer.
+
+  @param[in]  Conn     The iSCSI connection.
+  @param[in]  Segment  The net buffer to receive the segment into. It is
+                       already in the list of the segments of the PDU.
+
+  @retval EFI_SUCCESS  The receive is posted.
+  @retval Others       Other errors as indicated.
+
+**/
+EFI_STATUS
+IScsiReceivePduSegment (
+  IN ISCSI_CONNECTION  *Conn,
+  IN NET_BUF           *Segment
+  )
+{
+  ISCSI_PDU_RECEIVE  *Receive;
+  EFI_STATUS         Status;
+
+  Receive                  = &Conn->PduReceive;
+  Receive->Segment         = Segment;
+  Receive->FragmentCount   = ARRAY_SIZE (Receive->Fragment);
+  Receive->CurrentFragment = 0;
+
+  Status = NetbufBuildExt (Segment, Receive->Fragment, &Receive->FragmentCount);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  return IScsiPostPduReceive (Conn);
+}
+
+/**
+  Start to receive the next PDU on a connection in the full feature phase.
+
+  @param[in]  Conn  The iSCSI connection.
+
+  @retval EFI_SUCCESS          The receive is posted.
+  @retval EFI_OUT_OF_RESOURCES Failed to allocate memory.
+  @retval Others               Other errors as indicated.
+
+**/
+EFI_STATUS
+IScsiStartPduReceive (
+  IN ISCSI_CONNECTION  *Conn
+  )
+{
+  ISCSI_PDU_RECEIVE  *Receive;
+  NET_BUF            *PduHdr;
+  EFI_STATUS         Status;
+
+  Receive = &Conn->PduReceive;
+
+  if (Receive->Event == NULL) {
+    Status = gBS->CreateEvent (
+                    EVT_NOTIFY_SIGNAL,
+                    TPL_CALLBACK,
+                    IScsiOnPduReceived,
+                    Conn,
+                    &Receive->Event
+                    );
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    Receive->Token.Tcp4Token.CompletionToken.Event = Receive->Event;
+    Receive->Token.Tcp4Token.Packet.RxData         = &Receive->RxData;
+  }
+
+  Receive->NbufList = AllocatePool (sizeof (LIST_ENTRY));
+  if (Receive->NbufList == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  InitializeListHead (Receive->NbufList);
+
+  //
+  // The digests are not negotiated, see IScsiCheckOpParams().
+  //
+  PduHdr = NetbufAlloc (sizeof (ISCSI_BASIC_HEADER));
+  if (PduHdr == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  NetbufAllocSpace (PduHdr, sizeof (ISCSI_BASIC_HEADER), NET_BUF_TAIL);
+  InsertTailList (Receive->NbufList, &PduHdr->List);
+  Receive->PduHdr = PduHdr;
+
+  return IScsiReceivePduSegment (Conn, PduHdr);
+}
+
+/**
+  Stop the receive of the PDUs on a connection, and free the PDU being
+  received. It is safe to call it if the receive is not started.
+
+  @param[in]  Conn  The iSCSI connection.
+
+**/
+VOID
+IScsiStopPduReceive (
+  IN ISCSI_CONNECTION  *Conn
+  )
+{
+  ISCSI_PDU_RECEIVE  *Receive;
+
+  Receive = &Conn->PduReceive;
+
+  if (Receive->Posted) {
+    //
+    // The PDU may be received into the buffer of a task, TCP must not write
+    // to it once the task is gone.
+    //
+    if (Conn->TcpIo.TcpVersion == TCP_VERSION_4) {
+      Conn->TcpIo.Tcp.Tcp4->Cancel (Conn->TcpIo.Tcp.Tcp4, &Receive->Token.Tcp4Token.CompletionToken);
+    } else {
+      Conn->TcpIo.Tcp.Tcp6->Cancel (Conn->TcpIo.Tcp.Tcp6, &Receive->Token.Tcp6Token.CompletionToken);
+    }
+
+    Receive->Posted = FALSE;
+  }
+
+  if (Receive->NbufList != NULL) {
+    IScsiFreeNbufList (Receive->NbufList);
+    Receive->NbufList = NULL;
+  }
+
+  Receive->PduHdr  = NULL;
+  Receive->Segment = NULL;
+}
+
+/**
+  Stop using a connection that failed in the full feature phase, and fail the
+  nonblocking tasks of the session. The session is reinstated later by a
+  caller of the EXT SCSI PASS THRU protocol, as this may run in a notification
+  function.
+
+  @param[in]  Conn    The iSCSI connection.
+  @param[in]  Status  The error the connection failed with.
+
+**/
+VOID
+IScsiFailConnection (
+  IN ISCSI_CONNECTION  *Conn,
+  IN EFI_STATUS        Status
+  )
+{
+  ISCSI_SESSION  *Session;
+
+  DEBUG ((DEBUG_ERROR, "IScsi: connection failed - %r\n", Status));
+
+  Session = Conn->Session;
+
+  IScsiStopPduReceive (Conn);
+  Session->Failed = TRUE;
+  IScsiAbortAsyncTasks (Session);
+}
+
+/**
+  Process a PDU the target sent for a task or for the connection. A nonblocking
+  task is completed as soon as its status is received.
+
+  @param[in]  Conn  The connection the PDU is received on.
+  @param[in]  Pdu   The PDU. It is freed by this function.
+
+  @retval EFI_SUCCESS          The PDU is processed.
+  @retval EFI_PROTOCOL_ERROR   Some kind of iSCSI protocol error occurred.
+  @retval Others               Other errors as indicated.
+
+**/
+EFI_STATUS
+IScsiProcessTaskPdu (
+  IN ISCSI_CONNECTION  *Conn,
+  IN NET_BUF           *Pdu
+  )
+{
+  EFI_STATUS  Status;
+  UINT8       *PduHdr;
+  UINT8       OpCode;
+  ISCSI_TCB   *Tcb;
+
+  PduHdr = NetbufGetByte (Pdu, 0, NULL);
+  if (PduHdr == NULL) {
+    NetbufFree (Pdu);
+    return EFI_PROTOCOL_ERROR;
+  }
+
+  Tcb    = NULL;
+  OpCode = ISCSI_GET_OPCODE (PduHdr);
+  if ((OpCode == ISCSI_OPCODE_SCSI_DATA_IN) ||
+      (OpCode == ISCSI_OPCODE_R2T) ||
+      (OpCode == ISCSI_OPCODE_SCSI_RSP)
+      )
+  {
+    Tcb = IScsiFindTcb (Conn->Session, NTOHL (((ISCSI_BASIC_HEADER *)PduHdr)->InitiatorTaskTag));
+    if (Tcb == NULL) {
+      NetbufFree (Pdu);
+      return EFI_PROTOCOL_ERROR;
+    }
+  }
+
+  Status = EFI_SUCCESS;
+
+  switch (OpCode) {
+    case ISCSI_OPCODE_SCSI_DATA_IN:
+      Status = IScsiOnDataInRcvd (Pdu, Tcb, Tcb->Packet);
+      break;
+
+    case ISCSI_OPCODE_R2T:
+      Status = IScsiOnR2TRcvd (Pdu, Tcb, Tcb->Lun, Tcb->Packet);
+      break;
+
+    case ISCSI_OPCODE_SCSI_RSP:
+      Status = IScsiOnScsiRspRcvd (Pdu, Tcb, Tcb->Packet);
+      break;
+
+    case ISCSI_OPCODE_NOP_IN:
+      Status = IScsiOnNopInRcvd (Pdu, Conn);
+      break;
+
+    case ISCSI_OPCODE_VENDOR_T0:
+    case ISCSI_OPCODE_VENDOR_T1:
+    case ISCSI_OPCODE_VENDOR_T2:
+      //
+      // These messages are vendor specific. Skip them.
+      //
+      break;
+
+    default:
+      Status = EFI_PROTOCOL_ERROR;
+      break;
+  }
+
+  NetbufFree (Pdu);
+
+  if ((Tcb != NULL) && Tcb->StatusXferd && (Status == EFI_BAD_BUFFER_SIZE)) {
+    //
+    // The overflow is reported to the caller through the transfer lengths in
+    // the packet, the connection is still usable.
+    //
+    Tcb->Status = EFI_BAD_BUFFER_SIZE;
+    Status      = EFI_SUCCESS;
+  }
+
+  if (!EFI_ERROR (Status) && (Tcb != NULL) && (Tcb->Event != NULL) && Tcb->StatusXferd) {
+    IScsiCompleteAsyncTask (Tcb);
+  }
+
+  return Status;
+}
+
+/**
+  Process the completed receive token of a connection: assemble the PDU, post
+  the receive of its next part, and process the PDU once it is complete. It
+  does nothing if the token is not completed, so it can be called from both
+  the completion event and a caller polling the connection. It must be called
+  at TPL_CALLBACK.
+
+  @param[in]  Conn  The iSCSI connection.
+
+  @retval EFI_SUCCESS  The completed token is processed, or there is none.
+  @retval Others       The connection failed.
+
+**/
+EFI_STATUS
+IScsiProcessPduReceive (
+  IN ISCSI_CONNECTION  *Conn
+  )
+{
+  ISCSI_PDU_RECEIVE        *Receive;
+  NET_FRAGMENT             *Fragment;
+  UINT8                    *Header;
+  ISCSI_TCB                *Tcb;
+  ISCSI_IN_BUFFER_CONTEXT  *Context;
+  NET_BUF                  *DataSeg;
+  NET_BUF                  *Pdu;
+  UINT32                   PadLen;
+  EFI_STATUS               Status;
+
+  Receive = &Conn->PduReceive;
+
+  while (Receive->Posted && (Receive->Token.Tcp4Token.CompletionToken.Status != EFI_NOT_READY)) {
+    Receive->Posted = FALSE;
+
+    Status = Receive->Token.Tcp4Token.CompletionToken.Status;
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    Fragment        = &Receive->Fragment[Receive->CurrentFragment];
+    Fragment->Len  -= Receive->RxData.FragmentTable[0].FragmentLength;
+    Fragment->Bulk += Receive->RxData.FragmentTable[0].FragmentLength;
+    if (Fragment->Len == 0) {
+      Receive->CurrentFragment++;
+    }
+
+    if (Receive->CurrentFragment < Receive->FragmentCount) {
+      Status = IScsiPostPduReceive (Conn);
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+
+      continue;
+    }
+
+    Header = NetbufGetByte (Receive->PduHdr, 0, NULL);
+    PadLen = ISCSI_GET_PAD_LEN (ISCSI_GET_DATASEG_LEN (Header));
+
+    if ((Receive->Segment == Receive->PduHdr) && (ISCSI_GET_DATASEG_LEN (Header) != 0)) {
+      //
+      // The BHS is received. The data segment of a SCSI Data-In PDU is
+      // received directly into the buffer of the task it belongs to.
+      //
+      Context = NULL;
+      if (ISCSI_GET_OPCODE (Header) == ISCSI_OPCODE_SCSI_DATA_IN) {
+        Tcb = IScsiFindTcb (Conn->Session, NTOHL (((ISCSI_BASIC_HEADER *)Header)->InitiatorTaskTag));
+        if (Tcb != NULL) {
+          Context = &Tcb->InBufferContext;
+        }
+      }
+
+      Status = IScsiNewDataSegBuffer (Header, Context, FALSE, Receive->PadAndCRC32, &DataSeg);
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+
+      InsertTailList (Receive->NbufList, &DataSeg->List);
+
+      Status = IScsiReceivePduSegment (Conn, DataSeg);
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+
+      continue;
+    }
+
+    if ((Receive->Segment != Receive->PduHdr) && (PadLen != 0)) {
+      //
+      // Trim off the padding bytes in the data segment.
+      //
+      NetbufTrim (Receive->Segment, PadLen, NET_BUF_TAIL);
+    }
+
+    //
+    // Form the pdu from a list of pdu segments, then receive the next one.
+    //
+    Pdu = NetbufFromBufList (Receive->NbufList, 0, 0, IScsiFreeNbufList, Receive->NbufList);
+    if (Pdu == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    Receive->NbufList = NULL;
+
+    Status = IScsiProcessTaskPdu (Conn, Pdu);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    Status = IScsiStartPduReceive (Conn);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Poll the connection once for the PDUs from the target, and process the
+  received ones. The connection is failed on error.
+
+  @param[in]  Conn          The iSCSI connection.
+  @param[in]  TimeoutEvent  The timeout event. It is optional.
+
+  @retval EFI_SUCCESS  The connection is polled.
+  @retval EFI_TIMEOUT  The timeout event is signaled.
+  @retval Others       The connection failed.
+
+**/
+EFI_STATUS
+IScsiPollPduReceive (
+  IN ISCSI_CONNECTION  *Conn,
+  IN EFI_EVENT         TimeoutEvent OPTIONAL
+  )
+{
+  EFI_STATUS  Status;
+
+  if ((TimeoutEvent != NULL) && !EFI_ERROR (gBS->CheckEvent (TimeoutEvent))) {
+    Status = EFI_TIMEOUT;
+  } else {
+    if (Conn->TcpIo.TcpVersion == TCP_VERSION_4) {
+      Conn->TcpIo.Tcp.Tcp4->Poll (Conn->TcpIo.Tcp.Tcp4);
+    } else {
+      Conn->TcpIo.Tcp.Tcp6->Poll (Conn->TcpIo.Tcp.Tcp6);
+    }
+
+    Status = IScsiProcessPduReceive (Conn);
+  }
+
+  if (EFI_ERROR (Status)) {
+    IScsiFailConnection (Conn, Status);
+  }
+
+  return Status;
+}
+
+/**
+  Send the queued nonblocking SCSI commands while the target accepts new
+  commands.
+
+  @param[in]  Session  The iSCSI session.
+
+  @retval EFI_SUCCESS  The commands are sent, or the command window is closed.
+  @retval Others       The connection failed.
+
+**/
+EFI_STATUS
+IScsiSendAsyncRequests (
+  IN ISCSI_SESSION  *Session
+  )
+{
+  EFI_STATUS           Status;
+  ISCSI_CONNECTION     *Conn;
+  ISCSI_ASYNC_REQUEST  *Request;
+  ISCSI_TCB            *Tcb;
+  EFI_TPL              OldTpl;
+
+  Conn = NET_LIST_USER_STRUCT_S (
+           Session->Conns.ForwardLink,
+           ISCSI_CONNECTION,
+           Link,
+           ISCSI_CONNECTION_SIGNATURE
+           );
+
+  while (TRUE) {
+    //
+    // The requests are queued at TPL_NOTIFY.
+    //
+    OldTpl  = gBS->RaiseTPL (TPL_NOTIFY);
+    Request = NULL;
+    if (!IsListEmpty (&Session->AsyncRequestList)) {
+      Request = NET_LIST_HEAD (&Session->AsyncRequestList, ISCSI_ASYNC_REQUEST, Link);
+      RemoveEntryList (&Request->Link);
+    }
+
+    gBS->RestoreTPL (OldTpl);
+
+    if (Request == NULL) {
+      return EFI_SUCCESS;
+    }
+
+    Status = IScsiStartScsiCommand (Conn, Request->Lun, Request->Packet, Request->Event, &Tcb);
+    if (Status == EFI_NOT_READY) {
+      //
+      // The command window is closed, retry after some tasks complete.
+      //
+      OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+      InsertHeadList (&Session->AsyncRequestList, &Request->Link);
+      gBS->RestoreTPL (OldTpl);
+      return EFI_SUCCESS;
+    }
+
+    if (EFI_ERROR (Status)) {
+      Request->Packet->HostAdapterStatus = EFI_EXT_SCSI_STATUS_HOST_ADAPTER_OTHER;
+      gBS->SignalEvent (Request->Event);
+      FreePool (Request);
+      return Status;
+    }
+
+    //
+    // Time the task out as a blocking request would.
+    //
+    Tcb->Timeout = MultU64x32 (Request->Packet->Timeout, 4);
+
+    FreePool (Request);
+    Session->AsyncTaskNumber++;
+  }
+}
+
+/**
+  Execute the SCSI command issued through the EXT SCSI PASS THRU protocol.
+
+  @param[in]       PassThru  The EXT SCSI PASS THRU protocol.
+  @param[in]       Target    The target ID.
+  @param[in]       Lun       The LUN.
+  @param[in, out]  Packet    The request packet containing IO request, SCSI command
+                             buffer and buffers to read/write.
+
+  @retval EFI_SUCCESS          The SCSI command is executed and the result is updated to
+                               the Packet.
+  @retval EFI_DEVICE_ERROR     Session state was not as required.
+  @retval EFI_OUT_OF_RESOURCES Failed to allocate memory.
+  @retval EFI_PROTOCOL_ERROR   There is no such data in the net buffer.
+  @retval Others               Other errors as indicated.
+
+**/
+EFI_STATUS
+IScsiExecuteScsiCommand (
+  IN EFI_EXT_SCSI_PASS_THRU_PROTOCOL                 *PassThru,
+  IN UINT8                                           *Target,
+  IN UINT64                                          Lun,
+  IN OUT EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET  *Packet
+  )
+{
+  EFI_STATUS         Status;
+  ISCSI_DRIVER_DATA  *Private;
+  ISCSI_SESSION      *Session;
+  EFI_EVENT          TimeoutEvent;
+  ISCSI_CONNECTION   *Conn;
+  ISCSI_TCB          *Tcb;
+  UINT64             Timeout;
+  EFI_TPL            OldTpl;
+
+  Private      = ISCSI_DRIVER_DATA_FROM_EXT_SCSI_PASS_THRU (PassThru);
+  Session      = Private->Session;
+  Status       = EFI_SUCCESS;
+  Tcb          = NULL;
+  TimeoutEvent = NULL;
+  Timeout      = 0;
+
+  if ((Session->State != SESSION_STATE_LOGGED_IN) || Session->Failed) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  Conn = NET_LIST_USER_STRUCT_S (
+           Session->Conns.ForwardLink,
+           ISCSI_CONNECTION,
+           Link,
+           ISCSI_CONNECTION_SIGNATURE
+           );
+
+  //
+  // Start the timeout timer.
+  //
+  if (Packet->Timeout != 0) {
+    Timeout = MultU64x32 (Packet->Timeout, 4);
+    Status  = gBS->SetTimer (Conn->TimeoutEvent, TimerRelative, Timeout);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    TimeoutEvent = Conn->TimeoutEvent;
+  }
+
+  //
+  // The nonblocking tasks are sent and completed by notification functions
+  // at TPL_CALLBACK. Raise the TPL to use the connection exclusively, the
+  // PDUs of the nonblocking tasks are processed as well while waiting.
+  //
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+
+  while (TRUE) {
+    Status = IScsiStartScsiCommand (Conn, Lun, Packet, NULL, &Tcb);
+    if (Status != EFI_NOT_READY) {
+      break;
+    }
+
+    //
+    // The command window is closed by the nonblocking tasks, wait until some
+    // of them complete.
+    //
+    Tcb    = NULL;
+    Status = IScsiPollPduReceive (Conn, TimeoutEvent);
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+  }
+
+  if (!EFI_ERROR (Status)) {
+    while (!Tcb->StatusXferd) {
+      Status = IScsiPollPduReceive (Conn, TimeoutEvent);
+      if (EFI_ERROR (Status)) {
+        break;
+      }
+    }
+
+    if (!EFI_ERROR (Status)) {
+      Status = Tcb->Status;
+    }
+  }
+
+  if (Tcb != NULL) {
+    IScsiDelTcb (Tcb);
+  }
+
+  gBS->RestoreTPL (OldTpl);
+
+  if (TimeoutEvent != NULL) {
+    gBS->SetTimer (TimeoutEvent, TimerCancel, 0);
+  }
+
+  return Status;
+}
+
+/**
+  Queue a nonblocking SCSI command issued through the EXT SCSI PASS THRU protocol.
+  The command is sent to the target by IScsiOnAsyncPoll(), and Event is signaled
+  when the command completes.
+
+  @param[in]       PassThru  The EXT SCSI PASS THRU protocol.
+  @param[in]       Lun       The LUN.
+  @param[in, out]  Packet    The request packet containing IO request, SCSI command
+                             buffer and buffers to read/write.
+  @param[in]       Event     The event to signal when the command completes.
+
+  @retval EFI_SUCCESS          The SCSI command is queued.
+  @retval EFI_DEVICE_ERROR     Session state was not as required.
+  @retval EFI_OUT_OF_RESOURCES Failed to allocate memory.
+
+**/
+EFI_STATUS
+IScsiQueueScsiCommand (
+  IN EFI_EXT_SCSI_PASS_THRU_PROTOCOL                 *PassThru,
+  IN UINT64                                          Lun,
+  IN OUT EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET  *Packet,
+  IN EFI_EVENT                                       Event
+  )
+{
+  ISCSI_DRIVER_DATA    *Private;
+  ISCSI_SESSION        *Session;
+  ISCSI_ASYNC_REQUEST  *Request;
+  EFI_TPL              OldTpl;
+
+  Private = ISCSI_DRIVER_DATA_FROM_EXT_SCSI_PASS_THRU (PassThru);
+  Session = Private->Session;
+
+  Request = AllocatePool (sizeof (ISCSI_ASYNC_REQUEST));
+  if (Request == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Request->Lun    = Lun;
+  Request->Packet = Packet;
+  Request->Event  = Event;
+
+  //
+  // The caller may be a notification function at TPL_NOTIFY. The session
+  // fails at TPL_CALLBACK, check it with the queue locked.
+  //
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  if ((Session->State != SESSION_STATE_LOGGED_IN) || Session->Failed) {
+    gBS->RestoreTPL (OldTpl);
+    FreePool (Request);
+    return EFI_DEVICE_ERROR;
+  }
+
+  InsertTailList (&Session->AsyncRequestList, &Request->Link);
+  gBS->RestoreTPL (OldTpl);
+
+  //
+  // Keep polling until the command completes, and start polling as soon as
+  // the caller lowers the TPL.
+  //
+  gBS->SetTimer (Private->AsyncPollEvent, TimerPeriodic, ISCSI_ASYNC_POLL_INTERVAL);
+  gBS->SignalEvent (Private->AsyncPollEvent);
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Process the PDUs received on a connection in the full feature phase, and
+  send the nonblocking commands the completed tasks make room for.
+
+  @param[in]  Event    The receive token event.
+  @param[in]  Context  The iSCSI connection.
+
+**/
+VOID
+EFIAPI
+IScsiOnPduReceived (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  ISCSI_CONNECTION  *Conn;
+  EFI_STATUS        Status;
+
+  Conn = (ISCSI_CONNECTION *)Context;
+
+  if (Conn->Session->Failed) {
+    return;
+  }
+
+  Status = IScsiProcessPduReceive (Conn);
+  if (!EFI_ERROR (Status)) {
+    Status = IScsiSendAsyncRequests (Conn->Session);
+  }
+
+  if (EFI_ERROR (Status)) {
+    IScsiFailConnection (Conn, Status);
+  }
+}
+
+/**
+  Send the queued nonblocking SCSI commands, and time out the nonblocking tasks
+  the target does not complete. The PDUs of the tasks are processed by
+  IScsiOnPduReceived(), this function never waits for the target.
+
+  @param[in]  Event    The poll event.
+  @param[in]  Context  The iSCSI driver data.
+
+**/
+VOID
+EFIAPI
+IScsiOnAsyncPoll (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  ISCSI_DRIVER_DATA  *Private;
+  ISCSI_SESSION      *Session;
+  ISCSI_CONNECTION   *Conn;
+  LIST_ENTRY         *Entry;
+  ISCSI_TCB          *Tcb;
+  EFI_STATUS         Status;
+  EFI_TPL            OldTpl;
+
+  Private = (ISCSI_DRIVER_DATA *)Context;
+  Session = Private->Session;
+
+  if (Session == NULL) {
+    return;
+  }
+
+  if ((Session->State == SESSION_STATE_LOGGED_IN) && !Session->Failed) {
+    Conn = NET_LIST_USER_STRUCT_S (
+             Session->Conns.ForwardLink,
+             ISCSI_CONNECTION,
+             Link,
+             ISCSI_CONNECTION_SIGNATURE
+             );
+
+    Status = IScsiSendAsyncRequests (Session);
+
+    if (!EFI_ERROR (Status)) {
+      NET_LIST_FOR_EACH (Entry, &Session->TcbList) {
+        Tcb = NET_LIST_USER_STRUCT (Entry, ISCSI_TCB, Link);
+        if ((Tcb->Event == NULL) || (Tcb->Timeout == 0)) {
+          continue;
+        }
+
+        if (Tcb->Timeout <= ISCSI_ASYNC_POLL_INTERVAL) {
+          Status = EFI_TIMEOUT;
+          break;
+        }
+
+        Tcb->Timeout -= ISCSI_ASYNC_POLL_INTERVAL;
+      }
+    }
+
+    if (EFI_ERROR (Status)) {
+      IScsiFailConnection (Conn, Status);
+    }
+  }
+
+  //
+  // Stop polling when there is nothing left to do.
+  //
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  if (IsListEmpty (&Session->AsyncRequestList) && (Session->AsyncTaskNumber == 0)) {
+    gBS->SetTimer (Event, TimerCancel, 0);
+  }
+
+  gBS->RestoreTPL (OldTpl);
+}
+
 /**
   Reinstate the session on some error.
 
@@ -3133,10 +4005,13 @@ IScsiSessionInit (
 
     InitializeListHead (&Session->Conns);
     InitializeListHead (&Session->TcbList);
+    InitializeListHead (&Session->AsyncRequestList);
   }
 
   Session->Tsih = 0;
 
+  Session->Failed = FALSE;
+
   Session->CmdSN            = 1;
   Session->InitiatorTaskTag = 1;
   Session->NextCid          = 1;
@@ -3149,7 +4024,7 @@ IScsiSessionInit (
   Session->FirstBurstLength     = MAX_RECV_DATA_SEG_LEN_IN_FFP;
   Session->DefaultTime2Wait     = 2;
   Session->DefaultTime2Retain   = 20;
-  Session->MaxOutstandingR2T    = DEFAULT_MAX_OUTSTANDING_R2T;
+  Session->MaxOutstandingR2T    = ISCSI_MAX_OUTSTANDING_R2T;
   Session->DataPDUInOrder       = TRUE;
   Session->DataSequenceInOrder  = TRUE;
   Session->ErrorRecoveryLevel   = 0;
@@ -3174,6 +4049,8 @@ IScsiSessionAbort (
     return;
   }
 
+  IScsiAbortAsyncTasks (Session);
+
   ASSERT (!IsListEmpty (&Session->Conns));
 
   while (!IsListEmpty (&Session->Conns)) {
@@ -3189,6 +4066,8 @@ IScsiSessionAbort (
       ProtocolGuid = &gEfiTcp6ProtocolGuid;
     }
 
+    IScsiStopPduReceive (Conn);
+
     gBS->CloseProtocol (
            Conn->TcpIo.Handle,
            ProtocolGuid,
@@ -30,6 +30,13 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define DEFAULT_MAX_RECV_DATA_SEG_LEN  8192
 #define MAX_RECV_DATA_SEG_LEN_IN_FFP   65536
 #define DEFAULT_MAX_OUTSTANDING_R2T    1
+#define ISCSI_MAX_OUTSTANDING_R2T      16
+
+///
+/// The interval to send the queued nonblocking SCSI requests and to check
+/// the timeouts of the outstanding ones, 1 millisecond.
+///
+#define ISCSI_ASYNC_POLL_INTERVAL  10000
 
 #define ISCSI_VERSION_MAX  0x00
 #define ISCSI_VERSION_MIN  0x00
@@ -595,24 +602,73 @@ typedef struct _ISCSI_IN_BUFFER_CONTEXT {
 } ISCSI_IN_BUFFER_CONTEXT;
 
 typedef struct _ISCSI_TCB {
-  LIST_ENTRY            Link;
-
-  BOOLEAN               SoFarInOrder;
-  UINT32                ExpDataSN;
-  BOOLEAN               FbitReceived;
-  BOOLEAN               StatusXferd;
-  UINT32                ActiveR2Ts;
-  UINT32                Response;
-  CHAR8                 *Reason;
-  UINT32                InitiatorTaskTag;
-  UINT32                CmdSN;
-  UINT32                SNACKTag;
-
-  ISCSI_XFER_CONTEXT    XferContext;
-
-  ISCSI_CONNECTION      *Conn;
+  LIST_ENTRY                                    Link;
+
+  BOOLEAN                                       SoFarInOrder;
+  UINT32                                        ExpDataSN;
+  BOOLEAN                                       FbitReceived;
+  BOOLEAN                                       StatusXferd;
+  UINT32                                        ActiveR2Ts;
+  UINT32                                        Response;
+  CHAR8                                         *Reason;
+  UINT32                                        InitiatorTaskTag;
+  UINT32                                        CmdSN;
+  UINT32                                        SNACKTag;
+
+  ISCSI_XFER_CONTEXT                            XferContext;
+  ISCSI_IN_BUFFER_CONTEXT                       InBufferContext;
+
+  UINT64                                        Lun;
+  EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET    *Packet;
+  //
+  // The event to signal on completion, NULL for a blocking request.
+  //
+  EFI_EVENT                                     Event;
+
+  ISCSI_CONNECTION                              *Conn;
+
+  //
+  // The time left before a nonblocking request times out in 100ns units, 0
+  // for no timeout, and the status to return for a blocking request.
+  //
+  UINT64                                        Timeout;
+  EFI_STATUS                                    Status;
 } ISCSI_TCB;
 
+///
+/// A nonblocking SCSI request waiting for the target to accept new commands.
+///
+typedef struct _ISCSI_ASYNC_REQUEST {
+  LIST_ENTRY                                    Link;
+  UINT64                                        Lun;
+  EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET    *Packet;
+  EFI_EVENT                                     Event;
+} ISCSI_ASYNC_REQUEST;
+
+///
+/// The receive of the PDUs on a connection in the full feature phase. One
+/// receive token is kept posted to TCP, and the PDUs are assembled and
+/// processed as the token completes.
+///
+typedef struct _ISCSI_PDU_RECEIVE {
+  EFI_EVENT                Event;
+  TCP_IO_IO_TOKEN          Token;
+  EFI_TCP4_RECEIVE_DATA    RxData;
+  BOOLEAN                  Posted;
+
+  //
+  // The segments of the PDU being received, the segment being received now
+  // and the parts of it not received yet.
+  //
+  LIST_ENTRY               *NbufList;
+  NET_BUF                  *PduHdr;
+  NET_BUF                  *Segment;
+  NET_FRAGMENT             Fragment[2];
+  UINT32                   FragmentCount;
+  UINT32                   CurrentFragment;
+  UINT32                   PadAndCRC32[2];
+} ISCSI_PDU_RECEIVE;
+
 typedef struct _ISCSI_KEY_VALUE_PAIR {
   LIST_ENTRY    List;
 
@@ -982,7 +1038,6 @@ IScsiNormalizeName (
                                the Packet.
   @retval EFI_DEVICE_ERROR     Session state was not as required.
   @retval EFI_OUT_OF_RESOURCES Failed to allocate memory.
-  @retval EFI_NOT_READY        The target can not accept new commands.
   @retval Others               Other errors as indicated.
 
 **/
@@ -994,6 +1049,103 @@ IScsiExecuteScsiCommand (
   IN OUT EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET  *Packet
   );
 
+/**
+  Queue a nonblocking SCSI command issued through the EXT SCSI PASS THRU protocol.
+  The command is sent to the target by IScsiOnAsyncPoll(), and Event is signaled
+  when the command completes.
+
+  @param[in]       PassThru  The EXT SCSI PASS THRU protocol.
+  @param[in]       Lun       The LUN.
+  @param[in, out]  Packet    The request packet containing IO request, SCSI command
+                             buffer and buffers to read/write.
+  @param[in]       Event     The event to signal when the command completes.
+
+  @retval EFI_SUCCESS          The SCSI command is queued.
+  @retval EFI_DEVICE_ERROR     Session state was not as required.
+  @retval EFI_OUT_OF_RESOURCES Failed to allocate memory.
+
+**/
+EFI_STATUS
+IScsiQueueScsiCommand (
+  IN EFI_EXT_SCSI_PASS_THRU_PROTOCOL                 *PassThru,
+  IN UINT64                                          Lun,
+  IN OUT EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET  *Packet,
+  IN EFI_EVENT                                       Event
+  );
+
+/**
+  Send the queued nonblocking SCSI commands, and time out the nonblocking tasks
+  the target does not complete. The PDUs of the tasks are processed by
+  IScsiOnPduReceived(), this function never waits for the target.
+
+  @param[in]  Event    The poll event.
+  @param[in]  Context  The iSCSI driver data.
+
+**/
+VOID
+EFIAPI
+IScsiOnAsyncPoll (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  );
+
+/**
+  Start to receive the next PDU on a connection in the full feature phase.
+
+  @param[in]  Conn  The iSCSI connection.
+
+  @retval EFI_SUCCESS          The receive is posted.
+  @retval EFI_OUT_OF_RESOURCES Failed to allocate memory.
+  @retval Others               Other errors as indicated.
+
+**/
+EFI_STATUS
+IScsiStartPduReceive (
+  IN ISCSI_CONNECTION  *Conn
+  );
+
+/**
+  Stop the receive of the PDUs on a connection, and free the PDU being
+  received. It is safe to call it if the receive is not started.
+
+  @param[in]  Conn  The iSCSI connection.
+
+**/
+VOID
+IScsiStopPduReceive (
+  IN ISCSI_CONNECTION  *Conn
+  );
+
+/**
+  Process the PDUs received on a connection in the full feature phase, and
+  send the nonblocking commands the completed tasks make room for.
+
+  @param[in]  Event    The receive token event.
+  @param[in]  Context  The iSCSI connection.
+
+**/
+VOID
+EFIAPI
+IScsiOnPduReceived (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  );
+
+/**
+  Find the task control block of the task with the initiator task tag.
+
+  @param[in]  Session           The iSCSI session.
+  @param[in]  InitiatorTaskTag  The initiator task tag.
+
+  @return The task control block, or NULL if there is no such task.
+
+**/
+ISCSI_TCB *
+IScsiFindTcb (
+  IN ISCSI_SESSION  *Session,
+  IN UINT32         InitiatorTaskTag
+  );
+
 /**
   Reinstate the session on some error.
 
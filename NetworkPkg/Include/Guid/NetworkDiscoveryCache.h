@@ -0,0 +1,30 @@
+/** @file
+  This file defines the variables used to remember the results of the network
+  discovery across boots, when PcdNetworkDiscoveryCache is TRUE.
+
+Copyright (c) 2026, agent <agent@local>. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef __NETWORK_DISCOVERY_CACHE_H__
+#define __NETWORK_DISCOVERY_CACHE_H__
+
+//
+// Private variables, owned by the drivers writing them.
+// The DHCPv4 lease of HTTP Boot is stored in a variable named after the MAC
+// address string of the network interface, as returned by NetLibGetMacString().
+// The DNS answers are stored in the EDKII_DNS4_CACHE_VARIABLE and the
+// EDKII_DNS6_CACHE_VARIABLE variables.
+//
+#define EDKII_NETWORK_DISCOVERY_CACHE_GUID \
+  { \
+    0x3c5e8a1d, 0x7b24, 0x4f96, { 0xa1, 0x0e, 0x5d, 0x82, 0xc4, 0x37, 0x9b, 0x61 } \
+  }
+
+#define EDKII_DNS4_CACHE_VARIABLE  L"Dns4Cache"
+#define EDKII_DNS6_CACHE_VARIABLE  L"Dns6Cache"
+
+extern EFI_GUID  gEdkiiNetworkDiscoveryCacheGuid;
+
+#endif
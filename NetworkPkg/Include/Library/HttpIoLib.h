@@ -263,6 +263,50 @@ HttpIoRecvResponse (
   OUT     HTTP_IO_RESPONSE_DATA  *ResponseData
   );
 
+/**
+  Start receiving a HTTP RESPONSE message from the server, without waiting for
+  it. HttpIoPollResponse() is then called until the response is received.
+
+  @param[in]   HttpIo           The HttpIo wrapping the HTTP service.
+  @param[in]   RecvMsgHeader    TRUE to receive a new HTTP response (from message header).
+                                FALSE to continue receive the previous response message.
+  @param[in]   ResponseData     Point to a wrapper of the response data to receive,
+                                which must stay valid until the response is received.
+
+  @retval EFI_SUCCESS            The HTTP response is being received.
+  @retval EFI_INVALID_PARAMETER  One or more parameters are invalid.
+  @retval Others                 Other errors as indicated.
+
+**/
+EFI_STATUS
+HttpIoStartResponse (
+  IN      HTTP_IO                *HttpIo,
+  IN      BOOLEAN                RecvMsgHeader,
+  IN      HTTP_IO_RESPONSE_DATA  *ResponseData
+  );
+
+/**
+  Poll the network once for the HTTP RESPONSE message started with
+  HttpIoStartResponse(), without waiting for it.
+
+  @param[in]   HttpIo           The HttpIo wrapping the HTTP service.
+  @param[out]  ResponseData     Point to a wrapper of the received response data,
+                                the one given to HttpIoStartResponse().
+
+  @retval EFI_SUCCESS            The HTTP response is received.
+  @retval EFI_NOT_READY          The HTTP response is not received yet.
+  @retval EFI_TIMEOUT            The HTTP response is not received in time, and
+                                 it is cancelled.
+  @retval EFI_INVALID_PARAMETER  One or more parameters are invalid.
+  @retval Others                 Other errors as indicated.
+
+**/
+EFI_STATUS
+HttpIoPollResponse (
+  IN      HTTP_IO                *HttpIo,
+  OUT     HTTP_IO_RESPONSE_DATA  *ResponseData
+  );
+
 /**
   Get the value of the content length if there is a "Content-Length" header.
 
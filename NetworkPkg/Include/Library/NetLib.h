@@ -12,6 +12,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define _NET_LIB_H_
 
 #include <Protocol/Ip6.h>
+#include <Protocol/Dhcp4.h>
 
 #include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
@@ -2171,6 +2172,28 @@ NetbufChecksum (
   IN NET_BUF  *Nbuf
   );
 
+/**
+  Complete the checksum of a TCP or UDP packet whose checksum field holds only
+  the checksum of its pseudo header.
+
+  @param[in, out]  Nbuf        Pointer to the net buffer, which starts with the
+                               TCP or UDP header.
+  @param[in]       Offset      The offset of the checksum field in the net buffer.
+  @param[in]       PseudoSum   The checksum of the pseudo header, including the
+                               length of the packet.
+
+  @retval TRUE     The checksum field held PseudoSum and has been completed.
+  @retval FALSE    The checksum field doesn't hold PseudoSum and is unchanged.
+
+**/
+BOOLEAN
+EFIAPI
+NetbufCompleteChecksum (
+  IN OUT NET_BUF  *Nbuf,
+  IN     UINT32   Offset,
+  IN     UINT16   PseudoSum
+  );
+
 /**
   Compute the checksum for TCP/UDP pseudo header.
 
@@ -2248,6 +2271,92 @@ NetLibGetSystemGuid (
   OUT EFI_GUID  *SystemGuid
   );
 
+/**
+  Convert a time to the number of seconds elapsed since 1970-01-01 00:00:00.
+
+  The TimeZone and Daylight fields of Time are ignored, so the result is only
+  meaningful when compared with another value converted from the same clock.
+
+  If Time is NULL, then ASSERT().
+
+  @param[in]  Time      The time to convert.
+
+  @return               The number of seconds since 1970-01-01 00:00:00, or 0 if
+                        Time is earlier than that.
+
+**/
+UINT64
+EFIAPI
+NetLibTimeToSeconds (
+  IN CONST EFI_TIME  *Time
+  );
+
+/**
+  Tell whether a DHCPOFFER received by a discovery of NetLibDhcp4Race() names a
+  boot server the network interface can boot from.
+
+  @param[in]  Context           The Context of the NET_DHCP4_PROBE.
+  @param[in]  Packet            The DHCPOFFER packet received.
+
+  @retval TRUE                  The offer is usable, the interface wins the race.
+  @retval FALSE                 Wait for more DHCPOFFER packets.
+
+**/
+typedef
+BOOLEAN
+(EFIAPI *NET_DHCP4_PROBE_OFFER)(
+  IN VOID              *Context,
+  IN EFI_DHCP4_PACKET  *Packet
+  );
+
+///
+/// A DHCPv4 discovery run on a network interface by NetLibDhcp4Race().
+///
+typedef struct {
+  //
+  // Filled in by the caller.
+  //
+  EFI_DHCP4_PROTOCOL         *Dhcp4;
+  UINT32                     OptionCount;
+  EFI_DHCP4_PACKET_OPTION    **OptionList;
+  UINT32                     DiscoverTryCount;
+  UINT32                     *DiscoverTimeout;
+  NET_DHCP4_PROBE_OFFER      CheckOffer;
+  VOID                       *Context;
+  //
+  // Filled in by NetLibDhcp4Race().
+  //
+  EFI_STATUS                 Status;
+  EFI_EVENT                  Event;
+  BOOLEAN                    IsDone;
+  BOOLEAN                    IsUsable;
+} NET_DHCP4_PROBE;
+
+/**
+  Run the DHCPv4 discovery on several network interfaces at once, until one of
+  them is offered a usable boot server or all of them give up.
+
+  Each discovery only collects offers and never requests a lease. When the race
+  is over, the discoveries still running are stopped and all the EFI DHCPv4
+  Protocol instances are unconfigured.
+
+  If Probes is NULL and ProbeCount is not 0, then ASSERT().
+
+  @param[in, out]  Probes       The discoveries to run. The Status of those
+                                which could not be started is set to an error.
+  @param[in]       ProbeCount   The number of entries in Probes.
+
+  @return                       The index in Probes of the winner, or ProbeCount
+                                if no interface was offered a usable boot server.
+
+**/
+UINTN
+EFIAPI
+NetLibDhcp4Race (
+  IN OUT NET_DHCP4_PROBE  *Probes,
+  IN     UINTN            ProbeCount
+  );
+
 /**
   Create Dns QName according the queried domain name.
 
@@ -0,0 +1,89 @@
+/** @file
+  This file defines the EDKII DPC Statistics Protocol interface.
+
+  The driver producing the EFI_DPC_PROTOCOL may install this protocol on the
+  same handle to report how many Deferred Procedure Calls have gone through
+  its queues and how long they waited there, so that the latency added by the
+  DPCs to the network stack can be measured.
+
+  Copyright (c) 2026, agent <agent@local>. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef EDKII_DPC_STATISTICS_H_
+#define EDKII_DPC_STATISTICS_H_
+
+#define EDKII_DPC_STATISTICS_PROTOCOL_GUID \
+  { \
+    0x9b1c0a4e, 0x5d3f, 0x4c67, {0x8e, 0x21, 0x7a, 0x4f, 0xd0, 0x93, 0x1b, 0x5c} \
+  }
+
+typedef struct _EDKII_DPC_STATISTICS_PROTOCOL EDKII_DPC_STATISTICS_PROTOCOL;
+
+///
+/// The statistics of the DPC queues, counted since the driver started or since
+/// the statistics were last reset.
+///
+typedef struct {
+  ///
+  /// The number of DPCs queued.
+  ///
+  UINT64    Queued;
+  ///
+  /// The number of DPCs which could not be queued for lack of resources.
+  ///
+  UINT64    QueueFailures;
+  ///
+  /// The number of DPCs invoked.
+  ///
+  UINT64    Dispatched;
+  ///
+  /// The number of batches of DPCs taken off the queues for dispatch.
+  ///
+  UINT64    Batches;
+  ///
+  /// The maximum number of DPCs queued at the same time, across all TPLs.
+  ///
+  UINT64    MaxQueueDepth;
+  ///
+  /// The sum of the times, in nanoseconds, the invoked DPCs spent in the queues.
+  /// The latencies are only measured when PcdDpcLatencyStatistics is TRUE,
+  /// and are 0 otherwise.
+  ///
+  UINT64    TotalLatency;
+  ///
+  /// The longest time, in nanoseconds, an invoked DPC spent in the queues.
+  ///
+  UINT64    MaxLatency;
+} EDKII_DPC_STATISTICS;
+
+/**
+  Retrieve the statistics of the DPC queues.
+
+  This function may be called at TPL_NOTIFY or below.
+
+  @param[in]   This              Pointer to the EDKII_DPC_STATISTICS_PROTOCOL instance.
+  @param[out]  Statistics        The statistics of the DPC queues.
+  @param[in]   Reset             Whether to reset the statistics after retrieving them.
+
+  @retval EFI_SUCCESS            The statistics are retrieved.
+  @retval EFI_INVALID_PARAMETER  Statistics is NULL.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_DPC_GET_STATISTICS)(
+  IN  EDKII_DPC_STATISTICS_PROTOCOL  *This,
+  OUT EDKII_DPC_STATISTICS           *Statistics,
+  IN  BOOLEAN                        Reset
+  );
+
+///
+/// EDKII DPC Statistics Protocol reports the usage of the DPC queues.
+///
+struct _EDKII_DPC_STATISTICS_PROTOCOL {
+  EDKII_DPC_GET_STATISTICS    GetStatistics;
+};
+
+extern EFI_GUID  gEdkiiDpcStatisticsProtocolGuid;
+
+#endif /* EDKII_DPC_STATISTICS_H_ */
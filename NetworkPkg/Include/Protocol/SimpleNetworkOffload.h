@@ -0,0 +1,65 @@
+/** @file
+  This file defines the EDKII Simple Network Offload Protocol interface.
+
+  A network interface driver may install this protocol on the handle of its
+  Simple Network Protocol to advertise the transmit offloads it performs on
+  the frames given to the Transmit() service of the Simple Network Protocol.
+
+  The TCP checksum offload applies to a TCP segment carried directly in an
+  IPv4 header, or in an IPv6 header without extension headers, whose checksum
+  field holds the one's complement sum of the pseudo header instead of the
+  checksum: the interface computes the checksum of such a segment. Since the
+  computed checksum is also correct for a segment whose complete checksum
+  happens to equal the sum of its pseudo header, the caller needs no other
+  means to mark the segments left for the interface.
+
+  The TCP segmentation offload applies to such a TCP segment in an IPv4 frame
+  longer than the MaxPacketSize of the Simple Network Protocol: the interface
+  splits the segment into segments carrying as many bytes of the payload as
+  the MaxPacketSize allows, with a copy of the IPv4 and the TCP headers. The
+  PSH and FIN flags are only set in the last segment. Only the callers which
+  agreed with the peer on a maximum segment size no smaller than that may send
+  such frames.
+
+  Copyright (c) 2026, agent <agent@local>. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef EDKII_SIMPLE_NETWORK_OFFLOAD_H_
+#define EDKII_SIMPLE_NETWORK_OFFLOAD_H_
+
+#define EDKII_SIMPLE_NETWORK_OFFLOAD_PROTOCOL_GUID \
+  { \
+    0x44b29eaf, 0xe22e, 0x4328, {0xbd, 0xe3, 0x3a, 0x1c, 0x6f, 0x78, 0x01, 0x76} \
+  }
+
+typedef struct _EDKII_SIMPLE_NETWORK_OFFLOAD_PROTOCOL EDKII_SIMPLE_NETWORK_OFFLOAD_PROTOCOL;
+
+//
+// Bits in EDKII_SIMPLE_NETWORK_OFFLOAD_PROTOCOL.Capabilities
+//
+#define EDKII_SIMPLE_NETWORK_OFFLOAD_TCP4_CSUM  BIT0
+#define EDKII_SIMPLE_NETWORK_OFFLOAD_TCP6_CSUM  BIT1
+#define EDKII_SIMPLE_NETWORK_OFFLOAD_TCP4_TSO   BIT2
+
+///
+/// EDKII Simple Network Offload Protocol advertises the checksum and the
+/// segmentation offloads of a network interface.
+///
+struct _EDKII_SIMPLE_NETWORK_OFFLOAD_PROTOCOL {
+  ///
+  /// The offloads performed by the interface, a combination of the
+  /// EDKII_SIMPLE_NETWORK_OFFLOAD_* bits.
+  ///
+  UINT32    Capabilities;
+  ///
+  /// The maximum size, in bytes, of a frame excluding the media header that
+  /// the interface segments. Valid if EDKII_SIMPLE_NETWORK_OFFLOAD_TCP4_TSO
+  /// is set.
+  ///
+  UINT32    MaxSegmentationSize;
+};
+
+extern EFI_GUID  gEdkiiSimpleNetworkOffloadProtocolGuid;
+
+#endif /* EDKII_SIMPLE_NETWORK_OFFLOAD_H_ */
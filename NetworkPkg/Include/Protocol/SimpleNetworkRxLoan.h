@@ -0,0 +1,101 @@
+/** @file
+  This file defines the EDKII Simple Network Receive Loan Protocol interface.
+
+  A network interface driver may install this protocol on the handle of its
+  Simple Network Protocol to lend the received frames to the caller in place,
+  instead of copying them into a buffer supplied by the caller. The frame stays
+  in the receive buffer of the device until the caller returns the loan, so
+  the driver must keep enough buffers of its own posted to the device and
+  refuse further loans when it runs short of them.
+
+  Copyright (c) 2026, agent <agent@local>. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef EDKII_SIMPLE_NETWORK_RX_LOAN_H_
+#define EDKII_SIMPLE_NETWORK_RX_LOAN_H_
+
+#define EDKII_SIMPLE_NETWORK_RX_LOAN_PROTOCOL_GUID \
+  { \
+    0x6a830383, 0xcc90, 0x4ef6, {0xa8, 0x7a, 0xa5, 0x65, 0x7f, 0x59, 0x06, 0x4c} \
+  }
+
+typedef struct _EDKII_SIMPLE_NETWORK_RX_LOAN_PROTOCOL EDKII_SIMPLE_NETWORK_RX_LOAN_PROTOCOL;
+
+///
+/// A received frame lent to the caller. The structure is owned by the driver
+/// and stays valid until the loan is returned.
+///
+typedef struct {
+  ///
+  /// The protocol instance which lent the frame.
+  ///
+  EDKII_SIMPLE_NETWORK_RX_LOAN_PROTOCOL    *Lender;
+  ///
+  /// The frame, starting with the media header.
+  ///
+  UINT8                                    *Buffer;
+  ///
+  /// The size, in bytes, of the frame including the media header.
+  ///
+  UINTN                                    BufferSize;
+  ///
+  /// The size, in bytes, of the media header.
+  ///
+  UINTN                                    HeaderSize;
+} EDKII_SIMPLE_NETWORK_RX_LOAN;
+
+/**
+  Receive a frame from the network interface without copying it.
+
+  The caller must treat the frame as read only, except that the bytes
+  following the media header may be modified in place.
+
+  @param[in]   This              Pointer to the EDKII_SIMPLE_NETWORK_RX_LOAN_PROTOCOL instance.
+  @param[out]  Loan              The received frame lent to the caller.
+
+  @retval EFI_SUCCESS            A frame is received and lent to the caller.
+  @retval EFI_NOT_READY          No frame has been received.
+  @retval EFI_OUT_OF_RESOURCES   Too many frames are lent out. The caller may
+                                 receive the frame with the Simple Network
+                                 Protocol instead.
+  @retval EFI_NOT_STARTED        The network interface has not been started.
+  @retval EFI_DEVICE_ERROR       The network interface is not initialized, or
+                                 a malformed frame was dropped.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_SIMPLE_NETWORK_RECEIVE_LOAN)(
+  IN  EDKII_SIMPLE_NETWORK_RX_LOAN_PROTOCOL  *This,
+  OUT EDKII_SIMPLE_NETWORK_RX_LOAN           **Loan
+  );
+
+/**
+  Return a lent frame to the network interface, so that its buffer can be
+  reused for the reception.
+
+  This function may be called at TPL_NOTIFY or below, and after the network
+  interface has been shut down.
+
+  @param[in]  This               Pointer to the EDKII_SIMPLE_NETWORK_RX_LOAN_PROTOCOL instance.
+  @param[in]  Loan               The frame to return.
+**/
+typedef
+VOID
+(EFIAPI *EDKII_SIMPLE_NETWORK_RETURN_LOAN)(
+  IN EDKII_SIMPLE_NETWORK_RX_LOAN_PROTOCOL  *This,
+  IN EDKII_SIMPLE_NETWORK_RX_LOAN           *Loan
+  );
+
+///
+/// EDKII Simple Network Receive Loan Protocol lends the received frames in
+/// place to avoid a copy.
+///
+struct _EDKII_SIMPLE_NETWORK_RX_LOAN_PROTOCOL {
+  EDKII_SIMPLE_NETWORK_RECEIVE_LOAN    ReceiveLoan;
+  EDKII_SIMPLE_NETWORK_RETURN_LOAN     ReturnLoan;
+};
+
+extern EFI_GUID  gEdkiiSimpleNetworkRxLoanProtocolGuid;
+
+#endif /* EDKII_SIMPLE_NETWORK_RX_LOAN_H_ */
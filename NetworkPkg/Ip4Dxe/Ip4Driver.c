@@ -378,7 +378,25 @@ Ip4CreateService (
   }
 
   IpSb->OldMaxPacketSize = IpSb->MaxPacketSize;
-  *Service               = IpSb;
+
+  //
+  // Check whether the network interface segments the TCP packets.
+  //
+  Status = gBS->OpenProtocol (
+                  Controller,
+                  &gEdkiiSimpleNetworkOffloadProtocolGuid,
+                  (VOID **)&IpSb->Offload,
+                  ImageHandle,
+                  Controller,
+                  EFI_OPEN_PROTOCOL_GET_PROTOCOL
+                  );
+  if (EFI_ERROR (Status) ||
+      ((IpSb->Offload->Capabilities & EDKII_SIMPLE_NETWORK_OFFLOAD_TCP4_TSO) == 0))
+  {
+    IpSb->Offload = NULL;
+  }
+
+  *Service = IpSb;
 
   return EFI_SUCCESS;
 
@@ -21,6 +21,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Protocol/Dhcp4.h>
 #include <Protocol/HiiConfigRouting.h>
 #include <Protocol/HiiConfigAccess.h>
+#include <Protocol/SimpleNetworkOffload.h>
 
 #include <IndustryStandard/Dhcp.h>
 
@@ -162,60 +163,66 @@ struct _IP4_PROTOCOL {
 };
 
 struct _IP4_SERVICE {
-  UINT32                             Signature;
-  EFI_SERVICE_BINDING_PROTOCOL       ServiceBinding;
-  INTN                               State;
+  UINT32                                   Signature;
+  EFI_SERVICE_BINDING_PROTOCOL             ServiceBinding;
+  INTN                                     State;
 
   //
   // List of all the IP instances and interfaces, and default
   // interface and route table and caches.
   //
-  UINTN                              NumChildren;
-  LIST_ENTRY                         Children;
+  UINTN                                    NumChildren;
+  LIST_ENTRY                               Children;
 
-  LIST_ENTRY                         Interfaces;
+  LIST_ENTRY                               Interfaces;
 
-  IP4_INTERFACE                      *DefaultInterface;
-  IP4_ROUTE_TABLE                    *DefaultRouteTable;
+  IP4_INTERFACE                            *DefaultInterface;
+  IP4_ROUTE_TABLE                          *DefaultRouteTable;
 
   //
   // Ip reassemble utilities, and IGMP data
   //
-  IP4_ASSEMBLE_TABLE                 Assemble;
-  IGMP_SERVICE_DATA                  IgmpCtrl;
+  IP4_ASSEMBLE_TABLE                       Assemble;
+  IGMP_SERVICE_DATA                        IgmpCtrl;
 
   //
   // Low level protocol used by this service instance
   //
-  EFI_HANDLE                         Image;
-  EFI_HANDLE                         Controller;
+  EFI_HANDLE                               Image;
+  EFI_HANDLE                               Controller;
 
-  EFI_HANDLE                         MnpChildHandle;
-  EFI_MANAGED_NETWORK_PROTOCOL       *Mnp;
+  EFI_HANDLE                               MnpChildHandle;
+  EFI_MANAGED_NETWORK_PROTOCOL             *Mnp;
 
-  EFI_MANAGED_NETWORK_CONFIG_DATA    MnpConfigData;
-  EFI_SIMPLE_NETWORK_MODE            SnpMode;
+  EFI_MANAGED_NETWORK_CONFIG_DATA          MnpConfigData;
+  EFI_SIMPLE_NETWORK_MODE                  SnpMode;
 
-  EFI_EVENT                          Timer;
-  EFI_EVENT                          ReconfigCheckTimer;
-  EFI_EVENT                          ReconfigEvent;
+  EFI_EVENT                                Timer;
+  EFI_EVENT                                ReconfigCheckTimer;
+  EFI_EVENT                                ReconfigEvent;
 
-  BOOLEAN                            Reconfig;
+  BOOLEAN                                  Reconfig;
 
   //
   // Underlying media present status.
   //
-  BOOLEAN                            MediaPresent;
+  BOOLEAN                                  MediaPresent;
 
   //
   // IPv4 Configuration II Protocol instance
   //
-  IP4_CONFIG2_INSTANCE               Ip4Config2Instance;
+  IP4_CONFIG2_INSTANCE                     Ip4Config2Instance;
 
-  CHAR16                             *MacString;
+  CHAR16                                   *MacString;
 
-  UINT32                             MaxPacketSize;
-  UINT32                             OldMaxPacketSize; ///< The MTU before IPsec enable.
+  UINT32                                   MaxPacketSize;
+  UINT32                                   OldMaxPacketSize; ///< The MTU before IPsec enable.
+
+  //
+  // Optional, the network interface segments the TCP packets longer than
+  // the MTU.
+  //
+  EDKII_SIMPLE_NETWORK_OFFLOAD_PROTOCOL    *Offload;
 };
 
 #define IP4_INSTANCE_FROM_PROTOCOL(Ip4) \
@@ -226,6 +226,7 @@ Ip4Output (
   UINT32                 Mtu;
   UINT32                 Num;
   BOOLEAN                RawData;
+  BOOLEAN                Segmented;
 
   //
   // Select an interface/source for system packet, application
@@ -323,7 +324,15 @@ Ip4Output (
   //
   Mtu = IpSb->MaxPacketSize + sizeof (IP4_HEAD);
 
-  if (Packet->TotalSize + HeadLen > Mtu) {
+  //
+  // A TCP segment longer than the MTU isn't fragmented if the network
+  // interface segments it. IPsec would hide the TCP header from it.
+  //
+  Segmented = (BOOLEAN)(!RawData && !mIpSec2Installed && (IpSb->Offload != NULL) &&
+                        (Head->Protocol == EFI_IP_PROTO_TCP) &&
+                        (Packet->TotalSize + HeadLen <= IpSb->Offload->MaxSegmentationSize));
+
+  if ((Packet->TotalSize + HeadLen > Mtu) && !Segmented) {
     //
     // Fragmentation is disabled for RawData mode.
     //
@@ -331,6 +340,18 @@ Ip4Output (
       return EFI_BAD_BUFFER_SIZE;
     }
 
+    //
+    // The network interface can't complete a checksum left to it by TCP
+    // once the segment is split into fragments, complete it here.
+    //
+    if (Head->Protocol == EFI_IP_PROTO_TCP) {
+      NetbufCompleteChecksum (
+        Packet,
+        OFFSET_OF (TCP_HEAD, Checksum),
+        NetPseudoHeadChecksum (HTONL (Head->Src), HTONL (Head->Dst), EFI_IP_PROTO_TCP, (UINT16)Packet->TotalSize)
+        );
+    }
+
     //
     // Packet is fragmented from the tail to the head, that is, the
     // first frame sent is the last fragment of the packet. The first
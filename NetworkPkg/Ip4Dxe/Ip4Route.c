@@ -35,6 +35,7 @@ Ip4CreateRouteEntry (
   }
 
   InitializeListHead (&RtEntry->Link);
+  InitializeListHead (&RtEntry->NodeLink);
 
   RtEntry->RefCnt  = 1;
   RtEntry->Dest    = Dest;
@@ -166,6 +167,125 @@ Ip4CleanRouteCache (
   }
 }
 
+/**
+  Find the node of the route trie standing for the prefix of Dest
+  with the Length, creating the missing nodes on the path if Create
+  is TRUE.
+
+  @param[in]  RtTable               The route table of the route trie
+  @param[in]  Dest                  The destination network
+  @param[in]  Length                The length of the netmask
+  @param[in]  Create                Whether to create the missing nodes
+
+  @return NULL if the node doesn't exist or failed to allocate memory for it,
+          otherwise the point to the node.
+
+**/
+IP4_ROUTE_NODE *
+Ip4GetRouteNode (
+  IN IP4_ROUTE_TABLE  *RtTable,
+  IN IP4_ADDR         Dest,
+  IN UINTN            Length,
+  IN BOOLEAN          Create
+  )
+{
+  IP4_ROUTE_NODE  *Node;
+  IP4_ROUTE_NODE  *Child;
+  UINTN           Depth;
+  UINTN           Bit;
+
+  Node = &RtTable->Trie;
+
+  for (Depth = 0; Depth < Length; Depth++) {
+    Bit   = IP4_ROUTE_BIT (Dest, Depth);
+    Child = Node->Child[Bit];
+
+    if (Child == NULL) {
+      if (!Create) {
+        return NULL;
+      }
+
+      Child = AllocateZeroPool (sizeof (IP4_ROUTE_NODE));
+      if (Child == NULL) {
+        return NULL;
+      }
+
+      InitializeListHead (&Child->Routes);
+      Node->Child[Bit] = Child;
+    }
+
+    Node = Child;
+  }
+
+  return Node;
+}
+
+/**
+  Free the nodes on the path to the prefix of Dest with the Length
+  which no longer lead to any route entry. The path may end before
+  the Length if it is partially created.
+
+  @param[in, out]  RtTable          The route table of the route trie
+  @param[in]       Dest             The destination network
+  @param[in]       Length           The length of the netmask
+
+**/
+VOID
+Ip4PruneRouteNode (
+  IN OUT IP4_ROUTE_TABLE  *RtTable,
+  IN     IP4_ADDR         Dest,
+  IN     UINTN            Length
+  )
+{
+  IP4_ROUTE_NODE  *Path[IP4_MASK_NUM];
+  IP4_ROUTE_NODE  *Node;
+  UINTN           Depth;
+
+  Path[0] = &RtTable->Trie;
+
+  for (Depth = 0; Depth < Length; Depth++) {
+    Path[Depth + 1] = Path[Depth]->Child[IP4_ROUTE_BIT (Dest, Depth)];
+
+    if (Path[Depth + 1] == NULL) {
+      break;
+    }
+  }
+
+  for ( ; Depth > 0; Depth--) {
+    Node = Path[Depth];
+
+    if (!IsListEmpty (&Node->Routes) || (Node->Child[0] != NULL) || (Node->Child[1] != NULL)) {
+      break;
+    }
+
+    Path[Depth - 1]->Child[IP4_ROUTE_BIT (Dest, Depth - 1)] = NULL;
+    FreePool (Node);
+  }
+}
+
+/**
+  Free the sub-trie rooted at the Node of the route trie. The route
+  entries linked to the nodes aren't freed.
+
+  @param[in]  Node                  The root of the sub-trie to free
+
+**/
+VOID
+Ip4FreeRouteNode (
+  IN IP4_ROUTE_NODE  *Node
+  )
+{
+  if (Node->Child[0] != NULL) {
+    Ip4FreeRouteNode (Node->Child[0]);
+  }
+
+  if (Node->Child[1] != NULL) {
+    Ip4FreeRouteNode (Node->Child[1]);
+  }
+
+  FreePool (Node);
+}
+
 /**
   Create an empty route table, includes its internal route cache
 
@@ -194,6 +314,10 @@ Ip4CreateRouteTable (
     InitializeListHead (&(RtTable->RouteArea[Index]));
   }
 
+  RtTable->Trie.Child[0] = NULL;
+  RtTable->Trie.Child[1] = NULL;
+  InitializeListHead (&RtTable->Trie.Routes);
+
   RtTable->Next = NULL;
 
   Ip4InitRouteCache (&RtTable->Cache);
@@ -231,10 +355,17 @@ Ip4FreeRouteTable (
       RtEntry = NET_LIST_USER_STRUCT (Entry, IP4_ROUTE_ENTRY, Link);
 
       RemoveEntryList (Entry);
+      RemoveEntryList (&RtEntry->NodeLink);
       Ip4FreeRouteEntry (RtEntry);
     }
   }
 
+  for (Index = 0; Index < 2; Index++) {
+    if (RtTable->Trie.Child[Index] != NULL) {
+      Ip4FreeRouteNode (RtTable->Trie.Child[Index]);
+    }
+  }
+
   Ip4CleanRouteCache (&RtTable->Cache);
 
   FreePool (RtTable);
@@ -298,12 +429,15 @@ Ip4AddRoute (
   LIST_ENTRY       *Head;
   LIST_ENTRY       *Entry;
   IP4_ROUTE_ENTRY  *RtEntry;
+  IP4_ROUTE_NODE   *Node;
+  UINTN            Length;
 
   //
   // All the route entries with the same netmask length are
   // linke to the same route area
   //
-  Head = &(RtTable->RouteArea[NetGetMaskLength (Netmask)]);
+  Length = NetGetMaskLength (Netmask);
+  Head   = &(RtTable->RouteArea[Length]);
 
   //
   // First check whether the route exists
@@ -325,11 +459,20 @@ Ip4AddRoute (
     return EFI_OUT_OF_RESOURCES;
   }
 
+  Node = Ip4GetRouteNode (RtTable, Dest, Length, TRUE);
+
+  if (Node == NULL) {
+    Ip4PruneRouteNode (RtTable, Dest, Length);
+    Ip4FreeRouteEntry (RtEntry);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
   if (Gateway == IP4_ALLZERO_ADDRESS) {
     RtEntry->Flag = IP4_DIRECT_ROUTE;
   }
 
   InsertHeadList (Head, &RtEntry->Link);
+  InsertHeadList (&Node->Routes, &RtEntry->NodeLink);
   RtTable->TotalNum++;
 
   return EFI_SUCCESS;
@@ -360,8 +503,10 @@ Ip4DelRoute (
   LIST_ENTRY       *Entry;
   LIST_ENTRY       *Next;
   IP4_ROUTE_ENTRY  *RtEntry;
+  UINTN            Length;
 
-  Head = &(RtTable->RouteArea[NetGetMaskLength (Netmask)]);
+  Length = NetGetMaskLength (Netmask);
+  Head   = &(RtTable->RouteArea[Length]);
 
   NET_LIST_FOR_EACH_SAFE (Entry, Next, Head) {
     RtEntry = NET_LIST_USER_STRUCT (Entry, IP4_ROUTE_ENTRY, Link);
@@ -369,6 +514,8 @@ Ip4DelRoute (
     if (IP4_NET_EQUAL (RtEntry->Dest, Dest, Netmask) && (RtEntry->NextHop == Gateway)) {
       Ip4PurgeRouteCache (&RtTable->Cache, (UINTN)RtEntry);
       RemoveEntryList (Entry);
+      RemoveEntryList (&RtEntry->NodeLink);
+      Ip4PruneRouteNode (RtTable, RtEntry->Dest, Length);
       Ip4FreeRouteEntry (RtEntry);
 
       RtTable->TotalNum--;
@@ -419,11 +566,11 @@ Ip4FindRouteCache (
 }
 
 /**
-  Search the route table for a most specific match to the Dst. It searches
-  from the longest route area (mask length == 32) to the shortest route area
-  (default routes). In each route area, it will first search the instance's
-  route table, then the default route table. This is required by the following
-  requirements:
+  Search the route table for a most specific match to the Dst. It walks
+  the route trie of the instance's route table, then the one of the default
+  route table, along the bits of the Dst, and picks the longest prefix
+  found. On a tie, the instance's route entry wins. This is required by
+  the following requirements:
   1. IP search the route table for a most specific match
   2. The local route entries have precedence over the default route entry.
 
@@ -440,27 +587,40 @@ Ip4FindRouteEntry (
   IN IP4_ADDR         Dst
   )
 {
-  LIST_ENTRY       *Entry;
   IP4_ROUTE_ENTRY  *RtEntry;
+  IP4_ROUTE_NODE   *Node;
+  IP4_ROUTE_NODE   *Found;
   IP4_ROUTE_TABLE  *Table;
-  INTN             Index;
+  INTN             Depth;
+  INTN             FoundDepth;
 
-  RtEntry = NULL;
+  Found      = NULL;
+  FoundDepth = -1;
 
-  for (Index = IP4_MASK_MAX; Index >= 0; Index--) {
-    for (Table = RtTable; Table != NULL; Table = Table->Next) {
-      NET_LIST_FOR_EACH (Entry, &Table->RouteArea[Index]) {
-        RtEntry = NET_LIST_USER_STRUCT (Entry, IP4_ROUTE_ENTRY, Link);
+  for (Table = RtTable; Table != NULL; Table = Table->Next) {
+    Node = &Table->Trie;
+
+    for (Depth = 0; Node != NULL; Depth++) {
+      if ((Depth > FoundDepth) && !IsListEmpty (&Node->Routes)) {
+        Found      = Node;
+        FoundDepth = Depth;
+      }
 
-        if (IP4_NET_EQUAL (RtEntry->Dest, Dst, RtEntry->Netmask)) {
-          NET_GET_REF (RtEntry);
-          return RtEntry;
-        }
+      if (Depth == IP4_MASK_MAX) {
+        break;
       }
+
+      Node = Node->Child[IP4_ROUTE_BIT (Dst, Depth)];
     }
   }
 
-  return NULL;
+  if (Found == NULL) {
+    return NULL;
+  }
+
+  RtEntry = NET_LIST_USER_STRUCT (Found->Routes.ForwardLink, IP4_ROUTE_ENTRY, NodeLink);
+  NET_GET_REF (RtEntry);
+  return RtEntry;
 }
 
 /**
@@ -13,11 +13,17 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #define IP4_DIRECT_ROUTE  0x00000001
 
-#define IP4_ROUTE_CACHE_HASH_VALUE  31
+#define IP4_ROUTE_CACHE_HASH_VALUE  127
 #define IP4_ROUTE_CACHE_MAX         64 // Max NO. of cache entry per hash bucket
 
 #define IP4_ROUTE_CACHE_HASH(Dst, Src)  (((Dst) ^ (Src)) % IP4_ROUTE_CACHE_HASH_VALUE)
 
+//
+// The bit of the address to branch on at the Depth of the route trie,
+// starting from the most significant bit.
+//
+#define IP4_ROUTE_BIT(Addr, Depth)  (((Addr) >> (IP4_MASK_MAX - 1 - (Depth))) & 0x01)
+
 ///
 /// The route entry in the route table. Dest/Netmask is the destion
 /// network. The nexthop is the gateway to send the packet to in
@@ -27,6 +33,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 ///
 typedef struct {
   LIST_ENTRY    Link;
+  LIST_ENTRY    NodeLink;
   INTN          RefCnt;
   IP4_ADDR      Dest;
   IP4_ADDR      Netmask;
@@ -34,6 +41,20 @@ typedef struct {
   UINT32        Flag;
 } IP4_ROUTE_ENTRY;
 
+///
+/// The node of the binary trie which indexes the route entries by their
+/// destination network for the longest prefix match. The node at depth N
+/// stands for the prefix made of the N bits on the path from the root.
+/// The route entries whose Dest/Netmask is exactly that prefix are linked
+/// to Routes, the most recently added first.
+///
+typedef struct _IP4_ROUTE_NODE IP4_ROUTE_NODE;
+
+struct _IP4_ROUTE_NODE {
+  IP4_ROUTE_NODE    *Child[2];
+  LIST_ENTRY        Routes;
+};
+
 ///
 /// The route cache entry. The route cache entry is optional.
 /// But it is necessary to support the ICMP redirect message.
@@ -70,7 +91,9 @@ typedef struct {
 ///
 /// All the route table entries with the same mask are linked
 /// together in one route area. For example, RouteArea[0] contains
-/// the default routes. A route table also contains a route cache.
+/// the default routes. The same entries are also indexed by the
+/// route trie rooted at Trie, which is used to route the packets.
+/// A route table also contains a route cache.
 ///
 typedef struct _IP4_ROUTE_TABLE IP4_ROUTE_TABLE;
 
@@ -78,6 +101,7 @@ struct _IP4_ROUTE_TABLE {
   INTN               RefCnt;
   UINT32             TotalNum;
   LIST_ENTRY         RouteArea[IP4_MASK_NUM];
+  IP4_ROUTE_NODE     Trie;
   IP4_ROUTE_TABLE    *Next;
   IP4_ROUTE_CACHE    Cache;
 };
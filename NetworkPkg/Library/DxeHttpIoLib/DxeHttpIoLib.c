@@ -368,6 +368,45 @@ HttpIoRecvResponse (
   IN      BOOLEAN                RecvMsgHeader,
   OUT     HTTP_IO_RESPONSE_DATA  *ResponseData
   )
+{
+  EFI_STATUS  Status;
+
+  Status = HttpIoStartResponse (HttpIo, RecvMsgHeader, ResponseData);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  //
+  // Poll the network until receive finish.
+  //
+  do {
+    Status = HttpIoPollResponse (HttpIo, ResponseData);
+  } while (Status == EFI_NOT_READY);
+
+  return Status;
+}
+
+/**
+  Start receiving a HTTP RESPONSE message from the server, without waiting for
+  it. HttpIoPollResponse() is then called until the response is received.
+
+  @param[in]   HttpIo           The HttpIo wrapping the HTTP service.
+  @param[in]   RecvMsgHeader    TRUE to receive a new HTTP response (from message header).
+                                FALSE to continue receive the previous response message.
+  @param[in]   ResponseData     Point to a wrapper of the response data to receive,
+                                which must stay valid until the response is received.
+
+  @retval EFI_SUCCESS            The HTTP response is being received.
+  @retval EFI_INVALID_PARAMETER  One or more parameters are invalid.
+  @retval Others                 Other errors as indicated.
+
+**/
+EFI_STATUS
+HttpIoStartResponse (
+  IN      HTTP_IO                *HttpIo,
+  IN      BOOLEAN                RecvMsgHeader,
+  IN      HTTP_IO_RESPONSE_DATA  *ResponseData
+  )
 {
   EFI_STATUS         Status;
   EFI_HTTP_PROTOCOL  *Http;
@@ -412,34 +451,66 @@ HttpIoRecvResponse (
     // Remove timeout timer from the event list.
     //
     gBS->SetTimer (HttpIo->TimeoutEvent, TimerCancel, 0);
-    return Status;
   }
 
-  //
-  // Poll the network until receive finish.
-  //
-  while (!HttpIo->IsRxDone && EFI_ERROR (gBS->CheckEvent (HttpIo->TimeoutEvent))) {
-    Http->Poll (Http);
+  return Status;
+}
+
+/**
+  Poll the network once for the HTTP RESPONSE message started with
+  HttpIoStartResponse(), without waiting for it.
+
+  @param[in]   HttpIo           The HttpIo wrapping the HTTP service.
+  @param[out]  ResponseData     Point to a wrapper of the received response data,
+                                the one given to HttpIoStartResponse().
+
+  @retval EFI_SUCCESS            The HTTP response is received.
+  @retval EFI_NOT_READY          The HTTP response is not received yet.
+  @retval EFI_TIMEOUT            The HTTP response is not received in time, and
+                                 it is cancelled.
+  @retval EFI_INVALID_PARAMETER  One or more parameters are invalid.
+  @retval Others                 Other errors as indicated.
+
+**/
+EFI_STATUS
+HttpIoPollResponse (
+  IN      HTTP_IO                *HttpIo,
+  OUT     HTTP_IO_RESPONSE_DATA  *ResponseData
+  )
+{
+  EFI_STATUS         Status;
+  EFI_HTTP_PROTOCOL  *Http;
+
+  if ((HttpIo == NULL) || (HttpIo->Http == NULL) || (ResponseData == NULL)) {
+    return EFI_INVALID_PARAMETER;
   }
 
-  //
-  // Remove timeout timer from the event list.
-  //
-  gBS->SetTimer (HttpIo->TimeoutEvent, TimerCancel, 0);
+  Http = HttpIo->Http;
+  if (!HttpIo->IsRxDone) {
+    Http->Poll (Http);
+  }
 
   if (!HttpIo->IsRxDone) {
+    if (EFI_ERROR (gBS->CheckEvent (HttpIo->TimeoutEvent))) {
+      return EFI_NOT_READY;
+    }
+
     //
     // Timeout occurs, cancel the response token.
     //
+    gBS->SetTimer (HttpIo->TimeoutEvent, TimerCancel, 0);
     Http->Cancel (Http, &HttpIo->RspToken);
 
-    Status = EFI_TIMEOUT;
-
-    return Status;
-  } else {
-    HttpIo->IsRxDone = FALSE;
+    return EFI_TIMEOUT;
   }
 
+  //
+  // Remove timeout timer from the event list.
+  //
+  gBS->SetTimer (HttpIo->TimeoutEvent, TimerCancel, 0);
+  HttpIo->IsRxDone = FALSE;
+
+  Status = EFI_SUCCESS;
   if ((HttpIo->Callback != NULL) &&
       ((HttpIo->RspToken.Status == EFI_SUCCESS) || (HttpIo->RspToken.Status == EFI_HTTP_ERROR)))
   {
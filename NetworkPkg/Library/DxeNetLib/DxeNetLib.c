@@ -3396,6 +3396,246 @@ NetLibGetSystemGuid (
   return EFI_NOT_FOUND;
 }
 
+/**
+  Convert a time to the number of seconds elapsed since 1970-01-01 00:00:00.
+
+  The TimeZone and Daylight fields of Time are ignored, so the result is only
+  meaningful when compared with another value converted from the same clock.
+
+  If Time is NULL, then ASSERT().
+
+  @param[in]  Time      The time to convert.
+
+  @return               The number of seconds since 1970-01-01 00:00:00, or 0 if
+                        Time is earlier than that.
+
+**/
+UINT64
+EFIAPI
+NetLibTimeToSeconds (
+  IN CONST EFI_TIME  *Time
+  )
+{
+  UINT32  Year;
+  UINT32  Month;
+  UINT32  Era;
+  UINT32  YearOfEra;
+  UINT32  DayOfYear;
+  UINT32  DayOfEra;
+  UINT64  Days;
+
+  ASSERT (Time != NULL);
+
+  if (Time->Year < 1970) {
+    return 0;
+  }
+
+  //
+  // Count the days from 0000-03-01, so that the leap day is the last day of
+  // the year, then shift the origin to 1970-01-01 (day 719468).
+  //
+  Year  = Time->Year;
+  Month = Time->Month;
+  if (Month <= 2) {
+    Year--;
+  }
+
+  Era       = Year / 400;
+  YearOfEra = Year - Era * 400;
+  DayOfYear = (153 * (Month > 2 ? Month - 3 : Month + 9) + 2) / 5 + Time->Day - 1;
+  DayOfEra  = YearOfEra * 365 + YearOfEra / 4 - YearOfEra / 100 + DayOfYear;
+  Days      = (UINT64)Era * 146097 + DayOfEra - 719468;
+
+  return Days * 86400 + (UINT64)Time->Hour * 3600 + (UINT64)Time->Minute * 60 + Time->Second;
+}
+
+/**
+  EFI_DHCP4_CALLBACK of a discovery run by NetLibDhcp4Race(). It stops the
+  discovery as soon as a usable offer is received, and never lets it go on to
+  request a lease.
+
+  @param[in]  This              Pointer to the EFI DHCPv4 Protocol.
+  @param[in]  Context           Pointer to the NET_DHCP4_PROBE of the interface.
+  @param[in]  CurrentState      The current operational state of the EFI DHCPv4 Protocol driver.
+  @param[in]  Dhcp4Event        The event that occurs in the current state.
+  @param[in]  Packet            The DHCPv4 packet that is going to be sent or already received.
+  @param[out] NewPacket         The packet that is used to replace the above Packet.
+
+  @retval EFI_SUCCESS           Continue the DHCP process.
+  @retval EFI_NOT_READY         Wait for more DHCPOFFER packets.
+  @retval EFI_ABORTED           Stop the DHCP process.
+
+**/
+EFI_STATUS
+EFIAPI
+NetLibDhcp4ProbeCallBack (
+  IN  EFI_DHCP4_PROTOCOL  *This,
+  IN  VOID                *Context,
+  IN  EFI_DHCP4_STATE     CurrentState,
+  IN  EFI_DHCP4_EVENT     Dhcp4Event,
+  IN  EFI_DHCP4_PACKET    *Packet            OPTIONAL,
+  OUT EFI_DHCP4_PACKET    **NewPacket        OPTIONAL
+  )
+{
+  NET_DHCP4_PROBE  *Probe;
+
+  Probe = (NET_DHCP4_PROBE *)Context;
+
+  switch (Dhcp4Event) {
+    case Dhcp4RcvdOffer:
+      if ((Packet != NULL) && Probe->CheckOffer (Probe->Context, Packet)) {
+        Probe->IsUsable = TRUE;
+        return EFI_ABORTED;
+      }
+
+      return EFI_NOT_READY;
+
+    case Dhcp4SelectOffer:
+      return EFI_ABORTED;
+
+    default:
+      return EFI_SUCCESS;
+  }
+}
+
+/**
+  Notify function of the completion event of a discovery run by NetLibDhcp4Race().
+
+  @param[in]  Event             The event signaled.
+  @param[in]  Context           Pointer to the IsDone flag of the NET_DHCP4_PROBE.
+
+**/
+VOID
+EFIAPI
+NetLibDhcp4ProbeNotify (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  *((BOOLEAN *)Context) = TRUE;
+}
+
+/**
+  Run the DHCPv4 discovery on several network interfaces at once, until one of
+  them is offered a usable boot server or all of them give up.
+
+  Each discovery only collects offers and never requests a lease. When the race
+  is over, the discoveries still running are stopped and all the EFI DHCPv4
+  Protocol instances are unconfigured.
+
+  If Probes is NULL and ProbeCount is not 0, then ASSERT().
+
+  @param[in, out]  Probes       The discoveries to run. The Status of those
+                                which could not be started is set to an error.
+  @param[in]       ProbeCount   The number of entries in Probes.
+
+  @return                       The index in Probes of the winner, or ProbeCount
+                                if no interface was offered a usable boot server.
+
+**/
+UINTN
+EFIAPI
+NetLibDhcp4Race (
+  IN OUT NET_DHCP4_PROBE  *Probes,
+  IN     UINTN            ProbeCount
+  )
+{
+  NET_DHCP4_PROBE        *Probe;
+  EFI_DHCP4_CONFIG_DATA  Config;
+  UINTN                  Index;
+  UINTN                  Winner;
+  BOOLEAN                Pending;
+
+  ASSERT ((Probes != NULL) || (ProbeCount == 0));
+
+  //
+  // Start the discovery on every interface at once.
+  //
+  for (Index = 0; Index < ProbeCount; Index++) {
+    Probe           = &Probes[Index];
+    Probe->Event    = NULL;
+    Probe->IsDone   = FALSE;
+    Probe->IsUsable = FALSE;
+
+    ZeroMem (&Config, sizeof (Config));
+    Config.OptionCount      = Probe->OptionCount;
+    Config.OptionList       = Probe->OptionList;
+    Config.Dhcp4Callback    = NetLibDhcp4ProbeCallBack;
+    Config.CallbackContext  = Probe;
+    Config.DiscoverTryCount = Probe->DiscoverTryCount;
+    Config.DiscoverTimeout  = Probe->DiscoverTimeout;
+
+    Probe->Status = Probe->Dhcp4->Configure (Probe->Dhcp4, &Config);
+    if (EFI_ERROR (Probe->Status)) {
+      continue;
+    }
+
+    Probe->Status = gBS->CreateEvent (
+                           EVT_NOTIFY_SIGNAL,
+                           TPL_CALLBACK,
+                           NetLibDhcp4ProbeNotify,
+                           &Probe->IsDone,
+                           &Probe->Event
+                           );
+    if (!EFI_ERROR (Probe->Status)) {
+      Probe->Status = Probe->Dhcp4->Start (Probe->Dhcp4, Probe->Event);
+      if (EFI_ERROR (Probe->Status)) {
+        gBS->CloseEvent (Probe->Event);
+        Probe->Event = NULL;
+      }
+    }
+
+    if (EFI_ERROR (Probe->Status)) {
+      Probe->Dhcp4->Configure (Probe->Dhcp4, NULL);
+    }
+  }
+
+  //
+  // Wait for the first usable offer, or for all the discoveries to give up.
+  //
+  Winner = ProbeCount;
+  do {
+    Pending = FALSE;
+    for (Index = 0; Index < ProbeCount; Index++) {
+      Probe = &Probes[Index];
+      if (EFI_ERROR (Probe->Status)) {
+        continue;
+      }
+
+      if (Probe->IsUsable) {
+        Winner = Index;
+        break;
+      }
+
+      if (!Probe->IsDone) {
+        Pending = TRUE;
+      }
+    }
+
+    CpuPause ();
+  } while ((Winner == ProbeCount) && Pending);
+
+  //
+  // Cancel the discoveries still running and release the DHCPv4 instances.
+  //
+  for (Index = 0; Index < ProbeCount; Index++) {
+    Probe = &Probes[Index];
+    if (EFI_ERROR (Probe->Status)) {
+      continue;
+    }
+
+    if (!Probe->IsDone) {
+      Probe->Dhcp4->Stop (Probe->Dhcp4);
+    }
+
+    Probe->Dhcp4->Configure (Probe->Dhcp4, NULL);
+    gBS->CloseEvent (Probe->Event);
+    Probe->Event = NULL;
+  }
+
+  return Winner;
+}
+
 /**
   Create Dns QName according the queried domain name.
 
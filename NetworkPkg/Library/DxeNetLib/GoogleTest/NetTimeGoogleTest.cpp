@@ -0,0 +1,89 @@
+/** @file
+  Tests for NetLibTimeToSeconds in DxeNetLib.c.
+
+  Copyright (c) 2026, agent <agent@local>. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+#include <gtest/gtest.h>
+
+extern "C" {
+  #include <Uefi.h>
+  #include <Library/BaseLib.h>
+  #include <Library/BaseMemoryLib.h>
+  #include <Library/NetLib.h>
+}
+
+////////////////////////////////////////////////////////////////////////
+// NetLibTimeToSeconds Tests
+////////////////////////////////////////////////////////////////////////
+
+class NetLibTimeToSecondsTest : public ::testing::Test {
+protected:
+  EFI_TIME Time;
+
+  virtual void
+  SetUp (
+    )
+  {
+    ZeroMem (&Time, sizeof (Time));
+  }
+
+  void
+  SetTime (
+    UINT16  Year,
+    UINT8   Month,
+    UINT8   Day,
+    UINT8   Hour,
+    UINT8   Minute,
+    UINT8   Second
+    )
+  {
+    Time.Year   = Year;
+    Time.Month  = Month;
+    Time.Day    = Day;
+    Time.Hour   = Hour;
+    Time.Minute = Minute;
+    Time.Second = Second;
+  }
+};
+
+TEST_F (NetLibTimeToSecondsTest, EpochIsZero) {
+  SetTime (1970, 1, 1, 0, 0, 0);
+  EXPECT_EQ (NetLibTimeToSeconds (&Time), 0ULL);
+}
+
+TEST_F (NetLibTimeToSecondsTest, TimeBeforeEpochIsZero) {
+  SetTime (1969, 12, 31, 23, 59, 59);
+  EXPECT_EQ (NetLibTimeToSeconds (&Time), 0ULL);
+}
+
+TEST_F (NetLibTimeToSecondsTest, KnownDatesMatch) {
+  SetTime (2000, 1, 1, 0, 0, 0);
+  EXPECT_EQ (NetLibTimeToSeconds (&Time), 946684800ULL);
+
+  SetTime (2021, 3, 1, 12, 34, 56);
+  EXPECT_EQ (NetLibTimeToSeconds (&Time), 1614602096ULL);
+
+  SetTime (2038, 1, 19, 3, 14, 8);
+  EXPECT_EQ (NetLibTimeToSeconds (&Time), 2147483648ULL);
+}
+
+TEST_F (NetLibTimeToSecondsTest, LeapDaysAreCounted) {
+  UINT64  Before;
+  UINT64  After;
+
+  SetTime (2024, 2, 28, 0, 0, 0);
+  Before = NetLibTimeToSeconds (&Time);
+  SetTime (2024, 3, 1, 0, 0, 0);
+  After = NetLibTimeToSeconds (&Time);
+  EXPECT_EQ (After - Before, 2ULL * 86400);
+
+  //
+  // 2100 is not a leap year.
+  //
+  SetTime (2100, 2, 28, 0, 0, 0);
+  Before = NetLibTimeToSeconds (&Time);
+  SetTime (2100, 3, 1, 0, 0, 0);
+  After = NetLibTimeToSeconds (&Time);
+  EXPECT_EQ (After - Before, 86400ULL);
+}
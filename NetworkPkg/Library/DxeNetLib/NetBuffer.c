@@ -1604,6 +1604,12 @@ NetbufQueFlush (
 /**
   Compute the checksum for a bulk of data.
 
+  The data is summed a 64-bit word at a time. Each word is added as two 32-bit
+  halves to a 64-bit accumulator, which can't overflow for any UINT32 length,
+  and the accumulator is folded to 16 bits at the end. Since 2^16 - 1 divides
+  2^32 - 1, this gives the same one's complement sum as adding the data 16 bits
+  at a time.
+
   @param[in]   Bulk                  Pointer to the data.
   @param[in]   Len                   Length of the data, in bytes.
 
@@ -1617,15 +1623,52 @@ NetblockChecksum (
   IN UINT32  Len
   )
 {
-  register UINT32  Sum;
+  UINT64   Sum;
+  UINT64   Data;
+  UINT32   Sum32;
+  UINT8    First;
+  BOOLEAN  Odd;
 
-  Sum = 0;
+  Sum   = 0;
+  First = 0;
 
   //
-  // Add left-over byte, if any
+  // The 16-bit words of the data start at Bulk regardless of its alignment.
+  // If Bulk is odd, sum the data from the next byte, which is 2-byte aligned,
+  // and byte swap the result: shifting every byte to the other half of its
+  // word is the same as multiplying the one's complement sum by 2^8.
   //
-  if (Len % 2 != 0) {
-    Sum += *(Bulk + Len - 1);
+  Odd = (BOOLEAN)((((UINTN)Bulk & 0x1) != 0) && (Len != 0));
+  if (Odd) {
+    First = *Bulk;
+    Bulk++;
+    Len--;
+  }
+
+  while ((((UINTN)Bulk & 0x7) != 0) && (Len > 1)) {
+    Sum  += *(UINT16 *)Bulk;
+    Bulk += 2;
+    Len  -= 2;
+  }
+
+  while (Len >= 32) {
+    Data  = ((UINT64 *)Bulk)[0];
+    Sum  += (UINT32)Data + (Data >> 32);
+    Data  = ((UINT64 *)Bulk)[1];
+    Sum  += (UINT32)Data + (Data >> 32);
+    Data  = ((UINT64 *)Bulk)[2];
+    Sum  += (UINT32)Data + (Data >> 32);
+    Data  = ((UINT64 *)Bulk)[3];
+    Sum  += (UINT32)Data + (Data >> 32);
+    Bulk += 32;
+    Len  -= 32;
+  }
+
+  while (Len >= 8) {
+    Data  = *(UINT64 *)Bulk;
+    Sum  += (UINT32)Data + (Data >> 32);
+    Bulk += 8;
+    Len  -= 8;
   }
 
   while (Len > 1) {
@@ -1635,13 +1678,27 @@ NetblockChecksum (
   }
 
   //
-  // Fold 32-bit sum to 16 bits
+  // Add left-over byte, if any
   //
-  while ((Sum >> 16) != 0) {
-    Sum = (Sum & 0xffff) + (Sum >> 16);
+  if (Len != 0) {
+    Sum += *Bulk;
   }
 
-  return (UINT16)Sum;
+  //
+  // Fold 64-bit sum to 16 bits
+  //
+  Sum   = (Sum & 0xffffffff) + (Sum >> 32);
+  Sum   = (Sum & 0xffffffff) + (Sum >> 32);
+  Sum32 = (UINT32)Sum;
+  Sum32 = (Sum32 & 0xffff) + (Sum32 >> 16);
+  Sum32 = (Sum32 & 0xffff) + (Sum32 >> 16);
+
+  if (Odd) {
+    Sum32 = (UINT32)SwapBytes16 ((UINT16)Sum32) + First;
+    Sum32 = (Sum32 & 0xffff) + (Sum32 >> 16);
+  }
+
+  return (UINT16)Sum32;
 }
 
 /**
@@ -1722,6 +1779,59 @@ NetbufChecksum (
   return TotalSum;
 }
 
+/**
+  Complete the checksum of a TCP or UDP packet whose checksum field holds only
+  the checksum of its pseudo header.
+
+  A driver leaving the checksum to a network interface capable of the checksum
+  offload stores the checksum of the pseudo header in the checksum field. This
+  function completes such a packet in software, for the cases where the network
+  interface can't, such as a packet to be fragmented.
+
+  @param[in, out]  Nbuf        Pointer to the net buffer, which starts with the
+                               TCP or UDP header.
+  @param[in]       Offset      The offset of the checksum field in the net buffer.
+  @param[in]       PseudoSum   The checksum of the pseudo header, including the
+                               length of the packet.
+
+  @retval TRUE     The checksum field held PseudoSum and has been completed.
+  @retval FALSE    The checksum field doesn't hold PseudoSum and is unchanged.
+
+**/
+BOOLEAN
+EFIAPI
+NetbufCompleteChecksum (
+  IN OUT NET_BUF  *Nbuf,
+  IN     UINT32   Offset,
+  IN     UINT16   PseudoSum
+  )
+{
+  UINT8   *Field[2];
+  UINT16  Checksum;
+
+  NET_CHECK_SIGNATURE (Nbuf, NET_BUF_SIGNATURE);
+
+  if (NetbufCopy (Nbuf, Offset, sizeof (Checksum), (UINT8 *)&Checksum) != sizeof (Checksum)) {
+    return FALSE;
+  }
+
+  if (Checksum != PseudoSum) {
+    return FALSE;
+  }
+
+  //
+  // The sum of the packet already includes the pseudo header through its
+  // checksum field. The field may straddle two blocks.
+  //
+  Field[0] = NetbufGetByte (Nbuf, Offset, NULL);
+  Field[1] = NetbufGetByte (Nbuf, Offset + 1, NULL);
+  Checksum = (UINT16)~NetbufChecksum (Nbuf);
+
+  *Field[0] = ((UINT8 *)&Checksum)[0];
+  *Field[1] = ((UINT8 *)&Checksum)[1];
+  return TRUE;
+}
+
 /**
   Compute the checksum for TCP/UDP pseudo header.
 
@@ -181,7 +181,13 @@ MnpFreeNbuf (
 
   NET_PUT_REF (Nbuf);
 
-  if (Nbuf->RefCnt == 1) {
+  if ((Nbuf->RefCnt == 1) && MNP_NBUF_IS_LOANED (Nbuf)) {
+    //
+    // The frame is not in the buffer pool, give it back to the network
+    // interface.
+    //
+    NetbufFree (Nbuf);
+  } else if (Nbuf->RefCnt == 1) {
     //
     // Trim all buffer contained in the Nbuf, then append it to the NbufQue.
     //
@@ -206,6 +212,8 @@ MnpFreeNbuf (
 
   @param[in, out]  MnpDeviceData         Pointer to the MNP_DEVICE_DATA.
   @param[in]       Count                 Number of TX buffers to add.
+  @param[in]       Large                 Add the buffers of MnpDeviceData->LargeBufferLength
+                                         bytes to MnpDeviceData->FreeLargeTxBufList instead.
 
   @retval EFI_SUCCESS           The specified amount of TX buffers are allocated.
   @retval EFI_OUT_OF_RESOURCES  Failed to allocate a TX buffer.
@@ -214,19 +222,23 @@ MnpFreeNbuf (
 EFI_STATUS
 MnpAddFreeTxBuf (
   IN OUT MNP_DEVICE_DATA  *MnpDeviceData,
-  IN     UINTN            Count
+  IN     UINTN            Count,
+  IN     BOOLEAN          Large
   )
 {
   EFI_STATUS       Status;
   UINT32           Index;
+  UINT32           Length;
   MNP_TX_BUF_WRAP  *TxBufWrap;
 
   NET_CHECK_SIGNATURE (MnpDeviceData, MNP_DEVICE_DATA_SIGNATURE);
-  ASSERT ((Count > 0) && (MnpDeviceData->BufferLength > 0));
+
+  Length = Large ? MnpDeviceData->LargeBufferLength : MnpDeviceData->BufferLength;
+  ASSERT ((Count > 0) && (Length > 0));
 
   Status = EFI_SUCCESS;
   for (Index = 0; Index < Count; Index++) {
-    TxBufWrap = (MNP_TX_BUF_WRAP *)AllocatePool (OFFSET_OF (MNP_TX_BUF_WRAP, TxBuf) + MnpDeviceData->BufferLength);
+    TxBufWrap = (MNP_TX_BUF_WRAP *)AllocatePool (OFFSET_OF (MNP_TX_BUF_WRAP, TxBuf) + Length);
     if (TxBufWrap == NULL) {
       DEBUG ((DEBUG_ERROR, "MnpAddFreeTxBuf: TxBuf Alloc failed.\n"));
 
@@ -237,7 +249,11 @@ MnpAddFreeTxBuf (
     DEBUG ((DEBUG_INFO, "MnpAddFreeTxBuf: Add TxBufWrap %p, TxBuf %p\n", TxBufWrap, TxBufWrap->TxBuf));
     TxBufWrap->Signature = MNP_TX_BUF_WRAP_SIGNATURE;
     TxBufWrap->InUse     = FALSE;
-    InsertTailList (&MnpDeviceData->FreeTxBufList, &TxBufWrap->WrapEntry);
+    TxBufWrap->Large     = Large;
+    InsertTailList (
+      Large ? &MnpDeviceData->FreeLargeTxBufList : &MnpDeviceData->FreeTxBufList,
+      &TxBufWrap->WrapEntry
+      );
     InsertTailList (&MnpDeviceData->AllTxBufList, &TxBufWrap->AllEntry);
   }
 
@@ -251,6 +267,8 @@ MnpAddFreeTxBuf (
   them into the queue, then fetch the NET_BUF from the updated FreeTxBufList.
 
   @param[in, out]  MnpDeviceData        Pointer to the MNP_DEVICE_DATA.
+  @param[in]       Large                Allocate a buffer of LargeBufferLength bytes
+                                        from FreeLargeTxBufList instead.
 
   @return     Pointer to the allocated free NET_BUF structure, if NULL the
               operation is failed.
@@ -258,20 +276,35 @@ MnpAddFreeTxBuf (
 **/
 UINT8 *
 MnpAllocTxBuf (
-  IN OUT MNP_DEVICE_DATA  *MnpDeviceData
+  IN OUT MNP_DEVICE_DATA  *MnpDeviceData,
+  IN     BOOLEAN          Large
   )
 {
   EFI_TPL          OldTpl;
   UINT8            *TxBuf;
   EFI_STATUS       Status;
+  LIST_ENTRY       *FreeList;
   LIST_ENTRY       *Entry;
   MNP_TX_BUF_WRAP  *TxBufWrap;
+  UINTN            Count;
 
   NET_CHECK_SIGNATURE (MnpDeviceData, MNP_DEVICE_DATA_SIGNATURE);
 
+  //
+  // The large buffers are only needed for the packets to segment, add them
+  // one at a time.
+  //
+  if (Large) {
+    FreeList = &MnpDeviceData->FreeLargeTxBufList;
+    Count    = 1;
+  } else {
+    FreeList = &MnpDeviceData->FreeTxBufList;
+    Count    = MNP_TX_BUFFER_INCREASEMENT;
+  }
+
   OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
 
-  if (IsListEmpty (&MnpDeviceData->FreeTxBufList)) {
+  if (IsListEmpty (FreeList)) {
     //
     // First try to recycle some TX buffer from SNP
     //
@@ -284,8 +317,8 @@ MnpAllocTxBuf (
     //
     // If still no free TX buffer, allocate more.
     //
-    if (IsListEmpty (&MnpDeviceData->FreeTxBufList)) {
-      if ((MnpDeviceData->TxBufCount + MNP_TX_BUFFER_INCREASEMENT) > MNP_MAX_TX_BUFFER_NUM) {
+    if (IsListEmpty (FreeList)) {
+      if ((MnpDeviceData->TxBufCount + Count) > MNP_MAX_TX_BUFFER_NUM) {
         DEBUG (
           (DEBUG_ERROR,
            "MnpAllocTxBuf: The maximum TxBuf size is reached for MNP driver instance %p.\n",
@@ -296,8 +329,8 @@ MnpAllocTxBuf (
         goto ON_EXIT;
       }
 
-      Status = MnpAddFreeTxBuf (MnpDeviceData, MNP_TX_BUFFER_INCREASEMENT);
-      if (IsListEmpty (&MnpDeviceData->FreeTxBufList)) {
+      Status = MnpAddFreeTxBuf (MnpDeviceData, Count, Large);
+      if (IsListEmpty (FreeList)) {
         DEBUG (
           (DEBUG_ERROR,
            "MnpAllocNbuf: Failed to add TxBuf into the FreeTxBufList, %r.\n",
@@ -310,9 +343,9 @@ MnpAllocTxBuf (
     }
   }
 
-  ASSERT (!IsListEmpty (&MnpDeviceData->FreeTxBufList));
-  Entry = MnpDeviceData->FreeTxBufList.ForwardLink;
-  RemoveEntryList (MnpDeviceData->FreeTxBufList.ForwardLink);
+  ASSERT (!IsListEmpty (FreeList));
+  Entry = FreeList->ForwardLink;
+  RemoveEntryList (FreeList->ForwardLink);
   TxBufWrap        = NET_LIST_USER_STRUCT_S (Entry, MNP_TX_BUF_WRAP, WrapEntry, MNP_TX_BUF_WRAP_SIGNATURE);
   TxBufWrap->InUse = TRUE;
   TxBuf            = TxBufWrap->TxBuf;
@@ -363,7 +396,10 @@ MnpFreeTxBuf (
   }
 
   OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
-  InsertTailList (&MnpDeviceData->FreeTxBufList, &TxBufWrap->WrapEntry);
+  InsertTailList (
+    TxBufWrap->Large ? &MnpDeviceData->FreeLargeTxBufList : &MnpDeviceData->FreeTxBufList,
+    &TxBufWrap->WrapEntry
+    );
   TxBufWrap->InUse = FALSE;
   gBS->RestoreTPL (OldTpl);
 }
@@ -457,6 +493,38 @@ MnpInitializeDeviceData (
   SnpMode            = Snp->Mode;
   MnpDeviceData->Snp = Snp;
 
+  //
+  // Check whether the network interface is able to lend the received frames.
+  //
+  Status = gBS->OpenProtocol (
+                  ControllerHandle,
+                  &gEdkiiSimpleNetworkRxLoanProtocolGuid,
+                  (VOID **)&MnpDeviceData->RxLoan,
+                  ImageHandle,
+                  ControllerHandle,
+                  EFI_OPEN_PROTOCOL_GET_PROTOCOL
+                  );
+  if (EFI_ERROR (Status)) {
+    MnpDeviceData->RxLoan = NULL;
+  }
+
+  //
+  // Check whether the network interface segments the TCP/IPv4 packets.
+  //
+  Status = gBS->OpenProtocol (
+                  ControllerHandle,
+                  &gEdkiiSimpleNetworkOffloadProtocolGuid,
+                  (VOID **)&MnpDeviceData->Offload,
+                  ImageHandle,
+                  ControllerHandle,
+                  EFI_OPEN_PROTOCOL_GET_PROTOCOL
+                  );
+  if (EFI_ERROR (Status) ||
+      ((MnpDeviceData->Offload->Capabilities & EDKII_SIMPLE_NETWORK_OFFLOAD_TCP4_TSO) == 0))
+  {
+    MnpDeviceData->Offload = NULL;
+  }
+
   //
   // Initialize the lists.
   //
@@ -476,6 +544,10 @@ MnpInitializeDeviceData (
   //
   MnpDeviceData->PaddingSize = ((4 - SnpMode->MediaHeaderSize) & 0x3) + NET_VLAN_TAG_LEN;
 
+  if (MnpDeviceData->Offload != NULL) {
+    MnpDeviceData->LargeBufferLength = SnpMode->MediaHeaderSize + MnpDeviceData->Offload->MaxSegmentationSize;
+  }
+
   //
   // Initialize MAC string which will be used as VLAN configuration variable name
   //
@@ -509,6 +581,7 @@ MnpInitializeDeviceData (
   // Allocate buffer pool for tx.
   //
   InitializeListHead (&MnpDeviceData->FreeTxBufList);
+  InitializeListHead (&MnpDeviceData->FreeLargeTxBufList);
   InitializeListHead (&MnpDeviceData->AllTxBufList);
   MnpDeviceData->TxBufCount = 0;
 
@@ -1273,6 +1346,8 @@ MnpStart (
     }
 
     MnpDeviceData->EnableSystemPoll = EnableSystemPoll;
+    MnpDeviceData->PollInterval     = MNP_SYS_POLL_INTERVAL;
+    MnpDeviceData->PollIdleCount    = 0;
   }
 
   //
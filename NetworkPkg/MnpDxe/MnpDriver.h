@@ -15,6 +15,8 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Protocol/SimpleNetwork.h>
 #include <Protocol/ServiceBinding.h>
 #include <Protocol/VlanConfig.h>
+#include <Protocol/SimpleNetworkOffload.h>
+#include <Protocol/SimpleNetworkRxLoan.h>
 
 #include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
@@ -38,53 +40,76 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 extern  EFI_DRIVER_BINDING_PROTOCOL  gMnpDriverBinding;
 
 typedef struct {
-  UINT32                         Signature;
+  UINT32                                   Signature;
 
-  EFI_HANDLE                     ControllerHandle;
-  EFI_HANDLE                     ImageHandle;
+  EFI_HANDLE                               ControllerHandle;
+  EFI_HANDLE                               ImageHandle;
 
-  EFI_VLAN_CONFIG_PROTOCOL       VlanConfig;
-  UINTN                          NumberOfVlan;
-  CHAR16                         *MacString;
-  EFI_SIMPLE_NETWORK_PROTOCOL    *Snp;
+  EFI_VLAN_CONFIG_PROTOCOL                 VlanConfig;
+  UINTN                                    NumberOfVlan;
+  CHAR16                                   *MacString;
+  EFI_SIMPLE_NETWORK_PROTOCOL              *Snp;
+
+  //
+  // Optional, lets the received frames stay in the receive buffers of the
+  // network interface instead of being copied into RxNbufCache.
+  //
+  EDKII_SIMPLE_NETWORK_RX_LOAN_PROTOCOL    *RxLoan;
+
+  //
+  // Optional, lets the TCP/IPv4 packets longer than the MTU be transmitted
+  // through the network interface, which segments them.
+  //
+  EDKII_SIMPLE_NETWORK_OFFLOAD_PROTOCOL    *Offload;
 
   //
   // List of MNP_SERVICE_DATA
   //
-  LIST_ENTRY                     ServiceList;
+  LIST_ENTRY                               ServiceList;
   //
   // Number of configured MNP Service Binding child
   //
-  UINTN                          ConfiguredChildrenNumber;
+  UINTN                                    ConfiguredChildrenNumber;
 
-  LIST_ENTRY                     GroupAddressList;
-  UINT32                         GroupAddressCount;
+  LIST_ENTRY                               GroupAddressList;
+  UINT32                                   GroupAddressCount;
 
-  LIST_ENTRY                     FreeTxBufList;
-  LIST_ENTRY                     AllTxBufList;
-  UINT32                         TxBufCount;
+  LIST_ENTRY                               FreeTxBufList;
+  LIST_ENTRY                               FreeLargeTxBufList;
+  LIST_ENTRY                               AllTxBufList;
+  UINT32                                   TxBufCount;
 
-  NET_BUF_QUEUE                  FreeNbufQue;
-  INTN                           NbufCnt;
+  NET_BUF_QUEUE                            FreeNbufQue;
+  INTN                                     NbufCnt;
 
-  EFI_EVENT                      PollTimer;
-  BOOLEAN                        EnableSystemPoll;
+  EFI_EVENT                                PollTimer;
+  BOOLEAN                                  EnableSystemPoll;
+  //
+  // The current period of the PollTimer, shortened while packets keep
+  // arriving, and the number of polls since the last packet.
+  //
+  UINT64                                   PollInterval;
+  UINT32                                   PollIdleCount;
 
-  EFI_EVENT                      TimeoutCheckTimer;
-  EFI_EVENT                      MediaDetectTimer;
+  EFI_EVENT                                TimeoutCheckTimer;
+  EFI_EVENT                                MediaDetectTimer;
 
-  UINT32                         UnicastCount;
-  UINT32                         BroadcastCount;
-  UINT32                         MulticastCount;
-  UINT32                         PromiscuousCount;
+  UINT32                                   UnicastCount;
+  UINT32                                   BroadcastCount;
+  UINT32                                   MulticastCount;
+  UINT32                                   PromiscuousCount;
 
   //
   // The size of the data buffer in the MNP_PACKET_BUFFER used to
   // store a packet.
   //
-  UINT32                         BufferLength;
-  UINT32                         PaddingSize;
-  NET_BUF                        *RxNbufCache;
+  UINT32                                   BufferLength;
+  UINT32                                   PaddingSize;
+  //
+  // The size of the TX buffers holding the packets to segment.
+  //
+  UINT32                                   LargeBufferLength;
+  NET_BUF                                  *RxNbufCache;
 } MNP_DEVICE_DATA;
 
 #define MNP_DEVICE_DATA_FROM_THIS(a) \
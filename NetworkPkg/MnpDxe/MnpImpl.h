@@ -14,6 +14,9 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define NET_ETHER_FCS_SIZE  4
 
 #define MNP_SYS_POLL_INTERVAL        (10 * TICKS_PER_MS)    // 10 milliseconds
+#define MNP_SYS_POLL_INTERVAL_BUSY   (1 * TICKS_PER_MS)     // 1 millisecond
+#define MNP_SYS_POLL_IDLE_LIMIT      8                      // Idle polls before slowing down
+#define MNP_RX_BATCH_SIZE            64                     // Packets received per poll
 #define MNP_TIMEOUT_CHECK_INTERVAL   (50 * TICKS_PER_MS)    // 50 milliseconds
 #define MNP_MEDIA_DETECT_INTERVAL    (500 * TICKS_PER_MS)   // 500 milliseconds
 #define MNP_TX_TIMEOUT_TIME          (500 * TICKS_PER_MS)   // 500 milliseconds
@@ -91,9 +94,10 @@ typedef struct {
 
 typedef struct {
   UINT32        Signature;
-  LIST_ENTRY    WrapEntry;            // Link to FreeTxBufList
+  LIST_ENTRY    WrapEntry;            // Link to FreeTxBufList or FreeLargeTxBufList
   LIST_ENTRY    AllEntry;             // Link to AllTxBufList
   BOOLEAN       InUse;
+  BOOLEAN       Large;                // Of LargeBufferLength bytes
   UINT8         TxBuf[1];
 } MNP_TX_BUF_WRAP;
 
@@ -430,6 +434,55 @@ MnpReceivePacket (
   IN OUT MNP_DEVICE_DATA  *MnpDeviceData
   );
 
+/**
+  Receive and deliver the packets available from Snp, up to
+  MNP_RX_BATCH_SIZE of them.
+
+  @param[in, out]  MnpDeviceData        Pointer to the mnp device context data.
+  @param[out]      Count                Number of the packets received.
+
+  @retval EFI_SUCCESS           At least one packet is received.
+  @retval Others                No packet is received, the error returned by
+                                MnpReceivePacket().
+
+**/
+EFI_STATUS
+MnpReceivePackets (
+  IN OUT MNP_DEVICE_DATA  *MnpDeviceData,
+  OUT    UINTN            *Count
+  );
+
+/**
+  Return the frame wrapped by a NET_BUF to the network interface it is
+  lent from, when the last reference of the NET_BUF is freed.
+
+  @param[in]  Arg                Pointer to the EDKII_SIMPLE_NETWORK_RX_LOAN.
+
+**/
+VOID
+EFIAPI
+MnpReturnRxLoan (
+  IN VOID  *Arg
+  );
+
+//
+// Whether the Nbuf wraps a frame lent by the network interface rather than
+// a buffer of the MNP buffer pool.
+//
+#define MNP_NBUF_IS_LOANED(Nbuf)  ((Nbuf)->Vector->Free == MnpReturnRxLoan)
+
+//
+// Whether the IPv4 packet (Ethertype 0x0800) of the TxData is left for the
+// network interface to segment. The packets to segment aren't VLAN tagged.
+//
+#define MNP_TX_DATA_IS_SEGMENTED(MnpServiceData, TxData)          \
+  (((MnpServiceData)->MnpDeviceData->Offload != NULL) &&          \
+   ((MnpServiceData)->VlanId == 0) &&                             \
+   ((TxData)->DestinationAddress != NULL) &&                      \
+   ((TxData)->ProtocolType == 0x0800) &&                          \
+   ((TxData)->DataLength <=                                       \
+    (MnpServiceData)->MnpDeviceData->Offload->MaxSegmentationSize))
+
 /**
   Allocate a free NET_BUF from MnpDeviceData->FreeNbufQue. If there is none
   in the queue, first try to allocate some and add them into the queue, then
@@ -465,6 +518,8 @@ MnpFreeNbuf (
   them into the queue, then fetch the NET_BUF from the updated FreeTxBufList.
 
   @param[in, out]  MnpDeviceData        Pointer to the MNP_DEVICE_DATA.
+  @param[in]       Large                Allocate a buffer of LargeBufferLength bytes
+                                        from FreeLargeTxBufList instead.
 
   @return     Pointer to the allocated free NET_BUF structure, if NULL the
               operation is failed.
@@ -472,7 +527,8 @@ MnpFreeNbuf (
 **/
 UINT8 *
 MnpAllocTxBuf (
-  IN OUT MNP_DEVICE_DATA  *MnpDeviceData
+  IN OUT MNP_DEVICE_DATA  *MnpDeviceData,
+  IN     BOOLEAN          Large
   );
 
 /**
@@ -83,9 +83,10 @@ MnpIsValidTxToken (
     return FALSE;
   }
 
-  if (TxData->DataLength > MnpServiceData->Mtu) {
+  if ((TxData->DataLength > MnpServiceData->Mtu) && !MNP_TX_DATA_IS_SEGMENTED (MnpServiceData, TxData)) {
     //
-    // The total length is larger than the MTU.
+    // The total length is larger than the MTU, and the network interface
+    // doesn't segment the packet.
     //
     DEBUG ((DEBUG_WARN, "MnpIsValidTxData: TxData->DataLength exceeds Mtu.\n"));
     return FALSE;
@@ -124,7 +125,11 @@ MnpBuildTxPacket (
 
   MnpDeviceData = MnpServiceData->MnpDeviceData;
 
-  TxBuf = MnpAllocTxBuf (MnpDeviceData);
+  //
+  // The packets longer than the MTU are those left for the network
+  // interface to segment.
+  //
+  TxBuf = MnpAllocTxBuf (MnpDeviceData, (BOOLEAN)(TxData->DataLength > MnpServiceData->Mtu));
   if (TxBuf == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
@@ -813,6 +818,135 @@ MnpEnqueuePacket (
   }
 }
 
+/**
+  Return the frame wrapped by a NET_BUF to the network interface it is
+  lent from, when the last reference of the NET_BUF is freed.
+
+  @param[in]  Arg                Pointer to the EDKII_SIMPLE_NETWORK_RX_LOAN.
+
+**/
+VOID
+EFIAPI
+MnpReturnRxLoan (
+  IN VOID  *Arg
+  )
+{
+  EDKII_SIMPLE_NETWORK_RX_LOAN  *Loan;
+
+  Loan = (EDKII_SIMPLE_NETWORK_RX_LOAN *)Arg;
+  Loan->Lender->ReturnLoan (Loan->Lender, Loan);
+}
+
+/**
+  Try to receive a packet lent by the network interface and deliver it. The
+  packet is wrapped by a NET_BUF in place and given back to the network
+  interface when the last receiver recycles it.
+
+  @param[in, out]  MnpDeviceData        Pointer to the mnp device context data.
+
+  @retval EFI_SUCCESS           A packet is received.
+  @retval EFI_NOT_READY         No packet received.
+  @retval EFI_OUT_OF_RESOURCES  The packet can't be lent, receive it through
+                                Snp instead.
+  @retval EFI_DEVICE_ERROR      An unexpected error occurs.
+
+**/
+EFI_STATUS
+MnpReceiveLoanedPacket (
+  IN OUT MNP_DEVICE_DATA  *MnpDeviceData
+  )
+{
+  EFI_STATUS                             Status;
+  EDKII_SIMPLE_NETWORK_RX_LOAN_PROTOCOL  *RxLoan;
+  EDKII_SIMPLE_NETWORK_RX_LOAN           *Loan;
+  NET_FRAGMENT                           Fragment;
+  NET_BUF                                *Nbuf;
+  UINT8                                  *BufPtr;
+  MNP_SERVICE_DATA                       *MnpServiceData;
+  BOOLEAN                                Received;
+
+  RxLoan = MnpDeviceData->RxLoan;
+  Status = RxLoan->ReceiveLoan (RxLoan, &Loan);
+  if (EFI_ERROR (Status)) {
+    DEBUG_CODE_BEGIN ();
+    if ((Status != EFI_NOT_READY) && (Status != EFI_OUT_OF_RESOURCES)) {
+      DEBUG ((DEBUG_WARN, "MnpReceiveLoanedPacket: RxLoan->ReceiveLoan() = %r.\n", Status));
+    }
+
+    DEBUG_CODE_END ();
+
+    return Status;
+  }
+
+  //
+  // Sanity check.
+  //
+  if ((Loan->HeaderSize != MnpDeviceData->Snp->Mode->MediaHeaderSize) ||
+      (Loan->BufferSize < Loan->HeaderSize) ||
+      (Loan->BufferSize > MnpDeviceData->BufferLength))
+  {
+    DEBUG (
+      (DEBUG_WARN,
+       "MnpReceiveLoanedPacket: Size error, HL:TL = %d:%d.\n",
+       Loan->HeaderSize,
+       Loan->BufferSize)
+      );
+    RxLoan->ReturnLoan (RxLoan, Loan);
+    return EFI_DEVICE_ERROR;
+  }
+
+  if ((((UINTN)Loan->Buffer + Loan->HeaderSize) & 0x3) == 0) {
+    Fragment.Bulk = Loan->Buffer;
+    Fragment.Len  = (UINT32)Loan->BufferSize;
+    Nbuf          = NetbufFromExt (&Fragment, 1, 0, 0, MnpReturnRxLoan, Loan);
+    if (Nbuf == NULL) {
+      RxLoan->ReturnLoan (RxLoan, Loan);
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    //
+    // Take the reference RxNbufCache would hold, so that the RefCnt has the
+    // same meaning as for the NET_BUFs of the buffer pool.
+    //
+    NET_GET_REF (Nbuf);
+  } else {
+    //
+    // The protocol headers following the media header must be 4-byte aligned,
+    // copy the frame into the buffer pool.
+    //
+    Nbuf = MnpAllocNbuf (MnpDeviceData);
+    if (Nbuf == NULL) {
+      RxLoan->ReturnLoan (RxLoan, Loan);
+      return EFI_DEVICE_ERROR;
+    }
+
+    BufPtr = NetbufAllocSpace (Nbuf, (UINT32)Loan->BufferSize, NET_BUF_TAIL);
+    ASSERT (BufPtr != NULL);
+    CopyMem (BufPtr, Loan->Buffer, Loan->BufferSize);
+    RxLoan->ReturnLoan (RxLoan, Loan);
+  }
+
+  //
+  // Lent packets are only received when no VLAN is configured.
+  //
+  MnpServiceData = MnpFindServiceData (MnpDeviceData, 0);
+  if (MnpServiceData != NULL) {
+    MnpEnqueuePacket (MnpServiceData, Nbuf);
+  }
+
+  //
+  // RefCnt > 2 indicates there is at least one receiver of this packet.
+  //
+  Received = (BOOLEAN)(Nbuf->RefCnt > 2);
+  MnpFreeNbuf (MnpDeviceData, Nbuf);
+
+  if (Received) {
+    MnpDeliverPacket (MnpServiceData);
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   Try to receive a packet and deliver it.
 
@@ -850,6 +984,17 @@ MnpReceivePacket (
     return EFI_NOT_STARTED;
   }
 
+  if ((MnpDeviceData->RxLoan != NULL) && (MnpDeviceData->NumberOfVlan == 0)) {
+    //
+    // Let the packet stay in the receive buffer of the network interface,
+    // unless too many packets are lent out already.
+    //
+    Status = MnpReceiveLoanedPacket (MnpDeviceData);
+    if (Status != EFI_OUT_OF_RESOURCES) {
+      return Status;
+    }
+  }
+
   if (MnpDeviceData->RxNbufCache == NULL) {
     //
     // Try to get a new buffer as there may be buffers recycled.
@@ -985,6 +1130,49 @@ EXIT:
   return Status;
 }
 
+/**
+  Receive and deliver the packets available from Snp, up to
+  MNP_RX_BATCH_SIZE of them.
+
+  @param[in, out]  MnpDeviceData        Pointer to the mnp device context data.
+  @param[out]      Count                Number of the packets received.
+
+  @retval EFI_SUCCESS           At least one packet is received.
+  @retval Others                No packet is received, the error returned by
+                                MnpReceivePacket().
+
+**/
+EFI_STATUS
+MnpReceivePackets (
+  IN OUT MNP_DEVICE_DATA  *MnpDeviceData,
+  OUT    UINTN            *Count
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Index;
+
+  Status = EFI_NOT_READY;
+  for (Index = 0; Index < MNP_RX_BATCH_SIZE; Index++) {
+    Status = MnpReceivePacket (MnpDeviceData);
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    //
+    // Dispatch the DPC queued by the NotifyFunction of rx token's events, so
+    // that the receivers can queue their next rx token before the next packet
+    // is delivered.
+    //
+    DispatchDpc ();
+  }
+
+  if (Count != NULL) {
+    *Count = Index;
+  }
+
+  return (Index > 0) ? EFI_SUCCESS : Status;
+}
+
 /**
   Remove the received packets if timeout occurs.
 
@@ -1099,6 +1287,8 @@ MnpSystemPoll (
   )
 {
   MNP_DEVICE_DATA  *MnpDeviceData;
+  UINTN            Count;
+  UINT64           PollInterval;
 
   MnpDeviceData = (MNP_DEVICE_DATA *)Context;
   NET_CHECK_SIGNATURE (MnpDeviceData, MNP_DEVICE_DATA_SIGNATURE);
@@ -1106,10 +1296,34 @@ MnpSystemPoll (
   //
   // Try to receive packets from Snp.
   //
-  MnpReceivePacket (MnpDeviceData);
+  MnpReceivePackets (MnpDeviceData, &Count);
 
   //
   // Dispatch the DPC queued by the NotifyFunction of rx token's events.
   //
   DispatchDpc ();
+
+  if ((Event == NULL) || !MnpDeviceData->EnableSystemPoll) {
+    return;
+  }
+
+  //
+  // Poll faster while packets keep arriving, such as during a download, and
+  // fall back to the normal interval once the network goes quiet.
+  //
+  PollInterval = MnpDeviceData->PollInterval;
+  if (Count != 0) {
+    MnpDeviceData->PollIdleCount = 0;
+    PollInterval                 = MNP_SYS_POLL_INTERVAL_BUSY;
+  } else if (MnpDeviceData->PollIdleCount < MNP_SYS_POLL_IDLE_LIMIT) {
+    MnpDeviceData->PollIdleCount++;
+  } else {
+    PollInterval = MNP_SYS_POLL_INTERVAL;
+  }
+
+  if ((PollInterval != MnpDeviceData->PollInterval) &&
+      !EFI_ERROR (gBS->SetTimer (MnpDeviceData->PollTimer, TimerPeriodic, PollInterval)))
+  {
+    MnpDeviceData->PollInterval = PollInterval;
+  }
 }
@@ -71,22 +71,23 @@ Mtftp4CleanOperation (
 
   Instance->Operation = 0;
 
-  Instance->BlkSize       = MTFTP4_DEFAULT_BLKSIZE;
-  Instance->WindowSize    = 1;
-  Instance->TotalBlock    = 0;
-  Instance->AckedBlock    = 0;
-  Instance->LastBlock     = 0;
-  Instance->ServerIp      = 0;
-  Instance->ListeningPort = 0;
-  Instance->ConnectedPort = 0;
-  Instance->Gateway       = 0;
-  Instance->PacketToLive  = 0;
-  Instance->MaxRetry      = 0;
-  Instance->CurRetry      = 0;
-  Instance->Timeout       = 0;
-  Instance->McastIp       = 0;
-  Instance->McastPort     = 0;
-  Instance->Master        = TRUE;
+  Instance->BlkSize         = MTFTP4_DEFAULT_BLKSIZE;
+  Instance->WindowSize      = 1;
+  Instance->TotalBlock      = 0;
+  Instance->AckedBlock      = 0;
+  Instance->WindowRestarted = FALSE;
+  Instance->LastBlock       = 0;
+  Instance->ServerIp        = 0;
+  Instance->ListeningPort   = 0;
+  Instance->ConnectedPort   = 0;
+  Instance->Gateway         = 0;
+  Instance->PacketToLive    = 0;
+  Instance->MaxRetry        = 0;
+  Instance->CurRetry        = 0;
+  Instance->Timeout         = 0;
+  Instance->McastIp         = 0;
+  Instance->McastPort       = 0;
+  Instance->Master          = TRUE;
 }
 
 /**
@@ -126,6 +126,12 @@ struct _MTFTP4_PROTOCOL {
   //
   UINT64                    AckedBlock;
 
+  //
+  // TRUE if an ACK has been sent to restart the current window after
+  // an out of order block. The rest of the window is dropped silently.
+  //
+  BOOLEAN                   WindowRestarted;
+
   //
   // The server's communication end point: IP and two ports. one for
   // initial request, one for its selected port.
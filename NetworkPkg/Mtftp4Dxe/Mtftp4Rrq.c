@@ -264,6 +264,18 @@ Mtftp4RrqHandleData (
   // expected one. If we are passive (Slave), save the block.
   //
   if (Instance->Master && (Expected != BlockNum)) {
+    //
+    // With a window larger than one, the rest of the window following a
+    // lost block also arrives out of order. Restart the window only once
+    // (RFC7440 section 4), otherwise every such block makes the server
+    // send the whole window again. A lost ACK is recovered by the timer.
+    //
+    if ((Instance->WindowSize > 1) && Instance->WindowRestarted) {
+      return EFI_SUCCESS;
+    }
+
+    Instance->WindowRestarted = TRUE;
+
     //
     // If Expected is 0, (UINT16) (Expected - 1) is also the expected Ack number (65535).
     //
@@ -276,6 +288,8 @@ Mtftp4RrqHandleData (
     return Status;
   }
 
+  Instance->WindowRestarted = FALSE;
+
   //
   // Record the total received and saved block number.
   //
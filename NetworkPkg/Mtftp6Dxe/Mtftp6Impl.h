@@ -86,6 +86,12 @@ struct _MTFTP6_INSTANCE {
   //
   UINT64                    AckedBlock;
 
+  //
+  // TRUE if an ACK has been sent to restart the current window after
+  // an out of order block. The rest of the window is dropped silently.
+  //
+  BOOLEAN                   WindowRestarted;
+
   EFI_IPv6_ADDRESS          ServerIp;
   UINT16                    ServerCmdPort;
   UINT16                    ServerDataPort;
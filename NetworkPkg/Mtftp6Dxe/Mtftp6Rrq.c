@@ -234,6 +234,18 @@ Mtftp6RrqHandleData (
   // expected one. If we are passive (Slave), save the block.
   //
   if (Instance->IsMaster && (Expected != BlockNum)) {
+    //
+    // With a window larger than one, the rest of the window following a
+    // lost block also arrives out of order. Restart the window only once
+    // (RFC7440 section 4), otherwise every such block makes the server
+    // send the whole window again. A lost ACK is recovered by the timer.
+    //
+    if ((Instance->WindowSize > 1) && Instance->WindowRestarted) {
+      return EFI_SUCCESS;
+    }
+
+    Instance->WindowRestarted = TRUE;
+
     //
     // Free the received packet before send new packet in ReceiveNotify,
     // since the udpio might need to be reconfigured.
@@ -253,6 +265,8 @@ Mtftp6RrqHandleData (
     return Status;
   }
 
+  Instance->WindowRestarted = FALSE;
+
   //
   // Record the total received and saved block number.
   //
@@ -337,7 +351,7 @@ Mtftp6RrqOackValid (
   // return the timeout matches that requested.
   //
   if ((((ReplyInfo->BitMap & MTFTP6_OPT_BLKSIZE_BIT) != 0) && (ReplyInfo->BlkSize > RequestInfo->BlkSize)) ||
-      (((ReplyInfo->BitMap & MTFTP6_OPT_WINDOWSIZE_BIT) != 0) && (ReplyInfo->BlkSize > RequestInfo->BlkSize)) ||
+      (((ReplyInfo->BitMap & MTFTP6_OPT_WINDOWSIZE_BIT) != 0) && (ReplyInfo->WindowSize > RequestInfo->WindowSize)) ||
       (((ReplyInfo->BitMap & MTFTP6_OPT_TIMEOUT_BIT) != 0) && (ReplyInfo->Timeout != RequestInfo->Timeout))
       )
   {
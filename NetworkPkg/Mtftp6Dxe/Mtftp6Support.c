@@ -950,20 +950,21 @@ Mtftp6OperationClean (
   ZeroMem (&Instance->ServerIp, sizeof (EFI_IPv6_ADDRESS));
   ZeroMem (&Instance->McastIp, sizeof (EFI_IPv6_ADDRESS));
 
-  Instance->ServerCmdPort  = 0;
-  Instance->ServerDataPort = 0;
-  Instance->McastPort      = 0;
-  Instance->BlkSize        = 0;
-  Instance->Operation      = 0;
-  Instance->WindowSize     = 1;
-  Instance->TotalBlock     = 0;
-  Instance->AckedBlock     = 0;
-  Instance->LastBlk        = 0;
-  Instance->PacketToLive   = 0;
-  Instance->MaxRetry       = 0;
-  Instance->CurRetry       = 0;
-  Instance->Timeout        = 0;
-  Instance->IsMaster       = TRUE;
+  Instance->ServerCmdPort   = 0;
+  Instance->ServerDataPort  = 0;
+  Instance->McastPort       = 0;
+  Instance->BlkSize         = 0;
+  Instance->Operation       = 0;
+  Instance->WindowSize      = 1;
+  Instance->TotalBlock      = 0;
+  Instance->AckedBlock      = 0;
+  Instance->WindowRestarted = FALSE;
+  Instance->LastBlk         = 0;
+  Instance->PacketToLive    = 0;
+  Instance->MaxRetry        = 0;
+  Instance->CurRetry        = 0;
+  Instance->Timeout         = 0;
+  Instance->IsMaster        = TRUE;
 }
 
 /**
@@ -0,0 +1,150 @@
+/** @file
+  Tests for the TCP checksum left to the network interface by the checksum
+  offload, and for its completion in software by NetbufCompleteChecksum.
+
+  Copyright (c) 2026, agent <agent@local>. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+#include <gtest/gtest.h>
+
+extern "C" {
+  #include <Uefi.h>
+  #include <Library/BaseLib.h>
+  #include <Library/BaseMemoryLib.h>
+  #include <Library/NetLib.h>
+}
+
+#define TCP_CHECKSUM_FIELD  OFFSET_OF (TCP_HEAD, Checksum)
+
+////////////////////////////////////////////////////////////////////////
+// TCP Checksum Offload Tests
+////////////////////////////////////////////////////////////////////////
+
+VOID
+EFIAPI
+TcpChecksumTestFree (
+  IN VOID  *Arg
+  )
+{
+}
+
+class TcpChecksumOffloadTest : public ::testing::Test {
+protected:
+  UINT8 Segment[1500];
+  UINT16 HeadSum;
+
+  virtual void
+  SetUp (
+    )
+  {
+    UINT32  Seed;
+    UINTN   Index;
+
+    Seed = 0x2468ACE1;
+    for (Index = 0; Index < sizeof (Segment); Index++) {
+      Seed           = Seed * 1103515245 + 12345;
+      Segment[Index] = (UINT8)(Seed >> 16);
+    }
+
+    //
+    // 192.168.1.10 to 10.0.2.2, as TcpInitTcbLocal() computes it.
+    //
+    HeadSum = NetPseudoHeadChecksum (HTONL (0xC0A8010A), HTONL (0x0A000202), EFI_IP_PROTO_TCP, 0);
+  }
+
+  //
+  // The checksum computed by TcpChecksum() when no offload is used.
+  //
+  UINT16
+  FullChecksum (
+    UINT32  Len
+    )
+  {
+    UINT16  Checksum;
+
+    WriteUnaligned16 ((UINT16 *)&Segment[TCP_CHECKSUM_FIELD], 0);
+    Checksum = NetblockChecksum (Segment, Len);
+    Checksum = NetAddChecksum (Checksum, HeadSum);
+    Checksum = NetAddChecksum (Checksum, HTONS ((UINT16)Len));
+    return (UINT16)~Checksum;
+  }
+
+  //
+  // The checksum field left by TcpTransmitSegment() with the offload.
+  //
+  UINT16
+  PseudoSum (
+    UINT32  Len
+    )
+  {
+    return NetAddChecksum (HeadSum, HTONS ((UINT16)Len));
+  }
+};
+
+TEST_F (TcpChecksumOffloadTest, InterfaceCompletesPseudoSum) {
+  UINT32  Len;
+  UINT16  Expected;
+
+  for (Len = sizeof (TCP_HEAD); Len <= sizeof (Segment); Len += 37) {
+    Expected = FullChecksum (Len);
+
+    //
+    // The interface sums the segment from the TCP header on and stores
+    // the complement in the checksum field.
+    //
+    WriteUnaligned16 ((UINT16 *)&Segment[TCP_CHECKSUM_FIELD], PseudoSum (Len));
+    ASSERT_EQ ((UINT16)~NetblockChecksum (Segment, Len), Expected) << "Len " << Len;
+  }
+}
+
+TEST_F (TcpChecksumOffloadTest, FallbackCompletesPseudoSum) {
+  NET_FRAGMENT  Fragment[3];
+  NET_BUF       *Nbuf;
+  UINT32        Len;
+  UINT32        Split;
+  UINT16        Expected;
+
+  Len      = 1001;
+  Expected = FullChecksum (Len);
+
+  //
+  // Split the segment at odd offsets, including one inside the checksum
+  // field.
+  //
+  for (Split = 1; Split < sizeof (TCP_HEAD) + 2; Split += 2) {
+    WriteUnaligned16 ((UINT16 *)&Segment[TCP_CHECKSUM_FIELD], PseudoSum (Len));
+
+    Fragment[0].Bulk = Segment;
+    Fragment[0].Len  = Split;
+    Fragment[1].Bulk = Segment + Split;
+    Fragment[1].Len  = 301;
+    Fragment[2].Bulk = Segment + Split + 301;
+    Fragment[2].Len  = Len - Split - 301;
+
+    Nbuf = NetbufFromExt (Fragment, 3, 0, 0, TcpChecksumTestFree, NULL);
+    ASSERT_NE (Nbuf, (NET_BUF *)NULL);
+
+    EXPECT_TRUE (NetbufCompleteChecksum (Nbuf, TCP_CHECKSUM_FIELD, PseudoSum (Len)));
+    EXPECT_EQ (ReadUnaligned16 ((UINT16 *)&Segment[TCP_CHECKSUM_FIELD]), Expected) << "Split " << Split;
+    NetbufFree (Nbuf);
+  }
+}
+
+TEST_F (TcpChecksumOffloadTest, FallbackLeavesCompleteChecksum) {
+  NET_FRAGMENT  Fragment;
+  NET_BUF       *Nbuf;
+  UINT16        Expected;
+
+  Expected = FullChecksum (sizeof (Segment));
+  WriteUnaligned16 ((UINT16 *)&Segment[TCP_CHECKSUM_FIELD], Expected);
+  ASSERT_NE (Expected, PseudoSum (sizeof (Segment)));
+
+  Fragment.Bulk = Segment;
+  Fragment.Len  = sizeof (Segment);
+  Nbuf          = NetbufFromExt (&Fragment, 1, 0, 0, TcpChecksumTestFree, NULL);
+  ASSERT_NE (Nbuf, (NET_BUF *)NULL);
+
+  EXPECT_FALSE (NetbufCompleteChecksum (Nbuf, TCP_CHECKSUM_FIELD, PseudoSum (sizeof (Segment))));
+  EXPECT_EQ (ReadUnaligned16 ((UINT16 *)&Segment[TCP_CHECKSUM_FIELD]), Expected);
+  NetbufFree (Nbuf);
+}
@@ -0,0 +1,252 @@
+/** @file
+  Tests for the SACK option parsing in TcpOption.c and the SACK
+  scoreboard in TcpSack.c.
+
+  Copyright (c) 2026, agent <agent@local>. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+#include <gtest/gtest.h>
+
+extern "C" {
+  #include <Uefi.h>
+  #include <Library/BaseLib.h>
+  #include <Library/BaseMemoryLib.h>
+  #include <Library/DebugLib.h>
+  #include "../TcpMain.h"
+}
+
+////////////////////////////////////////////////////////////////////////
+// Symbol Definitions
+// These functions are not directly under test - but required to compile
+////////////////////////////////////////////////////////////////////////
+UINT32     mTcpTick;
+TCP_SEQNO  mRetransmitSeq;
+UINTN      mRetransmitCount;
+
+INTN
+TcpRetransmit (
+  IN TCP_CB     *Tcb,
+  IN TCP_SEQNO  Seq
+  )
+{
+  mRetransmitSeq = Seq;
+  mRetransmitCount++;
+  return 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+// TcpParseOption Tests
+////////////////////////////////////////////////////////////////////////
+
+class TcpParseSackOptionTest : public ::testing::Test {
+protected:
+  UINT8 Buffer[sizeof (TCP_HEAD) + TCP_OPTION_MAX_LEN];
+  TCP_HEAD *Head;
+  TCP_OPTION Option;
+
+  virtual void
+  SetUp (
+    )
+  {
+    ZeroMem (Buffer, sizeof (Buffer));
+    Head = (TCP_HEAD *)Buffer;
+  }
+
+  UINT8 *
+  SetOptionLength (
+    UINT8  Length
+    )
+  {
+    Head->HeadLen = (UINT8)((sizeof (TCP_HEAD) + Length) >> 2);
+    return (UINT8 *)(Head + 1);
+  }
+};
+
+TEST_F (TcpParseSackOptionTest, SackPermittedIsParsed) {
+  UINT8  *Opt;
+
+  Opt    = SetOptionLength (TCP_OPTION_SACK_PERM_ALIGNED_LEN);
+  Opt[0] = TCP_OPTION_NOP;
+  Opt[1] = TCP_OPTION_NOP;
+  Opt[2] = TCP_OPTION_SACK_PERM;
+  Opt[3] = TCP_OPTION_SACK_PERM_LEN;
+
+  ASSERT_EQ (TcpParseOption (Head, &Option), 0);
+  EXPECT_TRUE (TCP_FLG_ON (Option.Flag, TCP_OPTION_RCVD_SACK_PERM));
+  EXPECT_FALSE (TCP_FLG_ON (Option.Flag, TCP_OPTION_RCVD_SACK));
+}
+
+TEST_F (TcpParseSackOptionTest, SackBlocksAreParsed) {
+  UINT8  *Opt;
+
+  Opt    = SetOptionLength (TCP_OPTION_SACK_ALIGNED_LEN (2));
+  Opt[0] = TCP_OPTION_NOP;
+  Opt[1] = TCP_OPTION_NOP;
+  Opt[2] = TCP_OPTION_SACK;
+  Opt[3] = 2 + 2 * TCP_OPTION_SACK_BLOCK_LEN;
+  WriteUnaligned32 ((UINT32 *)&Opt[4], HTONL (1000));
+  WriteUnaligned32 ((UINT32 *)&Opt[8], HTONL (2000));
+  WriteUnaligned32 ((UINT32 *)&Opt[12], HTONL (3000));
+  WriteUnaligned32 ((UINT32 *)&Opt[16], HTONL (4000));
+
+  ASSERT_EQ (TcpParseOption (Head, &Option), 0);
+  ASSERT_TRUE (TCP_FLG_ON (Option.Flag, TCP_OPTION_RCVD_SACK));
+  ASSERT_EQ (Option.SackNum, 2);
+  EXPECT_EQ (Option.Sack[0].Left, 1000u);
+  EXPECT_EQ (Option.Sack[0].Right, 2000u);
+  EXPECT_EQ (Option.Sack[1].Left, 3000u);
+  EXPECT_EQ (Option.Sack[1].Right, 4000u);
+}
+
+TEST_F (TcpParseSackOptionTest, MalformedSackLengthIsRejected) {
+  UINT8  *Opt;
+
+  Opt    = SetOptionLength (TCP_OPTION_SACK_ALIGNED_LEN (1));
+  Opt[0] = TCP_OPTION_NOP;
+  Opt[1] = TCP_OPTION_NOP;
+  Opt[2] = TCP_OPTION_SACK;
+  Opt[3] = 2 + TCP_OPTION_SACK_BLOCK_LEN - 1;
+
+  EXPECT_EQ (TcpParseOption (Head, &Option), -1);
+}
+
+TEST_F (TcpParseSackOptionTest, TruncatedSackIsRejected) {
+  UINT8  *Opt;
+
+  Opt    = SetOptionLength (TCP_OPTION_SACK_ALIGNED_LEN (1));
+  Opt[0] = TCP_OPTION_NOP;
+  Opt[1] = TCP_OPTION_NOP;
+  Opt[2] = TCP_OPTION_SACK;
+  Opt[3] = 2 + 2 * TCP_OPTION_SACK_BLOCK_LEN;
+
+  EXPECT_EQ (TcpParseOption (Head, &Option), -1);
+}
+
+////////////////////////////////////////////////////////////////////////
+// SACK scoreboard Tests
+////////////////////////////////////////////////////////////////////////
+
+class TcpSackScoreboardTest : public ::testing::Test {
+protected:
+  TCP_CB Tcb;
+  TCP_OPTION Option;
+
+  virtual void
+  SetUp (
+    )
+  {
+    ZeroMem (&Tcb, sizeof (Tcb));
+    ZeroMem (&Option, sizeof (Option));
+    Tcb.SndUna       = 1000;
+    Tcb.SndNxt       = 11000;
+    Tcb.SndMss       = 1000;
+    mRetransmitCount = 0;
+  }
+
+  VOID
+  AddSack (
+    TCP_SEQNO  Left,
+    TCP_SEQNO  Right
+    )
+  {
+    Option.SackNum       = 1;
+    Option.Sack[0].Left  = Left;
+    Option.Sack[0].Right = Right;
+    TcpSackUpdate (&Tcb, &Option);
+  }
+};
+
+TEST_F (TcpSackScoreboardTest, RangesAreSortedAndMerged) {
+  AddSack (5000, 6000);
+  AddSack (2000, 3000);
+  AddSack (8000, 9000);
+  ASSERT_EQ (Tcb.SackNum, 3);
+  EXPECT_EQ (Tcb.SackBlock[0].Left, 2000u);
+  EXPECT_EQ (Tcb.SackBlock[1].Left, 5000u);
+  EXPECT_EQ (Tcb.SackBlock[2].Left, 8000u);
+
+  //
+  // Bridge the first two ranges.
+  //
+  AddSack (3000, 5000);
+  ASSERT_EQ (Tcb.SackNum, 2);
+  EXPECT_EQ (Tcb.SackBlock[0].Left, 2000u);
+  EXPECT_EQ (Tcb.SackBlock[0].Right, 6000u);
+  EXPECT_EQ (Tcb.SackBlock[1].Left, 8000u);
+  EXPECT_EQ (Tcb.SackBlock[1].Right, 9000u);
+}
+
+TEST_F (TcpSackScoreboardTest, InvalidBlocksAreIgnored) {
+  //
+  // D-SACK, beyond SND.NXT and malformed blocks.
+  //
+  AddSack (500, 1000);
+  AddSack (10000, 12000);
+  AddSack (4000, 3000);
+  EXPECT_EQ (Tcb.SackNum, 0);
+
+  //
+  // A block straddling SND.UNA is clamped.
+  //
+  AddSack (500, 2000);
+  ASSERT_EQ (Tcb.SackNum, 1);
+  EXPECT_EQ (Tcb.SackBlock[0].Left, 1000u);
+}
+
+TEST_F (TcpSackScoreboardTest, FullScoreboardKeepsLowestRanges) {
+  UINT32  Index;
+
+  for (Index = 0; Index < TCP_SACK_SCOREBOARD_SIZE; Index++) {
+    AddSack (2000 + Index * 1000, 2500 + Index * 1000);
+  }
+
+  ASSERT_EQ (Tcb.SackNum, TCP_SACK_SCOREBOARD_SIZE);
+
+  AddSack (1200, 1500);
+  ASSERT_EQ (Tcb.SackNum, TCP_SACK_SCOREBOARD_SIZE);
+  EXPECT_EQ (Tcb.SackBlock[0].Left, 1200u);
+  EXPECT_EQ (Tcb.SackBlock[TCP_SACK_SCOREBOARD_SIZE - 1].Left, 2000u + (TCP_SACK_SCOREBOARD_SIZE - 2) * 1000);
+}
+
+TEST_F (TcpSackScoreboardTest, CumulativeAckTrimsScoreboard) {
+  AddSack (2000, 3000);
+  AddSack (4000, 6000);
+
+  TcpSackTrim (&Tcb, 5000);
+  ASSERT_EQ (Tcb.SackNum, 1);
+  EXPECT_EQ (Tcb.SackBlock[0].Left, 5000u);
+  EXPECT_EQ (Tcb.SackBlock[0].Right, 6000u);
+
+  TcpSackTrim (&Tcb, 6000);
+  EXPECT_EQ (Tcb.SackNum, 0);
+}
+
+TEST_F (TcpSackScoreboardTest, HolesAreRetransmittedInOrder) {
+  TCP_SEQNO  Hole;
+  UINT32     Len;
+
+  AddSack (2000, 3000);
+  AddSack (5000, 6000);
+
+  ASSERT_TRUE (TcpSackNextHole (&Tcb, Tcb.SndUna, &Hole, &Len));
+  EXPECT_EQ (Hole, 1000u);
+  EXPECT_EQ (Len, 1000u);
+
+  //
+  // The first hole is retransmitted on entering the fast recovery.
+  //
+  Tcb.SackRetxmit = 2000;
+  ASSERT_TRUE (TcpSackRetransmit (&Tcb));
+  EXPECT_EQ (mRetransmitSeq, 3000u);
+  EXPECT_EQ (Tcb.SackRetxmit, 4000u);
+
+  ASSERT_TRUE (TcpSackRetransmit (&Tcb));
+  EXPECT_EQ (mRetransmitSeq, 4000u);
+  EXPECT_EQ (Tcb.SackRetxmit, 5000u);
+
+  //
+  // Nothing above the highest SACKed range is considered lost.
+  //
+  EXPECT_FALSE (TcpSackRetransmit (&Tcb));
+  EXPECT_EQ (mRetransmitCount, 2u);
+}
@@ -0,0 +1,64 @@
+/** @file
+  Congestion control algorithms of the TCP driver.
+
+  The algorithm is reached through the TCP_CONGESTION_OPS of the TCP_CB.
+  NewReno (RFC5681 and RFC6582) is the default.
+
+  Copyright (c) 2026, agent <agent@local>. All rights reserved.<BR>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "TcpMain.h"
+
+/**
+  Grow the congestion window by slow start or congestion avoidance.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Acked    The number of newly acknowledged bytes.
+
+**/
+VOID
+TcpNewRenoOnAck (
+  IN OUT TCP_CB  *Tcb,
+  IN     UINT32  Acked
+  )
+{
+  if (Tcb->CWnd < Tcb->Ssthresh) {
+    Tcb->CWnd += Tcb->SndMss;
+  } else {
+    Tcb->CWnd += MAX (Tcb->SndMss * Tcb->SndMss / Tcb->CWnd, 1);
+  }
+
+  Tcb->CWnd = MIN (Tcb->CWnd, TCP_MAX_WIN << Tcb->SndWndScale);
+}
+
+/**
+  Halve the amount of data in flight for the new slow start threshold.
+
+  @param[in]  Tcb      Pointer to the TCP_CB of this TCP instance.
+
+  @return The new slow start threshold.
+
+**/
+UINT32
+TcpNewRenoSsthresh (
+  IN TCP_CB  *Tcb
+  )
+{
+  UINT32  FlightSize;
+
+  //
+  // FlightSize is the amount of data that has been sent but not yet ACKed.
+  //
+  FlightSize = TCP_SUB_SEQ (Tcb->SndNxt, Tcb->SndUna);
+
+  return MAX (FlightSize >> 1, (UINT32)(2 * Tcb->SndMss));
+}
+
+TCP_CONGESTION_OPS  mTcpNewReno = {
+  "NewReno",
+  TcpNewRenoOnAck,
+  TcpNewRenoSsthresh
+};
@@ -352,6 +352,23 @@ TcpCreateService (
   InitializeListHead (&TcpServiceData->SocketList);
   ZeroMem (&OpenData, sizeof (IP_IO_OPEN_DATA));
 
+  //
+  // The checksum and segmentation offload is optional, it is only
+  // available if the network interface driver installs it on the same
+  // handle. A VLAN device has no such protocol installed.
+  //
+  Status = gBS->OpenProtocol (
+                  Controller,
+                  &gEdkiiSimpleNetworkOffloadProtocolGuid,
+                  (VOID **)&TcpServiceData->Offload,
+                  Image,
+                  Controller,
+                  EFI_OPEN_PROTOCOL_GET_PROTOCOL
+                  );
+  if (EFI_ERROR (Status)) {
+    TcpServiceData->Offload = NULL;
+  }
+
   if (IpVersion == IP_VERSION_4) {
     CopyMem (
       &OpenData.IpConfigData.Ip4CfgData,
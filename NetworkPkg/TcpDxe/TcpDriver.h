@@ -21,13 +21,14 @@ typedef struct _TCP_HEARTBEAT_TIMER {
 } TCP_HEARTBEAT_TIMER;
 
 typedef struct _TCP_SERVICE_DATA {
-  UINT32                          Signature;
-  EFI_HANDLE                      ControllerHandle;
-  EFI_HANDLE                      DriverBindingHandle;
-  UINT8                           IpVersion;
-  IP_IO                           *IpIo;
-  EFI_SERVICE_BINDING_PROTOCOL    ServiceBinding;
-  LIST_ENTRY                      SocketList;
+  UINT32                                   Signature;
+  EFI_HANDLE                               ControllerHandle;
+  EFI_HANDLE                               DriverBindingHandle;
+  UINT8                                    IpVersion;
+  IP_IO                                    *IpIo;
+  EFI_SERVICE_BINDING_PROTOCOL             ServiceBinding;
+  LIST_ENTRY                               SocketList;
+  EDKII_SIMPLE_NETWORK_OFFLOAD_PROTOCOL    *Offload;   ///< NULL if the interface has no offload.
 } TCP_SERVICE_DATA;
 
 typedef struct _TCP_PROTO_DATA {
@@ -583,6 +583,89 @@ TcpSetKeepaliveTimer (
   IN OUT TCP_CB  *Tcb
   );
 
+//
+// Functions in TcpSack.c
+//
+
+/**
+  Build the SACK blocks reporting the out-of-order data in the reassemble queue.
+
+  @param[in]   Tcb        Pointer to the TCP_CB of this TCP instance.
+  @param[out]  Blocks     Pointer to the buffer to store the SACK blocks.
+  @param[in]   MaxBlocks  The maximum number of SACK blocks to build.
+
+  @return The number of SACK blocks built.
+
+**/
+UINT8
+TcpSackBuildBlocks (
+  IN  TCP_CB          *Tcb,
+  OUT TCP_SACK_BLOCK  *Blocks,
+  IN  UINT8           MaxBlocks
+  );
+
+/**
+  Update the scoreboard with the SACK blocks received from the peer.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Option   Pointer to the options of the received segment.
+
+**/
+VOID
+TcpSackUpdate (
+  IN OUT TCP_CB      *Tcb,
+  IN     TCP_OPTION  *Option
+  );
+
+/**
+  Remove the ranges acknowledged by the cumulative ACK from the scoreboard.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Ack      The acknowledge sequence number of the received segment.
+
+**/
+VOID
+TcpSackTrim (
+  IN OUT TCP_CB     *Tcb,
+  IN     TCP_SEQNO  Ack
+  );
+
+/**
+  Find the first hole in the sequence space at or after From. Only the
+  holes below the highest SACKed sequence number are considered lost.
+
+  @param[in]   Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]   From     The sequence number to start the search from.
+  @param[out]  Hole     The first sequence number of the hole.
+  @param[out]  Len      The length of the hole.
+
+  @retval TRUE     A hole is found.
+  @retval FALSE    There is no hole at or after From.
+
+**/
+BOOLEAN
+TcpSackNextHole (
+  IN  TCP_CB     *Tcb,
+  IN  TCP_SEQNO  From,
+  OUT TCP_SEQNO  *Hole,
+  OUT UINT32     *Len
+  );
+
+/**
+  Retransmit the next hole which hasn't been retransmitted in the
+  current fast recovery.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+
+  @retval TRUE     A segment is retransmitted.
+  @retval FALSE    There is no hole left to retransmit.
+
+**/
+BOOLEAN
+TcpSackRetransmit (
+  IN OUT TCP_CB  *Tcb
+  );
+
 //
 // Functions in TcpIo.c
 //
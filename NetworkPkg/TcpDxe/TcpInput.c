@@ -30,7 +30,9 @@ TcpSeqAcceptable (
 }
 
 /**
-  NewReno fast recovery defined in RFC3782.
+  NewReno fast recovery defined in RFC3782. When SACK is in use,
+  the holes reported by the scoreboard are retransmitted as the
+  duplicate ACKs arrive, as suggested by RFC6675.
 
   @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
   @param[in]       Seg      Segment that triggers the fast recovery.
@@ -52,9 +54,7 @@ TcpFastRecover (
     //
     // Step 1A: Invoking fast retransmission.
     //
-    FlightSize = TCP_SUB_SEQ (Tcb->SndNxt, Tcb->SndUna);
-
-    Tcb->Ssthresh = MAX (FlightSize >> 1, (UINT32)(2 * Tcb->SndMss));
+    Tcb->Ssthresh = Tcb->CongestionOps->Ssthresh (Tcb);
     Tcb->Recover  = Tcb->SndNxt;
 
     Tcb->CongestState = TCP_CONGEST_RECOVER;
@@ -64,7 +64,8 @@ TcpFastRecover (
     // Step 2: Entering fast retransmission
     //
     TcpRetransmit (Tcb, Tcb->SndUna);
-    Tcb->CWnd = Tcb->Ssthresh + 3 * Tcb->SndMss;
+    Tcb->SackRetxmit = Tcb->SndUna + Tcb->SndMss;
+    Tcb->CWnd        = Tcb->Ssthresh + 3 * Tcb->SndMss;
 
     DEBUG (
       (DEBUG_NET,
@@ -87,7 +88,13 @@ TcpFastRecover (
     // Step 4 is skipped here only to be executed later
     // by TcpToSendData
     //
-    Tcb->CWnd += Tcb->SndMss;
+    // With SACK, the duplicated ACK clocks out the retransmission
+    // of the next hole instead, if there is any.
+    //
+    if (!TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_SND_SACK) || !TcpSackRetransmit (Tcb)) {
+      Tcb->CWnd += Tcb->SndMss;
+    }
+
     DEBUG (
       (DEBUG_NET,
        "TcpFastRecover: received another duplicated ACK (%d) for TCB %p\n",
@@ -119,9 +126,19 @@ TcpFastRecover (
       //
       // Step 5 - Partial ACK:
       // fast retransmit the first unacknowledge field
-      // , then deflate the CWnd
+      // , then deflate the CWnd. If the first unacknowledged
+      // field is already retransmitted in this recovery, go
+      // on with the next hole reported by SACK.
       //
-      TcpRetransmit (Tcb, Seg->Ack);
+      if (!TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_SND_SACK) ||
+          TCP_SEQ_GEQ (Seg->Ack, Tcb->SackRetxmit))
+      {
+        TcpRetransmit (Tcb, Seg->Ack);
+        Tcb->SackRetxmit = Seg->Ack + Tcb->SndMss;
+      } else {
+        TcpSackRetransmit (Tcb);
+      }
+
       Acked = TCP_SUB_SEQ (Seg->Ack, Tcb->SndUna);
 
       //
@@ -1186,6 +1203,12 @@ TcpInput (
   //
   // From now on: SND.UNA <= SEG.ACK <= SND.NXT.
   //
+  if (TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_SND_SACK) &&
+      TCP_FLG_ON (Option.Flag, TCP_OPTION_RCVD_SACK))
+  {
+    TcpSackUpdate (Tcb, &Option);
+  }
+
   if (TCP_FLG_ON (Option.Flag, TCP_OPTION_RCVD_TS)) {
     //
     // update TsRecent as specified in page 17 RFC7323.
@@ -1233,13 +1256,7 @@ TcpInput (
       (Tcb->CongestState == TCP_CONGEST_LOSS))
   {
     if (TCP_SEQ_GT (Seg->Ack, Tcb->SndUna)) {
-      if (Tcb->CWnd < Tcb->Ssthresh) {
-        Tcb->CWnd += Tcb->SndMss;
-      } else {
-        Tcb->CWnd += MAX (Tcb->SndMss * Tcb->SndMss / Tcb->CWnd, 1);
-      }
-
-      Tcb->CWnd = MIN (Tcb->CWnd, TCP_MAX_WIN << Tcb->SndWndScale);
+      Tcb->CongestionOps->OnAck (Tcb, TCP_SUB_SEQ (Seg->Ack, Tcb->SndUna));
     }
 
     if (Tcb->CongestState == TCP_CONGEST_LOSS) {
@@ -1261,6 +1278,7 @@ TcpInput (
     }
 
     Tcb->SndUna = Seg->Ack;
+    TcpSackTrim (Tcb, Seg->Ack);
 
     if (TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_SND_URG) &&
         TCP_SEQ_LT (Tcb->SndUp, Seg->Ack))
@@ -1477,6 +1495,8 @@ StepSix:
       goto RESET_THEN_DROP;
     }
 
+    Tcb->SackRecent = Seg->Seq;
+
     if (TcpQueueData (Tcb, Nbuf) == 0) {
       DEBUG (
         (DEBUG_ERROR,
@@ -14,6 +14,8 @@
 #include <Protocol/ServiceBinding.h>
 #include <Protocol/DriverBinding.h>
 #include <Protocol/Hash2.h>
+#include <Protocol/IpSec.h>
+#include <Protocol/SimpleNetworkOffload.h>
 #include <Library/IpIoLib.h>
 #include <Library/DevicePathLib.h>
 #include <Library/PrintLib.h>
@@ -35,6 +37,8 @@ extern LIST_ENTRY  mTcpListenQue;
 extern TCP_SEQNO   mTcpGlobalSecret;
 extern UINT32      mTcpTick;
 
+extern TCP_CONGESTION_OPS  mTcpNewReno;
+
 ///
 /// 30 seconds.
 ///
@@ -160,7 +160,10 @@ TcpInitTcbPeer (
   IN     TCP_OPTION  *Opt
   )
 {
-  UINT16  RcvMss;
+  UINT16                                 RcvMss;
+  EDKII_SIMPLE_NETWORK_OFFLOAD_PROTOCOL  *Offload;
+  VOID                                   *IpSec;
+  UINT32                                 TsoLen;
 
   ASSERT ((Tcb != NULL) && (Seg != NULL) && (Opt != NULL));
   ASSERT (TCP_FLG_ON (Seg->Flag, TCP_FLG_SYN));
@@ -221,6 +224,58 @@ TcpInitTcbPeer (
     //
     Tcb->SndMss -= TCP_OPTION_TS_ALIGNED_LEN;
   }
+
+  if (TCP_FLG_ON (Opt->Flag, TCP_OPTION_RCVD_SACK_PERM) && !TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_NO_SACK)) {
+    TCP_SET_FLG (Tcb->CtrlFlag, TCP_CTRL_SND_SACK);
+  }
+
+  Tcb->SackNum = 0;
+
+  //
+  // Leave the checksum and the segmentation of the large segments to the
+  // network interface if it is capable of doing so. Only IPv4 is offloaded:
+  // IPv6 may insert extension headers the interface doesn't look past. The
+  // IPsec transforms the TCP segment, so no offload is used if IPsec is
+  // present. The segmentation is only used if the peer's MSS isn't smaller
+  // than ours, so every segment split by the interface is a full sized
+  // segment for both ends.
+  //
+  TCP_CLEAR_FLG (Tcb->CtrlFlag, TCP_CTRL_CSUM_OFFLOAD | TCP_CTRL_TSO);
+  Tcb->SndTsoLen = Tcb->SndMss;
+
+  Offload = ((TCP_PROTO_DATA *)Tcb->Sk->ProtoReserved)->TcpService->Offload;
+  if ((Offload == NULL) ||
+      !EFI_ERROR (gBS->LocateProtocol (&gEfiIpSec2ProtocolGuid, NULL, &IpSec)))
+  {
+    return;
+  }
+
+  if ((Tcb->Sk->IpVersion != IP_VERSION_4) ||
+      ((Offload->Capabilities & EDKII_SIMPLE_NETWORK_OFFLOAD_TCP4_CSUM) == 0))
+  {
+    return;
+  }
+
+  TCP_SET_FLG (Tcb->CtrlFlag, TCP_CTRL_CSUM_OFFLOAD);
+
+  if (((Offload->Capabilities & EDKII_SIMPLE_NETWORK_OFFLOAD_TCP4_TSO) == 0) ||
+      !TCP_FLG_ON (Opt->Flag, TCP_OPTION_RCVD_MSS) ||
+      (Opt->Mss < TcpGetRcvMss (Tcb->Sk)))
+  {
+    return;
+  }
+
+  TsoLen = MIN (Offload->MaxSegmentationSize, MAX_UINT16);
+  if (TsoLen <= sizeof (IP4_HEAD) + sizeof (TCP_HEAD) + TCP_OPTION_MAX_LEN) {
+    return;
+  }
+
+  TsoLen -= sizeof (IP4_HEAD) + sizeof (TCP_HEAD) + TCP_OPTION_MAX_LEN;
+  TsoLen -= TsoLen % Tcb->SndMss;
+  if (TsoLen > Tcb->SndMss) {
+    Tcb->SndTsoLen = TsoLen;
+    TCP_SET_FLG (Tcb->CtrlFlag, TCP_CTRL_TSO);
+  }
 }
 
 /**
@@ -205,7 +205,12 @@ TcpDataToSend (
 
   Len = MIN (Win, Left);
 
-  if (Len > Tcb->SndMss) {
+  if (TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_TSO)) {
+    //
+    // The network interface splits the segment into SndMss sized ones.
+    //
+    Len = MIN (Len, Tcb->SndTsoLen);
+  } else if (Len > Tcb->SndMss) {
     Len = Tcb->SndMss;
   }
 
@@ -225,7 +230,7 @@ TcpDataToSend (
   // c)It can send everything it has, and either it isn't
   // expecting an ACK, or the Nagle algorithm is disabled.
   //
-  if ((Len == Tcb->SndMss) || (2 * Len >= Tcb->SndWndMax)) {
+  if ((Len >= Tcb->SndMss) || (2 * Len >= Tcb->SndWndMax)) {
     return Len;
   }
 
@@ -359,7 +364,15 @@ TcpTransmitSegment (
 
   Head->Flag     = Seg->Flag;
   Head->Urg      = NTOHS (Seg->Urg);
-  Head->Checksum = TcpChecksum (Nbuf, Tcb->HeadSum);
+  if (TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_CSUM_OFFLOAD)) {
+    //
+    // Leave only the sum of the pseudo header in the checksum field,
+    // the network interface completes it.
+    //
+    Head->Checksum = NetAddChecksum (Tcb->HeadSum, HTONS ((UINT16)Nbuf->TotalSize));
+  } else {
+    Head->Checksum = TcpChecksum (Nbuf, Tcb->HeadSum);
+  }
 
   //
   // Update the TCP session's control information.
@@ -945,7 +958,7 @@ TcpToSendData (
       Tcb->RttSeq     = Seq;
       Tcb->RttMeasure = 0;
     }
-  } while (Len == Tcb->SndMss);
+  } while (Len >= Tcb->SndMss);
 
   return Sent;
 
@@ -70,6 +70,10 @@
 #define TCP_CTRL_TIMER_ON      0x1000   ///< At least one of the timer is on.
 #define TCP_CTRL_RTT_ON        0x2000   ///< The RTT measurement is on.
 #define TCP_CTRL_ACK_NOW       0x4000   ///< Send the ACK now, don't delay.
+#define TCP_CTRL_NO_SACK       0x8000   ///< Disable selective acknowledgment.
+#define TCP_CTRL_SND_SACK      0x10000  ///< Selective acknowledgment is permitted by both ends.
+#define TCP_CTRL_CSUM_OFFLOAD  0x20000  ///< The checksum is computed by the network interface.
+#define TCP_CTRL_TSO           0x40000  ///< Segments up to SndTsoLen are split by the network interface.
 
 //
 // Timer related values
@@ -204,6 +208,19 @@
 
 #define TCP_MAX_WIN  0xFFFFU
 
+//
+// The number of SACKed ranges kept in the scoreboard of the sender.
+//
+#define TCP_SACK_SCOREBOARD_SIZE  8
+
+///
+/// A range of sequence numbers reported by a SACK option, Right is exclusive.
+///
+typedef struct _TCP_SACK_BLOCK {
+  TCP_SEQNO    Left;  ///< The first sequence number of the block.
+  TCP_SEQNO    Right; ///< The sequence number following the last byte of the block.
+} TCP_SACK_BLOCK;
+
 ///
 /// TCP segmentation data.
 ///
@@ -226,6 +243,47 @@ typedef struct _TCP_PEER {
 
 typedef struct _TCP_CONTROL_BLOCK TCP_CB;
 
+/**
+  Grow the congestion window when new data is acknowledged outside of the
+  fast recovery.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Acked    The number of newly acknowledged bytes.
+
+**/
+typedef
+VOID
+(*TCP_CONGESTION_ON_ACK) (
+  IN OUT TCP_CB  *Tcb,
+  IN     UINT32  Acked
+  );
+
+/**
+  Compute the slow start threshold after a loss is detected, either by
+  duplicate ACKs or by the retransmission timeout.
+
+  @param[in]  Tcb      Pointer to the TCP_CB of this TCP instance.
+
+  @return The new slow start threshold.
+
+**/
+typedef
+UINT32
+(*TCP_CONGESTION_SSTHRESH) (
+  IN TCP_CB  *Tcb
+  );
+
+///
+/// Congestion control algorithm. The loss detection and the fast
+/// retransmission and recovery stay in TcpInput.c and TcpTimer.c,
+/// the algorithm decides how the congestion window grows and shrinks.
+///
+typedef struct _TCP_CONGESTION_OPS {
+  CONST CHAR8                *Name;
+  TCP_CONGESTION_ON_ACK      OnAck;
+  TCP_CONGESTION_SSTHRESH    Ssthresh;
+} TCP_CONGESTION_OPS;
+
 ///
 /// TCP control block: it includes various states.
 ///
@@ -261,6 +319,7 @@ struct _TCP_CONTROL_BLOCK {
   TCP_SEQNO           SndWl1;    ///< Seq number used for last window update.
   TCP_SEQNO           SndWl2;    ///< Ack no of last window update.
   UINT16              SndMss;    ///< Max send segment size.
+  UINT32              SndTsoLen; ///< Max data length segmented by the interface.
   TCP_SEQNO           RcvNxt;    ///< Next sequence no to receive.
   UINT32              RcvWnd;    ///< Window advertised by the local peer.
   TCP_SEQNO           RcvWl2;    ///< The RcvNxt (or ACK) of last window update.
@@ -298,13 +357,22 @@ struct _TCP_CONTROL_BLOCK {
   // RFC2581, and 3782 variables.
   // Congestion control + NewReno fast recovery.
   //
-  UINT32              CWnd;         ///< Sender's congestion window.
-  UINT32              Ssthresh;     ///< Slow start threshold.
-  TCP_SEQNO           Recover;      ///< Recover point for NewReno.
-  UINT16              DupAck;       ///< Number of duplicate ACKs.
-  UINT8               CongestState; ///< The current congestion state(RFC3782).
-  UINT8               LossTimes;    ///< Number of retxmit timeouts in a row.
-  TCP_SEQNO           LossRecover;  ///< Recover point for retxmit.
+  UINT32              CWnd;          ///< Sender's congestion window.
+  UINT32              Ssthresh;      ///< Slow start threshold.
+  TCP_SEQNO           Recover;       ///< Recover point for NewReno.
+  UINT16              DupAck;        ///< Number of duplicate ACKs.
+  UINT8               CongestState;  ///< The current congestion state(RFC3782).
+  UINT8               LossTimes;     ///< Number of retxmit timeouts in a row.
+  TCP_SEQNO           LossRecover;   ///< Recover point for retxmit.
+  TCP_CONGESTION_OPS  *CongestionOps; ///< The congestion control algorithm.
+
+  //
+  // RFC2018 and RFC6675 variables, about selective acknowledgment.
+  //
+  UINT8               SackNum;                             ///< Number of ranges in SackBlock.
+  TCP_SACK_BLOCK      SackBlock[TCP_SACK_SCOREBOARD_SIZE]; ///< SACKed ranges above SndUna, sorted and disjoint.
+  TCP_SEQNO           SackRetxmit;                         ///< Sequence following the last retransmitted hole.
+  TCP_SEQNO           SackRecent;                          ///< Seq of the most recently received segment.
 
   //
   // RFC7323
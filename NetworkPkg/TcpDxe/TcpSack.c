@@ -0,0 +1,311 @@
+/** @file
+  Selective acknowledgment (RFC2018) and the SACK based loss recovery
+  (RFC6675) routines.
+
+  The receiver reports the out-of-order data in its reassemble queue to the
+  peer. The sender keeps the SACKed ranges reported by the peer in a small
+  scoreboard, so that the fast recovery retransmits the holes in the
+  sequence space instead of one segment per round trip.
+
+  Copyright (c) 2026, agent <agent@local>. All rights reserved.<BR>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "TcpMain.h"
+
+/**
+  Build the SACK blocks reporting the out-of-order data in the reassemble queue.
+
+  @param[in]   Tcb        Pointer to the TCP_CB of this TCP instance.
+  @param[out]  Blocks     Pointer to the buffer to store the SACK blocks.
+  @param[in]   MaxBlocks  The maximum number of SACK blocks to build.
+
+  @return The number of SACK blocks built.
+
+**/
+UINT8
+TcpSackBuildBlocks (
+  IN  TCP_CB          *Tcb,
+  OUT TCP_SACK_BLOCK  *Blocks,
+  IN  UINT8           MaxBlocks
+  )
+{
+  LIST_ENTRY      *Entry;
+  TCP_SEG         *Seg;
+  TCP_SACK_BLOCK  Block;
+  BOOLEAN         Recent;
+  UINT8           Num;
+  UINTN           Pass;
+
+  Num = 0;
+
+  //
+  // The first block must report the most recently received segment,
+  // the rest of the blocks are reported in sequence order.
+  //
+  for (Pass = 0; Pass < 2; Pass++) {
+    Entry = Tcb->RcvQue.ForwardLink;
+
+    while ((Entry != &Tcb->RcvQue) && (Num < MaxBlocks)) {
+      Seg         = TCPSEG_NETBUF (NET_LIST_USER_STRUCT (Entry, NET_BUF, List));
+      Block.Left  = Seg->Seq;
+      Block.Right = Seg->End;
+      Entry       = Entry->ForwardLink;
+
+      //
+      // Merge the adjacent segments into one block.
+      //
+      while (Entry != &Tcb->RcvQue) {
+        Seg = TCPSEG_NETBUF (NET_LIST_USER_STRUCT (Entry, NET_BUF, List));
+        if (Seg->Seq != Block.Right) {
+          break;
+        }
+
+        Block.Right = Seg->End;
+        Entry       = Entry->ForwardLink;
+      }
+
+      if (TCP_SEQ_LEQ (Block.Right, Tcb->RcvNxt)) {
+        continue;
+      }
+
+      Recent = (BOOLEAN)(TCP_SEQ_LEQ (Block.Left, Tcb->SackRecent) &&
+                         TCP_SEQ_LT (Tcb->SackRecent, Block.Right));
+      if (Recent == (BOOLEAN)(Pass == 0)) {
+        Blocks[Num++] = Block;
+      }
+    }
+  }
+
+  return Num;
+}
+
+/**
+  Insert a SACKed range into the scoreboard, merging it with the
+  overlapping and adjacent ranges.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Left     The first SACKed sequence number.
+  @param[in]       Right    The sequence number following the SACKed range.
+
+**/
+VOID
+TcpSackInsert (
+  IN OUT TCP_CB     *Tcb,
+  IN     TCP_SEQNO  Left,
+  IN     TCP_SEQNO  Right
+  )
+{
+  UINT8  Index;
+  UINT8  Last;
+  UINT8  Merged;
+
+  Index = 0;
+  while ((Index < Tcb->SackNum) && TCP_SEQ_LT (Tcb->SackBlock[Index].Right, Left)) {
+    Index++;
+  }
+
+  Last = Index;
+  while ((Last < Tcb->SackNum) && TCP_SEQ_LEQ (Tcb->SackBlock[Last].Left, Right)) {
+    if (TCP_SEQ_LT (Tcb->SackBlock[Last].Left, Left)) {
+      Left = Tcb->SackBlock[Last].Left;
+    }
+
+    if (TCP_SEQ_GT (Tcb->SackBlock[Last].Right, Right)) {
+      Right = Tcb->SackBlock[Last].Right;
+    }
+
+    Last++;
+  }
+
+  Merged = (UINT8)(Last - Index);
+  if (Merged == 0) {
+    //
+    // A new range. If the scoreboard is full, forget the highest
+    // range, the lower ones matter more to the recovery.
+    //
+    if (Tcb->SackNum == TCP_SACK_SCOREBOARD_SIZE) {
+      if (Index == Tcb->SackNum) {
+        return;
+      }
+
+      Tcb->SackNum--;
+    }
+
+    CopyMem (
+      &Tcb->SackBlock[Index + 1],
+      &Tcb->SackBlock[Index],
+      (Tcb->SackNum - Index) * sizeof (TCP_SACK_BLOCK)
+      );
+    Tcb->SackNum++;
+  } else if (Merged > 1) {
+    CopyMem (
+      &Tcb->SackBlock[Index + 1],
+      &Tcb->SackBlock[Last],
+      (Tcb->SackNum - Last) * sizeof (TCP_SACK_BLOCK)
+      );
+    Tcb->SackNum = (UINT8)(Tcb->SackNum - (Merged - 1));
+  }
+
+  Tcb->SackBlock[Index].Left  = Left;
+  Tcb->SackBlock[Index].Right = Right;
+}
+
+/**
+  Update the scoreboard with the SACK blocks received from the peer.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Option   Pointer to the options of the received segment.
+
+**/
+VOID
+TcpSackUpdate (
+  IN OUT TCP_CB      *Tcb,
+  IN     TCP_OPTION  *Option
+  )
+{
+  UINT8      Index;
+  TCP_SEQNO  Left;
+  TCP_SEQNO  Right;
+
+  for (Index = 0; Index < Option->SackNum; Index++) {
+    Left  = Option->Sack[Index].Left;
+    Right = Option->Sack[Index].Right;
+
+    //
+    // Ignore the malformed blocks, the blocks beyond the data sent and
+    // the blocks reporting data already acknowledged (D-SACK).
+    //
+    if (TCP_SEQ_GEQ (Left, Right) ||
+        TCP_SEQ_LEQ (Right, Tcb->SndUna) ||
+        TCP_SEQ_GT (Right, Tcb->SndNxt))
+    {
+      continue;
+    }
+
+    if (TCP_SEQ_LT (Left, Tcb->SndUna)) {
+      Left = Tcb->SndUna;
+    }
+
+    TcpSackInsert (Tcb, Left, Right);
+  }
+}
+
+/**
+  Remove the ranges acknowledged by the cumulative ACK from the scoreboard.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Ack      The acknowledge sequence number of the received segment.
+
+**/
+VOID
+TcpSackTrim (
+  IN OUT TCP_CB     *Tcb,
+  IN     TCP_SEQNO  Ack
+  )
+{
+  UINT8  Index;
+
+  Index = 0;
+  while ((Index < Tcb->SackNum) && TCP_SEQ_LEQ (Tcb->SackBlock[Index].Right, Ack)) {
+    Index++;
+  }
+
+  if (Index != 0) {
+    CopyMem (
+      &Tcb->SackBlock[0],
+      &Tcb->SackBlock[Index],
+      (Tcb->SackNum - Index) * sizeof (TCP_SACK_BLOCK)
+      );
+    Tcb->SackNum = (UINT8)(Tcb->SackNum - Index);
+  }
+
+  if ((Tcb->SackNum != 0) && TCP_SEQ_LT (Tcb->SackBlock[0].Left, Ack)) {
+    Tcb->SackBlock[0].Left = Ack;
+  }
+}
+
+/**
+  Find the first hole in the sequence space at or after From. Only the
+  holes below the highest SACKed sequence number are considered lost.
+
+  @param[in]   Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]   From     The sequence number to start the search from.
+  @param[out]  Hole     The first sequence number of the hole.
+  @param[out]  Len      The length of the hole.
+
+  @retval TRUE     A hole is found.
+  @retval FALSE    There is no hole at or after From.
+
+**/
+BOOLEAN
+TcpSackNextHole (
+  IN  TCP_CB     *Tcb,
+  IN  TCP_SEQNO  From,
+  OUT TCP_SEQNO  *Hole,
+  OUT UINT32     *Len
+  )
+{
+  UINT8  Index;
+
+  for (Index = 0; Index < Tcb->SackNum; Index++) {
+    if (TCP_SEQ_LT (From, Tcb->SackBlock[Index].Left)) {
+      *Hole = From;
+      *Len  = TCP_SUB_SEQ (Tcb->SackBlock[Index].Left, From);
+      return TRUE;
+    }
+
+    if (TCP_SEQ_LT (From, Tcb->SackBlock[Index].Right)) {
+      From = Tcb->SackBlock[Index].Right;
+    }
+  }
+
+  return FALSE;
+}
+
+/**
+  Retransmit the next hole which hasn't been retransmitted in the
+  current fast recovery.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+
+  @retval TRUE     A segment is retransmitted.
+  @retval FALSE    There is no hole left to retransmit.
+
+**/
+BOOLEAN
+TcpSackRetransmit (
+  IN OUT TCP_CB  *Tcb
+  )
+{
+  TCP_SEQNO  From;
+  TCP_SEQNO  Hole;
+  UINT32     Len;
+
+  From = Tcb->SndUna;
+  if (TCP_SEQ_GT (Tcb->SackRetxmit, From)) {
+    From = Tcb->SackRetxmit;
+  }
+
+  if (!TcpSackNextHole (Tcb, From, &Hole, &Len)) {
+    return FALSE;
+  }
+
+  if (TcpRetransmit (Tcb, Hole) != 0) {
+    return FALSE;
+  }
+
+  Tcb->SackRetxmit = Hole + MIN (Len, Tcb->SndMss);
+
+  DEBUG (
+    (DEBUG_NET,
+     "TcpSackRetransmit: retransmit hole %d (%d bytes) for TCB %p\n",
+     Hole,
+     Len,
+     Tcb)
+    );
+
+  return TRUE;
+}
@@ -60,15 +60,25 @@ TlsConfigurationSetData (
   switch (DataType) {
     case EfiTlsConfigDataTypeCACertificate:
       Status = TlsSetCaCertificate (Instance->TlsConn, Data, DataSize);
+      if (!EFI_ERROR (Status)) {
+        TlsUpdateTrustDigest (Instance, Data, DataSize);
+      }
+
       break;
     case EfiTlsConfigDataTypeHostPublicCert:
-      Status = TlsSetHostPublicCert (Instance->TlsConn, Data, DataSize);
+      Status                   = TlsSetHostPublicCert (Instance->TlsConn, Data, DataSize);
+      Instance->NoSessionCache = TRUE;
       break;
     case EfiTlsConfigDataTypeHostPrivateKey:
-      Status = TlsSetHostPrivateKey (Instance->TlsConn, Data, DataSize);
+      Status                   = TlsSetHostPrivateKey (Instance->TlsConn, Data, DataSize);
+      Instance->NoSessionCache = TRUE;
       break;
     case EfiTlsConfigDataTypeCertRevocationList:
       Status = TlsSetCertRevocationList (Data, DataSize);
+      if (!EFI_ERROR (Status)) {
+        TlsUpdateTrustDigest (Instance, Data, DataSize);
+      }
+
       break;
     default:
       Status = EFI_UNSUPPORTED;
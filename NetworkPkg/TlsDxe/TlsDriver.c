@@ -30,6 +30,10 @@ TlsCleanInstance (
       TlsFree (Instance->TlsConn);
     }
 
+    if (Instance->HostName != NULL) {
+      FreePool (Instance->HostName);
+    }
+
     FreePool (Instance);
   }
 }
@@ -86,6 +90,8 @@ TlsCleanService (
   )
 {
   if (Service != NULL) {
+    TlsFreeSessionCache (Service);
+
     if (Service->TlsCtx != NULL) {
       TlsCtxFree (Service->TlsCtx);
     }
@@ -483,6 +489,16 @@ TlsServiceBindingDestroyChild (
   RemoveEntryList (&TlsInstance->Link);
   TlsService->TlsChildrenNum--;
 
+  //
+  // With TLS 1.3 the session ticket arrives after the handshake, so cache the
+  // session again now that the connection is done with.
+  //
+  if ((TlsInstance->TlsSessionState == EfiTlsSessionDataTransferring) ||
+      (TlsInstance->TlsSessionState == EfiTlsSessionClosing))
+  {
+    TlsCacheSession (TlsInstance);
+  }
+
   gBS->RestoreTPL (OldTpl);
 
   TlsCleanInstance (TlsInstance);
@@ -26,6 +26,11 @@
 
 #define TLS_INSTANCE_SIGNATURE  SIGNATURE_32 ('T', 'L', 'S', 'I')
 
+//
+// The number of client sessions kept for resumption.
+//
+#define TLS_SESSION_CACHE_SIZE  8
+
 ///
 /// TLS Service Data
 ///
@@ -36,6 +41,19 @@ typedef struct _TLS_SERVICE TLS_SERVICE;
 ///
 typedef struct _TLS_INSTANCE TLS_INSTANCE;
 
+///
+/// A client session kept for resumption. A session is resumed only by a
+/// connection to the same server which verifies the server the same way.
+///
+typedef struct {
+  CHAR8                 *HostName;
+  EFI_TLS_VERIFY        VerifyMethod;
+  UINT8                 TrustDigest[SHA256_DIGEST_SIZE];
+  EFI_TLS_SESSION_ID    SessionId;
+  VOID                  *Session;
+  UINT64                LastUsed;
+} TLS_SESSION_CACHE_ENTRY;
+
 struct _TLS_SERVICE {
   UINT32                          Signature;
   EFI_SERVICE_BINDING_PROTOCOL    ServiceBinding;
@@ -55,6 +73,13 @@ struct _TLS_SERVICE {
   // created for the connections.
   //
   VOID                            *TlsCtx;
+
+  //
+  // Client sessions of the connections, to be resumed by the later
+  // connections to the same servers.
+  //
+  TLS_SESSION_CACHE_ENTRY         SessionCache[TLS_SESSION_CACHE_SIZE];
+  UINT64                          SessionCacheTick;
 };
 
 struct _TLS_INSTANCE {
@@ -76,6 +101,17 @@ struct _TLS_INSTANCE {
   // per established connection.
   //
   VOID                              *TlsConn;
+
+  //
+  // The server name set by EfiTlsVerifyHost, the digest of the CA
+  // certificates and revocation lists set by the configuration protocol.
+  // They tell which cached sessions the connection may resume. A connection
+  // which authenticates with a client certificate uses no cached session.
+  //
+  CHAR8                             *HostName;
+  UINT8                             TrustDigest[SHA256_DIGEST_SIZE];
+  BOOLEAN                           NoSessionCache;
+  BOOLEAN                           SessionIdSet;
 };
 
 #define TLS_SERVICE_FROM_THIS(a)   \
@@ -348,3 +348,239 @@ ERROR:
 
   return Status;
 }
+
+/**
+  Fold the trust anchor or revocation data set on the TLS instance into the
+  digest which tells the cached sessions it may resume.
+
+  @param[in, out]  TlsInstance    The pointer to the TLS instance.
+  @param[in]       Data           The data set by the configuration protocol.
+  @param[in]       DataSize       The size of Data in bytes.
+
+**/
+VOID
+TlsUpdateTrustDigest (
+  IN OUT TLS_INSTANCE  *TlsInstance,
+  IN     CONST VOID    *Data,
+  IN     UINTN         DataSize
+  )
+{
+  UINT8  *Buffer;
+
+  //
+  // Digest = SHA256 (Digest || Data), so that every certificate set counts.
+  // If the digest can't be updated, don't use the session cache at all.
+  //
+  Buffer = AllocatePool (SHA256_DIGEST_SIZE + DataSize);
+  if (Buffer != NULL) {
+    CopyMem (Buffer, TlsInstance->TrustDigest, SHA256_DIGEST_SIZE);
+    CopyMem (Buffer + SHA256_DIGEST_SIZE, Data, DataSize);
+    if (Sha256HashAll (Buffer, SHA256_DIGEST_SIZE + DataSize, TlsInstance->TrustDigest)) {
+      FreePool (Buffer);
+      return;
+    }
+
+    FreePool (Buffer);
+  }
+
+  TlsInstance->NoSessionCache = TRUE;
+}
+
+/**
+  Check whether a cache entry holds a session the TLS instance may resume.
+
+  @param[in]  TlsInstance         The pointer to the TLS instance.
+  @param[in]  Entry               The cache entry.
+  @param[in]  VerifyMethod        The verify method of the TLS instance.
+
+  @retval TRUE     The session was established with the same server and the
+                   same verification.
+  @retval FALSE    Otherwise.
+
+**/
+STATIC
+BOOLEAN
+TlsSessionCacheMatch (
+  IN TLS_INSTANCE             *TlsInstance,
+  IN TLS_SESSION_CACHE_ENTRY  *Entry,
+  IN EFI_TLS_VERIFY           VerifyMethod
+  )
+{
+  return (BOOLEAN)((Entry->Session != NULL) &&
+                   (Entry->VerifyMethod == VerifyMethod) &&
+                   (AsciiStriCmp (Entry->HostName, TlsInstance->HostName) == 0) &&
+                   (CompareMem (Entry->TrustDigest, TlsInstance->TrustDigest, SHA256_DIGEST_SIZE) == 0));
+}
+
+/**
+  Check whether the sessions of the TLS instance can be cached and resumed:
+  it must be a client which knows the server name and authenticates itself
+  with no certificate.
+
+  @param[in]  TlsInstance         The pointer to the TLS instance.
+
+  @retval TRUE     The sessions can be cached.
+  @retval FALSE    The sessions can't be cached.
+
+**/
+STATIC
+BOOLEAN
+TlsSessionCacheable (
+  IN TLS_INSTANCE  *TlsInstance
+  )
+{
+  return (BOOLEAN)((TlsInstance->HostName != NULL) &&
+                   !TlsInstance->NoSessionCache &&
+                   (TlsGetConnectionEnd (TlsInstance->TlsConn) == EfiTlsClient));
+}
+
+/**
+  Keep the session of an established client connection in the session cache
+  of the TLS service, so that a later connection to the same server can
+  resume it.
+
+  @param[in]  TlsInstance         The pointer to the TLS instance.
+
+**/
+VOID
+TlsCacheSession (
+  IN TLS_INSTANCE  *TlsInstance
+  )
+{
+  TLS_SERVICE              *Service;
+  TLS_SESSION_CACHE_ENTRY  *Entry;
+  EFI_TLS_VERIFY           VerifyMethod;
+  VOID                     *Session;
+  CHAR8                    *HostName;
+  UINTN                    Index;
+
+  if (!TlsSessionCacheable (TlsInstance)) {
+    return;
+  }
+
+  if (EFI_ERROR (TlsGetSession (TlsInstance->TlsConn, &Session))) {
+    return;
+  }
+
+  Service      = TlsInstance->Service;
+  VerifyMethod = TlsGetVerify (TlsInstance->TlsConn);
+
+  //
+  // Replace the session to the same server, or else the least recently used one.
+  //
+  Entry = &Service->SessionCache[0];
+  for (Index = 0; Index < TLS_SESSION_CACHE_SIZE; Index++) {
+    if (TlsSessionCacheMatch (TlsInstance, &Service->SessionCache[Index], VerifyMethod)) {
+      Entry = &Service->SessionCache[Index];
+      break;
+    }
+
+    if ((Entry->Session != NULL) &&
+        ((Service->SessionCache[Index].Session == NULL) ||
+         (Service->SessionCache[Index].LastUsed < Entry->LastUsed)))
+    {
+      Entry = &Service->SessionCache[Index];
+    }
+  }
+
+  HostName = AllocateCopyPool (AsciiStrSize (TlsInstance->HostName), TlsInstance->HostName);
+  if (HostName == NULL) {
+    TlsFreeSession (Session);
+    return;
+  }
+
+  if (Entry->Session != NULL) {
+    TlsFreeSession (Entry->Session);
+    FreePool (Entry->HostName);
+  }
+
+  ZeroMem (Entry, sizeof (TLS_SESSION_CACHE_ENTRY));
+  Entry->HostName     = HostName;
+  Entry->VerifyMethod = VerifyMethod;
+  Entry->Session      = Session;
+  Entry->LastUsed     = ++Service->SessionCacheTick;
+  CopyMem (Entry->TrustDigest, TlsInstance->TrustDigest, SHA256_DIGEST_SIZE);
+  if (EFI_ERROR (TlsGetSessionId (TlsInstance->TlsConn, Entry->SessionId.Data, &Entry->SessionId.Length))) {
+    Entry->SessionId.Length = 0;
+  }
+}
+
+/**
+  Find a cached session the TLS instance may resume.
+
+  @param[in]  TlsInstance         The pointer to the TLS instance.
+  @param[in]  SessionId           The ID of the session to find. NULL to find the
+                                  most recent session to the server.
+
+  @return The cached session, or NULL if none is found. The session stays owned
+          by the cache.
+
+**/
+VOID *
+TlsFindCachedSession (
+  IN TLS_INSTANCE              *TlsInstance,
+  IN CONST EFI_TLS_SESSION_ID  *SessionId OPTIONAL
+  )
+{
+  TLS_SERVICE              *Service;
+  TLS_SESSION_CACHE_ENTRY  *Entry;
+  TLS_SESSION_CACHE_ENTRY  *Found;
+  EFI_TLS_VERIFY           VerifyMethod;
+  UINTN                    Index;
+
+  if (!TlsSessionCacheable (TlsInstance)) {
+    return NULL;
+  }
+
+  Service      = TlsInstance->Service;
+  VerifyMethod = TlsGetVerify (TlsInstance->TlsConn);
+  Found        = NULL;
+
+  for (Index = 0; Index < TLS_SESSION_CACHE_SIZE; Index++) {
+    Entry = &Service->SessionCache[Index];
+    if (!TlsSessionCacheMatch (TlsInstance, Entry, VerifyMethod)) {
+      continue;
+    }
+
+    if ((SessionId != NULL) &&
+        ((Entry->SessionId.Length != SessionId->Length) ||
+         (CompareMem (Entry->SessionId.Data, SessionId->Data, SessionId->Length) != 0)))
+    {
+      continue;
+    }
+
+    if ((Found == NULL) || (Entry->LastUsed > Found->LastUsed)) {
+      Found = Entry;
+    }
+  }
+
+  if (Found == NULL) {
+    return NULL;
+  }
+
+  Found->LastUsed = ++Service->SessionCacheTick;
+  return Found->Session;
+}
+
+/**
+  Release all the sessions in the session cache of the TLS service.
+
+  @param[in]  Service             The TLS service data.
+
+**/
+VOID
+TlsFreeSessionCache (
+  IN TLS_SERVICE  *Service
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < TLS_SESSION_CACHE_SIZE; Index++) {
+    if (Service->SessionCache[Index].Session != NULL) {
+      TlsFreeSession (Service->SessionCache[Index].Session);
+      FreePool (Service->SessionCache[Index].HostName);
+    }
+  }
+
+  ZeroMem (Service->SessionCache, sizeof (Service->SessionCache));
+}
@@ -86,6 +86,63 @@ TlsDecryptPacket (
   IN     UINT32                 *FragmentCount
   );
 
+/**
+  Fold the trust anchor or revocation data set on the TLS instance into the
+  digest which tells the cached sessions it may resume.
+
+  @param[in, out]  TlsInstance    The pointer to the TLS instance.
+  @param[in]       Data           The data set by the configuration protocol.
+  @param[in]       DataSize       The size of Data in bytes.
+
+**/
+VOID
+TlsUpdateTrustDigest (
+  IN OUT TLS_INSTANCE  *TlsInstance,
+  IN     CONST VOID    *Data,
+  IN     UINTN         DataSize
+  );
+
+/**
+  Keep the session of an established client connection in the session cache
+  of the TLS service, so that a later connection to the same server can
+  resume it.
+
+  @param[in]  TlsInstance         The pointer to the TLS instance.
+
+**/
+VOID
+TlsCacheSession (
+  IN TLS_INSTANCE  *TlsInstance
+  );
+
+/**
+  Find a cached session the TLS instance may resume.
+
+  @param[in]  TlsInstance         The pointer to the TLS instance.
+  @param[in]  SessionId           The ID of the session to find. NULL to find the
+                                  most recent session to the server.
+
+  @return The cached session, or NULL if none is found. The session stays owned
+          by the cache.
+
+**/
+VOID *
+TlsFindCachedSession (
+  IN TLS_INSTANCE              *TlsInstance,
+  IN CONST EFI_TLS_SESSION_ID  *SessionId OPTIONAL
+  );
+
+/**
+  Release all the sessions in the session cache of the TLS service.
+
+  @param[in]  Service             The TLS service data.
+
+**/
+VOID
+TlsFreeSessionCache (
+  IN TLS_SERVICE  *Service
+  );
+
 /**
   Set TLS session data.
 
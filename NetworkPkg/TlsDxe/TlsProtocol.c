@@ -60,6 +60,7 @@ TlsSetSessionData (
   EFI_TLS_VERIFY             VerifyMethod;
   UINTN                      VerifyMethodSize;
   UINTN                      Index;
+  VOID                       *Session;
 
   EFI_TPL  OldTpl;
 
@@ -187,7 +188,18 @@ TlsSetSessionData (
       }
 
       Status = TlsSetVerifyHost (Instance->TlsConn, TlsVerifyHost->Flags, TlsVerifyHost->HostName);
+      if (EFI_ERROR (Status)) {
+        goto ON_EXIT;
+      }
 
+      //
+      // The server name keys the sessions kept for resumption.
+      //
+      if (Instance->HostName != NULL) {
+        FreePool (Instance->HostName);
+      }
+
+      Instance->HostName = AllocateCopyPool (AsciiStrSize (TlsVerifyHost->HostName), TlsVerifyHost->HostName);
       break;
     case EfiTlsSessionID:
       if (DataSize != sizeof (EFI_TLS_SESSION_ID)) {
@@ -195,11 +207,25 @@ TlsSetSessionData (
         goto ON_EXIT;
       }
 
-      Status = TlsSetSessionId (
-                 Instance->TlsConn,
-                 ((EFI_TLS_SESSION_ID *)Data)->Data,
-                 ((EFI_TLS_SESSION_ID *)Data)->Length
-                 );
+      //
+      // Resume the session with this ID if it is cached for the server,
+      // otherwise only offer the ID to the server.
+      //
+      Session = TlsFindCachedSession (Instance, (EFI_TLS_SESSION_ID *)Data);
+      if (Session != NULL) {
+        Status = TlsSetSession (Instance->TlsConn, Session);
+      } else {
+        Status = TlsSetSessionId (
+                   Instance->TlsConn,
+                   ((EFI_TLS_SESSION_ID *)Data)->Data,
+                   ((EFI_TLS_SESSION_ID *)Data)->Length
+                   );
+      }
+
+      if (!EFI_ERROR (Status)) {
+        Instance->SessionIdSet = TRUE;
+      }
+
       break;
     case EfiTlsSessionState:
       if (DataSize != sizeof (EFI_TLS_SESSION_STATE)) {
@@ -466,6 +492,7 @@ TlsBuildResponsePacket (
   EFI_STATUS    Status;
   TLS_INSTANCE  *Instance;
   EFI_TPL       OldTpl;
+  VOID          *Session;
 
   Status = EFI_SUCCESS;
 
@@ -484,6 +511,17 @@ TlsBuildResponsePacket (
   if ((RequestBuffer == NULL) && (RequestSize == 0)) {
     switch (Instance->TlsSessionState) {
       case EfiTlsSessionNotStarted:
+        //
+        // Resume the most recent session to the server, unless the caller
+        // has chosen the session to resume.
+        //
+        if (!Instance->SessionIdSet) {
+          Session = TlsFindCachedSession (Instance, NULL);
+          if (Session != NULL) {
+            TlsSetSession (Instance->TlsConn, Session);
+          }
+        }
+
         //
         // ClientHello.
         //
@@ -575,6 +613,7 @@ TlsBuildResponsePacket (
 
       if (!TlsInHandshake (Instance->TlsConn)) {
         Instance->TlsSessionState = EfiTlsSessionDataTransferring;
+        TlsCacheSession (Instance);
       }
     } else {
       //
@@ -908,6 +908,23 @@ PxeBcDiscoverBootFile (
   Type  = EFI_PXE_BASE_CODE_BOOT_TYPE_BOOTSTRAP;
   Layer = EFI_PXE_BASE_CODE_BOOT_LAYER_INITIAL;
 
+  //
+  // Race the DHCPv4 discovery on all the interfaces, unless this one already
+  // took part in a race. A loss is used for one boot attempt, a win is kept
+  // until PxeBcDhcp4EndRace() is called at the end of the boot attempt.
+  //
+  if (!Mode->UsingIpv6 && PcdGetBool (PcdNetworkBootRaceDiscovery)) {
+    if (Private->RaceState == PxeBcRaceNone) {
+      PxeBcDhcp4Race (Private);
+    }
+
+    if (Private->RaceState == PxeBcRaceLost) {
+      Private->RaceState = PxeBcRaceNone;
+      AsciiPrint ("\n  Another interface answered first, or no boot server answered.\n");
+      return EFI_NO_RESPONSE;
+    }
+  }
+
   //
   // Start D.O.R.A/S.A.R.R exchange to acquire station ip address and
   // other pxe boot information.
@@ -1643,6 +1643,185 @@ PxeBcSetIp4Policy (
   return EFI_SUCCESS;
 }
 
+/**
+  Check a DHCPOFFER received by the DHCPv4 discovery run on a network interface
+  during the race.
+
+  @param[in]  Context           Pointer to the PXEBC_DHCP4_PROBE of the interface.
+  @param[in]  Packet            The DHCPOFFER packet received.
+
+  @retval TRUE                  The offer names a boot server.
+  @retval FALSE                 Wait for more DHCPOFFER packets.
+
+**/
+BOOLEAN
+EFIAPI
+PxeBcDhcp4ProbeOffer (
+  IN VOID              *Context,
+  IN EFI_DHCP4_PACKET  *Packet
+  )
+{
+  PXEBC_DHCP4_PROBE  *Probe;
+
+  Probe = (PXEBC_DHCP4_PROBE *)Context;
+
+  if ((Packet->Length > PXEBC_DHCP4_PACKET_MAX_SIZE) ||
+      EFI_ERROR (PxeBcCacheDhcp4Packet (&Probe->Cache.Packet.Offer, Packet)) ||
+      EFI_ERROR (PxeBcParseDhcp4Packet (&Probe->Cache)))
+  {
+    return FALSE;
+  }
+
+  //
+  // A pure DHCPv4 offer is only usable if it names a boot file.
+  //
+  return (BOOLEAN)((Probe->Cache.OfferType != PxeOfferTypeDhcpOnly) ||
+                   (Probe->Cache.OptList[PXEBC_DHCP4_TAG_INDEX_BOOTFILE] != NULL));
+}
+
+/**
+  Race the DHCPv4 discovery on all the network interfaces managed by this driver
+  which have not taken part in a race yet, and record the winner and the losers
+  in their RaceState.
+
+  @param[in]  Private           Pointer to PxeBc private data of the interface
+                                asked to boot.
+
+**/
+VOID
+PxeBcDhcp4Race (
+  IN PXEBC_PRIVATE_DATA  *Private
+  )
+{
+  EFI_STATUS          Status;
+  EFI_HANDLE          *Handles;
+  UINTN               HandleCount;
+  UINTN               Index;
+  UINT32              *Id;
+  PXEBC_PRIVATE_DATA  *Candidate;
+  NET_DHCP4_PROBE     *Probes;
+  PXEBC_DHCP4_PROBE   *Contexts;
+  PXEBC_DHCP4_PROBE   *Context;
+  UINTN               ProbeCount;
+  UINTN               Winner;
+
+  Status = gBS->LocateHandleBuffer (ByProtocol, &gEfiCallerIdGuid, NULL, &HandleCount, &Handles);
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  Probes   = AllocateZeroPool (HandleCount * sizeof (NET_DHCP4_PROBE));
+  Contexts = AllocateZeroPool (HandleCount * sizeof (PXEBC_DHCP4_PROBE));
+  if ((Probes == NULL) || (Contexts == NULL)) {
+    goto ON_EXIT;
+  }
+
+  //
+  // Set up a discovery on every idle interface.
+  //
+  ProbeCount = 0;
+  for (Index = 0; Index < HandleCount; Index++) {
+    Status = gBS->HandleProtocol (Handles[Index], &gEfiCallerIdGuid, (VOID **)&Id);
+    if (EFI_ERROR (Status)) {
+      continue;
+    }
+
+    Candidate = PXEBC_PRIVATE_DATA_FROM_ID (Id);
+    if ((Candidate->Ip4Nic == NULL) || (Candidate->Dhcp4 == NULL) ||
+        (Candidate->RaceState != PxeBcRaceNone) ||
+        ((Candidate != Private) && Candidate->Mode.Started))
+    {
+      continue;
+    }
+
+    Context                          = &Contexts[ProbeCount];
+    Context->Private                 = Candidate;
+    Context->Cache.Packet.Offer.Size = PXEBC_CACHED_DHCP4_PACKET_MAX_SIZE;
+
+    Probes[ProbeCount].Dhcp4            = Candidate->Dhcp4;
+    Probes[ProbeCount].OptionCount      = PxeBcBuildDhcp4Options (Candidate, Context->OptList, Context->Buffer, FALSE);
+    Probes[ProbeCount].OptionList       = Context->OptList;
+    Probes[ProbeCount].DiscoverTryCount = PXEBC_DHCP_RETRIES;
+    Probes[ProbeCount].DiscoverTimeout  = mPxeDhcpTimeout;
+    Probes[ProbeCount].CheckOffer       = PxeBcDhcp4ProbeOffer;
+    Probes[ProbeCount].Context          = Context;
+    ProbeCount++;
+  }
+
+  Winner = NetLibDhcp4Race (Probes, ProbeCount);
+
+  //
+  // An interface whose discovery could not be started keeps no outcome.
+  //
+  for (Index = 0; Index < ProbeCount; Index++) {
+    if (!EFI_ERROR (Probes[Index].Status)) {
+      Contexts[Index].Private->RaceState = (Index == Winner) ? PxeBcRaceWon : PxeBcRaceLost;
+    }
+  }
+
+ON_EXIT:
+  if (Probes != NULL) {
+    FreePool (Probes);
+  }
+
+  if (Contexts != NULL) {
+    FreePool (Contexts);
+  }
+
+  FreePool (Handles);
+}
+
+/**
+  End the part of a network interface in the race when its boot attempt is over.
+  If the interface won the race but failed to boot, the interfaces which lost to
+  it run their own DHCPv4 discovery on their next boot attempt.
+
+  @param[in]  Private           Pointer to PxeBc private data.
+  @param[in]  Failed            TRUE if the boot attempt failed.
+
+**/
+VOID
+PxeBcDhcp4EndRace (
+  IN PXEBC_PRIVATE_DATA  *Private,
+  IN BOOLEAN             Failed
+  )
+{
+  EFI_STATUS          Status;
+  EFI_HANDLE          *Handles;
+  UINTN               HandleCount;
+  UINTN               Index;
+  UINT32              *Id;
+  PXEBC_PRIVATE_DATA  *Candidate;
+
+  if (Private->RaceState != PxeBcRaceWon) {
+    return;
+  }
+
+  Private->RaceState = PxeBcRaceNone;
+  if (!Failed) {
+    return;
+  }
+
+  Status = gBS->LocateHandleBuffer (ByProtocol, &gEfiCallerIdGuid, NULL, &HandleCount, &Handles);
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  for (Index = 0; Index < HandleCount; Index++) {
+    Status = gBS->HandleProtocol (Handles[Index], &gEfiCallerIdGuid, (VOID **)&Id);
+    if (EFI_ERROR (Status)) {
+      continue;
+    }
+
+    Candidate = PXEBC_PRIVATE_DATA_FROM_ID (Id);
+    if (Candidate->RaceState == PxeBcRaceLost) {
+      Candidate->RaceState = PxeBcRaceNone;
+    }
+  }
+
+  FreePool (Handles);
+}
+
 /**
   Start the D.O.R.A DHCPv4 process to acquire the IPv4 address and other PXE boot information.
 
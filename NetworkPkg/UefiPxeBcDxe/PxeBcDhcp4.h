@@ -270,6 +270,26 @@ typedef struct {
   PXEBC_VENDOR_OPTION        VendorOpt;
 } PXEBC_DHCP4_PACKET_CACHE;
 
+//
+// The outcome of the racing DHCPv4 discovery for a network interface, when
+// PcdNetworkBootRaceDiscovery is TRUE.
+//
+typedef enum {
+  PxeBcRaceNone,
+  PxeBcRaceWon,
+  PxeBcRaceLost
+} PXEBC_RACE_STATE;
+
+//
+// The context of the DHCPv4 discovery run on a network interface during the race.
+//
+typedef struct {
+  PXEBC_PRIVATE_DATA          *Private;
+  EFI_DHCP4_PACKET_OPTION     *OptList[PXEBC_DHCP4_OPTION_MAX_NUM];
+  UINT8                       Buffer[PXEBC_DHCP4_OPTION_MAX_SIZE];
+  PXEBC_DHCP4_PACKET_CACHE    Cache;
+} PXEBC_DHCP4_PROBE;
+
 /**
   Create a template DHCPv4 packet as a seed.
 
@@ -297,6 +317,35 @@ PxeBcParseDhcp4Packet (
   IN PXEBC_DHCP4_PACKET_CACHE  *Cache4
   );
 
+/**
+  Race the DHCPv4 discovery on all the network interfaces managed by this driver
+  which have not taken part in a race yet, and record the winner and the losers
+  in their RaceState.
+
+  @param[in]  Private           Pointer to PxeBc private data of the interface
+                                asked to boot.
+
+**/
+VOID
+PxeBcDhcp4Race (
+  IN PXEBC_PRIVATE_DATA  *Private
+  );
+
+/**
+  End the part of a network interface in the race when its boot attempt is over.
+  If the interface won the race but failed to boot, the interfaces which lost to
+  it run their own DHCPv4 discovery on their next boot attempt.
+
+  @param[in]  Private           Pointer to PxeBc private data.
+  @param[in]  Failed            TRUE if the boot attempt failed.
+
+**/
+VOID
+PxeBcDhcp4EndRace (
+  IN PXEBC_PRIVATE_DATA  *Private,
+  IN BOOLEAN             Failed
+  );
+
 /**
   Build and send out the request packet for the bootfile, and parse the reply.
 
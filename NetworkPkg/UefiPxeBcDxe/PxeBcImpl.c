@@ -2421,6 +2421,7 @@ EfiPxeLoadFile (
     //   3. unsupported.
     //
     PxeBc->Stop (PxeBc);
+    PxeBcDhcp4EndRace (Private, TRUE);
   } else {
     //
     // The DHCP4 can have only one configured child instance so we need to stop
@@ -2431,6 +2432,10 @@ EfiPxeLoadFile (
       Private->Dhcp4->Stop (Private->Dhcp4);
       Private->Dhcp4->Configure (Private->Dhcp4, NULL);
     }
+
+    if (Status == EFI_SUCCESS) {
+      PxeBcDhcp4EndRace (Private, FALSE);
+    }
   }
 
   return Status;
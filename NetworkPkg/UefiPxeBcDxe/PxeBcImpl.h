@@ -164,6 +164,7 @@ struct _PXEBC_PRIVATE_DATA {
   BOOLEAN                                      IsOfferSorted;
   BOOLEAN                                      IsProxyRecved;
   BOOLEAN                                      IsDoDiscover;
+  PXEBC_RACE_STATE                             RaceState;
 
   EFI_IP_ADDRESS                               TmpStationIp;
   EFI_IP_ADDRESS                               StationIp;
@@ -6,6 +6,8 @@
   SPDX-License-Identifier: BSD-2-Clause-Patent
 **/
 
+#include <Library/BaseLib.h> // MultU64x32()
+
 #include "VirtioFsDxe.h"
 
 /**
@@ -26,6 +28,10 @@
   @param[out] FuseAttr     The VIRTIO_FS_FUSE_ATTRIBUTES_RESPONSE object
                            describing the properties of the inode.
 
+  @param[out] AttrValid    The period, in nanoseconds, for which the device
+                           permits caching FuseAttr. Not set if AttrValid is
+                           NULL.
+
   @retval EFI_SUCCESS  FuseAttr has been filled in.
 
   @return              The "errno" value mapped to an EFI_STATUS code, if the
@@ -39,7 +45,8 @@ EFI_STATUS
 VirtioFsFuseGetAttr (
   IN OUT VIRTIO_FS                        *VirtioFs,
   IN     UINT64                           NodeId,
-  OUT VIRTIO_FS_FUSE_ATTRIBUTES_RESPONSE  *FuseAttr
+  OUT VIRTIO_FS_FUSE_ATTRIBUTES_RESPONSE  *FuseAttr,
+  OUT UINT64                              *AttrValid OPTIONAL
   )
 {
   VIRTIO_FS_FUSE_REQUEST           CommonReq;
@@ -124,5 +131,17 @@ VirtioFsFuseGetAttr (
     Status = VirtioFsErrnoToEfiStatus (CommonResp.Error);
   }
 
+  if (!EFI_ERROR (Status) && (AttrValid != NULL)) {
+    //
+    // Saturate the validity period rather than overflowing it.
+    //
+    if (GetAttrResp.AttrValid >= DivU64x32 (MAX_UINT64, 1000000000)) {
+      *AttrValid = MAX_UINT64;
+    } else {
+      *AttrValid = MultU64x32 (GetAttrResp.AttrValid, 1000000000) +
+                   GetAttrResp.AttrValidNsec;
+    }
+  }
+
   return Status;
 }
@@ -25,7 +25,8 @@
                            "VirtioFs->RequestId" is set to 1 on output. The
                            maximum write buffer size exposed in the FUSE_INIT
                            response is saved in "VirtioFs->MaxWrite", on
-                           output.
+                           output. The negotiated read-ahead size is saved in
+                           "VirtioFs->MaxReadahead", on output.
 
   @retval EFI_SUCCESS      The FUSE session has been started.
 
@@ -105,7 +106,7 @@ VirtioFsFuseInitSession (
   //
   InitReq.Major        = VIRTIO_FS_FUSE_MAJOR;
   InitReq.Minor        = VIRTIO_FS_FUSE_MINOR;
-  InitReq.MaxReadahead = 0;
+  InitReq.MaxReadahead = VIRTIO_FS_MAX_READAHEAD;
   InitReq.Flags        = VIRTIO_FS_FUSE_INIT_REQ_F_DO_READDIRPLUS;
 
   //
@@ -150,5 +151,11 @@ VirtioFsFuseInitSession (
   // Save the maximum write buffer size for FUSE_WRITE requests.
   //
   VirtioFs->MaxWrite = InitResp.MaxWrite;
+
+  //
+  // Save the read-ahead size for the per-file read-ahead buffers. Zero
+  // disables read-ahead.
+  //
+  VirtioFs->MaxReadahead = MIN (InitResp.MaxReadahead, VIRTIO_FS_MAX_READAHEAD);
   return EFI_SUCCESS;
 }
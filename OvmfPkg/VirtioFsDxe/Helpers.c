@@ -10,6 +10,7 @@
 #include <Library/BaseMemoryLib.h>       // CopyMem()
 #include <Library/MemoryAllocationLib.h> // AllocatePool()
 #include <Library/TimeBaseLib.h>         // EpochToEfiTime()
+#include <Library/TimerLib.h>            // GetPerformanceCounter()
 #include <Library/VirtioLib.h>           // Virtio10WriteFeatures()
 
 #include "VirtioFsDxe.h"
@@ -2523,3 +2524,150 @@ VirtioFsGetFuseModeUpdate (
   *Update = TRUE;
   return EFI_SUCCESS;
 }
+
+/**
+  Return the performance counter ticks elapsed between two readings of the
+  counter, allowing for the counter to roll over in between.
+
+  The counter may be narrow (the ACPI PM timer counts 24 bits only), so the
+  result is correct only if less than one full period of the counter elapsed.
+
+  @param[in] Begin  The earlier counter value.
+
+  @param[in] End    The later counter value.
+
+  @return  The number of ticks from Begin to End.
+**/
+STATIC
+UINT64
+VirtioFsElapsedTicks (
+  IN UINT64  Begin,
+  IN UINT64  End
+  )
+{
+  UINT64  StartValue;
+  UINT64  EndValue;
+
+  GetPerformanceCounterProperties (&StartValue, &EndValue);
+  if (StartValue > EndValue) {
+    //
+    // The counter counts down.
+    //
+    if (Begin >= End) {
+      return Begin - End;
+    }
+
+    return (Begin - EndValue) + (StartValue - End) + 1;
+  }
+
+  if (End >= Begin) {
+    return End - Begin;
+  }
+
+  return (EndValue - Begin) + (End - StartValue) + 1;
+}
+
+/**
+  Fetch the attributes of the inode that an open file refers to, serving them
+  from the attribute cache of the file if the validity period reported by the
+  device has not elapsed yet.
+
+  If the attributes have to be fetched from the device, and the size or the
+  last modification time of the file have changed relative to the cached
+  attributes, then the read-ahead buffer of the file is dropped as well.
+
+  @param[in,out] VirtioFsFile  The open file whose inode should be queried.
+                               The attribute cache and the read-ahead buffer
+                               of the file are updated on output.
+
+  @param[out] FuseAttr         The VIRTIO_FS_FUSE_ATTRIBUTES_RESPONSE object
+                               describing the properties of the inode.
+
+  @retval EFI_SUCCESS  FuseAttr has been filled in.
+
+  @return              Error codes propagated from VirtioFsFuseGetAttr().
+**/
+EFI_STATUS
+VirtioFsFileGetAttr (
+  IN OUT VIRTIO_FS_FILE                   *VirtioFsFile,
+  OUT VIRTIO_FS_FUSE_ATTRIBUTES_RESPONSE  *FuseAttr
+  )
+{
+  UINT64      Now;
+  UINT64      AttrValid;
+  UINT64      StartValue;
+  UINT64      EndValue;
+  UINT64      Period;
+  EFI_STATUS  Status;
+
+  Now = GetPerformanceCounter ();
+  if (VirtioFsFile->AttrCached &&
+      (GetTimeInNanoSecond (VirtioFsElapsedTicks (VirtioFsFile->AttrFetchTick, Now)) <
+       VirtioFsFile->AttrValid))
+  {
+    CopyMem (FuseAttr, &VirtioFsFile->Attr, sizeof *FuseAttr);
+    return EFI_SUCCESS;
+  }
+
+  Status = VirtioFsFuseGetAttr (
+             VirtioFsFile->OwnerFs,
+             VirtioFsFile->NodeId,
+             FuseAttr,
+             &AttrValid
+             );
+  if (EFI_ERROR (Status)) {
+    VirtioFsFile->AttrCached = FALSE;
+    return Status;
+  }
+
+  if (VirtioFsFile->AttrCached &&
+      ((FuseAttr->Size != VirtioFsFile->Attr.Size) ||
+       (FuseAttr->Mtime != VirtioFsFile->Attr.Mtime) ||
+       (FuseAttr->MtimeNsec != VirtioFsFile->Attr.MtimeNsec)))
+  {
+    VirtioFsFile->ReadAheadSize = 0;
+  }
+
+  //
+  // The elapsed time is only measured correctly within one period of the
+  // performance counter, so never cache the attributes for more than half of
+  // it.
+  //
+  GetPerformanceCounterProperties (&StartValue, &EndValue);
+  Period = GetTimeInNanoSecond (
+             (StartValue > EndValue) ? StartValue - EndValue : EndValue - StartValue
+             );
+
+  CopyMem (&VirtioFsFile->Attr, FuseAttr, sizeof *FuseAttr);
+  VirtioFsFile->AttrCached    = TRUE;
+  VirtioFsFile->AttrFetchTick = Now;
+  VirtioFsFile->AttrValid     = MIN (AttrValid, Period / 2);
+  return EFI_SUCCESS;
+}
+
+/**
+  Drop the cached attributes and the read-ahead buffer contents of all files
+  that are open on an inode, after the inode has been modified.
+
+  @param[in,out] VirtioFs  The Virtio Filesystem device whose open files
+                           should be scanned.
+
+  @param[in] NodeId        The inode number of the modified inode.
+**/
+VOID
+VirtioFsInvalidateNodeCaches (
+  IN OUT VIRTIO_FS  *VirtioFs,
+  IN     UINT64     NodeId
+  )
+{
+  LIST_ENTRY      *Entry;
+  VIRTIO_FS_FILE  *VirtioFsFile;
+
+  BASE_LIST_FOR_EACH (Entry, &VirtioFs->OpenFiles) {
+    VirtioFsFile = VIRTIO_FS_FILE_FROM_OPEN_FILES_ENTRY (Entry);
+    if (VirtioFsFile->NodeId == NodeId) {
+      VirtioFsFile->AttrCached    = FALSE;
+      VirtioFsFile->ReadAheadSize = 0;
+    }
+  }
+}
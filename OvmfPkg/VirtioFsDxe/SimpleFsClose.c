@@ -75,6 +75,10 @@ VirtioFsSimpleFileClose (
     FreePool (VirtioFsFile->FileInfoArray);
   }
 
+  if (VirtioFsFile->ReadAheadBuffer != NULL) {
+    FreePool (VirtioFsFile->ReadAheadBuffer);
+  }
+
   FreePool (VirtioFsFile);
   return EFI_SUCCESS;
 }
@@ -25,7 +25,6 @@ GetFileInfo (
   )
 {
   VIRTIO_FS_FILE                      *VirtioFsFile;
-  VIRTIO_FS                           *VirtioFs;
   UINTN                               AllocSize;
   UINTN                               BasenameSize;
   EFI_STATUS                          Status;
@@ -33,7 +32,6 @@ GetFileInfo (
   VIRTIO_FS_FUSE_ATTRIBUTES_RESPONSE  FuseAttr;
 
   VirtioFsFile = VIRTIO_FS_FILE_FROM_SIMPLE_FILE (This);
-  VirtioFs     = VirtioFsFile->OwnerFs;
 
   AllocSize = *BufferSize;
 
@@ -68,7 +66,7 @@ GetFileInfo (
   //
   // Fetch the file attributes, and convert them into the caller's buffer.
   //
-  Status = VirtioFsFuseGetAttr (VirtioFs, VirtioFsFile->NodeId, &FuseAttr);
+  Status = VirtioFsFileGetAttr (VirtioFsFile, &FuseAttr);
   if (!EFI_ERROR (Status)) {
     Status = VirtioFsFuseAttrToEfiFileInfo (&FuseAttr, FileInfo);
   }
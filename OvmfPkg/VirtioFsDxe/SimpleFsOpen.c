@@ -60,7 +60,8 @@ OpenRootDirectory (
     Status = VirtioFsFuseGetAttr (
                VirtioFs,
                VIRTIO_FS_FUSE_ROOT_DIR_NODE_ID,
-               &FuseAttr
+               &FuseAttr,
+               NULL
                );
     if (EFI_ERROR (Status)) {
       return Status;
@@ -557,6 +558,12 @@ VirtioFsSimpleFileOpen (
   NewVirtioFsFile->SingleFileInfoSize     = 0;
   NewVirtioFsFile->NumFileInfo            = 0;
   NewVirtioFsFile->NextFileInfo           = 0;
+  NewVirtioFsFile->AttrCached             = FALSE;
+  NewVirtioFsFile->AttrFetchTick          = 0;
+  NewVirtioFsFile->AttrValid              = 0;
+  NewVirtioFsFile->ReadAheadBuffer        = NULL;
+  NewVirtioFsFile->ReadAheadOffset        = 0;
+  NewVirtioFsFile->ReadAheadSize          = 0;
 
   //
   // One more file is now open for the filesystem.
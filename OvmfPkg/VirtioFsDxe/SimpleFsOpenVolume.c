@@ -82,6 +82,12 @@ VirtioFsOpenVolume (
   VirtioFsFile->SingleFileInfoSize     = 0;
   VirtioFsFile->NumFileInfo            = 0;
   VirtioFsFile->NextFileInfo           = 0;
+  VirtioFsFile->AttrCached             = FALSE;
+  VirtioFsFile->AttrFetchTick          = 0;
+  VirtioFsFile->AttrValid              = 0;
+  VirtioFsFile->ReadAheadBuffer        = NULL;
+  VirtioFsFile->ReadAheadOffset        = 0;
+  VirtioFsFile->ReadAheadSize          = 0;
 
   //
   // One more file open for the filesystem.
@@ -362,6 +362,56 @@ ReadFileInfoCache (
   return EFI_SUCCESS;
 }
 
+/**
+  Refill the read-ahead buffer of a regular file, starting at Offset.
+
+  The read-ahead buffer is allocated on first use. If read-ahead is disabled,
+  or the buffer cannot be allocated, then the function returns
+  EFI_UNSUPPORTED, and the caller is expected to read the file directly.
+**/
+STATIC
+EFI_STATUS
+RefillReadAheadBuffer (
+  IN OUT VIRTIO_FS_FILE  *VirtioFsFile,
+  IN     UINT64          Offset
+  )
+{
+  VIRTIO_FS   *VirtioFs;
+  EFI_STATUS  Status;
+  UINT32      ReadSize;
+
+  VirtioFs = VirtioFsFile->OwnerFs;
+  if (VirtioFs->MaxReadahead == 0) {
+    return EFI_UNSUPPORTED;
+  }
+
+  if (VirtioFsFile->ReadAheadBuffer == NULL) {
+    VirtioFsFile->ReadAheadBuffer = AllocatePool (VirtioFs->MaxReadahead);
+    if (VirtioFsFile->ReadAheadBuffer == NULL) {
+      return EFI_UNSUPPORTED;
+    }
+  }
+
+  VirtioFsFile->ReadAheadSize = 0;
+  ReadSize                    = VirtioFs->MaxReadahead;
+  Status                      = VirtioFsFuseReadFileOrDir (
+                                  VirtioFs,
+                                  VirtioFsFile->NodeId,
+                                  VirtioFsFile->FuseHandle,
+                                  FALSE,                 // IsDir
+                                  Offset,
+                                  &ReadSize,
+                                  VirtioFsFile->ReadAheadBuffer
+                                  );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  VirtioFsFile->ReadAheadOffset = Offset;
+  VirtioFsFile->ReadAheadSize   = ReadSize;
+  return EFI_SUCCESS;
+}
+
 /**
   Read from a regular file.
 **/
@@ -378,12 +428,13 @@ ReadRegularFile (
   VIRTIO_FS_FUSE_ATTRIBUTES_RESPONSE  FuseAttr;
   UINTN                               Transferred;
   UINTN                               Left;
+  UINT64                              Position;
 
   VirtioFs = VirtioFsFile->OwnerFs;
   //
   // The UEFI spec forbids reads that start beyond the end of the file.
   //
-  Status = VirtioFsFuseGetAttr (VirtioFs, VirtioFsFile->NodeId, &FuseAttr);
+  Status = VirtioFsFileGetAttr (VirtioFsFile, &FuseAttr);
   if (EFI_ERROR (Status) || (VirtioFsFile->FilePosition > FuseAttr.Size)) {
     return EFI_DEVICE_ERROR;
   }
@@ -393,6 +444,52 @@ ReadRegularFile (
   Left        = *BufferSize;
   while (Left > 0) {
     UINT32  ReadSize;
+    UINTN   CopySize;
+
+    Position = VirtioFsFile->FilePosition + Transferred;
+
+    //
+    // Serve the data from the read-ahead buffer, if possible.
+    //
+    if ((VirtioFsFile->ReadAheadSize > 0) &&
+        (Position >= VirtioFsFile->ReadAheadOffset) &&
+        (Position - VirtioFsFile->ReadAheadOffset <
+         VirtioFsFile->ReadAheadSize))
+    {
+      CopySize = (UINTN)MIN (
+                          (UINT64)Left,
+                          VirtioFsFile->ReadAheadOffset +
+                          VirtioFsFile->ReadAheadSize - Position
+                          );
+      CopyMem (
+        (UINT8 *)Buffer + Transferred,
+        VirtioFsFile->ReadAheadBuffer +
+        (UINTN)(Position - VirtioFsFile->ReadAheadOffset),
+        CopySize
+        );
+      Transferred += CopySize;
+      Left        -= CopySize;
+      continue;
+    }
+
+    //
+    // Requests smaller than the read-ahead buffer are served through the
+    // buffer, so that subsequent sequential reads need no FUSE_READ.
+    //
+    if (Left < VirtioFs->MaxReadahead) {
+      Status = RefillReadAheadBuffer (VirtioFsFile, Position);
+      if (!EFI_ERROR (Status)) {
+        if (VirtioFsFile->ReadAheadSize == 0) {
+          break;
+        }
+
+        continue;
+      }
+
+      if (Status != EFI_UNSUPPORTED) {
+        break;
+      }
+    }
 
     //
     // FUSE_READ cannot express a >=4GB buffer size.
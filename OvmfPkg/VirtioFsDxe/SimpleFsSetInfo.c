@@ -383,7 +383,7 @@ UpdateAttributes (
   // Fetch the current attributes first, so we can build the difference between
   // them and NewFileInfo.
   //
-  Status = VirtioFsFuseGetAttr (VirtioFs, VirtioFsFile->NodeId, &FuseAttr);
+  Status = VirtioFsFuseGetAttr (VirtioFs, VirtioFsFile->NodeId, &FuseAttr, NULL);
   if (EFI_ERROR (Status)) {
     return Status;
   }
@@ -625,8 +625,19 @@ VirtioFsSimpleFileSetInfo (
   IN VOID               *Buffer
   )
 {
+  VIRTIO_FS_FILE  *VirtioFsFile;
+  EFI_STATUS      Status;
+
   if (CompareGuid (InformationType, &gEfiFileInfoGuid)) {
-    return SetFileInfo (This, BufferSize, Buffer);
+    Status = SetFileInfo (This, BufferSize, Buffer);
+
+    //
+    // The attributes (or the file contents, after truncation) may have
+    // changed even if the request failed halfway.
+    //
+    VirtioFsFile = VIRTIO_FS_FILE_FROM_SIMPLE_FILE (This);
+    VirtioFsInvalidateNodeCaches (VirtioFsFile->OwnerFs, VirtioFsFile->NodeId);
+    return Status;
   }
 
   if (CompareGuid (InformationType, &gEfiFileSystemInfoGuid)) {
@@ -68,6 +68,10 @@ VirtioFsSimpleFileWrite (
 
   *BufferSize                 = Transferred;
   VirtioFsFile->FilePosition += Transferred;
+  if (Transferred > 0) {
+    VirtioFsInvalidateNodeCaches (VirtioFs, VirtioFsFile->NodeId);
+  }
+
   //
   // According to the UEFI spec,
   //
@@ -52,6 +52,12 @@
 //
 #define VIRTIO_FS_FILE_MAX_FILE_INFO  256
 
+//
+// Read-ahead size requested in FUSE_INIT. The device may lower it; the
+// negotiated value is the size of the per-file read-ahead buffer.
+//
+#define VIRTIO_FS_MAX_READAHEAD  SIZE_128KB
+
 //
 // Filesystem label encoded in UCS-2, transformed from the UTF-8 representation
 // in "VIRTIO_FS_CONFIG.Tag", and NUL-terminated. Only the printable ASCII code
@@ -79,6 +85,7 @@ typedef struct {
   VOID                               *RingMap;  // VirtioRingMap       2
   UINT64                             RequestId; // FuseInitSession     1
   UINT32                             MaxWrite;  // FuseInitSession     1
+  UINT32                             MaxReadahead; // FuseInitSession  1
   EFI_EVENT                          ExitBoot;  // DriverBindingStart  0
   LIST_ENTRY                         OpenFiles; // DriverBindingStart  0
   EFI_SIMPLE_FILE_SYSTEM_PROTOCOL    SimpleFs;  // DriverBindingStart  0
@@ -174,6 +181,25 @@ typedef struct {
   UINTN    SingleFileInfoSize;
   UINTN    NumFileInfo;
   UINTN    NextFileInfo;
+  //
+  // Attributes of the inode, cached for the validity period that the device
+  // reported in the FUSE_GETATTR response. AttrFetchTick is the performance
+  // counter value when the attributes were fetched, and AttrValid is the
+  // validity period in nanoseconds. The cache is dropped when the inode is
+  // modified through any open file.
+  //
+  BOOLEAN                               AttrCached;
+  UINT64                                AttrFetchTick;
+  UINT64                                AttrValid;
+  VIRTIO_FS_FUSE_ATTRIBUTES_RESPONSE    Attr;
+  //
+  // Read-ahead buffer of a regular file. Small, sequential
+  // EFI_FILE_PROTOCOL.Read() calls are served from this buffer, which is
+  // refilled with a single FUSE_READ request of VIRTIO_FS.MaxReadahead bytes.
+  //
+  UINT8     *ReadAheadBuffer;
+  UINT64    ReadAheadOffset;
+  UINT32    ReadAheadSize;
 } VIRTIO_FS_FILE;
 
 #define VIRTIO_FS_FILE_FROM_SIMPLE_FILE(SimpleFileReference) \
@@ -308,6 +334,18 @@ VirtioFsGetFuseModeUpdate (
   OUT UINT32            *Mode
   );
 
+EFI_STATUS
+VirtioFsFileGetAttr (
+  IN OUT VIRTIO_FS_FILE                   *VirtioFsFile,
+  OUT VIRTIO_FS_FUSE_ATTRIBUTES_RESPONSE  *FuseAttr
+  );
+
+VOID
+VirtioFsInvalidateNodeCaches (
+  IN OUT VIRTIO_FS  *VirtioFs,
+  IN     UINT64     NodeId
+  );
+
 //
 // Wrapper functions for FUSE commands (primitives).
 //
@@ -331,7 +369,8 @@ EFI_STATUS
 VirtioFsFuseGetAttr (
   IN OUT VIRTIO_FS                        *VirtioFs,
   IN     UINT64                           NodeId,
-  OUT VIRTIO_FS_FUSE_ATTRIBUTES_RESPONSE  *FuseAttr
+  OUT VIRTIO_FS_FUSE_ATTRIBUTES_RESPONSE  *FuseAttr,
+  OUT UINT64                              *AttrValid OPTIONAL
   );
 
 EFI_STATUS
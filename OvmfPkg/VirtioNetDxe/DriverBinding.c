@@ -9,6 +9,7 @@
 
 **/
 
+#include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/DevicePathLib.h>
 #include <Library/MemoryAllocationLib.h>
@@ -41,6 +42,8 @@
                                     host, the current link status is stored in
                                     *MediaPresent. Otherwise MediaPresent is
                                     unused.
+  param[out] Offloads               The transmit offloads offered by the host,
+                                    as EDKII_SIMPLE_NETWORK_OFFLOAD_* bits.
 
   @retval EFI_UNSUPPORTED           The host doesn't supply a MAC address.
   @return                           Status codes from VirtIo protocol members.
@@ -53,7 +56,8 @@ VirtioNetGetFeatures (
   IN OUT  VNET_DEV         *Dev,
   OUT     EFI_MAC_ADDRESS  *MacAddress,
   OUT     BOOLEAN          *MediaPresentSupported,
-  OUT     BOOLEAN          *MediaPresent
+  OUT     BOOLEAN          *MediaPresent,
+  OUT     UINT32           *Offloads
   )
 {
   EFI_STATUS  Status;
@@ -128,6 +132,19 @@ VirtioNetGetFeatures (
     *MediaPresent = (BOOLEAN)((LinkStatus & VIRTIO_NET_S_LINK_UP) != 0);
   }
 
+  //
+  // The host computes the checksums of the outgoing packets with
+  // VIRTIO_NET_F_CSUM, and segments them with VIRTIO_NET_F_HOST_TSO4 too.
+  //
+  *Offloads = 0;
+  if ((Features & VIRTIO_NET_F_CSUM) != 0) {
+    *Offloads = EDKII_SIMPLE_NETWORK_OFFLOAD_TCP4_CSUM |
+                EDKII_SIMPLE_NETWORK_OFFLOAD_TCP6_CSUM;
+    if ((Features & VIRTIO_NET_F_HOST_TSO4) != 0) {
+      *Offloads |= EDKII_SIMPLE_NETWORK_OFFLOAD_TCP4_TSO;
+    }
+  }
+
 YieldDevice:
   Dev->VirtIo->SetDeviceStatus (
                  Dev->VirtIo,
@@ -207,6 +224,14 @@ VirtioNetSnpPopulate (
   Dev->Snp.Receive        = &VirtioNetReceive;
   Dev->Snp.Mode           = &Dev->Snm;
 
+  Dev->RxLoanProtocol.ReceiveLoan = &VirtioNetReceiveLoan;
+  Dev->RxLoanProtocol.ReturnLoan  = &VirtioNetReturnLoan;
+
+  //
+  // The IPv4 total length field limits the size of a segmented packet.
+  //
+  Dev->OffloadProtocol.MaxSegmentationSize = MAX_UINT16;
+
   Dev->Snm.State           = EfiSimpleNetworkStopped;
   Dev->Snm.HwAddressSize   = SIZE_OF_VNET (Mac);
   Dev->Snm.MediaHeaderSize = SIZE_OF_VNET (Mac) +       // dst MAC
@@ -229,7 +254,8 @@ VirtioNetSnpPopulate (
              Dev,
              &Dev->Snm.CurrentAddress,
              &Dev->Snm.MediaPresentSupported,
-             &Dev->Snm.MediaPresent
+             &Dev->Snm.MediaPresent,
+             &Dev->OffloadProtocol.Capabilities
              );
   if (EFI_ERROR (Status)) {
     goto CloseWaitForPacket;
@@ -467,6 +493,7 @@ VirtioNetDriverBindingStart (
   }
 
   Dev->Signature = VNET_SIG;
+  InitializeListHead (&Dev->RxRetired);
 
   Status = gBS->OpenProtocol (
                   DeviceHandle,
@@ -531,6 +558,10 @@ VirtioNetDriverBindingStart (
                   &Dev->MacHandle,
                   &gEfiSimpleNetworkProtocolGuid,
                   &Dev->Snp,
+                  &gEdkiiSimpleNetworkRxLoanProtocolGuid,
+                  &Dev->RxLoanProtocol,
+                  &gEdkiiSimpleNetworkOffloadProtocolGuid,
+                  &Dev->OffloadProtocol,
                   &gEfiDevicePathProtocolGuid,
                   Dev->MacDevicePath,
                   NULL
@@ -564,6 +595,10 @@ UninstallMultiple:
          Dev->MacDevicePath,
          &gEfiSimpleNetworkProtocolGuid,
          &Dev->Snp,
+         &gEdkiiSimpleNetworkRxLoanProtocolGuid,
+         &Dev->RxLoanProtocol,
+         &gEdkiiSimpleNetworkOffloadProtocolGuid,
+         &Dev->OffloadProtocol,
          NULL
          );
 
@@ -677,6 +712,10 @@ VirtioNetDriverBindingStop (
              Dev->MacDevicePath,
              &gEfiSimpleNetworkProtocolGuid,
              &Dev->Snp,
+             &gEdkiiSimpleNetworkRxLoanProtocolGuid,
+             &Dev->RxLoanProtocol,
+             &gEdkiiSimpleNetworkOffloadProtocolGuid,
+             &Dev->OffloadProtocol,
              NULL
              );
       FreePool (Dev->MacDevicePath);
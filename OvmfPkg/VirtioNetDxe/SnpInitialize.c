@@ -133,8 +133,8 @@ ReleaseQueue:
   - fully populate the TX queue with a static pattern of virtio descriptor
     chains,
   - tracking of heads of free descriptor chains from the above,
-  - one common virtio-net request header (never modified by the host) for all
-    pending TX packets,
+  - one virtio-net request header (never modified by the host) for each
+    pending TX packet, carrying the offload requests of the packet,
   - select polling over TX interrupt.
 
   @param[in,out] Dev       The VNET_DEV driver instance about to enter the
@@ -155,11 +155,11 @@ VirtioNetInitTx (
   IN OUT VNET_DEV  *Dev
   )
 {
-  UINTN                 TxSharedReqSize;
+  UINTN                 TxReqSize;
   UINTN                 PktIdx;
   EFI_STATUS            Status;
   EFI_PHYSICAL_ADDRESS  DeviceAddress;
-  VOID                  *TxSharedReqBuffer;
+  VOID                  *TxReqBuffer;
 
   Dev->TxMaxPending = (UINT16)MIN (
                                 Dev->TxRing.QueueSize / 2,
@@ -184,41 +184,40 @@ VirtioNetInitTx (
   }
 
   //
-  // Allocate TxSharedReq header and map with BusMasterCommonBuffer so that it
-  // can be accessed equally by both processor and device.
+  // Allocate the TxReq headers and map them with BusMasterCommonBuffer so that
+  // they can be accessed equally by both processor and device.
   //
   Status = Dev->VirtIo->AllocateSharedPages (
                           Dev->VirtIo,
-                          EFI_SIZE_TO_PAGES (sizeof *Dev->TxSharedReq),
-                          &TxSharedReqBuffer
+                          EFI_SIZE_TO_PAGES (Dev->TxMaxPending * sizeof *Dev->TxReq),
+                          &TxReqBuffer
                           );
   if (EFI_ERROR (Status)) {
     goto UninitTxBufCollection;
   }
 
-  ZeroMem (TxSharedReqBuffer, sizeof *Dev->TxSharedReq);
+  //
+  // virtio-0.9.5, Appendix C, Packet Transmission: a zero header requests no
+  // offload (GsoType VIRTIO_NET_HDR_GSO_NONE). For VirtIo 1.0 only -- the
+  // NumBuffers field exists, but it is unused.
+  //
+  ZeroMem (TxReqBuffer, Dev->TxMaxPending * sizeof *Dev->TxReq);
 
   Status = VirtioMapAllBytesInSharedBuffer (
              Dev->VirtIo,
              VirtioOperationBusMasterCommonBuffer,
-             TxSharedReqBuffer,
-             sizeof *(Dev->TxSharedReq),
+             TxReqBuffer,
+             Dev->TxMaxPending * sizeof *Dev->TxReq,
              &DeviceAddress,
-             &Dev->TxSharedReqMap
+             &Dev->TxReqMap
              );
   if (EFI_ERROR (Status)) {
-    goto FreeTxSharedReqBuffer;
+    goto FreeTxReqBuffer;
   }
 
-  Dev->TxSharedReq = TxSharedReqBuffer;
+  Dev->TxReq = TxReqBuffer;
 
-  //
-  // In VirtIo 1.0, the NumBuffers field is mandatory. In 0.9.5, it depends on
-  // VIRTIO_NET_F_MRG_RXBUF, which we never negotiate.
-  //
-  TxSharedReqSize = (Dev->VirtIo->Revision < VIRTIO_SPEC_REVISION (1, 0, 0)) ?
-                    sizeof (Dev->TxSharedReq->V0_9_5) :
-                    sizeof *Dev->TxSharedReq;
+  TxReqSize = Dev->NetReqSize;
 
   for (PktIdx = 0; PktIdx < Dev->TxMaxPending; ++PktIdx) {
     UINT16  DescIdx;
@@ -227,11 +226,11 @@ VirtioNetInitTx (
     Dev->TxFreeStack[PktIdx] = DescIdx;
 
     //
-    // For each possibly pending packet, lay out the descriptor for the common
+    // For each possibly pending packet, lay out the descriptor for its own
     // (unmodified by the host) virtio-net request header.
     //
-    Dev->TxRing.Desc[DescIdx].Addr  = DeviceAddress;
-    Dev->TxRing.Desc[DescIdx].Len   = (UINT32)TxSharedReqSize;
+    Dev->TxRing.Desc[DescIdx].Addr  = DeviceAddress + PktIdx * sizeof *Dev->TxReq;
+    Dev->TxRing.Desc[DescIdx].Len   = (UINT32)TxReqSize;
     Dev->TxRing.Desc[DescIdx].Flags = VRING_DESC_F_NEXT;
     Dev->TxRing.Desc[DescIdx].Next  = (UINT16)(DescIdx + 1);
 
@@ -242,17 +241,6 @@ VirtioNetInitTx (
     Dev->TxRing.Desc[DescIdx + 1].Flags = 0;
   }
 
-  //
-  // virtio-0.9.5, Appendix C, Packet Transmission
-  //
-  Dev->TxSharedReq->V0_9_5.Flags   = 0;
-  Dev->TxSharedReq->V0_9_5.GsoType = VIRTIO_NET_HDR_GSO_NONE;
-
-  //
-  // For VirtIo 1.0 only -- the field exists, but it is unused
-  //
-  Dev->TxSharedReq->NumBuffers = 0;
-
   //
   // virtio-0.9.5, 2.4.2 Receiving Used Buffers From the Device
   //
@@ -267,11 +255,11 @@ VirtioNetInitTx (
 
   return EFI_SUCCESS;
 
-FreeTxSharedReqBuffer:
+FreeTxReqBuffer:
   Dev->VirtIo->FreeSharedPages (
                  Dev->VirtIo,
-                 EFI_SIZE_TO_PAGES (sizeof *(Dev->TxSharedReq)),
-                 TxSharedReqBuffer
+                 EFI_SIZE_TO_PAGES (Dev->TxMaxPending * sizeof *Dev->TxReq),
+                 TxReqBuffer
                  );
 
 UninitTxBufCollection:
@@ -299,6 +287,7 @@ FreeTxFreeStack:
   @param[in,out] Dev       The VNET_DEV driver instance about to enter the
                            EfiSimpleNetworkInitialized state.
 
+  @retval EFI_OUT_OF_RESOURCES  Failed to allocate the RX loan descriptors.
   @return                       Status codes from VIRTIO_CFG_WRITE() or
                                 VIRTIO_DEVICE_PROTOCOL.AllocateSharedPages or
                                 VirtioMapAllBytesInSharedBuffer().
@@ -315,6 +304,8 @@ VirtioNetInitRx (
   EFI_STATUS            Status;
   UINTN                 VirtioNetReqSize;
   UINTN                 RxBufSize;
+  UINTN                 RxFrameSize;
+  UINTN                 RxDataOffset;
   UINT16                RxAlwaysPending;
   UINTN                 PktIdx;
   UINT16                DescIdx;
@@ -322,28 +313,37 @@ VirtioNetInitRx (
   EFI_PHYSICAL_ADDRESS  RxBufDeviceAddress;
   VOID                  *RxBuffer;
 
-  //
-  // In VirtIo 1.0, the NumBuffers field is mandatory. In 0.9.5, it depends on
-  // VIRTIO_NET_F_MRG_RXBUF, which we never negotiate.
-  //
-  VirtioNetReqSize = (Dev->VirtIo->Revision < VIRTIO_SPEC_REVISION (1, 0, 0)) ?
-                     sizeof (VIRTIO_NET_REQ) :
-                     sizeof (VIRTIO_1_0_NET_REQ);
+  VirtioNetReqSize = Dev->NetReqSize;
+  RxFrameSize      = Dev->Snm.MediaHeaderSize + Dev->Snm.MaxPacketSize;
 
   //
-  // For each incoming packet we must supply two descriptors:
+  // Without VIRTIO_NET_F_MRG_RXBUF, for each incoming packet we must supply
+  // two descriptors:
   // - the recipient for the virtio-net request header, plus
   // - the recipient for the network data (which consists of Ethernet header
   //   and Ethernet payload).
   //
-  RxBufSize = VirtioNetReqSize +
-              (Dev->Snm.MediaHeaderSize + Dev->Snm.MaxPacketSize);
+  // With VIRTIO_NET_F_MRG_RXBUF, each RX buffer is a single descriptor that
+  // starts with the virtio-net request header. The buffer has room for a full
+  // frame, so the device never needs to merge several buffers into a packet,
+  // and the queue holds twice as many packets.
+  //
+  // The network data is placed so that the protocol headers following the
+  // Ethernet header are 4-byte aligned, which lets VirtioNetReceiveLoan() hand
+  // out the packets in place.
+  //
+  Dev->RxDescPerPkt = Dev->RxMrgBuf ? 1 : 2;
+  RxDataOffset      = ALIGN_VALUE (VirtioNetReqSize + Dev->Snm.MediaHeaderSize, 4) -
+                      Dev->Snm.MediaHeaderSize;
+  RxBufSize = ALIGN_VALUE (RxDataOffset + RxFrameSize, 4);
 
   //
-  // Limit the number of pending RX packets if the queue is big. The division
-  // by two is due to the above "two descriptors per packet" trait.
+  // Limit the number of pending RX packets if the queue is big.
   //
-  RxAlwaysPending = (UINT16)MIN (Dev->RxRing.QueueSize / 2, VNET_MAX_PENDING);
+  RxAlwaysPending = (UINT16)MIN (
+                              Dev->RxRing.QueueSize / Dev->RxDescPerPkt,
+                              VNET_MAX_RX_PENDING
+                              );
 
   //
   // The RxBuf is shared between guest and hypervisor, use
@@ -378,6 +378,24 @@ VirtioNetInitRx (
 
   Dev->RxBuf = RxBuffer;
 
+  //
+  // One loan descriptor per RX packet. Keep at least half of the packets
+  // pending in the RX queue, see VirtioNetReceiveLoan().
+  //
+  Dev->RxLoan = AllocateZeroPool (RxAlwaysPending * sizeof (*Dev->RxLoan));
+  if (Dev->RxLoan == NULL) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto UnmapSharedBuffer;
+  }
+
+  Dev->RxLoanNum     = RxAlwaysPending;
+  Dev->RxLoanPending = 0;
+  for (PktIdx = 0; PktIdx < RxAlwaysPending; ++PktIdx) {
+    Dev->RxLoan[PktIdx].Lender     = &Dev->RxLoanProtocol;
+    Dev->RxLoan[PktIdx].Buffer     = Dev->RxBuf + PktIdx * RxBufSize + RxDataOffset;
+    Dev->RxLoan[PktIdx].HeaderSize = Dev->Snm.MediaHeaderSize;
+  }
+
   //
   // virtio-0.9.5, 2.4.2 Receiving Used Buffers From the Device
   //
@@ -393,8 +411,8 @@ VirtioNetInitRx (
   *Dev->RxRing.Avail.Flags = (UINT16)VRING_AVAIL_F_NO_INTERRUPT;
 
   //
-  // now set up a separate, two-part descriptor chain for each RX packet, and
-  // link each chain into (from) the available ring as well
+  // now set up a separate descriptor chain for each RX packet, and link each
+  // chain into (from) the available ring as well
   //
   DescIdx            = 0;
   RxBufDeviceAddress = Dev->RxBufDeviceBase;
@@ -408,16 +426,29 @@ VirtioNetInitRx (
     //
     // virtio-0.9.5, 2.4.1.1 Placing Buffers into the Descriptor Table
     //
+    if (Dev->RxMrgBuf) {
+      Dev->RxRing.Desc[DescIdx].Addr = RxBufDeviceAddress + RxDataOffset -
+                                       VirtioNetReqSize;
+      Dev->RxRing.Desc[DescIdx].Len   = (UINT32)(VirtioNetReqSize + RxFrameSize);
+      Dev->RxRing.Desc[DescIdx].Flags = VRING_DESC_F_WRITE;
+      DescIdx++;
+
+      RxBufDeviceAddress += RxBufSize;
+      continue;
+    }
+
     Dev->RxRing.Desc[DescIdx].Addr  = RxBufDeviceAddress;
     Dev->RxRing.Desc[DescIdx].Len   = (UINT32)VirtioNetReqSize;
     Dev->RxRing.Desc[DescIdx].Flags = VRING_DESC_F_WRITE | VRING_DESC_F_NEXT;
     Dev->RxRing.Desc[DescIdx].Next  = (UINT16)(DescIdx + 1);
-    RxBufDeviceAddress             += Dev->RxRing.Desc[DescIdx++].Len;
+    DescIdx++;
 
-    Dev->RxRing.Desc[DescIdx].Addr  = RxBufDeviceAddress;
-    Dev->RxRing.Desc[DescIdx].Len   = (UINT32)(RxBufSize - VirtioNetReqSize);
+    Dev->RxRing.Desc[DescIdx].Addr  = RxBufDeviceAddress + RxDataOffset;
+    Dev->RxRing.Desc[DescIdx].Len   = (UINT32)RxFrameSize;
     Dev->RxRing.Desc[DescIdx].Flags = VRING_DESC_F_WRITE;
-    RxBufDeviceAddress             += Dev->RxRing.Desc[DescIdx++].Len;
+    DescIdx++;
+
+    RxBufDeviceAddress += RxBufSize;
   }
 
   //
@@ -438,11 +469,15 @@ VirtioNetInitRx (
   Status = Dev->VirtIo->SetQueueNotify (Dev->VirtIo, VIRTIO_NET_Q_RX);
   if (EFI_ERROR (Status)) {
     Dev->VirtIo->SetDeviceStatus (Dev->VirtIo, 0);
-    goto UnmapSharedBuffer;
+    goto FreeRxLoan;
   }
 
   return Status;
 
+FreeRxLoan:
+  FreePool (Dev->RxLoan);
+  Dev->RxLoan = NULL;
+
 UnmapSharedBuffer:
   Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, Dev->RxBufMap);
 
@@ -558,7 +593,26 @@ VirtioNetInitialize (
     );
 
   Features &= VIRTIO_NET_F_MAC | VIRTIO_NET_F_STATUS | VIRTIO_F_VERSION_1 |
-              VIRTIO_F_IOMMU_PLATFORM;
+              VIRTIO_F_IOMMU_PLATFORM | VIRTIO_NET_F_CSUM |
+              VIRTIO_NET_F_HOST_TSO4 | VIRTIO_NET_F_MRG_RXBUF;
+
+  //
+  // The offloads advertised by VirtioNetGetFeatures() must be negotiated.
+  // VIRTIO_NET_F_HOST_TSO4 depends on VIRTIO_NET_F_CSUM.
+  //
+  if ((Features & VIRTIO_NET_F_CSUM) == 0) {
+    Features &= ~(UINT64)VIRTIO_NET_F_HOST_TSO4;
+  }
+
+  //
+  // In VirtIo 1.0, the NumBuffers field of the virtio-net request header is
+  // mandatory. In 0.9.5, it depends on VIRTIO_NET_F_MRG_RXBUF.
+  //
+  Dev->RxMrgBuf   = (BOOLEAN)((Features & VIRTIO_NET_F_MRG_RXBUF) != 0);
+  Dev->NetReqSize = (UINT16)(((Dev->VirtIo->Revision < VIRTIO_SPEC_REVISION (1, 0, 0)) &&
+                              !Dev->RxMrgBuf) ?
+                             sizeof (VIRTIO_NET_REQ) :
+                             sizeof (VIRTIO_1_0_NET_REQ));
 
   //
   // In virtio-1.0, feature negotiation is expected to complete before queue
@@ -15,6 +15,88 @@
 
 #include "VirtioNet.h"
 
+/**
+  Peeks at the next packet on the used ring of the RX queue.
+
+  Each RX buffer has room for a full frame, so a device which negotiated
+  VIRTIO_NET_F_MRG_RXBUF is not expected to merge buffers. Should it merge
+  them anyway, the packet is dropped along with all of its buffers.
+
+  @param  Dev      The VNET_DEV driver instance.
+  @param  PktIdx   The index of the RX buffer holding the packet.
+  @param  RxLen    The size of the frame, excluding the virtio-net request
+                   header.
+
+  @retval  EFI_SUCCESS       The packet is at Dev->RxLastUsed. The caller
+                             advances Dev->RxLastUsed when it consumes it.
+  @retval  EFI_NOT_READY     No packet has been received.
+  @retval  EFI_DEVICE_ERROR  A merged packet was dropped.
+
+**/
+STATIC
+EFI_STATUS
+VirtioNetPeekRxPacket (
+  IN OUT VNET_DEV  *Dev,
+  OUT    UINTN     *PktIdx,
+  OUT    UINT32    *RxLen
+  )
+{
+  UINT16              RxCurUsed;
+  UINT16              UsedElemIdx;
+  UINT32              DescIdx;
+  UINT32              Len;
+  VIRTIO_1_0_NET_REQ  *Req;
+  UINT16              NumBuffers;
+
+  //
+  // virtio-0.9.5, 2.4.2 Receiving Used Buffers From the Device
+  //
+  MemoryFence ();
+  RxCurUsed = *Dev->RxRing.Used.Idx;
+  MemoryFence ();
+
+  if (Dev->RxLastUsed == RxCurUsed) {
+    return EFI_NOT_READY;
+  }
+
+  UsedElemIdx = Dev->RxLastUsed % Dev->RxRing.QueueSize;
+  DescIdx     = Dev->RxRing.Used.UsedElem[UsedElemIdx].Id;
+  Len         = Dev->RxRing.Used.UsedElem[UsedElemIdx].Len;
+  *PktIdx     = DescIdx / Dev->RxDescPerPkt;
+
+  //
+  // the virtio-net request header must be complete; we skip it
+  //
+  ASSERT (Len >= Dev->NetReqSize);
+  Len -= Dev->NetReqSize;
+  //
+  // the host must not have filled in more data than requested
+  //
+  ASSERT (Len <= (UINT32)(Dev->Snm.MediaHeaderSize + Dev->Snm.MaxPacketSize));
+  *RxLen = Len;
+
+  if (!Dev->RxMrgBuf) {
+    return EFI_SUCCESS;
+  }
+
+  Req        = (VIRTIO_1_0_NET_REQ *)(Dev->RxLoan[*PktIdx].Buffer - Dev->NetReqSize);
+  NumBuffers = Req->NumBuffers;
+  if (NumBuffers <= 1) {
+    return EFI_SUCCESS;
+  }
+
+  //
+  // The device makes all buffers of a packet visible at once.
+  //
+  NumBuffers = (UINT16)MIN (NumBuffers, (UINT16)(RxCurUsed - Dev->RxLastUsed));
+  while (NumBuffers-- > 0) {
+    UsedElemIdx = Dev->RxLastUsed++ % Dev->RxRing.QueueSize;
+    VirtioNetRecycleRxDesc (Dev, (UINT16)Dev->RxRing.Used.UsedElem[UsedElemIdx].Id);
+  }
+
+  return EFI_DEVICE_ERROR;
+}
+
 /**
   Receives a packet from a network interface.
 
@@ -67,15 +149,11 @@ VirtioNetReceive (
   VNET_DEV    *Dev;
   EFI_TPL     OldTpl;
   EFI_STATUS  Status;
-  UINT16      RxCurUsed;
-  UINT16      UsedElemIdx;
-  UINT32      DescIdx;
+  UINTN       PktIdx;
   UINT32      RxLen;
   UINTN       OrigBufferSize;
   UINT8       *RxPtr;
-  UINT16      AvailIdx;
   EFI_STATUS  NotifyStatus;
-  UINTN       RxBufOffset;
 
   if ((This == NULL) || (BufferSize == NULL) || (Buffer == NULL)) {
     return EFI_INVALID_PARAMETER;
@@ -94,32 +172,11 @@ VirtioNetReceive (
       break;
   }
 
-  //
-  // virtio-0.9.5, 2.4.2 Receiving Used Buffers From the Device
-  //
-  MemoryFence ();
-  RxCurUsed = *Dev->RxRing.Used.Idx;
-  MemoryFence ();
-
-  if (Dev->RxLastUsed == RxCurUsed) {
-    Status = EFI_NOT_READY;
+  Status = VirtioNetPeekRxPacket (Dev, &PktIdx, &RxLen);
+  if (EFI_ERROR (Status)) {
     goto Exit;
   }
 
-  UsedElemIdx = Dev->RxLastUsed % Dev->RxRing.QueueSize;
-  DescIdx     = Dev->RxRing.Used.UsedElem[UsedElemIdx].Id;
-  RxLen       = Dev->RxRing.Used.UsedElem[UsedElemIdx].Len;
-
-  //
-  // the virtio-net request header must be complete; we skip it
-  //
-  ASSERT (RxLen >= Dev->RxRing.Desc[DescIdx].Len);
-  RxLen -= Dev->RxRing.Desc[DescIdx].Len;
-  //
-  // the host must not have filled in more data than requested
-  //
-  ASSERT (RxLen <= Dev->RxRing.Desc[DescIdx + 1].Len);
-
   OrigBufferSize = *BufferSize;
   *BufferSize    = RxLen;
 
@@ -137,9 +194,7 @@ VirtioNetReceive (
     *HeaderSize = Dev->Snm.MediaHeaderSize;
   }
 
-  RxBufOffset = (UINTN)(Dev->RxRing.Desc[DescIdx + 1].Addr -
-                        Dev->RxBufDeviceBase);
-  RxPtr = Dev->RxBuf + RxBufOffset;
+  RxPtr = Dev->RxLoan[PktIdx].Buffer;
   CopyMem (Buffer, RxPtr, RxLen);
 
   if (DestAddr != NULL) {
@@ -165,18 +220,10 @@ VirtioNetReceive (
 RecycleDesc:
   ++Dev->RxLastUsed;
 
-  //
-  // virtio-0.9.5, 2.4.1 Supplying Buffers to The Device
-  //
-  AvailIdx                                                   = *Dev->RxRing.Avail.Idx;
-  Dev->RxRing.Avail.Ring[AvailIdx++ % Dev->RxRing.QueueSize] =
-    (UINT16)DescIdx;
-
-  MemoryFence ();
-  *Dev->RxRing.Avail.Idx = AvailIdx;
-
-  MemoryFence ();
-  NotifyStatus = Dev->VirtIo->SetQueueNotify (Dev->VirtIo, VIRTIO_NET_Q_RX);
+  NotifyStatus = VirtioNetRecycleRxDesc (
+                   Dev,
+                   (UINT16)(PktIdx * Dev->RxDescPerPkt)
+                   );
   if (!EFI_ERROR (Status)) {
     // earlier error takes precedence
     Status = NotifyStatus;
@@ -186,3 +233,148 @@ Exit:
   gBS->RestoreTPL (OldTpl);
   return Status;
 }
+
+/**
+  Receives a packet from a network interface and lends it to the caller in
+  place, instead of copying it.
+
+  At most half of the RX packets may be lent out at any time, so that the
+  device always has buffers to receive into. Beyond that, the caller is
+  expected to fall back to SNP.Receive().
+
+  @param  This   The protocol instance pointer.
+  @param  Loan   The received packet lent to the caller.
+
+  @retval  EFI_SUCCESS           A packet is lent to the caller.
+  @retval  EFI_NOT_READY         No packet has been received.
+  @retval  EFI_OUT_OF_RESOURCES  Too many packets are lent out.
+  @retval  EFI_NOT_STARTED       The network interface has not been started.
+  @retval  EFI_INVALID_PARAMETER One or more of the parameters has an
+                                 unsupported value.
+  @retval  EFI_DEVICE_ERROR      The network interface is not initialized, a
+                                 short packet was dropped, or the device could
+                                 not be notified.
+
+**/
+EFI_STATUS
+EFIAPI
+VirtioNetReceiveLoan (
+  IN  EDKII_SIMPLE_NETWORK_RX_LOAN_PROTOCOL  *This,
+  OUT EDKII_SIMPLE_NETWORK_RX_LOAN           **Loan
+  )
+{
+  VNET_DEV    *Dev;
+  EFI_TPL     OldTpl;
+  EFI_STATUS  Status;
+  UINTN       PktIdx;
+  UINT32      RxLen;
+
+  if ((This == NULL) || (Loan == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Dev    = VIRTIO_NET_FROM_RX_LOAN (This);
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+  switch (Dev->Snm.State) {
+    case EfiSimpleNetworkStopped:
+      Status = EFI_NOT_STARTED;
+      goto Exit;
+    case EfiSimpleNetworkStarted:
+      Status = EFI_DEVICE_ERROR;
+      goto Exit;
+    default:
+      break;
+  }
+
+  if (Dev->RxLoanPending >= Dev->RxLoanNum / 2) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto Exit;
+  }
+
+  Status = VirtioNetPeekRxPacket (Dev, &PktIdx, &RxLen);
+  if (EFI_ERROR (Status)) {
+    goto Exit;
+  }
+
+  ++Dev->RxLastUsed;
+
+  if (RxLen < Dev->Snm.MediaHeaderSize) {
+    //
+    // drop useless short packet
+    //
+    VirtioNetRecycleRxDesc (Dev, (UINT16)(PktIdx * Dev->RxDescPerPkt));
+    Status = EFI_DEVICE_ERROR;
+    goto Exit;
+  }
+
+  //
+  // The descriptor chain of the packet is not given back to the device until
+  // VirtioNetReturnLoan().
+  //
+  *Loan               = &Dev->RxLoan[PktIdx];
+  (*Loan)->BufferSize = RxLen;
+  Dev->RxLoanPending++;
+  Status = EFI_SUCCESS;
+
+Exit:
+  gBS->RestoreTPL (OldTpl);
+  return Status;
+}
+
+/**
+  Returns a packet lent by VirtioNetReceiveLoan(), giving its descriptor chain
+  back to the device.
+
+  Loans that were outstanding when the network interface was shut down belong
+  to a detached receive area, which is released together with its last loan.
+
+  @param  This   The protocol instance pointer.
+  @param  Loan   The packet to return.
+
+**/
+VOID
+EFIAPI
+VirtioNetReturnLoan (
+  IN EDKII_SIMPLE_NETWORK_RX_LOAN_PROTOCOL  *This,
+  IN EDKII_SIMPLE_NETWORK_RX_LOAN           *Loan
+  )
+{
+  VNET_DEV      *Dev;
+  EFI_TPL       OldTpl;
+  UINTN         PktIdx;
+  LIST_ENTRY    *Link;
+  VNET_RX_AREA  *Area;
+
+  Dev    = VIRTIO_NET_FROM_RX_LOAN (This);
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+
+  if ((Dev->Snm.State == EfiSimpleNetworkInitialized) &&
+      (Dev->RxLoan != NULL) &&
+      (Loan >= Dev->RxLoan) &&
+      (Loan < Dev->RxLoan + Dev->RxLoanNum))
+  {
+    PktIdx = Loan - Dev->RxLoan;
+    ASSERT (Dev->RxLoanPending > 0);
+    Dev->RxLoanPending--;
+    VirtioNetRecycleRxDesc (Dev, (UINT16)(PktIdx * Dev->RxDescPerPkt));
+  } else {
+    for (Link = GetFirstNode (&Dev->RxRetired);
+         !IsNull (&Dev->RxRetired, Link);
+         Link = GetNextNode (&Dev->RxRetired, Link))
+    {
+      Area = BASE_CR (Link, VNET_RX_AREA, Link);
+      if ((Loan >= Area->Loan) && (Loan < Area->Loan + Area->LoanNum)) {
+        ASSERT (Area->LoanPending > 0);
+        Area->LoanPending--;
+        if (Area->LoanPending == 0) {
+          RemoveEntryList (&Area->Link);
+          VirtioNetReleaseRxArea (Dev, Area);
+        }
+
+        break;
+      }
+    }
+  }
+
+  gBS->RestoreTPL (OldTpl);
+}
@@ -8,7 +8,9 @@
 
 **/
 
+#include <Library/BaseLib.h>
 #include <Library/MemoryAllocationLib.h>
+#include <Library/UefiBootServicesTableLib.h>
 
 #include "VirtioNet.h"
 
@@ -42,6 +44,53 @@ VirtioNetShutdownRx (
   IN OUT VNET_DEV  *Dev
   )
 {
+  VNET_RX_AREA  *Area;
+  EFI_TPL       OldTpl;
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  if (Dev->RxLoanPending > 0) {
+    //
+    // The caller still holds packets lent by VirtioNetReceiveLoan(). The
+    // device has been reset; detach the receive area and let
+    // VirtioNetReturnLoan() release it when the last packet comes back.
+    //
+    Area = AllocatePool (sizeof *Area);
+    if (Area == NULL) {
+      DEBUG ((
+        DEBUG_ERROR,
+        "%a: %u RX packets still lent out, leaking the RX area\n",
+        __func__,
+        Dev->RxLoanPending
+        ));
+    } else {
+      DEBUG ((
+        DEBUG_INFO,
+        "%a: %u RX packets still lent out, deferring the release of the RX area\n",
+        __func__,
+        Dev->RxLoanPending
+        ));
+      Area->Buf         = Dev->RxBuf;
+      Area->BufNrPages  = Dev->RxBufNrPages;
+      Area->BufMap      = Dev->RxBufMap;
+      Area->Loan        = Dev->RxLoan;
+      Area->LoanNum     = Dev->RxLoanNum;
+      Area->LoanPending = Dev->RxLoanPending;
+      InsertTailList (&Dev->RxRetired, &Area->Link);
+    }
+
+    Dev->RxLoan        = NULL;
+    Dev->RxLoanNum     = 0;
+    Dev->RxLoanPending = 0;
+    gBS->RestoreTPL (OldTpl);
+    return;
+  }
+
+  gBS->RestoreTPL (OldTpl);
+
+  FreePool (Dev->RxLoan);
+  Dev->RxLoan    = NULL;
+  Dev->RxLoanNum = 0;
+
   Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, Dev->RxBufMap);
   Dev->VirtIo->FreeSharedPages (
                  Dev->VirtIo,
@@ -50,6 +99,29 @@ VirtioNetShutdownRx (
                  );
 }
 
+/**
+  Release a receive area detached by VirtioNetShutdownRx(), once the last of
+  its lent packets has been returned.
+
+  @param[in] Dev   The VNET_DEV driver instance that owned the area.
+  @param[in] Area  The detached receive area, already unlinked from
+                   Dev->RxRetired.
+**/
+VOID
+EFIAPI
+VirtioNetReleaseRxArea (
+  IN VNET_DEV      *Dev,
+  IN VNET_RX_AREA  *Area
+  )
+{
+  ASSERT (Area->LoanPending == 0);
+
+  Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, Area->BufMap);
+  Dev->VirtIo->FreeSharedPages (Dev->VirtIo, Area->BufNrPages, Area->Buf);
+  FreePool (Area->Loan);
+  FreePool (Area);
+}
+
 VOID
 EFIAPI
 VirtioNetShutdownTx (
@@ -60,11 +132,11 @@ VirtioNetShutdownTx (
   TX_BUF_MAP_INFO           *TxBufMapInfo;
   VOID                      *UserStruct;
 
-  Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, Dev->TxSharedReqMap);
+  Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, Dev->TxReqMap);
   Dev->VirtIo->FreeSharedPages (
                  Dev->VirtIo,
-                 EFI_SIZE_TO_PAGES (sizeof *(Dev->TxSharedReq)),
-                 Dev->TxSharedReq
+                 EFI_SIZE_TO_PAGES (Dev->TxMaxPending * sizeof *(Dev->TxReq)),
+                 Dev->TxReq
                  );
 
   for (Entry = OrderedCollectionMin (Dev->TxBufCollection);
@@ -83,6 +155,52 @@ VirtioNetShutdownTx (
   FreePool (Dev->TxFreeStack);
 }
 
+/**
+  Give the descriptor chain of a received packet back to the device.
+
+  The available ring of the RX queue is updated at TPL_NOTIFY, because
+  VirtioNetReturnLoan() may be called at that level.
+
+  @param[in,out] Dev      The VNET_DEV driver instance.
+  @param[in]     DescIdx  The head of the descriptor chain to recycle.
+
+  @return  Status codes from VIRTIO_DEVICE_PROTOCOL.SetQueueNotify().
+*/
+EFI_STATUS
+EFIAPI
+VirtioNetRecycleRxDesc (
+  IN OUT VNET_DEV  *Dev,
+  IN     UINT16    DescIdx
+  )
+{
+  EFI_TPL  OldTpl;
+  UINT16   AvailIdx;
+
+  //
+  // virtio-0.9.5, 2.4.1 Supplying Buffers to The Device
+  //
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+
+  AvailIdx                                                   = *Dev->RxRing.Avail.Idx;
+  Dev->RxRing.Avail.Ring[AvailIdx++ % Dev->RxRing.QueueSize] = DescIdx;
+
+  MemoryFence ();
+  *Dev->RxRing.Avail.Idx = AvailIdx;
+  gBS->RestoreTPL (OldTpl);
+
+  //
+  // virtio-0.9.5, 2.4.1.4 Notifying the Device: the device tells us it is
+  // busy consuming the available ring, there is no need to kick it for every
+  // recycled buffer.
+  //
+  MemoryFence ();
+  if ((*Dev->RxRing.Used.Flags & VRING_USED_F_NO_NOTIFY) != 0) {
+    return EFI_SUCCESS;
+  }
+
+  return Dev->VirtIo->SetQueueNotify (Dev->VirtIo, VIRTIO_NET_Q_RX);
+}
+
 /**
   Release TX and RX VRING resources.
 
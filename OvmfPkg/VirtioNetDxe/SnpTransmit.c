@@ -15,6 +15,239 @@
 
 #include "VirtioNet.h"
 
+//
+// Ethertypes, and the offsets of the fields examined in the IPv4, IPv6 and
+// TCP headers.
+//
+#define VNET_ETHERTYPE_IP4       0x0800
+#define VNET_ETHERTYPE_IP6       0x86DD
+#define VNET_IP_PROTO_TCP        6
+#define VNET_IP6_HOP_BY_HOP      0
+#define VNET_IP6_DEST_OPTS       60
+#define VNET_IP4_HEAD_LEN        20
+#define VNET_IP6_HEAD_LEN        40
+#define VNET_TCP_HEAD_LEN        20
+#define VNET_TCP_CHECKSUM_FIELD  16
+
+/**
+  Add the 16-bit words of a block to a one's complement sum, the words being
+  taken in the byte order of the memory.
+
+  @param[in] Sum    The sum to add the words to.
+  @param[in] Block  The block to add, of an even size.
+  @param[in] Size   The size of the block in bytes.
+
+  @return The sum including the block, not folded.
+**/
+STATIC
+UINT32
+VirtioNetSumWords (
+  IN UINT32  Sum,
+  IN UINT8   *Block,
+  IN UINTN   Size
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < Size; Index += 2) {
+    Sum += ReadUnaligned16 ((UINT16 *)(Block + Index));
+  }
+
+  return Sum;
+}
+
+/**
+  Complete in software the checksum of a TCP segment whose checksum field
+  holds the sum of its pseudo header.
+
+  The sum of the segment includes the pseudo header through the checksum
+  field, so the checksum is the complement of the sum of the segment.
+
+  @param[in,out] Segment  The TCP segment, starting with the TCP header.
+  @param[in]     Size     The size of the segment in bytes.
+**/
+STATIC
+VOID
+VirtioNetCompleteTcpChecksum (
+  IN OUT UINT8  *Segment,
+  IN     UINTN  Size
+  )
+{
+  UINT32  Sum;
+  UINT8   Last[2];
+
+  Sum = VirtioNetSumWords (0, Segment, Size & ~(UINTN)1);
+  if ((Size & 1) != 0) {
+    Last[0] = Segment[Size - 1];
+    Last[1] = 0;
+    Sum     = VirtioNetSumWords (Sum, Last, sizeof Last);
+  }
+
+  Sum = (Sum & 0xFFFF) + (Sum >> 16);
+  Sum = (Sum & 0xFFFF) + (Sum >> 16);
+  WriteUnaligned16 ((UINT16 *)(Segment + VNET_TCP_CHECKSUM_FIELD), (UINT16)~Sum);
+}
+
+/**
+  Fill in the virtio-net request header of a packet to transmit, requesting
+  the offloads advertised through the EDKII Simple Network Offload Protocol.
+
+  A TCP segment whose checksum field holds the sum of its pseudo header is
+  left for the host to checksum. Such a segment in an IPv4 packet longer than
+  MaxPacketSize is also left for the host to segment. Such a segment behind
+  IPv6 extension headers is checksummed in software. A fragmented IPv4
+  packet doesn't carry the whole segment; Ip4Dxe completes the checksum
+  before fragmenting.
+
+  @param[in]  Dev         The VNET_DEV driver instance.
+  @param[in]  Frame       The packet to transmit, including the media header.
+  @param[in]  FrameSize   The size of the packet in bytes.
+  @param[out] Req         The virtio-net request header to fill in.
+
+  @retval EFI_SUCCESS            The header is filled in.
+  @retval EFI_INVALID_PARAMETER  The packet is too long and can't be
+                                 segmented.
+**/
+STATIC
+EFI_STATUS
+VirtioNetPrepareTxReq (
+  IN  VNET_DEV        *Dev,
+  IN  UINT8           *Frame,
+  IN  UINTN           FrameSize,
+  OUT VIRTIO_NET_REQ  *Req
+  )
+{
+  UINT32   Offloads;
+  BOOLEAN  Oversized;
+  UINT8    *Ip;
+  UINTN    IpSize;
+  UINTN    IpHeadLen;
+  UINTN    TcpOffset;
+  UINTN    TcpHeadLen;
+  UINTN    TcpLen;
+  UINT16   EtherType;
+  UINT8    NextHeader;
+  UINT32   Sum;
+
+  ZeroMem (Req, sizeof *Req);
+
+  Offloads  = Dev->OffloadProtocol.Capabilities;
+  Oversized = (BOOLEAN)(FrameSize > Dev->Snm.MediaHeaderSize + Dev->Snm.MaxPacketSize);
+  if (FrameSize < Dev->Snm.MediaHeaderSize + VNET_IP4_HEAD_LEN + VNET_TCP_HEAD_LEN) {
+    goto NoOffload;
+  }
+
+  Ip        = Frame + Dev->Snm.MediaHeaderSize;
+  IpSize    = FrameSize - Dev->Snm.MediaHeaderSize;
+  EtherType = (UINT16)((Ip[-2] << 8) | Ip[-1]);
+
+  if ((EtherType == VNET_ETHERTYPE_IP4) &&
+      ((Offloads & EDKII_SIMPLE_NETWORK_OFFLOAD_TCP4_CSUM) != 0))
+  {
+    //
+    // An unfragmented TCP segment filling the frame.
+    //
+    IpHeadLen = (Ip[0] & 0x0F) * 4;
+    if (((Ip[0] >> 4) != 4) || (IpHeadLen < VNET_IP4_HEAD_LEN) ||
+        (Ip[9] != VNET_IP_PROTO_TCP) || (((Ip[2] << 8) | Ip[3]) != IpSize) ||
+        ((Ip[6] & 0x3F) != 0) || (Ip[7] != 0))
+    {
+      goto NoOffload;
+    }
+
+    //
+    // Source and destination addresses.
+    //
+    Sum = VirtioNetSumWords (0, Ip + 12, 8);
+  } else if ((EtherType == VNET_ETHERTYPE_IP6) &&
+             ((Offloads & EDKII_SIMPLE_NETWORK_OFFLOAD_TCP6_CSUM) != 0) &&
+             !Oversized)
+  {
+    //
+    // A TCP segment filling the frame, following the IPv6 header directly or
+    // after hop-by-hop and destination options.
+    //
+    IpHeadLen = VNET_IP6_HEAD_LEN;
+    if ((IpSize < IpHeadLen + VNET_TCP_HEAD_LEN) || ((Ip[0] >> 4) != 6) ||
+        (((Ip[4] << 8) | Ip[5]) != IpSize - IpHeadLen))
+    {
+      goto NoOffload;
+    }
+
+    NextHeader = Ip[6];
+    while ((NextHeader == VNET_IP6_HOP_BY_HOP) || (NextHeader == VNET_IP6_DEST_OPTS)) {
+      if (IpHeadLen + 8 > IpSize) {
+        goto NoOffload;
+      }
+
+      NextHeader = Ip[IpHeadLen];
+      IpHeadLen += (Ip[IpHeadLen + 1] + 1) * 8;
+    }
+
+    if ((NextHeader != VNET_IP_PROTO_TCP) || (IpHeadLen > IpSize)) {
+      goto NoOffload;
+    }
+
+    Sum = VirtioNetSumWords (0, Ip + 8, 32);
+  } else {
+    goto NoOffload;
+  }
+
+  TcpOffset = Dev->Snm.MediaHeaderSize + IpHeadLen;
+  TcpLen    = IpSize - IpHeadLen;
+  if (TcpLen < VNET_TCP_HEAD_LEN) {
+    goto NoOffload;
+  }
+
+  TcpHeadLen = (Frame[TcpOffset + 12] >> 4) * 4;
+  if ((TcpHeadLen < VNET_TCP_HEAD_LEN) || (TcpHeadLen > TcpLen)) {
+    goto NoOffload;
+  }
+
+  //
+  // Protocol and TCP length complete the pseudo header.
+  //
+  Sum += SwapBytes16 (VNET_IP_PROTO_TCP) + SwapBytes16 ((UINT16)TcpLen);
+  Sum  = (Sum & 0xFFFF) + (Sum >> 16);
+  Sum  = (Sum & 0xFFFF) + (Sum >> 16);
+  if (ReadUnaligned16 ((UINT16 *)(Frame + TcpOffset + VNET_TCP_CHECKSUM_FIELD)) != Sum) {
+    goto NoOffload;
+  }
+
+  if ((EtherType == VNET_ETHERTYPE_IP6) && (IpHeadLen != VNET_IP6_HEAD_LEN)) {
+    //
+    // The offload only covers a TCP header right after the IPv6 header.
+    //
+    VirtioNetCompleteTcpChecksum (Frame + TcpOffset, TcpLen);
+    return EFI_SUCCESS;
+  }
+
+  //
+  // virtio-0.9.5, Appendix C, Packet Transmission: the host sums the packet
+  // from CsumStart and stores the checksum at CsumStart + CsumOffset.
+  //
+  Req->Flags      = VIRTIO_NET_HDR_F_NEEDS_CSUM;
+  Req->CsumStart  = (UINT16)TcpOffset;
+  Req->CsumOffset = VNET_TCP_CHECKSUM_FIELD;
+
+  if (Oversized) {
+    if (((Offloads & EDKII_SIMPLE_NETWORK_OFFLOAD_TCP4_TSO) == 0) ||
+        (IpSize > Dev->OffloadProtocol.MaxSegmentationSize))
+    {
+      return EFI_INVALID_PARAMETER;
+    }
+
+    Req->GsoType = VIRTIO_NET_HDR_GSO_TCPV4;
+    Req->HdrLen  = (UINT16)(TcpOffset + TcpHeadLen);
+    Req->GsoSize = (UINT16)(Dev->Snm.MaxPacketSize - IpHeadLen - TcpHeadLen);
+  }
+
+  return EFI_SUCCESS;
+
+NoOffload:
+  return Oversized ? EFI_INVALID_PARAMETER : EFI_SUCCESS;
+}
+
 /**
   Places a packet in the transmit queue of a network interface.
 
@@ -95,11 +328,6 @@ VirtioNetTransmit (
     goto Exit;
   }
 
-  if (BufferSize > Dev->Snm.MediaHeaderSize + Dev->Snm.MaxPacketSize) {
-    Status = EFI_INVALID_PARAMETER;
-    goto Exit;
-  }
-
   //
   // check if we have room for transmission
   //
@@ -142,6 +370,21 @@ VirtioNetTransmit (
     ASSERT ((UINTN)(Ptr - (UINT8 *)Buffer) == Dev->Snm.MediaHeaderSize);
   }
 
+  //
+  // Request the offloads in the virtio-net request header of the chain, and
+  // reject the packet if it is too long to be segmented.
+  //
+  DescIdx = Dev->TxFreeStack[Dev->TxCurPending];
+  Status  = VirtioNetPrepareTxReq (
+              Dev,
+              Buffer,
+              BufferSize,
+              &Dev->TxReq[DescIdx / 2].V0_9_5
+              );
+  if (EFI_ERROR (Status)) {
+    goto Exit;
+  }
+
   //
   // Map the transmit buffer system physical address to device address.
   //
@@ -159,7 +402,7 @@ VirtioNetTransmit (
   //
   // virtio-0.9.5, 2.4.1 Supplying Buffers to The Device
   //
-  DescIdx                            = Dev->TxFreeStack[Dev->TxCurPending++];
+  Dev->TxCurPending++;
   Dev->TxRing.Desc[DescIdx + 1].Addr = DeviceAddress;
   Dev->TxRing.Desc[DescIdx + 1].Len  = (UINT32)BufferSize;
 
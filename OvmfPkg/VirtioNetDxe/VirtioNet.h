@@ -20,6 +20,8 @@
 #include <Protocol/DevicePath.h>
 #include <Protocol/DriverBinding.h>
 #include <Protocol/SimpleNetwork.h>
+#include <Protocol/SimpleNetworkOffload.h>
+#include <Protocol/SimpleNetworkRxLoan.h>
 #include <Library/OrderedCollectionLib.h>
 
 #define VNET_SIG  SIGNATURE_32 ('V', 'N', 'E', 'T')
@@ -27,7 +29,8 @@
 //
 // maximum number of pending packets, separately for each direction
 //
-#define VNET_MAX_PENDING  64
+#define VNET_MAX_PENDING     64
+#define VNET_MAX_RX_PENDING  256
 
 //
 // State diagram:
@@ -61,6 +64,20 @@
 //                               Receive are callable.
 //
 
+//
+// A receive area detached by VirtioNetShutdownRx() while some of its packets
+// were still on loan. It is released when the last of them is returned.
+//
+typedef struct {
+  LIST_ENTRY                      Link;
+  UINT8                           *Buf;
+  UINTN                           BufNrPages;
+  VOID                            *BufMap;
+  EDKII_SIMPLE_NETWORK_RX_LOAN    *Loan;
+  UINT16                          LoanNum;
+  UINT16                          LoanPending;
+} VNET_RX_AREA;
+
 typedef struct {
   //
   // Parts of this structure are initialized / torn down in various functions
@@ -76,15 +93,22 @@ typedef struct {
   EFI_EVENT                      ExitBoot;       // VirtioNetSnpPopulate
   EFI_DEVICE_PATH_PROTOCOL       *MacDevicePath; // VirtioNetDriverBindingStart
   EFI_HANDLE                     MacHandle;      // VirtioNetDriverBindingStart
+  UINT16                         NetReqSize;     // VirtioNetInitialize
 
   VRING                          RxRing;          // VirtioNetInitRing
   VOID                           *RxRingMap;      // VirtioRingMap and
                                                   // VirtioNetInitRing
+  BOOLEAN                        RxMrgBuf;        // VirtioNetInitialize
+  UINT16                         RxDescPerPkt;    // VirtioNetInitRx
   UINT8                          *RxBuf;          // VirtioNetInitRx
   UINT16                         RxLastUsed;      // VirtioNetInitRx
   UINTN                          RxBufNrPages;    // VirtioNetInitRx
   EFI_PHYSICAL_ADDRESS           RxBufDeviceBase; // VirtioNetInitRx
   VOID                           *RxBufMap;       // VirtioNetInitRx
+  EDKII_SIMPLE_NETWORK_RX_LOAN   *RxLoan;         // VirtioNetInitRx
+  UINT16                         RxLoanNum;       // VirtioNetInitRx
+  UINT16                         RxLoanPending;   // VirtioNetInitRx
+  LIST_ENTRY                     RxRetired;       // VirtioNetDriverBindingStart
 
   VRING                          TxRing;           // VirtioNetInitRing
   VOID                           *TxRingMap;       // VirtioRingMap and
@@ -92,10 +116,16 @@ typedef struct {
   UINT16                         TxMaxPending;     // VirtioNetInitTx
   UINT16                         TxCurPending;     // VirtioNetInitTx
   UINT16                         *TxFreeStack;     // VirtioNetInitTx
-  VIRTIO_1_0_NET_REQ             *TxSharedReq;     // VirtioNetInitTx
-  VOID                           *TxSharedReqMap;  // VirtioNetInitTx
+  VIRTIO_1_0_NET_REQ             *TxReq;           // VirtioNetInitTx
+  VOID                           *TxReqMap;        // VirtioNetInitTx
   UINT16                         TxLastUsed;       // VirtioNetInitTx
   ORDERED_COLLECTION             *TxBufCollection; // VirtioNetInitTx
+
+  //
+  // Protocols installed on MacHandle next to Snp.
+  //
+  EDKII_SIMPLE_NETWORK_RX_LOAN_PROTOCOL    RxLoanProtocol;  // VirtioNetSnpPopulate
+  EDKII_SIMPLE_NETWORK_OFFLOAD_PROTOCOL    OffloadProtocol; // VirtioNetSnpPopulate
 } VNET_DEV;
 
 //
@@ -111,6 +141,9 @@ typedef struct {
 #define VIRTIO_NET_FROM_SNP(SnpPointer) \
         CR (SnpPointer, VNET_DEV, Snp, VNET_SIG)
 
+#define VIRTIO_NET_FROM_RX_LOAN(RxLoanPointer) \
+        CR (RxLoanPointer, VNET_DEV, RxLoanProtocol, VNET_SIG)
+
 #define VIRTIO_CFG_WRITE(Dev, Field, Value)  ((Dev)->VirtIo->WriteDevice (  \
                                                 (Dev)->VirtIo,              \
                                                 OFFSET_OF_VNET (Field),     \
@@ -252,9 +285,33 @@ VirtioNetReceive (
   OUT UINT16                      *Protocol   OPTIONAL
   );
 
+//
+// member functions implementing the Simple Network Receive Loan Protocol
+//
+EFI_STATUS
+EFIAPI
+VirtioNetReceiveLoan (
+  IN  EDKII_SIMPLE_NETWORK_RX_LOAN_PROTOCOL  *This,
+  OUT EDKII_SIMPLE_NETWORK_RX_LOAN           **Loan
+  );
+
+VOID
+EFIAPI
+VirtioNetReturnLoan (
+  IN EDKII_SIMPLE_NETWORK_RX_LOAN_PROTOCOL  *This,
+  IN EDKII_SIMPLE_NETWORK_RX_LOAN           *Loan
+  );
+
 //
 // utility functions shared by various SNP member functions
 //
+EFI_STATUS
+EFIAPI
+VirtioNetRecycleRxDesc (
+  IN OUT VNET_DEV  *Dev,
+  IN     UINT16    DescIdx
+  );
+
 VOID
 EFIAPI
 VirtioNetShutdownRx (
@@ -267,6 +324,13 @@ VirtioNetShutdownTx (
   IN OUT VNET_DEV  *Dev
   );
 
+VOID
+EFIAPI
+VirtioNetReleaseRxArea (
+  IN VNET_DEV      *Dev,
+  IN VNET_RX_AREA  *Area
+  );
+
 VOID
 EFIAPI
 VirtioNetUninitRing (